@@ -23,6 +23,7 @@
 #include "stm32l4xx_it.h"
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include <kernel.h>
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -49,6 +50,14 @@
 /* USER CODE BEGIN PFP */
 void target_timer_handler(void);
 
+/*
+ *  カーネルの現在時刻（kernel/time_event.hのcurrent_time）
+ *
+ *  カーネル内部の変数であるため，リネーム後の名前で参照する．タイム
+ *  ティックの周期は1ミリ秒であるため，ミリ秒単位の時刻として扱える．
+ */
+extern volatile ulong_t _kernel_current_time;
+
 /* USER CODE END PFP */
 
 /* Private user code ---------------------------------------------------------*/
@@ -170,7 +179,14 @@ void PendSV_Handler(void)
 void SysTick_Handler(void)
 {
   /* USER CODE BEGIN SysTick_IRQn 0 */
-  target_timer_handler();
+  /*
+   *  カーネルの動作中は，カーネルのタイムティックのみを処理する．HAL
+   *  のティック（uwTick）は，カーネルの起動前にのみ進める．
+   */
+  if (!sns_ker()) {
+    target_timer_handler();
+    return;
+  }
 
   /* USER CODE END SysTick_IRQn 0 */
   HAL_IncTick();
@@ -222,6 +238,62 @@ void EXTI15_10_IRQHandler(void)
 }
 
 /* USER CODE BEGIN 1 */
+/*
+ *  HALのタイムベースとカーネルの時刻の統合
+ *
+ *  HAL_GetTickは，カーネルの起動前に進めたuwTickに，カーネルの現在時
+ *  刻を加えた値を返す．カーネルの起動後はuwTickを進めないため，値は単
+ *  調に増加する．
+ */
+uint32_t HAL_GetTick(void)
+{
+  return uwTick + (uint32_t) _kernel_current_time;
+}
+
+/*
+ *  HAL_Delayは，タスクコンテキストでディスパッチできる状態であれば
+ *  dly_tskで待ち，それ以外（カーネルの起動前，非タスクコンテキスト，
+ *  CPUロック状態，ディスパッチ禁止状態など）ではHALと同じ方法でビジー
+ *  ウェイトする．
+ */
+void HAL_Delay(uint32_t Delay)
+{
+  uint32_t tickstart;
+  uint32_t wait = Delay;
+
+  if (!sns_ker() && !sns_dpn()) {
+    (void) dly_tsk((RELTIM) Delay);
+    return;
+  }
+
+  tickstart = HAL_GetTick();
+  if (wait < HAL_MAX_DELAY) {
+    wait += (uint32_t)(uwTickFreq);
+  }
+  while ((HAL_GetTick() - tickstart) < wait) {
+  }
+}
+
+/*
+ *  HAL_InitTickは，カーネルの起動前にのみSysTickを設定する．カーネル
+ *  の起動後（HAL_RCC_ClockConfigからの呼出しなど）は，カーネルが設定
+ *  したSysTickを変更しない．
+ */
+HAL_StatusTypeDef HAL_InitTick(uint32_t TickPriority)
+{
+  if (!sns_ker()) {
+    return HAL_OK;
+  }
+  if (uwTickFreq == 0U
+      || HAL_SYSTICK_Config(SystemCoreClock / (1000U / uwTickFreq)) != 0U
+      || TickPriority >= (1UL << __NVIC_PRIO_BITS)) {
+    return HAL_ERROR;
+  }
+  HAL_NVIC_SetPriority(SysTick_IRQn, TickPriority, 0U);
+  uwTickPrio = TickPriority;
+  return HAL_OK;
+}
+
 
 /* USER CODE END 1 */
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -194,6 +194,31 @@
 #define SYSTIC_NOREF     0x80000000
 #define SYSTIC_TENMS     0x00ffffff
 
+/*
+ *  ITM関連レジスタ
+ */
+#if __TARGET_ARCH_THUMB == 4
+
+#define ITM_STIM_BASE    0xE0000000
+#define ITM_STIM(port)   (ITM_STIM_BASE + ((port) * 4))
+#define ITM_TER          0xE0000E00
+#define ITM_TCR          0xE0000E80
+
+#define ITM_STIM_FIFOREADY  0x00000001
+#define ITM_TCR_ITMENA      0x00000001
+
+/*
+ *  DWT関連レジスタ
+ */
+#define DEMCR            0xE000EDFC
+#define DWT_CTRL         0xE0001000
+#define DWT_CYCCNT       0xE0001004
+
+#define DEMCR_TRCENA        0x01000000
+#define DWT_CTRL_CYCCNTENA  0x00000001
+
+#endif /* __TARGET_ARCH_THUMB == 4 */
+
 /*
  * FPU関連レジスタ
  */
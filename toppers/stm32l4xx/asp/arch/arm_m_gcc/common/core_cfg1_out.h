@@ -16,7 +16,9 @@ const uint32_t  MAGIC_4 = 0x12345678;
 
 const TCB	TCB_enatex = {
 	{ NULL, NULL },			/* task_queue */
+#ifndef TOPPERS_COMPACT_TCB
 	NULL,					/* p_tinib */
+#endif /* TOPPERS_COMPACT_TCB */
 	0U,						/* tstat */
 #ifdef TOPPERS_SUPPORT_MUTEX
 	0U,						/* bpriority */
@@ -25,7 +27,9 @@ const TCB	TCB_enatex = {
 	false,					/* acqeue */
 	false,					/* wupque */
 	true,					/* enatex */
+#ifndef TOPPERS_COMPACT_TCB
 	0U,						/* texprn */
+#endif /* TOPPERS_COMPACT_TCB */
 	NULL,					/* p_winifo */
 #ifdef TOPPERS_SUPPORT_MUTEX
 	{ NULL, NULL },			/* mutex_queue */
@@ -82,6 +82,17 @@ init_intmodel(void){
  */
 extern const FP vector_table[];
 
+#ifdef TOPPERS_RAM_VECTOR
+/*
+ *  RAM上のベクタテーブル
+ *
+ *  core_initializeでvector_tableをコピーし，VTORをこちらに設定する．
+ *  配置するセクションとアラインメントは，ターゲット依存部で
+ *  RAM_VECTOR_ATTRIBUTEとして定義する．
+ */
+static FP ram_vector_table[TMAX_INTNO + 1] RAM_VECTOR_ATTRIBUTE;
+#endif /* TOPPERS_RAM_VECTOR */
+
 /*
  *  システム例外・割込みの（例外番号 4〜15）
  *  割込み優先度設定レジスタへのアクセスのための配列
@@ -195,7 +206,16 @@ core_initialize(void)
 	/*
 	 *  ベクタテーブルを設定
 	 */
+#ifdef TOPPERS_RAM_VECTOR
+	uint_t	i;
+
+	for (i = 0; i <= TMAX_INTNO; i++) {
+		ram_vector_table[i] = vector_table[i];
+	}
+	sil_wrw_mem((void*)NVIC_VECTTBL, (uint32_t)ram_vector_table);
+#else /* TOPPERS_RAM_VECTOR */
 	sil_wrw_mem((void*)NVIC_VECTTBL, (uint32_t)vector_table);
+#endif /* TOPPERS_RAM_VECTOR */
 
 	/*
 	 *  各例外の優先度を設定
@@ -214,6 +234,15 @@ core_initialize(void)
 	 *  割込み処理モデル関連の初期化
 	 */
 	init_intmodel();
+
+#ifdef TOPPERS_LOCKPROF
+	/*
+	 *  ロック区間の計測に用いるサイクルカウンタを動作させる
+	 */
+	sil_wrw_mem((void *) DEMCR, sil_rew_mem((void *) DEMCR) | DEMCR_TRCENA);
+	sil_wrw_mem((void *) DWT_CTRL,
+					sil_rew_mem((void *) DWT_CTRL) | DWT_CTRL_CYCCNTENA);
+#endif /* TOPPERS_LOCKPROF */
 }
 
 /*
@@ -242,7 +271,11 @@ void
 x_config_int(INTNO intno, ATR intatr, PRI intpri)
 {
 	assert(VALID_INTNO_CFGINT(intno));
-	assert(TMIN_INTPRI <= intpri && intpri <= TMAX_INTPRI);
+	/*
+	 *  カーネル管理外の割込みには，TMIN_INTPRIよりも高い割込み優先度を設
+	 *  定できる．
+	 */
+	assert(-(1 << TBITW_IPRI) <= intpri && intpri <= TMAX_INTPRI);
 
 	/* 
 	 *  一旦割込みを禁止する
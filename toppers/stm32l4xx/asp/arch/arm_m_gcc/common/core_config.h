@@ -149,9 +149,30 @@ extern void call_exit_kernel(void) NoReturn;
  *
  *  activate_contextを，インライン関数ではなくマクロ定義としているのは，
  *  この時点ではTCBが定義されていないためである．
+ *
+ *  TOPPERS_COMPACT_TCBを定義した場合は，start_rでTCBからタスク初期化
+ *  ブロックを参照できないため，拡張情報と起動番地をスタック領域の最後
+ *  の2ワードに置き，start_rで取り出す．取り出した後は，スタックポイン
+ *  タはスタック領域の最後を指す．
  */
 extern void start_r(void);
 
+#ifdef TOPPERS_COMPACT_TCB
+
+#define activate_context(p_tcb)											\
+{																		\
+	const TINIB	*p_tinib = get_tinib(p_tcb);							\
+	uint32_t	*p_stk = (uint32_t *)((uint8_t *)(p_tinib->stk)			\
+											+ p_tinib->stksz) - 2;		\
+																		\
+	p_stk[0] = (uint32_t)(p_tinib->exinf);								\
+	p_stk[1] = (uint32_t)(p_tinib->task);								\
+	(p_tcb)->tskctxb.sp = (void *) p_stk;								\
+	(p_tcb)->tskctxb.pc = (FP) start_r;									\
+}
+
+#else /* TOPPERS_COMPACT_TCB */
+
 #define activate_context(p_tcb)											\
 {																		\
 	(p_tcb)->tskctxb.sp = (void *)((uint8_t *)((p_tcb)->p_tinib->stk)	\
@@ -159,6 +180,8 @@ extern void start_r(void);
 	(p_tcb)->tskctxb.pc = (FP) start_r;									\
 }
 
+#endif /* TOPPERS_COMPACT_TCB */
+
 /*
  *  calltexは使用しない
  */
@@ -322,6 +345,11 @@ extern void default_int_handler(void *p_excinf);
  */
 #define IIPM_ENAALL  (0)
 
+/*
+ *  ロック区間の計測
+ */
+#include "arm_m_gcc/common/core_lockprof.h"
+
 #ifndef TOPPERS_MACRO_ONLY
 
 /*
@@ -369,6 +397,7 @@ x_lock_cpu(void)
 	}
 	saved_iipm = iipm;
 	lock_flag = true;
+	LOCKPROF_ENTER(LPF_CPU);
 
 	/* クリティカルセクションの前後でメモリが書き換わる可能性がある */
 	ARM_MEMORY_CHANGED;    
@@ -391,6 +420,7 @@ x_unlock_cpu(void)
 {
 	/* クリティカルセクションの前後でメモリが書き換わる可能性がある */
 	ARM_MEMORY_CHANGED;
+	LOCKPROF_LEAVE(LPF_CPU);
 	lock_flag = false;
 	set_basepri(saved_iipm);
 }
@@ -398,6 +428,18 @@ x_unlock_cpu(void)
 #define t_unlock_cpu()    x_unlock_cpu()
 #define i_unlock_cpu()    x_unlock_cpu()
 
+#ifdef TOPPERS_LOCKPROF
+/*
+ *  ディスパッチ禁止区間の計測
+ *
+ *  dis_dspとena_dsp，ext_tskから，CPUロック状態で呼び出される．すでに
+ *  ディスパッチ禁止状態の場合は，区間を開始しない．
+ */
+#define LOCKPROF_DSP_ENTER() \
+		do { if (!disdsp) { LOCKPROF_ENTER(LPF_DSP); } } while (false)
+#define LOCKPROF_DSP_LEAVE()	LOCKPROF_LEAVE(LPF_DSP)
+#endif /* TOPPERS_LOCKPROF */
+
 /*
  *  CPUロック状態の参照
  */
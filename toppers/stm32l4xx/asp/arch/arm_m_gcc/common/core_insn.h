@@ -149,4 +149,40 @@ get_ipsr(void)
     return(sr);
 }
 
+#if __TARGET_ARCH_THUMB == 4
+
+/*
+ *  排他ロード／排他ストア命令（ARMv7-Mのみ）
+ *
+ *  strex_wordは，ストアに成功した場合に0を，失敗した場合に1を返す．
+ */
+#define TOPPERS_SUPPORT_EXCLUSIVE
+
+Inline uint32_t
+ldrex_word(volatile uint32_t *addr)
+{
+	uint32_t val;
+	Asm("ldrex %0, [%1]" : "=r"(val) : "r"(addr) : "memory");
+	return(val);
+}
+
+Inline uint32_t
+strex_word(uint32_t val, volatile uint32_t *addr)
+{
+	uint32_t res;
+	Asm("strex %0, %1, [%2]" : "=&r"(res) : "r"(val), "r"(addr) : "memory");
+	return(res);
+}
+
+/*
+ *  排他モニタのクリア
+ */
+Inline void
+clrex(void)
+{
+	Asm("clrex":::"memory");
+}
+
+#endif /* __TARGET_ARCH_THUMB == 4 */
+
 #endif /* CORE_INSN_H */
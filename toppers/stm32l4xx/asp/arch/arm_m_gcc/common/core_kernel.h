@@ -59,6 +59,23 @@
 
 #ifndef TOPPERS_MACRO_ONLY
 
+#ifdef TOPPERS_MTX_FASTPATH
+/*
+ *  排他ロード／排他ストア命令
+ *
+ *  ミューテックスの高速パス（floc_mtx／funl_mtx）をkernel.h中のインラ
+ *  イン関数で実現するために用いる．
+ */
+#include <core_insn.h>
+#endif /* TOPPERS_MTX_FASTPATH */
+
+#ifdef TOPPERS_LOCKPROF
+/*
+ *  ロック区間の計測結果の参照（ref_lpf，clr_lpf）
+ */
+#include "arm_m_gcc/common/core_lockprof.h"
+#endif /* TOPPERS_LOCKPROF */
+
 #endif /* TOPPERS_MACRO_ONLY */
 
 #endif /* TOPPERS_CORE_KERNEL_H */
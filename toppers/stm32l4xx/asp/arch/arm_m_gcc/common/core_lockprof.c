@@ -0,0 +1,162 @@
+/*
+ *  TOPPERS/ASP Kernel
+ *      Toyohashi Open Platform for Embedded Real-Time Systems/
+ *      Advanced Standard Profile Kernel
+ * 
+ *  Copyright (C) 2008-2011 by Embedded and Real-Time Systems Laboratory
+ *              Graduate School of Information Science, Nagoya Univ., JAPAN
+ * 
+ *  上記著作権者は，以下の(1)〜(4)の条件を満たす場合に限り，本ソフトウェ
+ *  ア（本ソフトウェアを改変したものを含む．以下同じ）を使用・複製・改
+ *  変・再配布（以下，利用と呼ぶ）することを無償で許諾する．
+ *  (1) 本ソフトウェアをソースコードの形で利用する場合には，上記の著作
+ *      権表示，この利用条件および下記の無保証規定が，そのままの形でソー
+ *      スコード中に含まれていること．
+ *  (2) 本ソフトウェアを，ライブラリ形式など，他のソフトウェア開発に使
+ *      用できる形で再配布する場合には，再配布に伴うドキュメント（利用
+ *      者マニュアルなど）に，上記の著作権表示，この利用条件および下記
+ *      の無保証規定を掲載すること．
+ *  (3) 本ソフトウェアを，機器に組み込むなど，他のソフトウェア開発に使
+ *      用できない形で再配布する場合には，次のいずれかの条件を満たすこ
+ *      と．
+ *    (a) 再配布に伴うドキュメント（利用者マニュアルなど）に，上記の著
+ *        作権表示，この利用条件および下記の無保証規定を掲載すること．
+ *    (b) 再配布の形態を，別に定める方法によって，TOPPERSプロジェクトに
+ *        報告すること．
+ *  (4) 本ソフトウェアの利用により直接的または間接的に生じるいかなる損
+ *      害からも，上記著作権者およびTOPPERSプロジェクトを免責すること．
+ *      また，本ソフトウェアのユーザまたはエンドユーザからのいかなる理
+ *      由に基づく請求からも，上記著作権者およびTOPPERSプロジェクトを
+ *      免責すること．
+ * 
+ *  本ソフトウェアは，無保証で提供されているものである．上記著作権者お
+ *  よびTOPPERSプロジェクトは，本ソフトウェアに関して，特定の使用目的
+ *  に対する適合性も含めて，いかなる保証も行わない．また，本ソフトウェ
+ *  アの利用により直接的または間接的に生じたいかなる損害に関しても，そ
+ *  の責任を負わない．
+ * 
+ *  @(#) $Id$
+ */
+
+/*
+ *		ロック区間の計測（ARMv7-M用）
+ */
+
+#include <kernel.h>
+#include <sil.h>
+#include <t_syslog.h>
+
+/*
+ *  計測中のロック区間
+ */
+LPFSEC	lockprof_sec[TNUM_LPFTYPE];
+
+/*
+ *  計測結果
+ */
+static T_RLPF	lockprof_result[TNUM_LPFTYPE];
+
+/*
+ *  ロック区間の終了
+ *
+ *  区間を終了する前に呼び出されるため，同じ種類の区間の計測結果は，こ
+ *  の関数の中で排他的に更新できる．
+ */
+void
+lockprof_leave(uint_t lpftype)
+{
+	uint32_t	cycles;
+	uintptr_t	site;
+	T_LPFREC	*worst;
+	uint_t		i;
+
+	cycles = *((volatile uint32_t *) DWT_CYCCNT) - lockprof_sec[lpftype].begin;
+	site = lockprof_sec[lpftype].site;
+	if (site == 0U) {
+		return;
+	}
+	lockprof_sec[lpftype].site = 0U;
+	lockprof_result[lpftype].count++;
+
+	/*
+	 *  同じ戻り番地の記録があればそれを，なければ最も短い記録を置き換
+	 *  える．
+	 */
+	worst = lockprof_result[lpftype].worst;
+	for (i = 0U; i < TNUM_LPFWORST - 1U; i++) {
+		if (worst[i].site == site) {
+			break;
+		}
+	}
+	if (cycles <= worst[i].cycles) {
+		return;
+	}
+	while (i > 0U && worst[i - 1U].cycles < cycles) {
+		worst[i] = worst[i - 1U];
+		i--;
+	}
+	worst[i].cycles = cycles;
+	worst[i].site = site;
+}
+
+/*
+ *  計測結果の参照
+ */
+ER
+ref_lpf(uint_t lpftype, T_RLPF *pk_rlpf)
+{
+	SIL_PRE_LOC;
+
+	if (lpftype >= TNUM_LPFTYPE) {
+		return(E_PAR);
+	}
+	SIL_LOC_INT();
+	*pk_rlpf = lockprof_result[lpftype];
+	SIL_UNL_INT();
+	return(E_OK);
+}
+
+/*
+ *  計測結果の初期化
+ */
+ER
+clr_lpf(void)
+{
+	uint_t	lpftype, i;
+	SIL_PRE_LOC;
+
+	SIL_LOC_INT();
+	for (lpftype = 0U; lpftype < TNUM_LPFTYPE; lpftype++) {
+		lockprof_result[lpftype].count = 0U;
+		for (i = 0U; i < TNUM_LPFWORST; i++) {
+			lockprof_result[lpftype].worst[i].cycles = 0U;
+			lockprof_result[lpftype].worst[i].site = 0U;
+		}
+	}
+	SIL_UNL_INT();
+	return(E_OK);
+}
+
+/*
+ *  計測結果の出力
+ */
+static const char	*const lockprof_name[TNUM_LPFTYPE] = {
+	"CPU lock", "interrupt lock", "dispatch disable"
+};
+
+void
+lockprof_terminate(intptr_t exinf)
+{
+	T_RLPF	rlpf;
+	uint_t	lpftype, i;
+
+	for (lpftype = 0U; lpftype < TNUM_LPFTYPE; lpftype++) {
+		(void) ref_lpf(lpftype, &rlpf);
+		syslog_2(LOG_NOTICE, "lockprof: %s, %u sections",
+								lockprof_name[lpftype], rlpf.count);
+		for (i = 0U; i < TNUM_LPFWORST && rlpf.worst[i].site != 0U; i++) {
+			syslog_3(LOG_NOTICE, "lockprof:  #%d: %u cycles at 0x%08x",
+						i + 1U, rlpf.worst[i].cycles, rlpf.worst[i].site);
+		}
+	}
+}
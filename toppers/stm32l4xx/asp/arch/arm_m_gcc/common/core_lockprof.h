@@ -0,0 +1,159 @@
+/*
+ *  TOPPERS/ASP Kernel
+ *      Toyohashi Open Platform for Embedded Real-Time Systems/
+ *      Advanced Standard Profile Kernel
+ * 
+ *  Copyright (C) 2008-2011 by Embedded and Real-Time Systems Laboratory
+ *              Graduate School of Information Science, Nagoya Univ., JAPAN
+ * 
+ *  上記著作権者は，以下の(1)〜(4)の条件を満たす場合に限り，本ソフトウェ
+ *  ア（本ソフトウェアを改変したものを含む．以下同じ）を使用・複製・改
+ *  変・再配布（以下，利用と呼ぶ）することを無償で許諾する．
+ *  (1) 本ソフトウェアをソースコードの形で利用する場合には，上記の著作
+ *      権表示，この利用条件および下記の無保証規定が，そのままの形でソー
+ *      スコード中に含まれていること．
+ *  (2) 本ソフトウェアを，ライブラリ形式など，他のソフトウェア開発に使
+ *      用できる形で再配布する場合には，再配布に伴うドキュメント（利用
+ *      者マニュアルなど）に，上記の著作権表示，この利用条件および下記
+ *      の無保証規定を掲載すること．
+ *  (3) 本ソフトウェアを，機器に組み込むなど，他のソフトウェア開発に使
+ *      用できない形で再配布する場合には，次のいずれかの条件を満たすこ
+ *      と．
+ *    (a) 再配布に伴うドキュメント（利用者マニュアルなど）に，上記の著
+ *        作権表示，この利用条件および下記の無保証規定を掲載すること．
+ *    (b) 再配布の形態を，別に定める方法によって，TOPPERSプロジェクトに
+ *        報告すること．
+ *  (4) 本ソフトウェアの利用により直接的または間接的に生じるいかなる損
+ *      害からも，上記著作権者およびTOPPERSプロジェクトを免責すること．
+ *      また，本ソフトウェアのユーザまたはエンドユーザからのいかなる理
+ *      由に基づく請求からも，上記著作権者およびTOPPERSプロジェクトを
+ *      免責すること．
+ * 
+ *  本ソフトウェアは，無保証で提供されているものである．上記著作権者お
+ *  よびTOPPERSプロジェクトは，本ソフトウェアに関して，特定の使用目的
+ *  に対する適合性も含めて，いかなる保証も行わない．また，本ソフトウェ
+ *  アの利用により直接的または間接的に生じたいかなる損害に関しても，そ
+ *  の責任を負わない．
+ * 
+ *  @(#) $Id$
+ */
+
+/*
+ *		ロック区間の計測（ARMv7-M用）
+ *
+ *  TOPPERS_LOCKPROFを定義した場合に，CPUロック区間（t_lock_cpu，
+ *  i_lock_cpu），全割込みロック区間（SIL_LOC_INT）とディスパッチ禁止
+ *  区間（dis_dsp）の開始と終了の時刻を，サイクルカウンタ（DWT CYCCNT）
+ *  で取得し，種類毎に，区間の数と，最も長い区間の長さとそれを開始した
+ *  関数の戻り番地を，長い順にTNUM_LPFWORST個記録する．同じ戻り番地の
+ *  区間は，最も長いものだけを記録する．
+ *
+ *  このインクルードファイルは，core_config.h，core_sil.hとcore_kernel.h
+ *  からインクルードされる．他のファイルから直接インクルードしてはなら
+ *  ない．TOPPERS_LOCKPROFを定義しない場合は，区間の開始と終了のマクロ
+ *  を空に定義するのみである．
+ */
+
+#ifndef TOPPERS_CORE_LOCKPROF_H
+#define TOPPERS_CORE_LOCKPROF_H
+
+#ifdef TOPPERS_LOCKPROF
+
+#if __TARGET_ARCH_THUMB != 4
+#error TOPPERS_LOCKPROF is supported only on ARMv7-M.
+#endif /* __TARGET_ARCH_THUMB != 4 */
+
+#include "arm_m.h"
+
+/*
+ *  ロック区間の種類
+ */
+#define LPF_CPU			0U		/* CPUロック区間 */
+#define LPF_INT			1U		/* 全割込みロック区間 */
+#define LPF_DSP			2U		/* ディスパッチ禁止区間 */
+#define TNUM_LPFTYPE	3U		/* ロック区間の種類の数 */
+
+/*
+ *  記録する区間の数
+ */
+#ifndef TNUM_LPFWORST
+#define TNUM_LPFWORST	4U
+#endif /* TNUM_LPFWORST */
+
+#ifndef TOPPERS_MACRO_ONLY
+
+/*
+ *  ロック区間の記録
+ */
+typedef struct lock_profile_record {
+	uint32_t	cycles;			/* 区間の長さ（サイクル数）*/
+	uintptr_t	site;			/* 区間を開始した関数の戻り番地 */
+} T_LPFREC;
+
+/*
+ *  ロック区間の計測結果のパケット
+ */
+typedef struct t_rlpf {
+	uint32_t	count;						/* 計測した区間の数 */
+	T_LPFREC	worst[TNUM_LPFWORST];		/* 長い順の区間の記録 */
+} T_RLPF;
+
+/*
+ *  計測中のロック区間
+ *
+ *  siteが0の場合は，計測中の区間がないことを示す．CPUロック区間は，割
+ *  込みの出口処理とディスパッチャ（core_support.S）でも開始するため，
+ *  メンバの順序を変更してはならない．
+ */
+typedef struct lock_profile_section {
+	uint32_t	begin;			/* 開始時のサイクルカウンタの値 */
+	uintptr_t	site;			/* 区間を開始した関数の戻り番地 */
+} LPFSEC;
+
+extern LPFSEC	lockprof_sec[TNUM_LPFTYPE];
+
+/*
+ *  ロック区間の開始
+ *
+ *  インライン関数の中から呼び出すため，戻り番地は，インライン展開され
+ *  た関数のものとなる．
+ */
+Inline void
+lockprof_enter(uint_t lpftype, uintptr_t site)
+{
+	lockprof_sec[lpftype].begin = *((volatile uint32_t *) DWT_CYCCNT);
+	lockprof_sec[lpftype].site = site;
+}
+
+#define LOCKPROF_ENTER(lpftype) \
+		lockprof_enter((lpftype), (uintptr_t) __builtin_return_address(0))
+
+/*
+ *  ロック区間の終了
+ *
+ *  ロック区間を終了する前に（ロックを解除する前に）呼び出す．
+ */
+extern void	lockprof_leave(uint_t lpftype) throw();
+
+#define LOCKPROF_LEAVE(lpftype)		lockprof_leave(lpftype)
+
+/*
+ *  計測結果の参照と初期化
+ */
+extern ER	ref_lpf(uint_t lpftype, T_RLPF *pk_rlpf) throw();
+extern ER	clr_lpf(void) throw();
+
+/*
+ *  計測結果の出力（終了処理ルーチン）
+ */
+extern void	lockprof_terminate(intptr_t exinf) throw();
+
+#endif /* TOPPERS_MACRO_ONLY */
+
+#else /* TOPPERS_LOCKPROF */
+
+#define LOCKPROF_ENTER(lpftype)
+#define LOCKPROF_LEAVE(lpftype)
+
+#endif /* TOPPERS_LOCKPROF */
+#endif /* TOPPERS_CORE_LOCKPROF_H */
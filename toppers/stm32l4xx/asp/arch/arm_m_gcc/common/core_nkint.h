@@ -0,0 +1,106 @@
+/*
+ *  TOPPERS/ASP Kernel
+ *      Toyohashi Open Platform for Embedded Real-Time Systems/
+ *      Advanced Standard Profile Kernel
+ * 
+ *  Copyright (C) 2008-2011 by Embedded and Real-Time Systems Laboratory
+ *              Graduate School of Information Science, Nagoya Univ., JAPAN
+ * 
+ *  上記著作権者は，以下の(1)〜(4)の条件を満たす場合に限り，本ソフトウェ
+ *  ア（本ソフトウェアを改変したものを含む．以下同じ）を使用・複製・改
+ *  変・再配布（以下，利用と呼ぶ）することを無償で許諾する．
+ *  (1) 本ソフトウェアをソースコードの形で利用する場合には，上記の著作
+ *      権表示，この利用条件および下記の無保証規定が，そのままの形でソー
+ *      スコード中に含まれていること．
+ *  (2) 本ソフトウェアを，ライブラリ形式など，他のソフトウェア開発に使
+ *      用できる形で再配布する場合には，再配布に伴うドキュメント（利用
+ *      者マニュアルなど）に，上記の著作権表示，この利用条件および下記
+ *      の無保証規定を掲載すること．
+ *  (3) 本ソフトウェアを，機器に組み込むなど，他のソフトウェア開発に使
+ *      用できない形で再配布する場合には，次のいずれかの条件を満たすこ
+ *      と．
+ *    (a) 再配布に伴うドキュメント（利用者マニュアルなど）に，上記の著
+ *        作権表示，この利用条件および下記の無保証規定を掲載すること．
+ *    (b) 再配布の形態を，別に定める方法によって，TOPPERSプロジェクトに
+ *        報告すること．
+ *  (4) 本ソフトウェアの利用により直接的または間接的に生じるいかなる損
+ *      害からも，上記著作権者およびTOPPERSプロジェクトを免責すること．
+ *      また，本ソフトウェアのユーザまたはエンドユーザからのいかなる理
+ *      由に基づく請求からも，上記著作権者およびTOPPERSプロジェクトを
+ *      免責すること．
+ * 
+ *  本ソフトウェアは，無保証で提供されているものである．上記著作権者お
+ *  よびTOPPERSプロジェクトは，本ソフトウェアに関して，特定の使用目的
+ *  に対する適合性も含めて，いかなる保証も行わない．また，本ソフトウェ
+ *  アの利用により直接的または間接的に生じたいかなる損害に関しても，そ
+ *  の責任を負わない．
+ * 
+ *  @(#) $Id$
+ */
+
+/*
+ *		カーネル管理外の割込みからの通知（ARMv7-M用）
+ *
+ *  カーネル管理外の割込みハンドラは，サービスコールを呼び出すことがで
+ *  きない．そこで，通知するビットパターンをアトミック操作で記録し，カ
+ *  ーネル管理の中継用の割込み（NKINT_INTNO）を要求する．中継用の割込
+ *  みサービスルーチンは，記録されたビットパターンをイベントフラグ
+ *  （NKINT_FLG）にセットする．
+ *
+ *  排他ロード／排他ストア命令と割込みペンディングセットレジスタへの書
+ *  込みのみを用いるため，カーネル管理外の割込みハンドラから呼び出すこ
+ *  とができ，割込みを禁止しない．
+ */
+
+#ifndef TOPPERS_CORE_NKINT_H
+#define TOPPERS_CORE_NKINT_H
+
+#include <kernel.h>
+#include <sil.h>
+#include "arm_m.h"
+
+/*
+ *  中継用の割込みの割込み番号と割込み優先度
+ *
+ *  デフォルトでは，全てのSTM32で存在するIRQ1（PVD）を用いる．周辺デバ
+ *  イスは操作しないため，PVDの割込みを使用していなければ副作用はない．
+ *  ターゲット依存部またはアプリケーションで，未使用の割込み番号に変更
+ *  できる．
+ */
+#ifndef NKINT_INTNO
+#define NKINT_INTNO		17			/* IRQ1 */
+#endif /* NKINT_INTNO */
+
+#ifndef NKINT_INTPRI
+#define NKINT_INTPRI	TMAX_INTPRI	/* カーネル管理の最低優先度 */
+#endif /* NKINT_INTPRI */
+
+#ifndef TOPPERS_MACRO_ONLY
+
+/*
+ *  通知されたビットパターン
+ */
+extern uint32_t	nkint_flgptn;
+
+/*
+ *  イベントフラグのセットの要求
+ *
+ *  カーネル管理外の割込みハンドラから呼び出し，NKINT_FLGにsetptnをセッ
+ *  トすることを要求する．中継用の割込みサービスルーチンが実行されるま
+ *  でに要求されたビットパターンは，まとめてセットされる．
+ */
+Inline void
+nkint_set_flg(FLGPTN setptn)
+{
+	(void) sil_atm_set(&nkint_flgptn, (uint32_t) setptn);
+	sil_wrw_mem((void *)(NVIC_ISER0 + ((NKINT_INTNO - 16) / 32) * 4),
+						(uint32_t)(1U << ((NKINT_INTNO - 16) % 32)));
+}
+
+/*
+ *  中継用の割込みサービスルーチン
+ */
+extern void	nkint_isr(intptr_t exinf) throw();
+
+#endif /* TOPPERS_MACRO_ONLY */
+#endif /* TOPPERS_CORE_NKINT_H */
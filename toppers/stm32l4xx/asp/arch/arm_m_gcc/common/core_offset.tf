@@ -5,8 +5,10 @@ $
 $
 $  オフセット値のマクロ定義の生成
 $
-$DEFINE("TCB_p_tinib", offsetof_TCB_p_tinib)$
-$DEFINE("TCB_texptn", offsetof_TCB_texptn)$
+$IF !TOPPERS_COMPACT_TCB$
+	$DEFINE("TCB_p_tinib", offsetof_TCB_p_tinib)$
+	$DEFINE("TCB_texptn", offsetof_TCB_texptn)$
+$END$
 $DEFINE("TCB_sp", offsetof_TCB_sp)$
 $DEFINE("TCB_pc", offsetof_TCB_pc)$
 
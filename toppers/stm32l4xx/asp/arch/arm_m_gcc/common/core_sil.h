@@ -44,6 +44,11 @@
 #ifndef TOPPERS_CORE_SIL_H
 #define TOPPERS_CORE_SIL_H
 
+/*
+ *  ロック区間の計測
+ */
+#include "arm_m_gcc/common/core_lockprof.h"
+
 #ifndef TOPPERS_MACRO_ONLY
 
 #if __TARGET_ARCH_THUMB == 4
@@ -63,6 +68,7 @@ TOPPERS_disint(void)
 		pre_basepri = val;
 		val = (1 << (8 - TBITW_IPRI));
 		Asm("msr BASEPRI, %0" : : "r"(val) : "memory");
+		LOCKPROF_ENTER(LPF_INT);
 		return (false);
 	} else {
 		return (true);
@@ -85,6 +91,7 @@ TOPPERS_enaint(bool_t locked)
 {
 	if (!locked) {
 #if __TARGET_ARCH_THUMB == 4
+		LOCKPROF_LEAVE(LPF_INT);
 		Asm("msr BASEPRI, %0" : : "r"(pre_basepri) : "memory");
 #else /* __TARGET_ARCH_THUMB == 3 */
 		Asm("cpsie i":::"memory");
@@ -99,6 +106,90 @@ TOPPERS_enaint(bool_t locked)
 #define SIL_LOC_INT()    ((void)(TOPPERS_locked = TOPPERS_disint()))
 #define SIL_UNL_INT()    (TOPPERS_enaint(TOPPERS_locked))
 
+#if __TARGET_ARCH_THUMB == 4
+/*
+ *  アトミック操作（ARMv7-M用）
+ *
+ *  排他ロード／排他ストア命令（core_insn.hのldrex_word／strex_word）で
+ *  実現する．例外の受付け時と例外からのリターン時には排他モニタがクリ
+ *  アされるため，操作の途中で割込みが入った場合には排他ストアが失敗し，
+ *  操作をやり直す．割込みを禁止しないため，割込み応答時間に影響を与え
+ *  ない．ARMv6-Mでは，sil.hのデフォルトの定義（全割込みロック状態で操
+ *  作する）を用いる．
+ */
+#define TOPPERS_OMIT_SIL_ATOMIC
+
+#include <core_insn.h>
+
+Inline uint32_t
+sil_atm_rew(const uint32_t *mem)
+{
+	return(*((const volatile uint32_t *) mem));
+}
+
+Inline void
+sil_atm_wrw(uint32_t *mem, uint32_t data)
+{
+	*((volatile uint32_t *) mem) = data;
+}
+
+Inline uint32_t
+sil_atm_add(uint32_t *mem, uint32_t val)
+{
+	uint32_t	data;
+
+	do {
+		data = ldrex_word(mem);
+	} while (strex_word(data + val, mem) != 0U);
+	return(data);
+}
+
+Inline uint32_t
+sil_atm_sub(uint32_t *mem, uint32_t val)
+{
+	uint32_t	data;
+
+	do {
+		data = ldrex_word(mem);
+	} while (strex_word(data - val, mem) != 0U);
+	return(data);
+}
+
+Inline bool_t
+sil_atm_cas(uint32_t *mem, uint32_t oldval, uint32_t newval)
+{
+	do {
+		if (ldrex_word(mem) != oldval) {
+			Asm("clrex":::"memory");
+			return(false);
+		}
+	} while (strex_word(newval, mem) != 0U);
+	return(true);
+}
+
+Inline uint32_t
+sil_atm_set(uint32_t *mem, uint32_t bits)
+{
+	uint32_t	data;
+
+	do {
+		data = ldrex_word(mem);
+	} while (strex_word(data | bits, mem) != 0U);
+	return(data);
+}
+
+Inline uint32_t
+sil_atm_clr(uint32_t *mem, uint32_t bits)
+{
+	uint32_t	data;
+
+	do {
+		data = ldrex_word(mem);
+	} while (strex_word(data & ~bits, mem) != 0U);
+	return(data);
+}
+#endif /* __TARGET_ARCH_THUMB == 4 */
+
 #endif /* TOPPERS_MACRO_ONLY */
 
 #endif /* TOPPERS_CORE_SIL_H */
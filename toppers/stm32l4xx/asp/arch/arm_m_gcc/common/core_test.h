@@ -55,4 +55,72 @@
 #define CANNOT_RETURN_CPUEXC
 #endif /* __TARGET_ARCH_THUMB == 4 */
 
+#if __TARGET_ARCH_THUMB == 4
+/*
+ *  サイクルカウンタ（DWT CYCCNT）による計測のための定義
+ */
+#include <sil.h>
+#include <arm_m.h>
+
+#define TEST_CYC_INIT() \
+	do { \
+		sil_wrw_mem((void *) DEMCR, \
+					sil_rew_mem((void *) DEMCR) | DEMCR_TRCENA); \
+		sil_wrw_mem((void *) DWT_CTRL, \
+					sil_rew_mem((void *) DWT_CTRL) | DWT_CTRL_CYCCNTENA); \
+	} while (false)
+#define TEST_GET_CYC()		sil_rew_mem((void *) DWT_CYCCNT)
+
+/*
+ *  実行時間分布集計モジュールのサイクルカウンタによる計測
+ *
+ *  TOPPERS_HIST_CYCCNTを定義した場合，実行時間をget_utmの代わりにサ
+ *  イクルカウンタで計測し，サイクル数単位で記録する．計測のオーバヘッ
+ *  ドは，init_hist時に計測して差し引く．
+ */
+#ifdef TOPPERS_HIST_CYCCNT
+#define HISTTIM					uint32_t
+#define HIST_INIT_HOOK()		TEST_CYC_INIT()
+#define HIST_GET_TIM(p_time)	((void)(*(p_time) = TEST_GET_CYC()))
+#define HIST_CONV_TIM(time)		((uint_t)(time))
+#define HIST_UNIT				"cycle"
+#define HIST_CALIBRATE
+#endif /* TOPPERS_HIST_CYCCNT */
+#endif /* __TARGET_ARCH_THUMB == 4 */
+
+/*
+ *  テスト用の割込み要求の発生
+ *
+ *  NVICの割込みペンディングセットレジスタにより，TEST_INTNOの割込み要
+ *  求を発生させる．デフォルトでは，全てのSTM32で存在するIRQ0（WWDG）
+ *  を用いる．周辺デバイスは操作しないため，WWDGを使用していなければ副
+ *  作用はない．ターゲット依存部で，未使用の割込み番号に変更できる．
+ */
+#include <sil.h>
+#include <arm_m.h>
+
+#ifndef TEST_INTNO
+#define TEST_INTNO			16		/* IRQ0 */
+#endif /* TEST_INTNO */
+#ifndef TEST_INTPRI
+#define TEST_INTPRI			-2
+#endif /* TEST_INTPRI */
+
+/*
+ *  カーネル管理外の割込みのテスト用の割込み番号と割込み優先度
+ *
+ *  デフォルトでは，IRQ2（TAMP_STAMP）をTMIN_INTPRIよりも1つ高い割込み
+ *  優先度で用いる．
+ */
+#ifndef TEST_NKINTNO
+#define TEST_NKINTNO		18		/* IRQ2 */
+#endif /* TEST_NKINTNO */
+#ifndef TEST_NKINTPRI
+#define TEST_NKINTPRI		(TMIN_INTPRI - 1)
+#endif /* TEST_NKINTPRI */
+
+#define TEST_RAISE_INT(intno) \
+	sil_wrw_mem((void *)(NVIC_ISER0 + (((intno) - 16) / 32) * 4), \
+				(uint32_t)(1U << (((intno) - 16) % 32)))
+
 #endif /* TOPPERS_CORE_TEST_H */
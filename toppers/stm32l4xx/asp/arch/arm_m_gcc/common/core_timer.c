@@ -46,6 +46,13 @@
 #include "time_event.h"
 #include "target_timer.h"
 
+#ifdef TOPPERS_TIMER_VARIABLE_CLOCK
+/*
+ *  タイマ周期（単位は内部表現）
+ */
+CLOCK	target_timer_cyc;
+#endif /* TOPPERS_TIMER_VARIABLE_CLOCK */
+
 /*
  *  タイマの起動処理
  */
@@ -61,6 +68,9 @@ target_timer_initialize(intptr_t exinf)
 #else 
 	cyc = TO_CLOCK(TIC_NUME, TIC_DENO) - 1;
 #endif /* SYSTIC_USE_CALIBRATION */
+#ifdef TOPPERS_TIMER_VARIABLE_CLOCK
+	target_timer_cyc = cyc + 1;
+#endif /* TOPPERS_TIMER_VARIABLE_CLOCK */
 
 	/* 停止 */
 	tmp = sil_rew_mem((void *)SYSTIC_CONTROL_STATUS);
@@ -83,6 +93,51 @@ target_timer_initialize(intptr_t exinf)
 	sil_wrw_mem((void *)SYSTIC_CONTROL_STATUS, tmp);
 }
 
+#ifdef TOPPERS_TIMER_VARIABLE_CLOCK
+/*
+ *  タイマの位相を指定した再起動処理
+ *
+ *  現在の周期の経過時間がelapsedとなるように，残りの時間を1回だけリ
+ *  ロード値に設定して現在値をクリアし，タイマを動作させる．現在値が再
+ *  ロードされたことを確認してから，リロード値をタイマ周期に戻す．
+ */
+void
+target_timer_restart(CLOCK elapsed)
+{
+	CLOCK    cyc, remain;
+
+	cyc = target_timer_cyc;
+	remain = (elapsed + 2U < cyc) ? cyc - elapsed : 2U;
+
+	sil_wrw_mem((void *)SYSTIC_RELOAD_VALUE, remain - 1);
+	sil_wrw_mem((void *)SYSTIC_CURRENT_VALUE, 0);
+	sil_wrw_mem((void *)SYSTIC_CONTROL_STATUS,
+					sil_rew_mem((void *)SYSTIC_CONTROL_STATUS) | SYSTIC_ENABLE);
+	while (sil_rew_mem((void *)SYSTIC_CURRENT_VALUE) == 0) ;
+	sil_wrw_mem((void *)SYSTIC_RELOAD_VALUE, cyc - 1);
+}
+
+/*
+ *  タイマのクロック変更処理
+ *
+ *  変更前のクロックでの経過時間を新しいクロックに換算し，その位相でタ
+ *  イマを再起動する．クロック変更中にタイマが一巡した場合には，タイマ
+ *  割込み要求が保留されているため，タイムティックは失われない．
+ */
+void
+target_timer_change_clock(void)
+{
+	CLOCK    old_cyc, new_cyc, elapsed;
+
+	old_cyc = target_timer_cyc;
+	new_cyc = TO_CLOCK(TIC_NUME, TIC_DENO);
+	elapsed = old_cyc - sil_rew_mem((void *)SYSTIC_CURRENT_VALUE);
+	elapsed = (CLOCK)(((uint64_t) elapsed) * new_cyc / old_cyc);
+	target_timer_cyc = new_cyc;
+	target_timer_restart(elapsed);
+}
+#endif /* TOPPERS_TIMER_VARIABLE_CLOCK */
+
 /*
  *  タイマの停止処理
  */
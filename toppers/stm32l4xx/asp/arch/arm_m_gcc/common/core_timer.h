@@ -72,6 +72,19 @@ typedef uint32_t    CLOCK;
  */
 #define MAX_CLOCK    ((CLOCK) 0x00ffffffU)
 
+/*
+ *  タイマ周期（単位は内部表現）
+ *
+ *  TOPPERS_TIMER_VARIABLE_CLOCKを定義した場合には，実行中にSYS_CLOCK
+ *  を変更できるように，タイマ周期を変数に保持する．
+ */
+#ifdef TOPPERS_TIMER_VARIABLE_CLOCK
+extern CLOCK	target_timer_cyc;
+#define TIMER_CYC	target_timer_cyc
+#else /* TOPPERS_TIMER_VARIABLE_CLOCK */
+#define TIMER_CYC	TO_CLOCK(TIC_NUME, TIC_DENO)
+#endif /* TOPPERS_TIMER_VARIABLE_CLOCK */
+
 /*
  *  タイマの起動処理
  *
@@ -86,13 +99,32 @@ extern void target_timer_initialize(intptr_t exinf);
  */
 extern void target_timer_terminate(intptr_t exinf);
 
+#ifdef TOPPERS_TIMER_VARIABLE_CLOCK
+/*
+ *  タイマのクロック変更処理
+ *
+ *  SYS_CLOCKを変更した直後に，CPUロック状態で呼び出す．タイマ周期を新
+ *  しいクロックから求め直し，現在の周期の経過時間を保ったまま，タイマ
+ *  を再設定する．
+ */
+extern void target_timer_change_clock(void);
+
+/*
+ *  タイマの位相を指定した再起動処理
+ *
+ *  停止していたタイマを，現在の周期の経過時間がelapsedとなる位相で再
+ *  起動する．省電力モードからの復帰時に，CPUロック状態で呼び出す．
+ */
+extern void target_timer_restart(CLOCK elapsed);
+#endif /* TOPPERS_TIMER_VARIABLE_CLOCK */
+
 /*
  *  タイマの現在値の読出し
  */
 Inline CLOCK
 target_timer_get_current(void)
 {
-	return(TO_CLOCK(TIC_NUME, TIC_DENO) - sil_rew_mem((void*)SYSTIC_CURRENT_VALUE));
+	return(TIMER_CYC - sil_rew_mem((void*)SYSTIC_CURRENT_VALUE));
 }
 
 /*
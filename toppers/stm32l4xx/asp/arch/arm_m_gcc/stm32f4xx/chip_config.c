@@ -86,6 +86,15 @@ target_exit(void)
 	/*
 	 *  開発環境依存の終了処理
 	 */
+#ifdef TOPPERS_QEMU_EXEC
+	/*
+	 *  セミホスティングのSYS_EXIT（ADP_Stopped_ApplicationExit）により，
+	 *  QEMUを終了させる．
+	 */
+	Asm("mov r0, #0x18\n\t"
+		"ldr r1, =0x20026\n\t"
+		"bkpt 0xab" ::: "r0", "r1", "memory");
+#endif /* TOPPERS_QEMU_EXEC */
 	while(1);
 }
 
@@ -56,9 +56,13 @@
  *  カーネル管理の割込み優先度の範囲
  *
  *  TMIN_INTPRIの定義を変更することで，このレベルよりも高い割込み優先度
- *  を持つものをカーネル管理外の割込みとするかを変更できる．
+ *  を持つものをカーネル管理外の割込みとするかを変更できる．コンパイル
+ *  オプションで定義することもできる（例えば，-DTMIN_INTPRI=-14とする
+ *  と，-16〜-15がカーネル管理外の割込み優先度となる）．
  */
+#ifndef TMIN_INTPRI
 #define TMIN_INTPRI		(-15)		/* 割込み優先度の最小値（最高値）*/
+#endif /* TMIN_INTPRI */
 
 /*
  *  サポートする機能の定義
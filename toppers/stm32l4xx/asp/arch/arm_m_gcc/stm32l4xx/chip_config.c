@@ -51,6 +51,69 @@
 #include "target_syssvc.h"
 #include "chip_serial.h"
 
+/*
+ *  64ビットカウンタのプリスケーラ値（1MHzでカウントする）
+ *
+ *  TIM2のクロックはPCLK1である．PCLK1が1MHz未満の場合は，正しい時刻
+ *  にならない．
+ */
+#define UTM64_PSC	((SysFrePCLK1 >= 1000000U) ? (SysFrePCLK1 / 1000000U - 1U) : 0U)
+
+/*
+ *  64ビットカウンタの初期化
+ *
+ *  TIM2の更新イベントをトリガ出力（TRGO）とし，TIM5を内部トリガ0
+ *  （ITR0＝TIM2）による外部クロックモード1で動作させる．
+ */
+void
+chip_utm64_initialize(void)
+{
+	sil_wrw_mem((void *)(TADR_RCC_BASE+TOFF_RCC_APB1ENR1),
+				sil_rew_mem((void *)(TADR_RCC_BASE+TOFF_RCC_APB1ENR1))
+								| RCC_APB1ENR1_TIM2EN | RCC_APB1ENR1_TIM5EN);
+	(void) sil_rew_mem((void *)(TADR_RCC_BASE+TOFF_RCC_APB1ENR1));
+
+	sil_wrw_mem((void *)(TADR_UTM64_HIGH+TOFF_TIM_CR1), 0U);
+	sil_wrw_mem((void *)(TADR_UTM64_HIGH+TOFF_TIM_SMCR),
+								TIM_SMCR_SMS_2 | TIM_SMCR_SMS_1 | TIM_SMCR_SMS_0);
+	sil_wrw_mem((void *)(TADR_UTM64_HIGH+TOFF_TIM_PSC), 0U);
+	sil_wrw_mem((void *)(TADR_UTM64_HIGH+TOFF_TIM_ARR), 0xffffffffU);
+	sil_wrw_mem((void *)(TADR_UTM64_HIGH+TOFF_TIM_CR1), TIM_CR1_CEN);
+
+	sil_wrw_mem((void *)(TADR_UTM64_LOW+TOFF_TIM_CR1), TIM_CR1_URS);
+	sil_wrw_mem((void *)(TADR_UTM64_LOW+TOFF_TIM_CR2), TIM_CR2_MMS_1);
+	sil_wrw_mem((void *)(TADR_UTM64_LOW+TOFF_TIM_ARR), 0xffffffffU);
+	chip_utm64_reload(0U);
+}
+
+/*
+ *  64ビットカウンタの再設定
+ *
+ *  TIM2を停止し，更新イベントで新しいプリスケーラ値を反映させてから，
+ *  両方のカウンタに時刻を書き戻す．更新イベントによりTIM5が1つ進むが，
+ *  その後に書き戻すため影響しない．
+ */
+void
+chip_utm64_reload(uint32_t usec)
+{
+	uint64_t	utm;
+
+	if ((sil_rew_mem((void *)(TADR_UTM64_LOW+TOFF_TIM_CR1)) & TIM_CR1_CEN) != 0U) {
+		utm = fch_utm64() + usec;
+	}
+	else {
+		utm = 0U;
+	}
+
+	sil_wrw_mem((void *)(TADR_UTM64_LOW+TOFF_TIM_CR1), TIM_CR1_URS);
+	sil_wrw_mem((void *)(TADR_UTM64_LOW+TOFF_TIM_PSC), UTM64_PSC);
+	sil_wrw_mem((void *)(TADR_UTM64_LOW+TOFF_TIM_EGR), TIM_EGR_UG);
+	sil_wrw_mem((void *)(TADR_UTM64_LOW+TOFF_TIM_CNT), (uint32_t) utm);
+	(void) sil_rew_mem((void *)(TADR_UTM64_LOW+TOFF_TIM_CNT));
+	sil_wrw_mem((void *)(TADR_UTM64_HIGH+TOFF_TIM_CNT), (uint32_t)(utm >> 32));
+	sil_wrw_mem((void *)(TADR_UTM64_LOW+TOFF_TIM_CR1), TIM_CR1_URS | TIM_CR1_CEN);
+}
+
 /*
  *  ターゲット依存の初期化
  */
@@ -62,6 +125,11 @@ target_initialize(void){
 	 */
 	SystemFrequency = sysclock_init_value();
 
+	/*
+	 *  64ビットの性能評価用システム時刻の初期化
+	 */
+	chip_utm64_initialize();
+
 	/*
 	 * コア依存の初期化
 	 */
@@ -76,6 +144,13 @@ target_initialize(void){
 	 *  タイマの割込みレベルの設定
 	 */
 	sil_wrb_mem((uint8_t *)(TADR_SCB_BASE+TOFF_SCB_SHP15), (14 << (8 - 4)) & 0xff);
+
+#ifdef TOPPERS_STOP2_IDLE
+	/*
+	 *  STOP2アイドルの初期化
+	 */
+	target_idle_initialize();
+#endif /* TOPPERS_STOP2_IDLE */
 } 
 
 
@@ -57,14 +57,19 @@
  *  カーネル管理の割込み優先度の範囲
  *
  *  TMIN_INTPRIの定義を変更することで，このレベルよりも高い割込み優先度
- *  を持つものをカーネル管理外の割込みとするかを変更できる．
+ *  を持つものをカーネル管理外の割込みとするかを変更できる．コンパイル
+ *  オプションで定義することもできる（例えば，-DTMIN_INTPRI=-14とする
+ *  と，-16〜-15がカーネル管理外の割込み優先度となる）．
  */
+#ifndef TMIN_INTPRI
 #define TMIN_INTPRI		(-15)		/* 割込み優先度の最小値（最高値）*/
+#endif /* TMIN_INTPRI */
 
 /*
  *  サポートする機能の定義
  */
 #define TOPPERS_TARGET_SUPPORT_GET_UTM	/* get_utmをサポートする */
+#define TOPPERS_TARGET_SUPPORT_GET_UTM64	/* get_utm64をサポートする */
 
 /*
  *  タイムティックの定義
@@ -72,6 +77,11 @@
 #define TIC_NUME   1U            /* タイムティックの周期の分子 */
 #define TIC_DENO   1U            /* タイムティックの周期の分母 */
 
+/*
+ *  64ビットの性能評価用システム時刻の読出し（fch_utm64）
+ */
+#include "arm_m_gcc/stm32l4xx/chip_utm64.h"
+
 /*
  *  コア依存で共通な定義
  */
@@ -296,6 +296,68 @@ void put_hex(char a, int val)
 	target_fput_log('\n');
 }
 
+/*
+ *  ボーレートレジスタの設定値の算出
+ *
+ *  ポートのクロック源の周波数から，BPS_SETTINGに対応するBRRの値を求め
+ *  る．クロック源がシステムクロックの場合は，SystemFrequencyを用いる．
+ *  LPUARTの場合は，プリスケーラも設定する．
+ */
+static uint32_t
+usart_brr(const GPIOINIB *p_gpioinib, uint32_t base)
+{
+	uint32_t apbclock, tmp;
+
+	tmp = (sil_rew_mem((uint32_t *)(TADR_RCC_BASE+TOFF_RCC_CCIPR)) >> p_gpioinib->srcindex) & RCC_CCIPR_USART1SEL;
+	if(base == TADR_LPUART1_BASE){	/* LPUART */
+#ifdef TOFF_USART_PRESC
+		sil_modw_mem((uint32_t *)(base+TOFF_USART_PRESC), USART_PRESC_PRESCALER, UART_CLOCKPRESCALER);	/* DIV1 */
+#endif
+		switch(tmp){
+		case RCC_USARTCLKSOURCE_SYSCLK:
+			apbclock = SysFreHCLK;
+			break;
+		case RCC_USARTCLKSOURCE_HSI:
+			apbclock = HSI_VALUE;
+			break;
+		case RCC_USARTCLKSOURCE_LSE:
+			apbclock = LSE_VALUE;
+			break;
+		default:
+			apbclock = SysFrePCLK1;
+			break;
+		}
+
+		tmp = (((unsigned long long)(apbclock / UART_CLOCK_DIV_FACTOR) * 256U) + (BPS_SETTING / 2U)) / BPS_SETTING;
+	}
+	else{
+		switch(tmp){
+		case RCC_USARTCLKSOURCE_HSI:
+			apbclock = HSI_VALUE;
+			break;
+		case RCC_USARTCLKSOURCE_LSE:
+			apbclock = LSE_VALUE;
+			break;
+		case RCC_USARTCLKSOURCE_SYSCLK:
+			apbclock = SysFreHCLK;
+			break;
+		default:
+			apbclock = SysFrePCLK1;
+			break;
+		}
+
+		if((sil_rew_mem((uint32_t *)(base+TOFF_USART_CR1)) & USART_CR1_OVER8) != 0){
+			uint32_t usartdiv = ((apbclock*2) + (BPS_SETTING/2)) / BPS_SETTING;
+			tmp = usartdiv & 0xFFF0U;
+			tmp |= (uint16_t)((usartdiv & 0x0000000F) >> 1);
+		}
+		else{
+			tmp = (apbclock + (BPS_SETTING/2)) / BPS_SETTING;
+		}
+	}
+	return(tmp);
+}
+
 /*
  *  SIOドライバの初期化
  */
@@ -328,7 +390,6 @@ sio_opn_por(ID siopid, intptr_t exinf)
 	bool_t   opnflg;
 	ER       ercd;
 	uint32_t base, txbase, rxbase;
-	uint32_t apbclock, tmp;
 
 	p_siopcb = get_siopcb(siopid);
 	p_siopinib = p_siopcb->p_siopinib;
@@ -369,54 +430,7 @@ sio_opn_por(ID siopid, intptr_t exinf)
 	sil_modw_mem((uint32_t *)(base+TOFF_USART_CR2), USART_CR2_STOP, USART_StopBits_1);
 	sil_modw_mem((uint32_t *)(base+TOFF_USART_CR3), CR3_CLEAR_MASK, USART_HardwareFlowControl_None);
 
-	tmp = (sil_rew_mem((uint32_t *)(TADR_RCC_BASE+TOFF_RCC_CCIPR)) >> p_gpioinib->srcindex) & RCC_CCIPR_USART1SEL;
-	if(base == TADR_LPUART1_BASE){	/* LPUART */
-#ifdef TOFF_USART_PRESC
-		sil_modw_mem((uint32_t *)(base+TOFF_USART_PRESC), USART_PRESC_PRESCALER, UART_CLOCKPRESCALER);	/* DIV1 */
-#endif
-		switch(tmp){
-		case RCC_USARTCLKSOURCE_SYSCLK:
-			apbclock = SysFreHCLK;
-			break;
-		case RCC_USARTCLKSOURCE_HSI:
-			apbclock = HSI_VALUE;
-			break;
-		case RCC_USARTCLKSOURCE_LSE:
-			apbclock = LSE_VALUE;
-			break;
-		default:
-			apbclock = SysFrePCLK1;
-			break;
-		}
-
-		tmp = (((unsigned long long)(apbclock / UART_CLOCK_DIV_FACTOR) * 256U) + (BPS_SETTING / 2U)) / BPS_SETTING;
-	}
-	else{
-		switch(tmp){
-		case RCC_USARTCLKSOURCE_HSI:
-			apbclock = HSI_VALUE;
-			break;
-		case RCC_USARTCLKSOURCE_LSE:
-			apbclock = LSE_VALUE;
-			break;
-		case RCC_USARTCLKSOURCE_SYSCLK:
-			apbclock = SysFreHCLK;
-			break;
-		default:
-			apbclock = SysFrePCLK1;
-			break;
-		}
-
-		if((sil_rew_mem((uint32_t *)(base+TOFF_USART_CR1)) & USART_CR1_OVER8) != 0){
-			uint32_t usartdiv = ((apbclock*2) + (BPS_SETTING/2)) / BPS_SETTING;
-			tmp = usartdiv & 0xFFF0U;
-			tmp |= (uint16_t)((usartdiv & 0x0000000F) >> 1);
-		}
-		else{
-			tmp = (apbclock + (BPS_SETTING/2)) / BPS_SETTING;
-		}
-	}
-	sil_wrw_mem((uint32_t *)(base+TOFF_USART_BRR), tmp);
+	sil_wrw_mem((uint32_t *)(base+TOFF_USART_BRR), usart_brr(p_gpioinib, base));
 	sil_orw_mem((uint32_t *)(base+TOFF_USART_CR3), USART_CR3_EIE);
 	sil_orw_mem((uint32_t *)(base+TOFF_USART_CR1), (USART_CR1_PEIE | USART_CR1_RXNEIE));
 	p_siopcb->opnflg = true;
@@ -595,7 +609,6 @@ void chip_uart_init(ID siopid)
 	const GPIOINIB  *p_gpioinib = &gpioinib_table[INDEX_PORT(siopid)];
 	const SIOPINIB  *p_siopinib = &siopinib_table[INDEX_PORT(siopid)];
 	uint32_t base, txbase, rxbase;
-	uint32_t apbclock, tmp;
 
 	txbase = p_gpioinib->txportbase;
 	rxbase = p_gpioinib->rxportbase;
@@ -622,54 +635,54 @@ void chip_uart_init(ID siopid)
 	sil_modw_mem((uint32_t *)(base+TOFF_USART_CR2), USART_CR2_STOP, USART_StopBits_1);
 	sil_modw_mem((uint32_t *)(base+TOFF_USART_CR3), CR3_CLEAR_MASK, USART_HardwareFlowControl_None);
 
-	tmp = (sil_rew_mem((uint32_t *)(TADR_RCC_BASE+TOFF_RCC_CCIPR)) >> p_gpioinib->srcindex) & RCC_CCIPR_USART1SEL;
-	if(base == TADR_LPUART1_BASE){	/* LPUART */
-#ifdef TOFF_USART_PRESC
-		sil_modw_mem((uint32_t *)(base+TOFF_USART_PRESC), USART_PRESC_PRESCALER, UART_CLOCKPRESCALER);	/* DIV1 */
-#endif
-		switch(tmp){
-		case RCC_USARTCLKSOURCE_SYSCLK:
-			apbclock = SysFreHCLK;
-			break;
-		case RCC_USARTCLKSOURCE_HSI:
-			apbclock = HSI_VALUE;
-			break;
-		case RCC_USARTCLKSOURCE_LSE:
-			apbclock = LSE_VALUE;
-			break;
-		default:
-			apbclock = SysFrePCLK1;
-			break;
-		}
+	sil_wrw_mem((uint32_t *)(base+TOFF_USART_BRR), usart_brr(p_gpioinib, base));
+	sil_andw_mem((uint32_t *)(base+TOFF_USART_CR1), (USART_CR1_TXEIE | USART_CR1_RXNEIE));
+	sil_orw_mem((uint32_t *)(base+TOFF_USART_CR1), USART_CR1_UE);
+}
 
-		tmp = (((unsigned long long)(apbclock / UART_CLOCK_DIV_FACTOR) * 256U) + (BPS_SETTING / 2U)) / BPS_SETTING;
+/*
+ *  システムクロック変更後のボーレートの再設定
+ *
+ *  動作中のポートのBRRを，変更後のクロックから求め直す．BRRはUSARTの
+ *  停止中にしか書き込めないため，送信の完了を待ってから一旦停止する．
+ *  CPUロック状態で呼び出す．
+ */
+void chip_uart_change_clock(void)
+{
+	const GPIOINIB  *p_gpioinib;
+	uint32_t base;
+	uint_t   i;
+
+	for (i = 0; i < TNUM_SIOP; i++) {
+		p_gpioinib = &gpioinib_table[i];
+		base = siopinib_table[i].base;
+		if (p_gpioinib->txportbase == 0
+			|| (sil_rew_mem((uint32_t *)(base+TOFF_USART_CR1)) & USART_CR1_UE) == 0)
+			continue;
+		while((sil_rew_mem((uint32_t *)(base+TOFF_USART_ISR)) & USART_ISR_TC) == 0);
+		sil_andw_mem((uint32_t *)(base+TOFF_USART_CR1), USART_CR1_UE);
+		sil_wrw_mem((uint32_t *)(base+TOFF_USART_BRR), usart_brr(p_gpioinib, base));
+		sil_orw_mem((uint32_t *)(base+TOFF_USART_CR1), USART_CR1_UE);
 	}
-	else{
-		switch(tmp){
-		case RCC_USARTCLKSOURCE_HSI:
-			apbclock = HSI_VALUE;
-			break;
-		case RCC_USARTCLKSOURCE_LSE:
-			apbclock = LSE_VALUE;
-			break;
-		case RCC_USARTCLKSOURCE_SYSCLK:
-			apbclock = SysFreHCLK;
-			break;
-		default:
-			apbclock = SysFrePCLK1;
-			break;
-		}
+}
 
-		if((sil_rew_mem((uint32_t *)(base+TOFF_USART_CR1)) & USART_CR1_OVER8) != 0){
-			uint32_t usartdiv = ((apbclock*2) + (BPS_SETTING/2)) / BPS_SETTING;
-			tmp = usartdiv & 0x0000FFF0;
-			tmp |= (uint16_t)((usartdiv & 0x0000000F) >> 1);
-		}
-		else{
-			tmp = (apbclock + (BPS_SETTING/2)) / BPS_SETTING;
-		}
+/*
+ *  送信中のポートの有無
+ *
+ *  動作中のポートのいずれかが送信を完了していなければtrueを返す．
+ *  PCLKが停止する省電力モードに入る前に確認する．
+ */
+bool_t chip_uart_busy(void)
+{
+	uint32_t base;
+	uint_t   i;
+
+	for (i = 0; i < TNUM_SIOP; i++) {
+		base = siopinib_table[i].base;
+		if (gpioinib_table[i].txportbase != 0
+			&& (sil_rew_mem((uint32_t *)(base+TOFF_USART_CR1)) & USART_CR1_UE) != 0
+			&& (sil_rew_mem((uint32_t *)(base+TOFF_USART_ISR)) & USART_ISR_TC) == 0)
+			return true;
 	}
-	sil_wrw_mem((uint32_t *)(base+TOFF_USART_BRR), tmp);
-	sil_andw_mem((uint32_t *)(base+TOFF_USART_CR1), (USART_CR1_TXEIE | USART_CR1_RXNEIE));
-	sil_orw_mem((uint32_t *)(base+TOFF_USART_CR1), USART_CR1_UE);
+	return false;
 }
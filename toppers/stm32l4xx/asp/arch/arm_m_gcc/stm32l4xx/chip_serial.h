@@ -121,5 +121,15 @@ extern void sio_pol_snd_chr(int8_t c, ID siopid);
  */
 extern void chip_uart_init(ID siopid);
 
+/*
+ *  システムクロック変更後のボーレートの再設定
+ */
+extern void chip_uart_change_clock(void);
+
+/*
+ *  送信中のポートの有無
+ */
+extern bool_t chip_uart_busy(void);
+
 #endif /* TOPPERS_MACRO_ONLY */
 #endif /* TOPPERS_CHIP_SERIAL_H */
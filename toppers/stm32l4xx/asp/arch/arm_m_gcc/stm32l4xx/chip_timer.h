@@ -53,6 +53,14 @@
  */
 #define TIMER_CLOCK		(SYS_CLOCK / 1000)
 
+/*
+ *  実行中のシステムクロックの変更に対応する
+ *
+ *  SYS_CLOCKは変数SystemFrequencyであり，sysclock_switchによって変更
+ *  される．
+ */
+#define TOPPERS_TIMER_VARIABLE_CLOCK
+
 /*
  *  タイマ割込みハンドラ登録のための定数
  */
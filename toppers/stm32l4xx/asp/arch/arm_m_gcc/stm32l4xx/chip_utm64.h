@@ -0,0 +1,104 @@
+/*
+ *  TOPPERS/ASP Kernel
+ *      Toyohashi Open Platform for Embedded Real-Time Systems/
+ *      Advanced Standard Profile Kernel
+ * 
+ *  Copyright (C) 2005-2011 by Embedded and Real-Time Systems Laboratory
+ *              Graduate School of Information Science, Nagoya Univ., JAPAN
+ *  Copyright (C) 2017-2018 by TOPPERS PROJECT Educational Working Group.
+ * 
+ *  上記著作権者は，以下の(1)〜(4)の条件を満たす場合に限り，本ソフトウェ
+ *  ア（本ソフトウェアを改変したものを含む．以下同じ）を使用・複製・改
+ *  変・再配布（以下，利用と呼ぶ）することを無償で許諾する．
+ *  (1) 本ソフトウェアをソースコードの形で利用する場合には，上記の著作
+ *      権表示，この利用条件および下記の無保証規定が，そのままの形でソー
+ *      スコード中に含まれていること．
+ *  (2) 本ソフトウェアを，ライブラリ形式など，他のソフトウェア開発に使
+ *      用できる形で再配布する場合には，再配布に伴うドキュメント（利用
+ *      者マニュアルなど）に，上記の著作権表示，この利用条件および下記
+ *      の無保証規定を掲載すること．
+ *  (3) 本ソフトウェアを，機器に組み込むなど，他のソフトウェア開発に使
+ *      用できない形で再配布する場合には，次のいずれかの条件を満たすこ
+ *      と．
+ *    (a) 再配布に伴うドキュメント（利用者マニュアルなど）に，上記の著
+ *        作権表示，この利用条件および下記の無保証規定を掲載すること．
+ *    (b) 再配布の形態を，別に定める方法によって，TOPPERSプロジェクトに
+ *        報告すること．
+ *  (4) 本ソフトウェアの利用により直接的または間接的に生じるいかなる損
+ *      害からも，上記著作権者およびTOPPERSプロジェクトを免責すること．
+ *      また，本ソフトウェアのユーザまたはエンドユーザからのいかなる理
+ *      由に基づく請求からも，上記著作権者およびTOPPERSプロジェクトを
+ *      免責すること．
+ * 
+ *  本ソフトウェアは，無保証で提供されているものである．上記著作権者お
+ *  よびTOPPERSプロジェクトは，本ソフトウェアに関して，特定の使用目的
+ *  に対する適合性も含めて，いかなる保証も行わない．また，本ソフトウェ
+ *  アの利用により直接的または間接的に生じたいかなる損害に関しても，そ
+ *  の責任を負わない．
+ * 
+ *  @(#) $Id$
+ */
+
+/*
+ *  64ビットの性能評価用システム時刻（stm32l4xx用）
+ *
+ *  32ビットのTIM2を1MHzのフリーランニングカウンタとし，その桁あふれ
+ *  （更新イベント）をトリガ出力としてTIM5で数えることで，マイクロ秒単
+ *  位の64ビットカウンタを構成する．上位と下位は別のレジスタであるため，
+ *  上位・下位・上位の順に読み出し，2回の上位が一致するまで読み直す．
+ *  TIM2の桁あふれからTIM5の更新までは数クロックの遅れがあるため，下位
+ *  が0の間（1マイクロ秒）も読み直す．割込みを禁止しないため，どのコン
+ *  テキストからも呼び出すことができる．
+ *
+ *  このインクルードファイルは，chip_kernel.hでインクルードされる．
+ */
+
+#ifndef TOPPERS_CHIP_UTM64_H
+#define TOPPERS_CHIP_UTM64_H
+
+#include <sil.h>
+#include "_renamed_stm32l4xx.h"
+
+/*
+ *  64ビットカウンタに用いるタイマ
+ */
+#define TADR_UTM64_LOW		TADR_TIM2_BASE	/* 下位32ビット（マイクロ秒）*/
+#define TADR_UTM64_HIGH		TADR_TIM5_BASE	/* 上位32ビット（下位の桁あふれ回数）*/
+
+#ifndef TOPPERS_MACRO_ONLY
+
+/*
+ *  64ビットの性能評価用システム時刻の読出し
+ */
+Inline uint64_t
+fch_utm64(void)
+{
+	uint32_t	high, low;
+
+	do {
+		high = sil_rew_mem((void *)(TADR_UTM64_HIGH+TOFF_TIM_CNT));
+		low = sil_rew_mem((void *)(TADR_UTM64_LOW+TOFF_TIM_CNT));
+	} while (low == 0U
+			|| high != sil_rew_mem((void *)(TADR_UTM64_HIGH+TOFF_TIM_CNT)));
+	return((((uint64_t) high) << 32) | low);
+}
+
+/*
+ *  64ビットカウンタの初期化
+ *
+ *  target_initializeから呼び出す．
+ */
+extern void chip_utm64_initialize(void);
+
+/*
+ *  64ビットカウンタの再設定
+ *
+ *  システムクロックを変更した後や，タイマが停止する省電力モードから復
+ *  帰した後に，CPUロック状態で呼び出す．プリスケーラを現在のシステム
+ *  クロックから求め直し，停止していた時間usecを加えてカウンタを再起動
+ *  する．
+ */
+extern void chip_utm64_reload(uint32_t usec);
+
+#endif /* TOPPERS_MACRO_ONLY */
+#endif /* TOPPERS_CHIP_UTM64_H */
@@ -50,12 +50,99 @@
 
 /*
  *  トレースログバッファとそれにアクセスするためのポインタ
+ *
+ *  TOPPERS_TRACE_LOCKFREEを定義した場合には，trace_headとtrace_tailは
+ *  バッファ中の位置ではなく，それぞれ読み出したログと予約したログの
+ *  通し番号を保持し，trace_stampには各エントリに書き込んだログの通し
+ *  番号から作った印（TRACE_STAMP）を保持する．書込み中のエントリの印
+ *  は，TRACE_STAMP_BUSYのビットを立てた値とする．
  */
 SYSLOG	trace_buffer[TCNT_TRACE_BUFFER];	/* トレースログバッファ */
 uint_t	trace_count;				/* トレースログバッファ中のログの数 */
 uint_t	trace_head;					/* 先頭のトレースログの格納位置 */
 uint_t	trace_tail;					/* 次のトレースログの格納位置 */
+uint_t	trace_lost;					/* 失われたトレースの数 */
+uint_t	trace_hiwat;				/* トレースログバッファ中のログの最大数 */
 MODE	trace_mode;					/* トレースモード */
+#ifdef TOPPERS_TRACE_LOCKFREE
+uint_t	trace_stamp[TCNT_TRACE_BUFFER];	/* 書込み完了の印 */
+#endif /* TOPPERS_TRACE_LOCKFREE */
+TCB		*trace_quiet_tcb = NULL;	/* トレースログを記録しないタスク */
+
+/*
+ *  記録しないトレースログの判定
+ *
+ *  トレースログ送出タスクの処理を記録すると，それを送出するための処理
+ *  が再び記録され，送出が止まらなくなる．そのため，trace_quiet_tcbの
+ *  タスクの状態遷移とディスパッチ，タスクコンテキストからの記録を捨て
+ *  る．
+ */
+Inline bool_t
+trace_quiet(const TRACE *p_trace)
+{
+	if (trace_quiet_tcb == NULL) {
+		return(false);
+	}
+	switch (p_trace->logtype) {
+	case LOG_TYPE_TSKSTAT:
+	case LOG_TYPE_DSP|LOG_ENTER:
+	case LOG_TYPE_DSP|LOG_LEAVE:
+		return(((TCB *)(p_trace->loginfo[0])) == trace_quiet_tcb);
+	default:
+		return(!sense_context() && p_runtsk == trace_quiet_tcb);
+	}
+}
+
+#ifdef TOPPERS_TRACE_LOCKFREE
+
+/*
+ *  トレースログバッファのサイズのチェック
+ *
+ *  通し番号が一周した時にもバッファ中の位置が連続するように，サイズは
+ *  2のべき乗でなければならない．
+ */
+#if (TCNT_TRACE_BUFFER & (TCNT_TRACE_BUFFER - 1)) != 0
+#error TCNT_TRACE_BUFFER must be a power of two with TOPPERS_TRACE_LOCKFREE.
+#endif /* (TCNT_TRACE_BUFFER & (TCNT_TRACE_BUFFER - 1)) != 0 */
+
+/*
+ *  通し番号からバッファ中の位置と書込み完了の印を求めるマクロ
+ */
+#define TRACE_SLOT(index)	((index) & (TCNT_TRACE_BUFFER - 1U))
+#define TRACE_STAMP(index)	((uint_t)(((index) + 1U) << 1))
+#define TRACE_STAMP_BUSY	1U
+
+/*
+ *  トレースログバッファのクリア
+ *
+ *  書込み中のエントリの印は，書込み側が書き換えるまで残しておく．
+ */
+static void
+trace_clear(void)
+{
+	uint_t	i;
+
+	for (i = 0U; i < TCNT_TRACE_BUFFER; i++) {
+		if ((trace_stamp[i] & TRACE_STAMP_BUSY) == 0U) {
+			trace_stamp[i] = TRACE_STAMP(trace_tail - 1U);
+		}
+	}
+	trace_count = 0U;
+	trace_head = trace_tail;
+	trace_lost = 0U;
+	trace_hiwat = 0U;
+}
+
+/*
+ *  失われたトレースの数の更新（書込み側）
+ */
+static void
+trace_add_lost(void)
+{
+	(void) sil_atm_add((uint32_t *) &trace_lost, 1U);
+}
+
+#endif /* TOPPERS_TRACE_LOCKFREE */
 
 /*
  *  トレースログ機能の初期化
@@ -65,9 +152,16 @@ trace_initialize(intptr_t exinf)
 {
 	MODE	mode = ((MODE) exinf);
 
+#ifdef TOPPERS_TRACE_LOCKFREE
+	trace_tail = 0U;
+	trace_clear();
+#else /* TOPPERS_TRACE_LOCKFREE */
 	trace_count = 0U;
 	trace_head = 0U;
 	trace_tail = 0U;
+	trace_lost = 0U;
+	trace_hiwat = 0U;
+#endif /* TOPPERS_TRACE_LOCKFREE */
 	trace_mode = mode;
 }     
 
@@ -78,14 +172,169 @@ ER
 trace_sta_log(MODE mode)
 {
 	if ((mode & TRACE_CLEAR) != 0U) {
+#ifdef TOPPERS_TRACE_LOCKFREE
+		SIL_PRE_LOC;
+
+		SIL_LOC_INT();
+		trace_clear();
+		SIL_UNL_INT();
+#else /* TOPPERS_TRACE_LOCKFREE */
 		trace_count = 0U;
 		trace_head = 0U;
 		trace_tail = 0U;
+		trace_lost = 0U;
+		trace_hiwat = 0U;
+#endif /* TOPPERS_TRACE_LOCKFREE */
 	}
 	trace_mode = mode;
 	return(E_OK);
 }     
 
+#ifdef TOPPERS_TRACE_LOCKFREE
+
+/* 
+ *  トレースログの書込み（ロックフリー版）
+ *
+ *  書込み位置をアトミック操作（sil_atm_cas）で予約し，割込みを禁止せ
+ *  ずにトレースログを書き込む．書込みを終えた後にtrace_stampを更新する
+ *  ことで，読出し側に書込み完了を知らせる．
+ *
+ *  予約の後に長く割り込まれると，リングバッファモードでは，他の書込み
+ *  に一周追い越されていることがある．そのため，エントリの印を書込み中
+ *  の値にアトミック操作で書き換えてから書き込み，印が既に新しいログの
+ *  ものか，他の書込みの途中である場合には，ログを捨てる．
+ */
+ER
+trace_wri_log(TRACE *p_trace)
+{
+	MODE	mode = trace_mode;
+	uint_t	index, slot, stamp, old;
+
+	if (mode != TRACE_STOP && !trace_quiet(p_trace)) {
+		p_trace->logtim = TRACE_GET_TIM();
+
+		/*
+		 *  書込み位置の予約
+		 */
+		do {
+			index = sil_atm_rew((uint32_t *) &trace_tail);
+			if (index - trace_head >= TCNT_TRACE_BUFFER
+						&& (mode & (TRACE_AUTOSTOP|TRACE_STREAM)) != 0U) {
+				/*
+				 *  自動停止モードとストリーミングモードでは，送出さ
+				 *  れていないログを上書きしない．
+				 */
+				if ((mode & TRACE_AUTOSTOP) != 0U) {
+					trace_mode = TRACE_STOP;
+				}
+				trace_add_lost();
+				return(E_OK);
+			}
+		} while (!sil_atm_cas((uint32_t *) &trace_tail, index, index + 1U));
+
+		/*
+		 *  エントリの確保
+		 */
+		slot = TRACE_SLOT(index);
+		stamp = TRACE_STAMP(index);
+		do {
+			old = sil_atm_rew((uint32_t *) &(trace_stamp[slot]));
+			if ((old & TRACE_STAMP_BUSY) != 0U
+							|| ((int_t)(old - stamp)) >= 0) {
+				trace_add_lost();
+				return(E_OK);
+			}
+		} while (!sil_atm_cas((uint32_t *) &(trace_stamp[slot]),
+											old, stamp | TRACE_STAMP_BUSY));
+
+		/*
+		 *  トレースバッファに記録
+		 */
+		ARM_MEMORY_CHANGED;
+		trace_buffer[slot] = *p_trace;
+		ARM_MEMORY_CHANGED;
+		sil_atm_wrw((uint32_t *) &(trace_stamp[slot]), stamp);
+	}
+	return(E_OK);
+}
+
+/*
+ *  トレースログの読出し（ロックフリー版）
+ *
+ *  読出し側は頻繁に呼ばれることはないため，読出し同士の排他のために
+ *  割込みを禁止する．trace_countとtrace_hiwatは，読出し時に更新する．
+ */
+ER
+trace_rea_log(TRACE *p_trace)
+{
+	ER_UINT	ercd;
+	uint_t	tail, slot, stamp, expected;
+	SIL_PRE_LOC;
+
+	SIL_LOC_INT();
+
+	for (;;) {
+		tail = trace_tail;
+		if (tail - trace_head > TCNT_TRACE_BUFFER) {
+			/*
+			 *  リングバッファモードで上書きされたログを読み飛ばす．
+			 */
+			trace_lost += tail - trace_head - TCNT_TRACE_BUFFER;
+			trace_head = tail - TCNT_TRACE_BUFFER;
+		}
+		if (tail - trace_head > trace_hiwat) {
+			trace_hiwat = tail - trace_head;
+		}
+		if (trace_head == tail) {
+			ercd = E_OBJ;
+			break;
+		}
+
+		slot = TRACE_SLOT(trace_head);
+		expected = TRACE_STAMP(trace_head);
+		stamp = trace_stamp[slot];
+		if (stamp != expected) {
+			if (((int_t)((stamp & ~TRACE_STAMP_BUSY) - expected)) > 0) {
+				/*
+				 *  既に上書きされている場合
+				 */
+				trace_lost++;
+				trace_head++;
+				continue;
+			}
+
+			/*
+			 *  書込み中のログに追い付いた場合
+			 */
+			ercd = E_OBJ;
+			break;
+		}
+
+		*p_trace = trace_buffer[slot];
+		ARM_MEMORY_CHANGED;
+		if (trace_stamp[slot] != stamp) {
+			/*
+			 *  取り出している間に上書きされた場合
+			 */
+			trace_lost++;
+			trace_head++;
+			continue;
+		}
+		trace_head++;
+		ercd = E_OK;
+		break;
+	}
+	trace_count = trace_tail - trace_head;
+	if (trace_count > TCNT_TRACE_BUFFER) {
+		trace_count = TCNT_TRACE_BUFFER;
+	}
+
+	SIL_UNL_INT();
+	return(ercd);
+}
+
+#else /* TOPPERS_TRACE_LOCKFREE */
+
 /* 
  *  トレースログの書込み
  */
@@ -94,7 +343,7 @@ trace_wri_log(TRACE *p_trace)
 {
 	SIL_PRE_LOC;
 
-	if (trace_mode != TRACE_STOP) {
+	if (trace_mode != TRACE_STOP && !trace_quiet(p_trace)) {
 		SIL_LOC_INT();
 
 		/*
@@ -106,23 +355,37 @@ trace_wri_log(TRACE *p_trace)
 		 */
 		p_trace->logtim = TRACE_GET_TIM();
 
-		/*
-		 *  トレースバッファに記録
-		 */
-		trace_buffer[trace_tail] = *p_trace;
-		trace_tail++;
-		if (trace_tail >= TCNT_TRACE_BUFFER) {
-			trace_tail = 0U;
-		}
-		if (trace_count < TCNT_TRACE_BUFFER) {
-			trace_count++;
-			if (trace_count >= TCNT_TRACE_BUFFER
-						&& (trace_mode & TRACE_AUTOSTOP) != 0U) {
-				trace_mode = TRACE_STOP;
-			}
+		if (trace_count >= TCNT_TRACE_BUFFER
+						&& (trace_mode & TRACE_STREAM) != 0U) {
+			/*
+			 *  ストリーミングモードでは，送出されていないログを上書
+			 *  きせずに，新しいログを捨てる．
+			 */
+			trace_lost++;
 		}
 		else {
-			trace_head = trace_tail;
+			/*
+			 *  トレースバッファに記録
+			 */
+			trace_buffer[trace_tail] = *p_trace;
+			trace_tail++;
+			if (trace_tail >= TCNT_TRACE_BUFFER) {
+				trace_tail = 0U;
+			}
+			if (trace_count < TCNT_TRACE_BUFFER) {
+				trace_count++;
+				if (trace_count > trace_hiwat) {
+					trace_hiwat = trace_count;
+				}
+				if (trace_count >= TCNT_TRACE_BUFFER
+							&& (trace_mode & TRACE_AUTOSTOP) != 0U) {
+					trace_mode = TRACE_STOP;
+				}
+			}
+			else {
+				trace_head = trace_tail;
+				trace_lost++;
+			}
 		}
 
 		SIL_UNL_INT();
@@ -161,6 +424,8 @@ trace_rea_log(TRACE *p_trace)
 	return(ercd);
 }
 
+#endif /* TOPPERS_TRACE_LOCKFREE */
+
 /*
  *  トレースログを出力するためのライブラリ関数
  */
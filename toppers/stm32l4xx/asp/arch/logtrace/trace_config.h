@@ -83,6 +83,16 @@ extern uint_t	trace_count;		/* トレースログバッファ中のログの数
 extern uint_t	trace_head;			/* 先頭のトレースログの格納位置 */
 extern uint_t	trace_tail;			/* 次のトレースログの格納位置 */
 extern uint_t	trace_lost;			/* 失われたトレースの数 */
+extern uint_t	trace_hiwat;		/* トレースログバッファ中のログの最大数 */
+
+/*
+ *  トレースログを記録しないタスク
+ *
+ *  トレースログ送出タスク（trace_stream.c）が自タスクのTCBを設定する．
+ *  このタスクが呼び出したサービスコールと，このタスクの状態遷移とディ
+ *  スパッチは記録しない．
+ */
+extern struct task_control_block	*trace_quiet_tcb;
 
 #endif /* TOPPERS_MACRO_ONLY */
 
@@ -93,6 +103,7 @@ extern uint_t	trace_lost;			/* 失われたトレースの数 */
 #define TRACE_RINGBUF		UINT_C(0x01)	/* リングバッファモード */
 #define TRACE_AUTOSTOP		UINT_C(0x02)	/* 自動停止モード */
 #define TRACE_CLEAR			UINT_C(0x04)	/* トレースログのクリア */
+#define TRACE_STREAM		UINT_C(0x08)	/* ストリーミングモード */
 
 #ifndef TOPPERS_MACRO_ONLY
 
@@ -105,6 +116,7 @@ extern uint_t	trace_lost;			/* 失われたトレースの数 */
  *  TRACE_STOP：初期化のみでトレースは開始しない．
  *  TRACE_RINGBUF：リングバッファモードでトレースを開始．
  *  TRACE_AUTOSTOP：自動停止モードでトレースを開始．
+ *  TRACE_STREAM：ストリーミングモードでトレースを開始．
  */
 extern void	trace_initialize(intptr_t exinf);
 
@@ -116,7 +128,12 @@ extern void	trace_initialize(intptr_t exinf);
  *  TRACE_STOP：トレースを停止．
  *  TRACE_RINGBUF：リングバッファモードでトレースを開始．
  *  TRACE_AUTOSTOP：自動停止モードでトレースを開始．
+ *  TRACE_STREAM：ストリーミングモードでトレースを開始．
  *  TRACE_CLEAR：トレースログをクリア．
+ *
+ *  ストリーミングモードでは，トレースログバッファが満杯の場合に古いロ
+ *  グを上書きせず，新しいログを捨ててtrace_lostに数える．バッファから
+ *  のログの取出しは，トレースログ送出タスク（trace_stream.c）が行う．
  */
 extern ER	trace_sta_log(MODE mode);
 
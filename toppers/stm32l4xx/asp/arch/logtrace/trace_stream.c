@@ -0,0 +1,295 @@
+/*
+ *  TOPPERS/ASP Kernel
+ *      Toyohashi Open Platform for Embedded Real-Time Systems/
+ *      Advanced Standard Profile Kernel
+ * 
+ *  Copyright (C) 2005-2011 by Embedded and Real-Time Systems Laboratory
+ *              Graduate School of Information Science, Nagoya Univ., JAPAN
+ *  Copyright (C) 2017-2018 by TOPPERS PROJECT Educational Working Group.
+ * 
+ *  上記著作権者は，以下の(1)〜(4)の条件を満たす場合に限り，本ソフトウェ
+ *  ア（本ソフトウェアを改変したものを含む．以下同じ）を使用・複製・改
+ *  変・再配布（以下，利用と呼ぶ）することを無償で許諾する．
+ *  (1) 本ソフトウェアをソースコードの形で利用する場合には，上記の著作
+ *      権表示，この利用条件および下記の無保証規定が，そのままの形でソー
+ *      スコード中に含まれていること．
+ *  (2) 本ソフトウェアを，ライブラリ形式など，他のソフトウェア開発に使
+ *      用できる形で再配布する場合には，再配布に伴うドキュメント（利用
+ *      者マニュアルなど）に，上記の著作権表示，この利用条件および下記
+ *      の無保証規定を掲載すること．
+ *  (3) 本ソフトウェアを，機器に組み込むなど，他のソフトウェア開発に使
+ *      用できない形で再配布する場合には，次のいずれかの条件を満たすこ
+ *      と．
+ *    (a) 再配布に伴うドキュメント（利用者マニュアルなど）に，上記の著
+ *        作権表示，この利用条件および下記の無保証規定を掲載すること．
+ *    (b) 再配布の形態を，別に定める方法によって，TOPPERSプロジェクトに
+ *        報告すること．
+ *  (4) 本ソフトウェアの利用により直接的または間接的に生じるいかなる損
+ *      害からも，上記著作権者およびTOPPERSプロジェクトを免責すること．
+ *      また，本ソフトウェアのユーザまたはエンドユーザからのいかなる理
+ *      由に基づく請求からも，上記著作権者およびTOPPERSプロジェクトを
+ *      免責すること．
+ * 
+ *  本ソフトウェアは，無保証で提供されているものである．上記著作権者お
+ *  よびTOPPERSプロジェクトは，本ソフトウェアに関して，特定の使用目的
+ *  に対する適合性も含めて，いかなる保証も行わない．また，本ソフトウェ
+ *  アの利用により直接的または間接的に生じたいかなる損害に関しても，そ
+ *  の責任を負わない．
+ * 
+ *  $Id$
+ */
+
+/*
+ *		トレースログのストリーミング出力
+ */
+
+#include "kernel_impl.h"
+#include "task.h"
+#include <sil.h>
+#include <log_output.h>
+#include "syssvc/serial.h"
+#include "trace_stream.h"
+
+/*
+ *  送出先のシリアルポートのID
+ */
+#ifndef TRACE_STREAM_ITM
+static ID		trace_stream_portid;
+#endif /* TRACE_STREAM_ITM */
+
+/*
+ *  送出中のフレームのためのバッファ
+ */
+static uint8_t	trace_frame[TRACE_FRM_HDRSZ + TRACE_FRM_MAXPLD + 1U];
+static uint_t	trace_frame_len;			/* バッファ中のバイト数 */
+static uint16_t	trace_frame_seq;			/* フレームのシーケンス番号 */
+
+/*
+ *  ストリーミング出力の統計情報
+ */
+static uint_t	trace_stream_sent;			/* 送出したフレームの数 */
+static uint_t	trace_stream_stall;			/* 送出が追い付かなかった回数 */
+
+/*
+ *  バイト列の送出
+ */
+static void
+trace_stream_send(const uint8_t *buf, uint_t len)
+{
+#ifdef TRACE_STREAM_ITM
+	uint_t	i;
+
+	for (i = 0U; i < len; i++) {
+		/*
+		 *  ITMが有効化されていない（デバッガが接続されていない）場合
+		 *  には，FIFOが空くことはないため，送出せずに捨てる．
+		 */
+		if ((sil_rew_mem((void *) ITM_TCR) & ITM_TCR_ITMENA) == 0U) {
+			return;
+		}
+		while ((sil_rew_mem((void *) ITM_STIM(TRACE_STREAM_ITM_PORT))
+										& ITM_STIM_FIFOREADY) == 0U) ;
+		sil_wrb_mem((void *) ITM_STIM(TRACE_STREAM_ITM_PORT), buf[i]);
+	}
+#else /* TRACE_STREAM_ITM */
+	(void) serial_wri_dat(trace_stream_portid, (const char *) buf, len);
+#endif /* TRACE_STREAM_ITM */
+}
+
+/*
+ *  フレームの組立て
+ */
+static void
+trace_frame_begin(uint_t kind)
+{
+	trace_frame[0] = TRACE_FRM_SYNC0;
+	trace_frame[1] = TRACE_FRM_SYNC1;
+	trace_frame[2] = (uint8_t) kind;
+	trace_frame[4] = (uint8_t)(trace_frame_seq & 0xffU);
+	trace_frame[5] = (uint8_t)(trace_frame_seq >> 8);
+	trace_frame_len = TRACE_FRM_HDRSZ;
+}
+
+static void
+trace_frame_put1(uint8_t val)
+{
+	if (trace_frame_len < TRACE_FRM_HDRSZ + TRACE_FRM_MAXPLD) {
+		trace_frame[trace_frame_len] = val;
+		trace_frame_len++;
+	}
+}
+
+static void
+trace_frame_put2(uint16_t val)
+{
+	trace_frame_put1((uint8_t)(val & 0xffU));
+	trace_frame_put1((uint8_t)(val >> 8));
+}
+
+static void
+trace_frame_put4(uint32_t val)
+{
+	trace_frame_put2((uint16_t)(val & 0xffffU));
+	trace_frame_put2((uint16_t)(val >> 16));
+}
+
+static void
+trace_frame_putc(char c)
+{
+	trace_frame_put1((uint8_t) c);
+}
+
+static void
+trace_frame_end(void)
+{
+	uint8_t	sum = 0U;
+	uint_t	i;
+
+	trace_frame[3] = (uint8_t)(trace_frame_len - TRACE_FRM_HDRSZ);
+	for (i = 2U; i < trace_frame_len; i++) {
+		sum += trace_frame[i];
+	}
+	trace_frame[trace_frame_len] = (uint8_t)(-sum);
+	trace_stream_send(trace_frame, trace_frame_len + 1U);
+	trace_frame_seq++;
+	trace_stream_sent++;
+}
+
+/* 
+ *  カーネル情報の取出し
+ */
+static uint32_t
+get_tskid(intptr_t info)
+{
+	TCB		*p_tcb;
+
+	p_tcb = (TCB *) info;
+	if (p_tcb == NULL) {
+		return(0U);
+	}
+	else {
+		return((uint32_t) TSKID(p_tcb));
+	}
+}
+
+/*
+ *  トレースログの送出
+ *
+ *  ホスト側で解釈できない情報（TCBへのポインタや書式文字列へのポイン
+ *  タ）は，送出前にタスクIDや整形済みの文字列に変換する．
+ */
+static void
+trace_stream_record(const TRACE *p_trace)
+{
+	int_t	i;
+
+	switch (p_trace->logtype) {
+	case LOG_TYPE_COMMENT:
+	case LOG_TYPE_ASSERT:
+		trace_frame_begin(TRACE_FRM_TXT);
+		trace_frame_put4((uint32_t)(p_trace->logtim));
+		syslog_print(p_trace, trace_frame_putc);
+		break;
+	default:
+		trace_frame_begin(TRACE_FRM_REC);
+		trace_frame_put2((uint16_t)(p_trace->logtype));
+		trace_frame_put4((uint32_t)(p_trace->logtim));
+		switch (p_trace->logtype) {
+		case LOG_TYPE_TSKSTAT:
+		case LOG_TYPE_DSP|LOG_ENTER:
+		case LOG_TYPE_DSP|LOG_LEAVE:
+			trace_frame_put4(get_tskid(p_trace->loginfo[0]));
+			i = 1;
+			break;
+		default:
+			i = 0;
+			break;
+		}
+		for (; i < TMAX_LOGINFO; i++) {
+			trace_frame_put4((uint32_t)(p_trace->loginfo[i]));
+		}
+		break;
+	}
+	trace_frame_end();
+}
+
+/*
+ *  ストリーミング出力の状態参照
+ */
+ER
+trace_ref_stm(T_TRACE_RSTM *pk_rstm)
+{
+	SIL_PRE_LOC;
+
+	SIL_LOC_INT();
+	pk_rstm->count = trace_count;
+	pk_rstm->hiwat = trace_hiwat;
+	pk_rstm->lost = trace_lost;
+	pk_rstm->sent = trace_stream_sent;
+	pk_rstm->stall = trace_stream_stall;
+	SIL_UNL_INT();
+	return(E_OK);
+}
+
+/*
+ *  統計情報の送出
+ */
+static void
+trace_stream_stat(void)
+{
+	T_TRACE_RSTM	rstm;
+
+	(void) trace_ref_stm(&rstm);
+	trace_frame_begin(TRACE_FRM_STAT);
+	trace_frame_put4((uint32_t)(rstm.count));
+	trace_frame_put4((uint32_t)(rstm.hiwat));
+	trace_frame_put4((uint32_t)(rstm.lost));
+	trace_frame_put4((uint32_t)(rstm.sent));
+	trace_frame_put4((uint32_t)(rstm.stall));
+	trace_frame_end();
+}
+
+/*
+ *  トレースログ送出タスクの本体
+ */
+void
+trace_stream_main(intptr_t exinf)
+{
+	TRACE	trace;
+	uint_t	n;
+	SYSTIM	stat_time, now;
+
+	trace_quiet_tcb = p_runtsk;
+#ifndef TRACE_STREAM_ITM
+	trace_stream_portid = (ID) exinf;
+	(void) serial_opn_por(trace_stream_portid);
+	(void) serial_ctl_por(trace_stream_portid, IOCTL_NULL);
+#endif /* TRACE_STREAM_ITM */
+	(void) get_tim(&stat_time);
+	trace_stream_stat();
+
+	for (;;) {
+		n = 0U;
+		while (n < TRACE_STREAM_BATCH && trace_rea_log(&trace) >= 0) {
+			trace_stream_record(&trace);
+			n++;
+		}
+
+		(void) get_tim(&now);
+		if (now - stat_time >= TRACE_STREAM_STAT_INTERVAL) {
+			trace_stream_stat();
+			stat_time = now;
+		}
+
+		if (n >= TRACE_STREAM_BATCH && trace_count > 0U) {
+			/*
+			 *  送出が記録に追い付いていない場合には，待たずに送出を
+			 *  続ける．
+			 */
+			trace_stream_stall++;
+		}
+		else {
+			(void) dly_tsk(TRACE_STREAM_INTERVAL);
+		}
+	}
+}
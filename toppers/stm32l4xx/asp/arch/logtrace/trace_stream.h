@@ -0,0 +1,145 @@
+/*
+ *  TOPPERS/ASP Kernel
+ *      Toyohashi Open Platform for Embedded Real-Time Systems/
+ *      Advanced Standard Profile Kernel
+ * 
+ *  Copyright (C) 2005-2011 by Embedded and Real-Time Systems Laboratory
+ *              Graduate School of Information Science, Nagoya Univ., JAPAN
+ *  Copyright (C) 2017-2018 by TOPPERS PROJECT Educational Working Group.
+ * 
+ *  上記著作権者は，以下の(1)〜(4)の条件を満たす場合に限り，本ソフトウェ
+ *  ア（本ソフトウェアを改変したものを含む．以下同じ）を使用・複製・改
+ *  変・再配布（以下，利用と呼ぶ）することを無償で許諾する．
+ *  (1) 本ソフトウェアをソースコードの形で利用する場合には，上記の著作
+ *      権表示，この利用条件および下記の無保証規定が，そのままの形でソー
+ *      スコード中に含まれていること．
+ *  (2) 本ソフトウェアを，ライブラリ形式など，他のソフトウェア開発に使
+ *      用できる形で再配布する場合には，再配布に伴うドキュメント（利用
+ *      者マニュアルなど）に，上記の著作権表示，この利用条件および下記
+ *      の無保証規定を掲載すること．
+ *  (3) 本ソフトウェアを，機器に組み込むなど，他のソフトウェア開発に使
+ *      用できない形で再配布する場合には，次のいずれかの条件を満たすこ
+ *      と．
+ *    (a) 再配布に伴うドキュメント（利用者マニュアルなど）に，上記の著
+ *        作権表示，この利用条件および下記の無保証規定を掲載すること．
+ *    (b) 再配布の形態を，別に定める方法によって，TOPPERSプロジェクトに
+ *        報告すること．
+ *  (4) 本ソフトウェアの利用により直接的または間接的に生じるいかなる損
+ *      害からも，上記著作権者およびTOPPERSプロジェクトを免責すること．
+ *      また，本ソフトウェアのユーザまたはエンドユーザからのいかなる理
+ *      由に基づく請求からも，上記著作権者およびTOPPERSプロジェクトを
+ *      免責すること．
+ * 
+ *  本ソフトウェアは，無保証で提供されているものである．上記著作権者お
+ *  よびTOPPERSプロジェクトは，本ソフトウェアに関して，特定の使用目的
+ *  に対する適合性も含めて，いかなる保証も行わない．また，本ソフトウェ
+ *  アの利用により直接的または間接的に生じたいかなる損害に関しても，そ
+ *  の責任を負わない．
+ * 
+ *  $Id$
+ */
+
+/*
+ *		トレースログのストリーミング出力
+ *
+ *  ストリーミングモード（TRACE_STREAM）で記録されたトレースログを，低
+ *  優先度のトレースログ送出タスクがトレースログバッファから取り出し，
+ *  フレーム形式に変換してシリアルポートまたはITMのスティミュラスポー
+ *  トに送出し続ける．受信側のホストでは，utils/tracerecvを用いてフレー
+ *  ムを組み立て直す．
+ *
+ *  フレームの形式は次の通り（複数バイトのフィールドはリトルエンディア
+ *  ン）．
+ *
+ *	SYNC0(1) SYNC1(1) KIND(1) LEN(1) SEQ(2) PAYLOAD(LEN) SUM(1)
+ *
+ *  SUMは，KINDからPAYLOADの最後までのバイトの和の2の補数である．
+ */
+
+#ifndef TOPPERS_TRACE_STREAM_H
+#define TOPPERS_TRACE_STREAM_H
+
+#include "target_syssvc.h"
+#include "logtrace/trace_config.h"
+
+/*
+ *  トレースログ送出タスク関連の定数のデフォルト値の定義
+ */
+#ifndef TRACE_STREAM_PRIORITY
+#define TRACE_STREAM_PRIORITY	TMAX_TPRI	/* 初期優先度 */
+#endif /* TRACE_STREAM_PRIORITY */
+
+#ifndef TRACE_STREAM_STACK_SIZE
+#define TRACE_STREAM_STACK_SIZE	1024		/* スタック領域のサイズ */
+#endif /* TRACE_STREAM_STACK_SIZE */
+
+#ifndef TRACE_STREAM_PORTID
+#define TRACE_STREAM_PORTID		2			/* 送出先のシリアルポート番号 */
+#endif /* TRACE_STREAM_PORTID */
+
+#ifndef TRACE_STREAM_ITM_PORT
+#define TRACE_STREAM_ITM_PORT	0			/* ITMのスティミュラスポート番号 */
+#endif /* TRACE_STREAM_ITM_PORT */
+
+#ifndef TRACE_STREAM_INTERVAL
+#define TRACE_STREAM_INTERVAL	10U			/* 送出タスクの動作間隔（ミリ秒）*/
+#endif /* TRACE_STREAM_INTERVAL */
+
+#ifndef TRACE_STREAM_BATCH
+#define TRACE_STREAM_BATCH		32U			/* 一度に送出するログの最大数 */
+#endif /* TRACE_STREAM_BATCH */
+
+#ifndef TRACE_STREAM_STAT_INTERVAL
+#define TRACE_STREAM_STAT_INTERVAL	1000U	/* 統計情報の送出間隔（ミリ秒）*/
+#endif /* TRACE_STREAM_STAT_INTERVAL */
+
+/*
+ *  フレームの定義
+ */
+#define TRACE_FRM_SYNC0		UINT_C(0x7e)	/* 同期パターン */
+#define TRACE_FRM_SYNC1		UINT_C(0x54)
+#define TRACE_FRM_REC		UINT_C(0x01)	/* トレースログ */
+#define TRACE_FRM_TXT		UINT_C(0x02)	/* 整形済みのログ文字列 */
+#define TRACE_FRM_STAT		UINT_C(0x03)	/* 統計情報 */
+
+#define TRACE_FRM_HDRSZ		6U				/* ヘッダのサイズ */
+#define TRACE_FRM_MAXPLD	255U			/* ペイロードの最大サイズ */
+
+#ifndef TOPPERS_MACRO_ONLY
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ *  ストリーミング出力の状態参照のためのパケット形式
+ */
+typedef struct t_trace_rstm {
+	uint_t	count;		/* トレースログバッファ中のログの数 */
+	uint_t	hiwat;		/* トレースログバッファ中のログの最大数 */
+	uint_t	lost;		/* 失われたログの数 */
+	uint_t	sent;		/* 送出したフレームの数 */
+	uint_t	stall;		/* 送出が記録に追い付かなかった回数 */
+} T_TRACE_RSTM;
+
+/*
+ *  ストリーミング出力の状態参照
+ */
+extern ER	trace_ref_stm(T_TRACE_RSTM *pk_rstm) throw();
+
+/*
+ *  トレースログ送出タスクの本体
+ *
+ *  拡張情報には，送出先のシリアルポートのIDを渡す．TRACE_STREAM_ITMを
+ *  マクロ定義した場合には，シリアルポートの代わりにITMのスティミュラ
+ *  スポート（TRACE_STREAM_ITM_PORT）に送出し，拡張情報は使用しない．
+ */
+extern void	trace_stream_main(intptr_t exinf) throw();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TOPPERS_MACRO_ONLY */
+
+#endif /* TOPPERS_TRACE_STREAM_H */
@@ -0,0 +1,647 @@
+/*
+ *  TOPPERS/ASP Kernel
+ *      Toyohashi Open Platform for Embedded Real-Time Systems/
+ *      Advanced Standard Profile Kernel
+ * 
+ *  Copyright (C) 2005-2011 by Embedded and Real-Time Systems Laboratory
+ *              Graduate School of Information Science, Nagoya Univ., JAPAN
+ *  Copyright (C) 2017-2018 by TOPPERS PROJECT Educational Working Group.
+ * 
+ *  上記著作権者は，以下の(1)〜(4)の条件を満たす場合に限り，本ソフトウェ
+ *  ア（本ソフトウェアを改変したものを含む．以下同じ）を使用・複製・改
+ *  変・再配布（以下，利用と呼ぶ）することを無償で許諾する．
+ *  (1) 本ソフトウェアをソースコードの形で利用する場合には，上記の著作
+ *      権表示，この利用条件および下記の無保証規定が，そのままの形でソー
+ *      スコード中に含まれていること．
+ *  (2) 本ソフトウェアを，ライブラリ形式など，他のソフトウェア開発に使
+ *      用できる形で再配布する場合には，再配布に伴うドキュメント（利用
+ *      者マニュアルなど）に，上記の著作権表示，この利用条件および下記
+ *      の無保証規定を掲載すること．
+ *  (3) 本ソフトウェアを，機器に組み込むなど，他のソフトウェア開発に使
+ *      用できない形で再配布する場合には，次のいずれかの条件を満たすこ
+ *      と．
+ *    (a) 再配布に伴うドキュメント（利用者マニュアルなど）に，上記の著
+ *        作権表示，この利用条件および下記の無保証規定を掲載すること．
+ *    (b) 再配布の形態を，別に定める方法によって，TOPPERSプロジェクトに
+ *        報告すること．
+ *  (4) 本ソフトウェアの利用により直接的または間接的に生じるいかなる損
+ *      害からも，上記著作権者およびTOPPERSプロジェクトを免責すること．
+ *      また，本ソフトウェアのユーザまたはエンドユーザからのいかなる理
+ *      由に基づく請求からも，上記著作権者およびTOPPERSプロジェクトを
+ *      免責すること．
+ * 
+ *  本ソフトウェアは，無保証で提供されているものである．上記著作権者お
+ *  よびTOPPERSプロジェクトは，本ソフトウェアに関して，特定の使用目的
+ *  に対する適合性も含めて，いかなる保証も行わない．また，本ソフトウェ
+ *  アの利用により直接的または間接的に生じたいかなる損害に関しても，そ
+ *  の責任を負わない．
+ * 
+ *  $Id$
+ */
+
+/*
+ *		プロセッサ依存モジュール（POSIX用）
+ */
+
+#include "kernel_impl.h"
+#include "check.h"
+#include "task.h"
+#include <time.h>
+
+/*
+ *  CPUロックフラグ実現のための変数
+ */
+volatile bool_t		lock_flag;		/* CPUロックフラグの値を保持する変数 */
+volatile uint_t		saved_iipm;		/* 割込み優先度マスクを保存する変数 */
+
+/*
+ *  IPM（内部表現）の現在値と割込みのネスト段数
+ */
+volatile uint_t		current_iipm;
+volatile uint_t		intnest;
+
+/*
+ *  割込み優先度マスク毎のシグナル集合
+ *
+ *  iipm_sigset[iipm]は，IPMをiipmに設定した時にマスクすべきシグナルの
+ *  集合である．iipm_sigset[IIPM_LOCK]は，カーネル管理の割込みに使える
+ *  すべてのシグナルを含む．
+ */
+static sigset_t		iipm_sigset[IIPM_LOCK + 1U];
+
+/*
+ *  割込み要求禁止フラグがセットされている割込みの集合
+ */
+static sigset_t		disint_sigset;
+
+/*
+ *  割込み属性が設定されている割込みの集合と各割込みの割込み優先度
+ */
+static sigset_t		cfgint_sigset;
+static uint_t		int_iipm[TNUM_SIGNO];
+
+/*
+ *  シグナル毎の出入口処理の番地
+ *
+ *  x_define_inh／x_define_excで設定した出入口処理（INTHDR_ENTRY／
+ *  EXCHDR_ENTRYで生成した引数のない関数）の番地を保持し，sig_handler
+ *  から呼び出す．
+ */
+static void			(*sig_entry[TNUM_SIGNO])(void);
+
+/*
+ *  出入口処理に渡すシグナルハンドラの第3引数
+ *
+ *  sig_handlerは，出入口処理を呼び出す直前にこの変数を設定し，出入口
+ *  処理は実行開始直後にこれを読み出す．その間に受け付けたシグナルのハ
+ *  ンドラは，リターン前に元の値に戻す．
+ */
+void				*prc_p_uctx;
+
+/*
+ *  タスクのコンテキストの雛形とディスパッチャのコンテキスト
+ *
+ *  ディスパッチャは，非タスクコンテキスト用のスタック領域上で動作する．
+ */
+static ucontext_t	tmpl_uctx;
+static ucontext_t	disp_uctx;
+
+/*
+ *  カーネル管理の割込みに使えるシグナルの集合の作成
+ */
+static void
+make_kernel_sigset(sigset_t *p_sigset)
+{
+	uint_t	signo;
+
+	(void) sigemptyset(p_sigset);
+	for (signo = 1U; signo < TNUM_SIGNO; signo++) {
+		if (VALID_INTNO(signo)) {
+			(void) sigaddset(p_sigset, (int) signo);
+		}
+	}
+}
+
+/*
+ *  IPMに対応するシグナルマスクの作成
+ */
+static void
+make_sigmask(uint_t iipm, sigset_t *p_sigset)
+{
+	(void) sigorset(p_sigset, &(iipm_sigset[iipm]), &disint_sigset);
+}
+
+/*
+ *  IPM（ハードウェアの割込み優先度マスク，内部表現）の設定
+ */
+void
+set_iipm(uint_t iipm)
+{
+	sigset_t	sigset;
+
+	current_iipm = iipm;
+	make_sigmask(iipm, &sigset);
+	(void) sigprocmask(SIG_SETMASK, &sigset, NULL);
+}
+
+/*
+ *  プロセッサ依存の初期化
+ */
+void
+prc_initialize(void)
+{
+	uint_t	iipm;
+
+	/*
+	 *  SIGRTMINは実行時に決まる値であるため，ここでチェックする．
+	 */
+	assert(SIGRTMIN <= (int) TINTNO_RT(0)
+							&& (int) TINTNO_RT(15) <= SIGRTMAX);
+
+	/*
+	 *  CPUロックフラグ実現のための変数の初期化
+	 *
+	 *  カーネルの初期化処理は，非タスクコンテキスト・CPUロック状態で
+	 *  実行する．
+	 */
+	lock_flag = true;
+	saved_iipm = IIPM_ENAALL;
+	current_iipm = IIPM_LOCK;
+	intnest = 1U;
+
+	/*
+	 *  シグナル集合の初期化
+	 *
+	 *  割込み属性が設定されるまでは，すべての割込みの割込み要求禁止フ
+	 *  ラグがセットされているものとする．
+	 */
+	for (iipm = 0U; iipm < IIPM_LOCK; iipm++) {
+		(void) sigemptyset(&(iipm_sigset[iipm]));
+	}
+	make_kernel_sigset(&(iipm_sigset[IIPM_LOCK]));
+	make_kernel_sigset(&disint_sigset);
+	(void) sigemptyset(&cfgint_sigset);
+
+	/*
+	 *  コンテキストの雛形の初期化
+	 *
+	 *  タスクとディスパッチャは，CPUロック状態から実行を開始する．
+	 */
+	(void) getcontext(&tmpl_uctx);
+	tmpl_uctx.uc_link = NULL;
+	tmpl_uctx.uc_sigmask = iipm_sigset[IIPM_LOCK];
+	disp_uctx = tmpl_uctx;
+	disp_uctx.uc_stack.ss_sp = (void *) istk;
+	disp_uctx.uc_stack.ss_size = (size_t) istksz;
+}
+
+/*
+ *  プロセッサ依存の終了処理
+ */
+void
+prc_terminate(void)
+{
+}
+
+/*
+ *  割込み要求ラインの属性の設定
+ *
+ *  カーネルの初期化処理から，CPUロック状態で呼び出される．
+ */
+void
+x_config_int(INTNO intno, ATR intatr, PRI intpri)
+{
+	uint_t	iipm = INT_IPM(intpri);
+	uint_t	i;
+
+	assert(VALID_INTNO_CFGINT(intno));
+	assert(TMIN_INTPRI <= intpri && intpri <= TMAX_INTPRI);
+
+	int_iipm[intno] = iipm;
+	(void) sigaddset(&cfgint_sigset, (int) intno);
+	for (i = 0U; i < IIPM_LOCK; i++) {
+		if (i >= iipm) {
+			(void) sigaddset(&(iipm_sigset[i]), (int) intno);
+		}
+		else {
+			(void) sigdelset(&(iipm_sigset[i]), (int) intno);
+		}
+	}
+
+	if ((intatr & TA_ENAINT) != 0U) {
+		(void) sigdelset(&disint_sigset, (int) intno);
+	}
+	else {
+		(void) sigaddset(&disint_sigset, (int) intno);
+	}
+}
+
+/*
+ *  割込み要求禁止フラグのセット
+ *
+ *  割込みハンドラからもdisint_sigsetを参照するため，カーネル管理の割
+ *  込みをマスクした状態で更新する．
+ */
+bool_t
+x_disable_int(INTNO intno)
+{
+	sigset_t	sigset;
+
+	if (!VALID_INTNO(intno)
+			|| sigismember(&cfgint_sigset, (int) intno) != 1) {
+		return(false);
+	}
+	(void) sigprocmask(SIG_BLOCK, &(iipm_sigset[IIPM_LOCK]), &sigset);
+	(void) sigaddset(&disint_sigset, (int) intno);
+	(void) sigaddset(&sigset, (int) intno);
+	(void) sigprocmask(SIG_SETMASK, &sigset, NULL);
+	return(true);
+}
+
+/*
+ *  割込み要求禁止フラグのクリア
+ *
+ *  割込みのマスクを解除するのは，現在のIPMでマスクされない場合のみで
+ *  ある．
+ */
+bool_t
+x_enable_int(INTNO intno)
+{
+	sigset_t	sigset;
+
+	if (!VALID_INTNO(intno)
+			|| sigismember(&cfgint_sigset, (int) intno) != 1) {
+		return(false);
+	}
+	(void) sigprocmask(SIG_BLOCK, &(iipm_sigset[IIPM_LOCK]), &sigset);
+	(void) sigdelset(&disint_sigset, (int) intno);
+	if (sigismember(&(iipm_sigset[current_iipm]), (int) intno) != 1) {
+		(void) sigdelset(&sigset, (int) intno);
+	}
+	(void) sigprocmask(SIG_SETMASK, &sigset, NULL);
+	return(true);
+}
+
+/*
+ *  割込み要求のクリア
+ *
+ *  保留中のシグナルは，その動作を一旦SIG_IGNに設定することで破棄する．
+ */
+void
+x_clear_int(INTNO intno)
+{
+	struct sigaction	sa, saved_sa;
+	sigset_t			sigset;
+
+	(void) sigprocmask(SIG_BLOCK, &(iipm_sigset[IIPM_LOCK]), &sigset);
+	sa.sa_handler = SIG_IGN;
+	sa.sa_flags = 0;
+	(void) sigemptyset(&(sa.sa_mask));
+	(void) sigaction((int) intno, &sa, &saved_sa);
+	(void) sigaction((int) intno, &saved_sa, NULL);
+	(void) sigprocmask(SIG_SETMASK, &sigset, NULL);
+}
+
+/*
+ *  シグナルハンドラ
+ *
+ *  割込みハンドラとCPU例外ハンドラに共通のシグナルハンドラ．シグナル
+ *  番号に対応する出入口処理を呼び出す．
+ */
+static void
+sig_handler(int signo, siginfo_t *p_info, void *p_uctx)
+{
+	void	*saved_p_uctx = prc_p_uctx;
+
+	prc_p_uctx = p_uctx;
+	(*sig_entry[signo])();
+	prc_p_uctx = saved_p_uctx;
+}
+
+/*
+ *  割込みハンドラの設定
+ *
+ *  割込みハンドラの出入口処理は，カーネル管理の割込みをすべてマスクし
+ *  た状態で実行を開始する．
+ */
+void
+x_define_inh(INHNO inhno, FP int_entry)
+{
+	struct sigaction	sa;
+
+	sig_entry[inhno] = (void (*)(void)) int_entry;
+	sa.sa_sigaction = sig_handler;
+	sa.sa_flags = SA_SIGINFO | SA_RESTART;
+	sa.sa_mask = iipm_sigset[IIPM_LOCK];
+	(void) sigaction((int) inhno, &sa, NULL);
+}
+
+/*
+ *  CPU例外ハンドラの設定
+ *
+ *  CPU例外ハンドラの実行中も，割込みはマスクしない．
+ */
+void
+x_define_exc(EXCNO excno, FP exc_entry)
+{
+	struct sigaction	sa;
+
+	sig_entry[excno] = (void (*)(void)) exc_entry;
+	sa.sa_sigaction = sig_handler;
+	sa.sa_flags = SA_SIGINFO | SA_RESTART;
+	(void) sigemptyset(&(sa.sa_mask));
+	(void) sigaction((int) excno, &sa, NULL);
+}
+
+/*
+ *  タスクコンテキストの初期化
+ */
+void
+prc_activate_context(TSKCTXB *p_tskctxb, void *stk, SIZE stksz)
+{
+	p_tskctxb->uctx = tmpl_uctx;
+	p_tskctxb->uctx.uc_stack.ss_sp = stk;
+	p_tskctxb->uctx.uc_stack.ss_size = (size_t) stksz;
+	makecontext(&(p_tskctxb->uctx), start_r, 0);
+}
+
+/*
+ *  タスクの起動処理
+ *
+ *  CPUロック状態で起動されるため，CPUロック解除状態にしてからタスクを
+ *  呼び出す．タスクからリターンした場合には，ext_tskを呼び出す．
+ */
+void
+start_r(void)
+{
+	lock_flag = false;
+	set_iipm(IIPM_ENAALL);
+	(*(get_tinib(p_runtsk)->task))(get_tinib(p_runtsk)->exinf);
+	(void) ext_tsk();
+}
+
+/*
+ *  ディスパッチャ本体
+ *
+ *  ディスパッチャのコンテキストで，CPUロック状態で実行する．実行すべ
+ *  きタスクがない場合には，割込み（シグナル）を待つ．割込みを待つ間は
+ *  非タスクコンテキストとし，割込みハンドラの出入口処理でディスパッチ
+ *  しないようにする．
+ */
+static void
+dispatcher_0(void)
+{
+	sigset_t	sigset;
+
+	while (true) {
+		if (p_schedtsk != NULL) {
+			p_runtsk = p_schedtsk;
+#ifdef LOG_DSP_LEAVE
+			LOG_DSP_LEAVE(p_runtsk);
+#endif /* LOG_DSP_LEAVE */
+			(void) setcontext(&(p_runtsk->tskctxb.uctx));
+		}
+
+		p_runtsk = NULL;
+		intnest = 1U;
+		lock_flag = false;
+		current_iipm = IIPM_ENAALL;
+		do {
+			/*
+			 *  sigsuspendは，シグナルマスクの設定と割込み待ちをアトミッ
+			 *  クに行い，戻る時にはシグナルマスクを元（IIPM_LOCK）に戻す．
+			 */
+			make_sigmask(IIPM_ENAALL, &sigset);
+			(void) sigsuspend(&sigset);
+		} while (!reqflg);
+		reqflg = false;
+		current_iipm = IIPM_LOCK;
+		saved_iipm = IIPM_ENAALL;
+		lock_flag = true;
+		intnest = 0U;
+	}
+}
+
+/*
+ *  ディスパッチャの呼出し
+ *
+ *  p_uctxがNULLでない場合には，そこに現在のコンテキストを保存する．
+ */
+static void
+call_dispatcher(ucontext_t *p_uctx)
+{
+	makecontext(&disp_uctx, dispatcher_0, 0);
+	if (p_uctx != NULL) {
+		(void) swapcontext(p_uctx, &disp_uctx);
+	}
+	else {
+		(void) setcontext(&disp_uctx);
+	}
+}
+
+/*
+ *  最高優先順位タスクへのディスパッチ
+ *
+ *  実行すべきタスクがある場合には，ディスパッチャを経由せずに直接切り
+ *  換える．
+ */
+void
+dispatch(void)
+{
+	TCB		*p_selftsk = p_runtsk;
+
+#ifdef LOG_DSP_ENTER
+	LOG_DSP_ENTER(p_selftsk);
+#endif /* LOG_DSP_ENTER */
+	if (p_schedtsk != NULL) {
+		p_runtsk = p_schedtsk;
+#ifdef LOG_DSP_LEAVE
+		LOG_DSP_LEAVE(p_runtsk);
+#endif /* LOG_DSP_LEAVE */
+		(void) swapcontext(&(p_selftsk->tskctxb.uctx),
+										&(p_runtsk->tskctxb.uctx));
+	}
+	else {
+		call_dispatcher(&(p_selftsk->tskctxb.uctx));
+	}
+
+	/*
+	 *  ここへは，p_selftskが再び実行状態になった時に戻ってくる．
+	 */
+	if (p_runtsk->enatex && TSK_TEXPTN(p_runtsk) != 0U && ipmflg) {
+		call_texrtn();
+	}
+}
+
+/*
+ *  ディスパッチャの動作開始
+ */
+void
+start_dispatch(void)
+{
+	intnest = 0U;
+	call_dispatcher(NULL);
+	assert(false);
+	while (true);
+}
+
+/*
+ *  現在のコンテキストを捨ててディスパッチ
+ */
+void
+exit_and_dispatch(void)
+{
+#ifdef LOG_DSP_ENTER
+	LOG_DSP_ENTER(p_runtsk);
+#endif /* LOG_DSP_ENTER */
+	call_dispatcher(NULL);
+	assert(false);
+	while (true);
+}
+
+/*
+ *  カーネルの終了処理の呼出し
+ */
+void
+call_exit_kernel(void)
+{
+	intnest = 1U;
+	exit_kernel();
+	assert(false);
+	while (true);
+}
+
+/*
+ *  割込み処理の出口で必要なディスパッチとタスク例外処理ルーチンの呼出し
+ *
+ *  割込みハンドラ／CPU例外ハンドラからタスクに戻る場合に，reqflgが
+ *  セットされていれば呼び出される．iipmは，戻り先のタスクのIPMである．
+ *  dispatchからこの関数に戻ってくるのは，割り込まれたタスクが再び実行
+ *  状態になった時である．
+ */
+static void
+ret_int_dispatch(uint_t iipm)
+{
+	reqflg = false;
+	saved_iipm = iipm;
+	lock_flag = true;
+	if (dspflg && p_runtsk != p_schedtsk) {
+		dispatch();
+	}
+	else if (p_runtsk->enatex && TSK_TEXPTN(p_runtsk) != 0U && ipmflg) {
+		call_texrtn();
+	}
+	lock_flag = false;
+}
+
+/*
+ *  割込みハンドラの出入口処理
+ *
+ *  シグナルハンドラは，カーネル管理の割込みをすべてマスクした状態で実
+ *  行を開始するため，受け付けた割込みの割込み優先度までマスクを下げて
+ *  から割込みハンドラを呼び出す．
+ *
+ *  タスクに戻る場合には，シグナルハンドラからのリターン時に設定される
+ *  シグナルマスクを，戻り先のタスクのIPMに対応する値に書き換える．割
+ *  込みハンドラの中で割込み要求禁止フラグが操作された場合にも，正しく
+ *  反映されるようにするためである．
+ */
+void
+prc_int_entry(INHNO inhno, void (*inthdr)(void), void *p_uctx)
+{
+	uint_t	iipm = current_iipm;
+
+	intnest++;
+	set_iipm(int_iipm[inhno]);
+#ifdef LOG_INH_ENTER
+	LOG_INH_ENTER(inhno);
+#endif /* LOG_INH_ENTER */
+	(*inthdr)();
+#ifdef LOG_INH_LEAVE
+	LOG_INH_LEAVE(inhno);
+#endif /* LOG_INH_LEAVE */
+	set_iipm(IIPM_LOCK);
+	intnest--;
+
+	if (intnest == 0U) {
+		if (reqflg) {
+			ret_int_dispatch(iipm);
+		}
+		make_sigmask(iipm, &(((ucontext_t *) p_uctx)->uc_sigmask));
+	}
+	lock_flag = false;
+	current_iipm = iipm;
+}
+
+/*
+ *  CPU例外ハンドラの出入口処理
+ *
+ *  CPU例外がCPUロック状態で発生した場合には，CPU例外ハンドラからサー
+ *  ビスコールを呼び出せないため，ディスパッチは必要ない．
+ */
+void
+prc_exc_entry(EXCNO excno, void (*exchdr)(void *p_excinf), void *p_uctx)
+{
+	EXCINF		excinf;
+	sigset_t	sigset;
+
+	excinf.p_uctx = p_uctx;
+	excinf.intnest = intnest;
+	excinf.lock_flag = lock_flag;
+	excinf.iipm = current_iipm;
+
+	intnest++;
+#ifdef LOG_EXC_ENTER
+	LOG_EXC_ENTER(excno);
+#endif /* LOG_EXC_ENTER */
+	(*exchdr)((void *) &excinf);
+#ifdef LOG_EXC_LEAVE
+	LOG_EXC_LEAVE(excno);
+#endif /* LOG_EXC_LEAVE */
+	(void) sigprocmask(SIG_BLOCK, &(iipm_sigset[IIPM_LOCK]), &sigset);
+	intnest--;
+
+	if (intnest == 0U && !excinf.lock_flag && reqflg) {
+		current_iipm = IIPM_LOCK;
+		ret_int_dispatch(excinf.iipm);
+		make_sigmask(excinf.iipm, &(((ucontext_t *) p_uctx)->uc_sigmask));
+	}
+	current_iipm = excinf.iipm;
+}
+
+/*
+ *  微少時間待ち
+ *
+ *  sil_dly_nseは待ち状態に入らない処理であるため，nanosleepは用いず，
+ *  指定した時間が経過するまでCLOCK_MONOTONICを読みながらループする．
+ */
+void
+sil_dly_nse(ulong_t dlytim)
+{
+	struct timespec	ts;
+	uint64_t		end, now;
+
+	(void) clock_gettime(CLOCK_MONOTONIC, &ts);
+	end = (uint64_t) ts.tv_sec * 1000000000U + (uint64_t) ts.tv_nsec + dlytim;
+	do {
+		(void) clock_gettime(CLOCK_MONOTONIC, &ts);
+		now = (uint64_t) ts.tv_sec * 1000000000U + (uint64_t) ts.tv_nsec;
+	} while (now < end);
+}
+
+/*
+ *  スタートアップモジュール
+ *
+ *  カーネル管理の割込みに使えるシグナルをすべてマスクしてから，カーネ
+ *  ルを起動する．
+ */
+int
+main(void)
+{
+	sigset_t	sigset;
+
+	make_kernel_sigset(&sigset);
+	(void) sigprocmask(SIG_BLOCK, &sigset, NULL);
+	sta_ker();
+	return(0);
+}
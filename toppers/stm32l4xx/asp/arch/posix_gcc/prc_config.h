@@ -0,0 +1,521 @@
+/*
+ *  TOPPERS/ASP Kernel
+ *      Toyohashi Open Platform for Embedded Real-Time Systems/
+ *      Advanced Standard Profile Kernel
+ * 
+ *  Copyright (C) 2005-2011 by Embedded and Real-Time Systems Laboratory
+ *              Graduate School of Information Science, Nagoya Univ., JAPAN
+ *  Copyright (C) 2017-2018 by TOPPERS PROJECT Educational Working Group.
+ * 
+ *  上記著作権者は，以下の(1)〜(4)の条件を満たす場合に限り，本ソフトウェ
+ *  ア（本ソフトウェアを改変したものを含む．以下同じ）を使用・複製・改
+ *  変・再配布（以下，利用と呼ぶ）することを無償で許諾する．
+ *  (1) 本ソフトウェアをソースコードの形で利用する場合には，上記の著作
+ *      権表示，この利用条件および下記の無保証規定が，そのままの形でソー
+ *      スコード中に含まれていること．
+ *  (2) 本ソフトウェアを，ライブラリ形式など，他のソフトウェア開発に使
+ *      用できる形で再配布する場合には，再配布に伴うドキュメント（利用
+ *      者マニュアルなど）に，上記の著作権表示，この利用条件および下記
+ *      の無保証規定を掲載すること．
+ *  (3) 本ソフトウェアを，機器に組み込むなど，他のソフトウェア開発に使
+ *      用できない形で再配布する場合には，次のいずれかの条件を満たすこ
+ *      と．
+ *    (a) 再配布に伴うドキュメント（利用者マニュアルなど）に，上記の著
+ *        作権表示，この利用条件および下記の無保証規定を掲載すること．
+ *    (b) 再配布の形態を，別に定める方法によって，TOPPERSプロジェクトに
+ *        報告すること．
+ *  (4) 本ソフトウェアの利用により直接的または間接的に生じるいかなる損
+ *      害からも，上記著作権者およびTOPPERSプロジェクトを免責すること．
+ *      また，本ソフトウェアのユーザまたはエンドユーザからのいかなる理
+ *      由に基づく請求からも，上記著作権者およびTOPPERSプロジェクトを
+ *      免責すること．
+ * 
+ *  本ソフトウェアは，無保証で提供されているものである．上記著作権者お
+ *  よびTOPPERSプロジェクトは，本ソフトウェアに関して，特定の使用目的
+ *  に対する適合性も含めて，いかなる保証も行わない．また，本ソフトウェ
+ *  アの利用により直接的または間接的に生じたいかなる損害に関しても，そ
+ *  の責任を負わない．
+ * 
+ *  $Id$
+ */
+
+/*
+ *		プロセッサ依存モジュール（POSIX用）
+ *
+ *  このインクルードファイルは，target_config.h（または，そこからインク
+ *  ルードされるファイル）のみからインクルードされる．他のファイルから
+ *  直接インクルードしてはならない．
+ *
+ *  POSIX環境の1つのプロセス上でカーネルを動作させるためのプロセッサ依
+ *  存部である．割込みをシグナルで，割込み優先度マスクをシグナルマスク
+ *  で，タスクのコンテキストをucontextで模擬する．
+ */
+
+#ifndef TOPPERS_PRC_CONFIG_H
+#define TOPPERS_PRC_CONFIG_H
+
+#ifndef TOPPERS_MACRO_ONLY
+
+#include <signal.h>
+#include <ucontext.h>
+
+/*
+ *  タスクコンテキストブロックの定義
+ */
+typedef struct task_context_block {
+	ucontext_t	uctx;		/* 実行コンテキスト */
+} TSKCTXB;
+
+#endif /* TOPPERS_MACRO_ONLY */
+
+/*
+ *  割込み優先度マスク操作ライブラリ
+ *
+ *  ハードウェアの割込み優先度マスク（IPM）に相当するものとして，割込み
+ *  優先度毎に，その割込み優先度以下の割込み（シグナル）をすべて含むシ
+ *  グナル集合（iipm_sigset）を用意し，それをシグナルマスクに設定する．
+ *  割込み優先度マスクの内部表現（IIPM）は，外部表現の符号を反転した値
+ *  （0〜7）とし，iipm_sigsetの添え字に用いる．
+ *
+ *  シグナルマスクからIPMを読み出すことはできないため，現在のIPMは変数
+ *  （current_iipm）で保持する．
+ */
+
+/*
+ *  割込み優先度マスクの外部表現と内部表現の変換
+ */
+#define EXT_IPM(iipm)	(-CAST(PRI, iipm))			/* 外部表現に変換 */
+#define INT_IPM(ipm)	(CAST(uint_t, -(ipm)))		/* 内部表現に変換 */
+
+/*
+ *  CPUロック状態での割込み優先度マスク
+ *
+ *  TIPM_LOCKは，CPUロック状態での割込み優先度マスク（IPM）であり，カー
+ *  ネル管理の割込みをすべてマスクする．
+ */
+#define TIPM_LOCK		TMIN_INTPRI
+
+/*
+ *  CPUロック状態での割込み優先度マスクの内部表現
+ */
+#define IIPM_LOCK		INT_IPM(TIPM_LOCK)
+
+/*
+ *  TIPM_ENAALL（割込み優先度マスク全解除）の内部表現
+ */
+#define IIPM_ENAALL		INT_IPM(TIPM_ENAALL)
+
+/*
+ *  シグナル番号の上限
+ *
+ *  割込み番号（シグナル番号）を添え字とする表の大きさに用いる．
+ */
+#define TNUM_SIGNO		50U
+
+#ifndef TOPPERS_MACRO_ONLY
+
+/*
+ *  IPM（ハードウェアの割込み優先度マスク，内部表現）の現在値を保持す
+ *  る変数
+ */
+extern volatile uint_t	current_iipm;
+
+/*
+ *  IPM（ハードウェアの割込み優先度マスク，内部表現）の設定（prc_config.c）
+ *
+ *  current_iipmを更新し，iipmに対応するシグナル集合と，割込み要求禁止
+ *  フラグがセットされた割込みの集合の和をシグナルマスクに設定する．
+ */
+extern void	set_iipm(uint_t iipm);
+
+/*
+ *  割込みのネスト段数
+ *
+ *  割込みハンドラ（シグナルハンドラ）の実行中は1以上になる．非タスク
+ *  コンテキストの判定に用いる．
+ */
+extern volatile uint_t	intnest;
+
+/*
+ *  コンテキストの参照
+ */
+Inline bool_t
+sense_context(void)
+{
+	return(intnest > 0U);
+}
+
+/*
+ *  TOPPERS標準割込み処理モデルの実現
+ *
+ *  M68040用のプロセッサ依存部と同様に，CPUロックフラグの機能をIPMによっ
+ *  て実現する．CPUロックフラグの値は変数（lock_flag）で，CPUロック状態
+ *  の間のモデル上の割込み優先度マスクは変数（saved_iipm）で保持する．
+ *
+ *  CPUロック状態の間のIPMはIIPM_LOCKであり，カーネル管理の割込み（シ
+ *  グナル）はすべてマスクされる．全割込みロック状態は，すべてのシグナ
+ *  ルをマスクすることで実現する（prc_sil.h）．
+ */
+
+/*
+ *  CPUロックフラグ実現のための変数
+ *
+ *  これらの変数は，CPUロック状態の時のみ書き換えてよいものとする．
+ */
+extern volatile bool_t	lock_flag;	/* CPUロックフラグの値を保持する変数 */
+extern volatile uint_t	saved_iipm;	/* 割込み優先度マスクを保存する変数 */
+
+/*
+ *  CPUロック状態への移行
+ *
+ *  IPMをsaved_iipmに保存し，IIPM_LOCKに設定する．また，lock_flagを
+ *  trueにする．IPMがIIPM_LOCKに設定済みの場合には，シグナルマスクを変
+ *  更するシステムコールを省略する．
+ */
+Inline void
+x_lock_cpu(void)
+{
+	uint_t	iipm;
+
+	iipm = current_iipm;
+	if (IIPM_LOCK > iipm) {
+		set_iipm(IIPM_LOCK);
+	}
+	saved_iipm = iipm;
+	lock_flag = true;
+	Asm("":::"memory");
+}
+
+#define t_lock_cpu()	x_lock_cpu()
+#define i_lock_cpu()	x_lock_cpu()
+
+/*
+ *  CPUロック状態の解除
+ *
+ *  lock_flagをfalseにし，IPMを，saved_iipmに保存した値に戻す．
+ */
+Inline void
+x_unlock_cpu(void)
+{
+	Asm("":::"memory");
+	lock_flag = false;
+	if (saved_iipm != current_iipm) {
+		set_iipm(saved_iipm);
+	}
+}
+
+#define t_unlock_cpu()	x_unlock_cpu()
+#define i_unlock_cpu()	x_unlock_cpu()
+
+/*
+ *  CPUロック状態の参照
+ */
+Inline bool_t
+x_sense_lock(void)
+{
+	return(lock_flag);
+}
+
+#define t_sense_lock()	x_sense_lock()
+#define i_sense_lock()	x_sense_lock()
+
+/*
+ * （モデル上の）割込み優先度マスクの設定
+ *
+ *  CPUロック状態の間は，IPMが必ずIIPM_LOCKに設定されているため，
+ *  saved_iipmのみを設定する．
+ */
+Inline void
+x_set_ipm(PRI intpri)
+{
+	uint_t	iipm = INT_IPM(intpri);
+
+	if (!lock_flag) {
+		set_iipm(iipm);
+	}
+	else {
+		saved_iipm = iipm;
+	}
+}
+
+#define t_set_ipm(intpri)	x_set_ipm(intpri)
+#define i_set_ipm(intpri)	x_set_ipm(intpri)
+
+/*
+ * （モデル上の）割込み優先度マスクの参照
+ */
+Inline PRI
+x_get_ipm(void)
+{
+	uint_t	iipm;
+
+	if (!lock_flag) {
+		iipm = current_iipm;
+	}
+	else {
+		iipm = saved_iipm;
+	}
+	return(EXT_IPM(iipm));
+}
+
+#define t_get_ipm()		x_get_ipm()
+#define i_get_ipm()		x_get_ipm()
+
+/*
+ *  割込み番号・割込みハンドラ番号・CPU例外ハンドラ番号の範囲の判定
+ *
+ *  SIGRTMINは，glibcがスレッドの実装に使うシグナルを除いた値（通常は
+ *  34）である．prc_initializeで，SIGRTMIN+15がSIGRTMAXを越えないこと
+ *  をチェックしている．
+ */
+#define VALID_INTNO(intno)	((intno) == TINTNO_USR1 || (intno) == TINTNO_USR2 \
+								|| (intno) == TINTNO_ALRM || (intno) == TINTNO_IO \
+								|| (TINTNO_RT(0) <= (intno) \
+										&& (intno) <= TINTNO_RT(15)))
+#define VALID_INTNO_CREISR(intno)	VALID_INTNO(intno)
+#define VALID_INTNO_DISINT(intno)	VALID_INTNO(intno)
+#define VALID_INTNO_CFGINT(intno)	VALID_INTNO(intno)
+#define VALID_INHNO_DEFINH(inhno)	VALID_INTNO(inhno)
+#define VALID_EXCNO_DEFEXC(excno)	((excno) == TEXCNO_ILL \
+								|| (excno) == TEXCNO_TRAP || (excno) == TEXCNO_BUS \
+								|| (excno) == TEXCNO_FPE || (excno) == TEXCNO_SEGV)
+
+/*
+ *  割込み要求禁止フラグのセット（prc_config.c）
+ *
+ *  割込み要求禁止フラグは，シグナルマスクに常に加えるシグナル集合で模
+ *  擬する．割込み属性が設定されていない割込みに対しては，falseを返す．
+ */
+extern bool_t	x_disable_int(INTNO intno);
+
+#define t_disable_int(intno)	x_disable_int(intno)
+#define i_disable_int(intno)	x_disable_int(intno)
+
+/*
+ *  割込み要求禁止フラグのクリア（prc_config.c）
+ */
+extern bool_t	x_enable_int(INTNO intno);
+
+#define t_enable_int(intno)		x_enable_int(intno)
+#define i_enable_int(intno)		x_enable_int(intno)
+
+/*
+ *  割込み要求のクリア（prc_config.c）
+ *
+ *  保留中のシグナルを破棄する．
+ */
+extern void	x_clear_int(INTNO intno);
+
+#define t_clear_int(intno)		x_clear_int(intno)
+#define i_clear_int(intno)		x_clear_int(intno)
+
+/*
+ *  割込み要求のチェック
+ *
+ *  シグナルが保留中であるかを調べる．
+ */
+Inline bool_t
+x_probe_int(INTNO intno)
+{
+	sigset_t	sigset;
+
+	(void) sigpending(&sigset);
+	return(sigismember(&sigset, (int) intno) == 1);
+}
+
+#define t_probe_int(intno)		x_probe_int(intno)
+#define i_probe_int(intno)		x_probe_int(intno)
+
+/*
+ *  割込み要求ラインの属性の設定（prc_config.c）
+ */
+extern void	x_config_int(INTNO intno, ATR intatr, PRI intpri);
+
+/*
+ *  割込みハンドラの入口と出口で必要な処理
+ *
+ *  シグナルの受付けによって割込み要求はクリアされるため，必要な処理は
+ *  ない．
+ */
+Inline void
+i_begin_int(INTNO intno)
+{
+}
+
+Inline void
+i_end_int(INTNO intno)
+{
+}
+
+/*
+ *  最高優先順位タスクへのディスパッチ（prc_config.c）
+ *
+ *  dispatchは，タスクコンテキストから呼び出されたサービスコール処理か
+ *  ら呼び出すべきもので，タスクコンテキスト・CPUロック状態・ディスパッ
+ *  チ許可状態・（モデル上の）割込み優先度マスク全解除状態で呼び出さな
+ *  ければならない．
+ */
+extern void	dispatch(void);
+
+/*
+ *  ディスパッチャの動作開始（prc_config.c）
+ *
+ *  start_dispatchは，カーネル起動時に呼び出すべきもので，カーネル管理
+ *  の割込みをすべてマスクした状態で呼び出さなければならない．
+ */
+extern void	start_dispatch(void) NoReturn;
+
+/*
+ *  現在のコンテキストを捨ててディスパッチ（prc_config.c）
+ *
+ *  exit_and_dispatchは，ext_tskから呼び出すべきもので，タスクコンテキ
+ *  スト・CPUロック状態・ディスパッチ許可状態・（モデル上の）割込み優先
+ *  度マスク全解除状態で呼び出さなければならない．
+ */
+extern void	exit_and_dispatch(void) NoReturn;
+
+/*
+ *  カーネルの終了処理の呼出し（prc_config.c）
+ *
+ *  call_exit_kernelは，カーネルの終了時に呼び出すべきもので，非タスク
+ *  コンテキストに切り換えて，カーネルの終了処理（exit_kernel）を呼び出
+ *  す．
+ */
+extern void call_exit_kernel(void) NoReturn;
+
+/*
+ *  タスクコンテキストの初期化（prc_config.c）
+ *
+ *  タスクが休止状態から実行できる状態に移行する時に呼ばれる．ucontext
+ *  の雛形をコピーし，スタック領域を設定して，タスクの起動番地として
+ *  start_rを設定する．
+ *
+ *  activate_contextを，インライン関数ではなくマクロ定義としているのは，
+ *  この時点ではTCBが定義されていないためである．
+ */
+extern void	start_r(void);
+extern void	prc_activate_context(TSKCTXB *p_tskctxb, void *stk, SIZE stksz);
+
+#define activate_context(p_tcb)											\
+{																		\
+	prc_activate_context(&((p_tcb)->tskctxb), get_tinib(p_tcb)->stk,	\
+											get_tinib(p_tcb)->stksz);	\
+}
+
+/*
+ *  calltexは使用しない
+ */
+#define OMIT_CALLTEX
+
+/*
+ *  割込みハンドラの設定（prc_config.c）
+ *
+ *  シグナルinhnoのシグナルハンドラとして，割込みハンドラの出入口処理
+ *  int_entryを登録する．
+ */
+extern void	x_define_inh(INHNO inhno, FP int_entry);
+
+/*
+ *  CPU例外ハンドラの設定（prc_config.c）
+ */
+extern void	x_define_exc(EXCNO excno, FP exc_entry);
+
+/*
+ *  割込みハンドラの出入口処理（prc_config.c）
+ *
+ *  シグナルハンドラから呼び出され，割込みハンドラinthdrを呼び出した後，
+ *  必要であればディスパッチとタスク例外処理ルーチンの呼出しを行う．
+ *  p_uctxには，シグナルハンドラの第3引数を渡す．
+ */
+extern void	prc_int_entry(INHNO inhno, void (*inthdr)(void), void *p_uctx);
+
+/*
+ *  CPU例外ハンドラの出入口処理（prc_config.c）
+ */
+extern void	prc_exc_entry(EXCNO excno, void (*exchdr)(void *p_excinf),
+															void *p_uctx);
+
+/*
+ *  出入口処理に渡すシグナルハンドラの第3引数（prc_config.c）
+ */
+extern void	*prc_p_uctx;
+
+/*
+ *  割込みハンドラの出入口処理の生成
+ *
+ *  シグナルハンドラ（prc_config.c中のsig_handler）から呼び出される関
+ *  数を生成する．シグナルハンドラの第3引数は，prc_p_uctxから読み出す．
+ *  kernel_cfg.cでは名前の置換えが解除されているため，出入口処理は置換
+ *  え後の名前で呼び出す．
+ */
+#define INT_ENTRY(inhno, inthdr)	_kernel_##inthdr##_##inhno
+
+#define INTHDR_ENTRY(inhno, inhno_num, inthdr) \
+static void _kernel_##inthdr##_##inhno(void) \
+{ \
+	_kernel_prc_int_entry(inhno_num, inthdr, _kernel_prc_p_uctx); \
+}
+
+/*
+ *  CPU例外ハンドラの出入口処理の生成
+ */
+#define EXC_ENTRY(excno, exchdr)	_kernel_##exchdr##_##excno
+
+#define EXCHDR_ENTRY(excno, excno_num, exchdr) \
+static void _kernel_##exchdr##_##excno(void) \
+{ \
+	_kernel_prc_exc_entry(excno_num, exchdr, _kernel_prc_p_uctx); \
+}
+
+/*
+ *  CPU例外の情報
+ *
+ *  CPU例外ハンドラに渡すp_excinfは，この構造体を指す．CPU例外の発生し
+ *  た時点のシステム状態を保持する．
+ */
+typedef struct exception_information {
+	void	*p_uctx;		/* シグナルハンドラに渡されたucontext */
+	uint_t	intnest;		/* 割込みのネスト段数 */
+	bool_t	lock_flag;		/* CPUロックフラグ */
+	uint_t	iipm;			/* IPM（内部表現） */
+} EXCINF;
+
+/*
+ *  CPU例外の発生した時のコンテキストの参照
+ *
+ *  CPU例外の発生した時のコンテキストが，タスクコンテキストの時にfalse，
+ *  そうでない時にtrueを返す．
+ */
+Inline bool_t
+exc_sense_context(void *p_excinf)
+{
+	return(((EXCINF *) p_excinf)->intnest > 0U);
+}
+
+/*
+ *  CPU例外の発生した時のコンテキストと割込みのマスク状態の参照
+ *
+ *  CPU例外の発生した時のシステム状態が，カーネル実行中でなく，タスクコ
+ *  ンテキストであり，CPUロック状態でなく，割込み優先度マスク全解除状
+ *  態である時にtrue，そうでない時にfalseを返す．
+ */
+Inline bool_t
+exc_sense_intmask(void *p_excinf)
+{
+	return(!exc_sense_context(p_excinf)
+				&& !((EXCINF *) p_excinf)->lock_flag
+				&& ((EXCINF *) p_excinf)->iipm == IIPM_ENAALL);
+}
+
+/*
+ *  プロセッサ依存の初期化
+ */
+extern void	prc_initialize(void);
+
+/*
+ *  プロセッサ依存の終了時処理
+ */
+extern void	prc_terminate(void);
+
+#endif /* TOPPERS_MACRO_ONLY */
+#endif /* TOPPERS_PRC_CONFIG_H */
@@ -0,0 +1,92 @@
+/*
+ *  TOPPERS/ASP Kernel
+ *      Toyohashi Open Platform for Embedded Real-Time Systems/
+ *      Advanced Standard Profile Kernel
+ * 
+ *  Copyright (C) 2005-2011 by Embedded and Real-Time Systems Laboratory
+ *              Graduate School of Information Science, Nagoya Univ., JAPAN
+ *  Copyright (C) 2017-2018 by TOPPERS PROJECT Educational Working Group.
+ * 
+ *  上記著作権者は，以下の(1)〜(4)の条件を満たす場合に限り，本ソフトウェ
+ *  ア（本ソフトウェアを改変したものを含む．以下同じ）を使用・複製・改
+ *  変・再配布（以下，利用と呼ぶ）することを無償で許諾する．
+ *  (1) 本ソフトウェアをソースコードの形で利用する場合には，上記の著作
+ *      権表示，この利用条件および下記の無保証規定が，そのままの形でソー
+ *      スコード中に含まれていること．
+ *  (2) 本ソフトウェアを，ライブラリ形式など，他のソフトウェア開発に使
+ *      用できる形で再配布する場合には，再配布に伴うドキュメント（利用
+ *      者マニュアルなど）に，上記の著作権表示，この利用条件および下記
+ *      の無保証規定を掲載すること．
+ *  (3) 本ソフトウェアを，機器に組み込むなど，他のソフトウェア開発に使
+ *      用できない形で再配布する場合には，次のいずれかの条件を満たすこ
+ *      と．
+ *    (a) 再配布に伴うドキュメント（利用者マニュアルなど）に，上記の著
+ *        作権表示，この利用条件および下記の無保証規定を掲載すること．
+ *    (b) 再配布の形態を，別に定める方法によって，TOPPERSプロジェクトに
+ *        報告すること．
+ *  (4) 本ソフトウェアの利用により直接的または間接的に生じるいかなる損
+ *      害からも，上記著作権者およびTOPPERSプロジェクトを免責すること．
+ *      また，本ソフトウェアのユーザまたはエンドユーザからのいかなる理
+ *      由に基づく請求からも，上記著作権者およびTOPPERSプロジェクトを
+ *      免責すること．
+ * 
+ *  本ソフトウェアは，無保証で提供されているものである．上記著作権者お
+ *  よびTOPPERSプロジェクトは，本ソフトウェアに関して，特定の使用目的
+ *  に対する適合性も含めて，いかなる保証も行わない．また，本ソフトウェ
+ *  アの利用により直接的または間接的に生じたいかなる損害に関しても，そ
+ *  の責任を負わない．
+ * 
+ *  $Id$
+ */
+
+/*
+ *		kernel.hのプロセッサ依存部（POSIX用）
+ *
+ *  このインクルードファイルは，target_kernel.h（または，そこからインク
+ *  ルードされるファイル）のみからインクルードされる．他のファイルから
+ *  直接インクルードしてはならない．
+ */
+
+#ifndef TOPPERS_PRC_KERNEL_H
+#define TOPPERS_PRC_KERNEL_H
+
+/*
+ *  サポートする機能の定義
+ */
+#define TOPPERS_TARGET_SUPPORT_DIS_INT		/* dis_int */
+#define TOPPERS_TARGET_SUPPORT_ENA_INT		/* ena_int */
+
+/*
+ *  割込み優先度の範囲
+ *
+ *  割込み優先度マスクはシグナルマスクで模擬するため，割込み優先度の段
+ *  数に制約はないが，M68040と同じ7段階としている．
+ */
+#define TMIN_INTPRI		(-7)		/* 割込み優先度の最小値（最高値）*/
+#define TMAX_INTPRI		(-1)		/* 割込み優先度の最大値（最低値） */
+
+/*
+ *  割込み番号の定義
+ *
+ *  割込み番号と割込みハンドラ番号には，シグナル番号（Linuxでの値）を
+ *  そのまま用いる．カーネル管理の割込みとして使えるのは，以下のシグナ
+ *  ルである．
+ */
+#define TINTNO_USR1		10U			/* SIGUSR1 */
+#define TINTNO_USR2		12U			/* SIGUSR2 */
+#define TINTNO_ALRM		14U			/* SIGALRM */
+#define TINTNO_IO		29U			/* SIGIO */
+#define TINTNO_RT(n)	(34U + (n))	/* SIGRTMIN+n（0≦n≦15） */
+
+/*
+ *  CPU例外ハンドラ番号の定義
+ *
+ *  CPU例外ハンドラ番号にも，同期シグナルのシグナル番号を用いる．
+ */
+#define TEXCNO_ILL		4U			/* SIGILL */
+#define TEXCNO_TRAP		5U			/* SIGTRAP */
+#define TEXCNO_BUS		7U			/* SIGBUS */
+#define TEXCNO_FPE		8U			/* SIGFPE */
+#define TEXCNO_SEGV		11U			/* SIGSEGV */
+
+#endif /* TOPPERS_PRC_KERNEL_H */
@@ -0,0 +1,63 @@
+/* This file is generated from prc_rename.def by genrename. */
+
+#ifndef TOPPERS_PRC_RENAME_H
+#define TOPPERS_PRC_RENAME_H
+
+/*
+ *  prc_config.c
+ */
+#define lock_flag					_kernel_lock_flag
+#define saved_iipm					_kernel_saved_iipm
+#define current_iipm				_kernel_current_iipm
+#define intnest						_kernel_intnest
+#define set_iipm					_kernel_set_iipm
+#define prc_initialize				_kernel_prc_initialize
+#define prc_terminate				_kernel_prc_terminate
+#define x_config_int				_kernel_x_config_int
+#define x_disable_int				_kernel_x_disable_int
+#define x_enable_int				_kernel_x_enable_int
+#define x_clear_int					_kernel_x_clear_int
+#define x_define_inh				_kernel_x_define_inh
+#define x_define_exc				_kernel_x_define_exc
+#define prc_activate_context		_kernel_prc_activate_context
+#define start_r						_kernel_start_r
+#define dispatch					_kernel_dispatch
+#define start_dispatch				_kernel_start_dispatch
+#define exit_and_dispatch			_kernel_exit_and_dispatch
+#define call_exit_kernel			_kernel_call_exit_kernel
+#define prc_int_entry				_kernel_prc_int_entry
+#define prc_exc_entry				_kernel_prc_exc_entry
+#define prc_p_uctx					_kernel_prc_p_uctx
+
+#ifdef TOPPERS_LABEL_ASM
+
+/*
+ *  prc_config.c
+ */
+#define _lock_flag					__kernel_lock_flag
+#define _saved_iipm					__kernel_saved_iipm
+#define _current_iipm				__kernel_current_iipm
+#define _intnest					__kernel_intnest
+#define _set_iipm					__kernel_set_iipm
+#define _prc_initialize				__kernel_prc_initialize
+#define _prc_terminate				__kernel_prc_terminate
+#define _x_config_int				__kernel_x_config_int
+#define _x_disable_int				__kernel_x_disable_int
+#define _x_enable_int				__kernel_x_enable_int
+#define _x_clear_int				__kernel_x_clear_int
+#define _x_define_inh				__kernel_x_define_inh
+#define _x_define_exc				__kernel_x_define_exc
+#define _prc_activate_context		__kernel_prc_activate_context
+#define _start_r					__kernel_start_r
+#define _dispatch					__kernel_dispatch
+#define _start_dispatch				__kernel_start_dispatch
+#define _exit_and_dispatch			__kernel_exit_and_dispatch
+#define _call_exit_kernel			__kernel_call_exit_kernel
+#define _prc_int_entry				__kernel_prc_int_entry
+#define _prc_exc_entry				__kernel_prc_exc_entry
+#define _prc_p_uctx					__kernel_prc_p_uctx
+
+#endif /* TOPPERS_LABEL_ASM */
+
+
+#endif /* TOPPERS_PRC_RENAME_H */
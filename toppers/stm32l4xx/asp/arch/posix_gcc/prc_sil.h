@@ -0,0 +1,95 @@
+/*
+ *  TOPPERS/ASP Kernel
+ *      Toyohashi Open Platform for Embedded Real-Time Systems/
+ *      Advanced Standard Profile Kernel
+ * 
+ *  Copyright (C) 2005-2011 by Embedded and Real-Time Systems Laboratory
+ *              Graduate School of Information Science, Nagoya Univ., JAPAN
+ *  Copyright (C) 2017-2018 by TOPPERS PROJECT Educational Working Group.
+ * 
+ *  上記著作権者は，以下の(1)〜(4)の条件を満たす場合に限り，本ソフトウェ
+ *  ア（本ソフトウェアを改変したものを含む．以下同じ）を使用・複製・改
+ *  変・再配布（以下，利用と呼ぶ）することを無償で許諾する．
+ *  (1) 本ソフトウェアをソースコードの形で利用する場合には，上記の著作
+ *      権表示，この利用条件および下記の無保証規定が，そのままの形でソー
+ *      スコード中に含まれていること．
+ *  (2) 本ソフトウェアを，ライブラリ形式など，他のソフトウェア開発に使
+ *      用できる形で再配布する場合には，再配布に伴うドキュメント（利用
+ *      者マニュアルなど）に，上記の著作権表示，この利用条件および下記
+ *      の無保証規定を掲載すること．
+ *  (3) 本ソフトウェアを，機器に組み込むなど，他のソフトウェア開発に使
+ *      用できない形で再配布する場合には，次のいずれかの条件を満たすこ
+ *      と．
+ *    (a) 再配布に伴うドキュメント（利用者マニュアルなど）に，上記の著
+ *        作権表示，この利用条件および下記の無保証規定を掲載すること．
+ *    (b) 再配布の形態を，別に定める方法によって，TOPPERSプロジェクトに
+ *        報告すること．
+ *  (4) 本ソフトウェアの利用により直接的または間接的に生じるいかなる損
+ *      害からも，上記著作権者およびTOPPERSプロジェクトを免責すること．
+ *      また，本ソフトウェアのユーザまたはエンドユーザからのいかなる理
+ *      由に基づく請求からも，上記著作権者およびTOPPERSプロジェクトを
+ *      免責すること．
+ * 
+ *  本ソフトウェアは，無保証で提供されているものである．上記著作権者お
+ *  よびTOPPERSプロジェクトは，本ソフトウェアに関して，特定の使用目的
+ *  に対する適合性も含めて，いかなる保証も行わない．また，本ソフトウェ
+ *  アの利用により直接的または間接的に生じたいかなる損害に関しても，そ
+ *  の責任を負わない．
+ * 
+ *  $Id$
+ */
+
+/*
+ *		sil.hのプロセッサ依存部（POSIX用）
+ */
+
+#ifndef TOPPERS_PRC_SIL_H
+#define TOPPERS_PRC_SIL_H
+
+#ifndef TOPPERS_MACRO_ONLY
+
+#include <signal.h>
+
+/*
+ *  すべての割込み（シグナル）をマスク
+ *
+ *  全割込みロック状態は，すべてのシグナルをブロックすることで実現する．
+ *  元のシグナルマスクは，*p_sigmaskに返す．
+ */
+Inline void
+TOPPERS_disint(sigset_t *p_sigmask)
+{
+	sigset_t	TOPPERS_allset;
+
+	(void) sigfillset(&TOPPERS_allset);
+	(void) sigprocmask(SIG_BLOCK, &TOPPERS_allset, p_sigmask);
+}
+
+/*
+ *  シグナルマスクの設定
+ */
+Inline void
+TOPPERS_set_sigmask(const sigset_t *p_sigmask)
+{
+	(void) sigprocmask(SIG_SETMASK, p_sigmask, NULL);
+}
+
+/*
+ *  全割込みロック状態の制御
+ */
+#define SIL_PRE_LOC		sigset_t TOPPERS_sigmask
+#define SIL_LOC_INT()	TOPPERS_disint(&TOPPERS_sigmask)
+#define SIL_UNL_INT()	TOPPERS_set_sigmask(&TOPPERS_sigmask)
+
+#endif /* TOPPERS_MACRO_ONLY */
+
+/*
+ *  プロセッサのエンディアン
+ */
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define SIL_ENDIAN_BIG				/* ビッグエンディアン */
+#else /* __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__ */
+#define SIL_ENDIAN_LITTLE			/* リトルエンディアン */
+#endif /* __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__ */
+
+#endif /* TOPPERS_PRC_SIL_H */
@@ -0,0 +1,64 @@
+/* This file is generated from prc_rename.def by genrename. */
+
+/* This file is included only when prc_rename.h has been included. */
+#ifdef TOPPERS_PRC_RENAME_H
+#undef TOPPERS_PRC_RENAME_H
+
+/*
+ *  prc_config.c
+ */
+#undef lock_flag
+#undef saved_iipm
+#undef current_iipm
+#undef intnest
+#undef set_iipm
+#undef prc_initialize
+#undef prc_terminate
+#undef x_config_int
+#undef x_disable_int
+#undef x_enable_int
+#undef x_clear_int
+#undef x_define_inh
+#undef x_define_exc
+#undef prc_activate_context
+#undef start_r
+#undef dispatch
+#undef start_dispatch
+#undef exit_and_dispatch
+#undef call_exit_kernel
+#undef prc_int_entry
+#undef prc_exc_entry
+#undef prc_p_uctx
+
+#ifdef TOPPERS_LABEL_ASM
+
+/*
+ *  prc_config.c
+ */
+#undef _lock_flag
+#undef _saved_iipm
+#undef _current_iipm
+#undef _intnest
+#undef _set_iipm
+#undef _prc_initialize
+#undef _prc_terminate
+#undef _x_config_int
+#undef _x_disable_int
+#undef _x_enable_int
+#undef _x_clear_int
+#undef _x_define_inh
+#undef _x_define_exc
+#undef _prc_activate_context
+#undef _start_r
+#undef _dispatch
+#undef _start_dispatch
+#undef _exit_and_dispatch
+#undef _call_exit_kernel
+#undef _prc_int_entry
+#undef _prc_exc_entry
+#undef _prc_p_uctx
+
+#endif /* TOPPERS_LABEL_ASM */
+
+
+#endif /* TOPPERS_PRC_RENAME_H */
@@ -86,6 +86,10 @@ typedef	uint_t		INTNO;		/* 割込み番号 */
 typedef	uint_t		INHNO;		/* 割込みハンドラ番号 */
 typedef	uint_t		EXCNO;		/* CPU例外ハンドラ番号 */
 
+#ifdef TOPPERS_TARGET_SUPPORT_GET_UTM64
+typedef	uint64_t	SYSUTM64;	/* 64ビットの性能評価用システム時刻 */
+#endif /* TOPPERS_TARGET_SUPPORT_GET_UTM64 */
+
 /*
  *  処理単位の型定義
  */
@@ -392,6 +396,9 @@ extern ER		ref_mpf(ID mpfid, T_RMPF *pk_rmpf) throw();
  */
 extern ER		get_tim(SYSTIM *p_systim) throw();
 extern ER		get_utm(SYSUTM *p_sysutm) throw();
+#ifdef TOPPERS_TARGET_SUPPORT_GET_UTM64
+extern ER		get_utm64(SYSUTM64 *p_sysutm64) throw();
+#endif /* TOPPERS_TARGET_SUPPORT_GET_UTM64 */
 
 extern ER_ID	acre_cyc(const T_CCYC *pk_ccyc) throw();
 extern ER		del_cyc(ID cycid) throw();
@@ -529,6 +536,10 @@ extern bool_t	xsns_xpn(void *p_excinf) throw();
 #define TOPPERS_SUPPORT_GET_UTM			/* get_utmがサポートされている */
 #endif /* TOPPERS_TARGET_SUPPORT_GET_UTM */
 
+#ifdef TOPPERS_TARGET_SUPPORT_GET_UTM64
+#define TOPPERS_SUPPORT_GET_UTM64		/* get_utm64がサポートされている */
+#endif /* TOPPERS_TARGET_SUPPORT_GET_UTM64 */
+
 #define TOPPERS_SUPPORT_DYNAMIC_CRE		/* 動的生成機能拡張 */
 
 /*
@@ -208,6 +208,7 @@
 /* time_manage.c */
 #define TOPPERS_get_tim
 #define TOPPERS_get_utm
+#define TOPPERS_get_utm64
 
 /* cyclic.c */
 #define TOPPERS_cycini
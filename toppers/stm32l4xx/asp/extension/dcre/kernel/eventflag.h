@@ -49,6 +49,16 @@
 
 #include "wait.h"
 
+/*
+ *  イベントフラグの待ちインデックスのサポート
+ *
+ *  動的生成対応カーネルは，TOPPERS_FLG_WAIT_INDEXによるイベントフラグ
+ *  の待ちインデックスをサポートしていない．
+ */
+#ifdef TOPPERS_FLG_WAIT_INDEX
+#error TOPPERS_FLG_WAIT_INDEX is not supported with dynamic creation.
+#endif /* TOPPERS_FLG_WAIT_INDEX */
+
 /*
  *  イベントフラグ初期化ブロック
  *
@@ -49,6 +49,16 @@
 
 #include "wait.h"
 
+/*
+ *  メッセージの優先度ごとのキューのサポート
+ *
+ *  動的生成対応カーネルは，TOPPERS_MBX_PRI_QUEUEによるメッセージの優
+ *  先度ごとのキューをサポートしていない．
+ */
+#ifdef TOPPERS_MBX_PRI_QUEUE
+#error TOPPERS_MBX_PRI_QUEUE is not supported with dynamic creation.
+#endif /* TOPPERS_MBX_PRI_QUEUE */
+
 /*
  *  メールボックス初期化ブロック
  *
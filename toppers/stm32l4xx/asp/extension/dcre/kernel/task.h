@@ -50,6 +50,16 @@
 #include <queue.h>
 #include "time_event.h"
 
+/*
+ *  TCBの縮小のサポート
+ *
+ *  動的生成対応カーネルは，TOPPERS_COMPACT_TCBによるTCBの縮小をサポート
+ *  していない．
+ */
+#ifdef TOPPERS_COMPACT_TCB
+#error TOPPERS_COMPACT_TCB is not supported with dynamic creation.
+#endif /* TOPPERS_COMPACT_TCB */
+
 /*
  *  トレースログマクロのデフォルト定義
  */
@@ -381,6 +391,12 @@ extern TCB	tcb_table[];
  */
 #define	TSKID(p_tcb)	((ID)(((p_tcb) - tcb_table) + TMIN_TSKID))
 
+/*
+ *  TCBからタスク初期化ブロックと保留例外要因を参照するためのマクロ
+ */
+#define get_tinib(p_tcb)	((p_tcb)->p_tinib)
+#define TSK_TEXPTN(p_tcb)	((p_tcb)->texptn)
+
 /*
  *  タスク管理モジュールの初期化
  */
@@ -86,6 +86,10 @@ typedef	uint_t		INTNO;		/* 割込み番号 */
 typedef	uint_t		INHNO;		/* 割込みハンドラ番号 */
 typedef	uint_t		EXCNO;		/* CPU例外ハンドラ番号 */
 
+#ifdef TOPPERS_TARGET_SUPPORT_GET_UTM64
+typedef	uint64_t	SYSUTM64;	/* 64ビットの性能評価用システム時刻 */
+#endif /* TOPPERS_TARGET_SUPPORT_GET_UTM64 */
+
 /*
  *  処理単位の型定義
  */
@@ -124,6 +128,18 @@ typedef	struct t_msg_pri {		/* 優先度付きメッセージヘッダ */
 	PRI		msgpri;				/* メッセージ優先度 */
 } T_MSG_PRI;
 
+#ifdef TOPPERS_WAIT_OBJ
+/*
+ *  複数オブジェクト待ちの待ち対象の型定義
+ */
+typedef struct t_wobj {
+	uint_t	objtyp;		/* オブジェクトの種類 */
+	ID		objid;		/* オブジェクトのID番号 */
+	FLGPTN	waiptn;		/* 待ちビットパターン（イベントフラグの場合）*/
+	MODE	wfmode;		/* 待ちモード（イベントフラグの場合）*/
+} T_WOBJ;
+#endif /* TOPPERS_WAIT_OBJ */
+
 /*
  *  パケット形式の定義
  */
@@ -296,6 +312,10 @@ extern ER		trcv_mbx(ID mbxid, T_MSG **ppk_msg, TMO tmout) throw();
 extern ER		ini_mbx(ID mbxid) throw();
 extern ER		ref_mbx(ID mbxid, T_RMBX *pk_rmbx) throw();
 
+#ifdef TOPPERS_WAIT_OBJ
+extern ER_UINT	twai_obj(const T_WOBJ *p_wobj, uint_t nobj, TMO tmout) throw();
+#endif /* TOPPERS_WAIT_OBJ */
+
 extern ER		snd_mbf(ID mbfid, const void *msg, uint_t msgsz) throw();
 extern ER		psnd_mbf(ID mbfid, const void *msg, uint_t msgsz) throw();
 extern ER		tsnd_mbf(ID mbfid, const void *msg,
@@ -321,6 +341,9 @@ extern ER		ref_mpf(ID mpfid, T_RMPF *pk_rmpf) throw();
  */
 extern ER		get_tim(SYSTIM *p_systim) throw();
 extern ER		get_utm(SYSUTM *p_sysutm) throw();
+#ifdef TOPPERS_TARGET_SUPPORT_GET_UTM64
+extern ER		get_utm64(SYSUTM64 *p_sysutm64) throw();
+#endif /* TOPPERS_TARGET_SUPPORT_GET_UTM64 */
 
 extern ER		sta_cyc(ID cycid) throw();
 extern ER		stp_cyc(ID cycid) throw();
@@ -392,6 +415,12 @@ extern bool_t	xsns_xpn(void *p_excinf) throw();
 #define TWF_ORW			UINT_C(0x01)	/* イベントフラグのOR待ち */
 #define TWF_ANDW		UINT_C(0x02)	/* イベントフラグのAND待ち */
 
+#define TOBJ_SEM		UINT_C(0x01)	/* セマフォを待つ */
+#define TOBJ_FLG		UINT_C(0x02)	/* イベントフラグを待つ */
+#define TOBJ_DTQ		UINT_C(0x03)	/* データキューを待つ */
+#define TOBJ_PDQ		UINT_C(0x04)	/* 優先度データキューを待つ */
+#define TOBJ_MBX		UINT_C(0x05)	/* メールボックスを待つ */
+
 /*
  *  オブジェクトの状態の定義
  */
@@ -414,6 +443,7 @@ extern bool_t	xsns_xpn(void *p_excinf) throw();
 #define TTW_SMBF		UINT_C(0x0400)	/* メッセージバッファへの送信待ち */
 #define TTW_RMBF		UINT_C(0x0800)	/* メッセージバッファからの受信待ち */
 #define TTW_MPF			UINT_C(0x2000)	/* 固定長メモリブロックの獲得待ち */
+#define TTW_OBJ			UINT_C(0x4000)	/* 複数オブジェクト待ち */
 
 #define TTEX_ENA		UINT_C(0x01)	/* タスク例外処理許可状態 */
 #define TTEX_DIS		UINT_C(0x02)	/* タスク例外処理禁止状態 */
@@ -454,6 +484,14 @@ extern bool_t	xsns_xpn(void *p_excinf) throw();
 #define TOPPERS_SUPPORT_GET_UTM			/* get_utmがサポートされている */
 #endif /* TOPPERS_TARGET_SUPPORT_GET_UTM */
 
+#ifdef TOPPERS_TARGET_SUPPORT_GET_UTM64
+#define TOPPERS_SUPPORT_GET_UTM64		/* get_utm64がサポートされている */
+#endif /* TOPPERS_TARGET_SUPPORT_GET_UTM64 */
+
+#ifdef TOPPERS_WAIT_OBJ
+#define TOPPERS_SUPPORT_TWAI_OBJ		/* twai_objがサポートされている */
+#endif /* TOPPERS_WAIT_OBJ */
+
 #define TOPPERS_SUPPORT_MESSAGEBUF		/* メッセージバッファ機能拡張 */
 
 /*
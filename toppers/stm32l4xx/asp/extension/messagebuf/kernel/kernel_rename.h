@@ -71,6 +71,10 @@
  */
 #define initialize_eventflag		_kernel_initialize_eventflag
 #define check_flg_cond				_kernel_check_flg_cond
+#define flg_index_make_wait			_kernel_flg_index_make_wait
+#define flg_index_release			_kernel_flg_index_release
+#define flg_index_init				_kernel_flg_index_init
+#define flg_index_tskid				_kernel_flg_index_tskid
 
 /*
  *  dataqueue.c
@@ -139,6 +143,12 @@
  */
 #define initialize_exception		_kernel_initialize_exception
 
+/*
+ *  multi_wait.c
+ */
+#define mwaitcb						_kernel_mwaitcb
+#define notify_multi_wait			_kernel_notify_multi_wait
+
 /*
  *  kernel_cfg.c
  */
@@ -258,6 +268,10 @@
  */
 #define _initialize_eventflag		__kernel_initialize_eventflag
 #define _check_flg_cond				__kernel_check_flg_cond
+#define _flg_index_make_wait		__kernel_flg_index_make_wait
+#define _flg_index_release			__kernel_flg_index_release
+#define _flg_index_init				__kernel_flg_index_init
+#define _flg_index_tskid			__kernel_flg_index_tskid
 
 /*
  *  dataqueue.c
@@ -326,6 +340,12 @@
  */
 #define _initialize_exception		__kernel_initialize_exception
 
+/*
+ *  multi_wait.c
+ */
+#define _mwaitcb					__kernel_mwaitcb
+#define _notify_multi_wait			__kernel_notify_multi_wait
+
 /*
  *  kernel_cfg.c
  */
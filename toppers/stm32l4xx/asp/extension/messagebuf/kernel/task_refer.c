@@ -180,6 +180,11 @@ ref_tsk(ID tskid, T_RTSK *pk_rtsk)
 				pk_rtsk->wobjid = MPFID(((WINFO_MPF *)(p_tcb->p_winfo))
 																->p_mpfcb);
 				break;
+#ifdef TOPPERS_WAIT_OBJ
+			case TS_WAIT_OBJ:
+				pk_rtsk->tskwait = TTW_OBJ;
+				break;
+#endif /* TOPPERS_WAIT_OBJ */
 			}
 
 			/*
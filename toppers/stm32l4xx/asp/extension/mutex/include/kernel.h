@@ -86,6 +86,10 @@ typedef	uint_t		INTNO;		/* 割込み番号 */
 typedef	uint_t		INHNO;		/* 割込みハンドラ番号 */
 typedef	uint_t		EXCNO;		/* CPU例外ハンドラ番号 */
 
+#ifdef TOPPERS_TARGET_SUPPORT_GET_UTM64
+typedef	uint64_t	SYSUTM64;	/* 64ビットの性能評価用システム時刻 */
+#endif /* TOPPERS_TARGET_SUPPORT_GET_UTM64 */
+
 /*
  *  処理単位の型定義
  */
@@ -124,6 +128,18 @@ typedef	struct t_msg_pri {		/* 優先度付きメッセージヘッダ */
 	PRI		msgpri;				/* メッセージ優先度 */
 } T_MSG_PRI;
 
+#ifdef TOPPERS_WAIT_OBJ
+/*
+ *  複数オブジェクト待ちの待ち対象の型定義
+ */
+typedef struct t_wobj {
+	uint_t	objtyp;		/* オブジェクトの種類 */
+	ID		objid;		/* オブジェクトのID番号 */
+	FLGPTN	waiptn;		/* 待ちビットパターン（イベントフラグの場合）*/
+	MODE	wfmode;		/* 待ちモード（イベントフラグの場合）*/
+} T_WOBJ;
+#endif /* TOPPERS_WAIT_OBJ */
+
 /*
  *  パケット形式の定義
  */
@@ -179,6 +195,17 @@ typedef struct t_rmtx {
 	ID		wtskid;		/* ミューテックスの待ち行列の先頭のタスクのID番号 */
 } T_RMTX;
 
+typedef struct t_rrwl {
+	ID		htskid;		/* 書込みロックを保持しているタスクのID番号 */
+	uint_t	rdcnt;		/* 読出しロックを保持しているタスクの数 */
+	ID		wtskid;		/* リーダライタロックの待ち行列の先頭のタスクの
+						   ID番号 */
+} T_RRWL;
+
+typedef struct t_rcnd {
+	ID		wtskid;		/* 条件変数の待ち行列の先頭のタスクのID番号 */
+} T_RCND;
+
 typedef struct t_rmpf {
 	ID		wtskid;		/* 固定長メモリプールの待ち行列の先頭のタスクの
 						   ID番号 */
@@ -291,6 +318,10 @@ extern ER		trcv_mbx(ID mbxid, T_MSG **ppk_msg, TMO tmout) throw();
 extern ER		ini_mbx(ID mbxid) throw();
 extern ER		ref_mbx(ID mbxid, T_RMBX *pk_rmbx) throw();
 
+#ifdef TOPPERS_WAIT_OBJ
+extern ER_UINT	twai_obj(const T_WOBJ *p_wobj, uint_t nobj, TMO tmout) throw();
+#endif /* TOPPERS_WAIT_OBJ */
+
 extern ER		loc_mtx(ID mtxid) throw();
 extern ER		ploc_mtx(ID mtxid) throw();
 extern ER		tloc_mtx(ID mtxid, TMO tmout) throw();
@@ -298,6 +329,23 @@ extern ER		unl_mtx(ID mtxid) throw();
 extern ER		ini_mtx(ID mtxid) throw();
 extern ER		ref_mtx(ID mtxid, T_RMTX *pk_rmtx) throw();
 
+extern ER		loc_rdl(ID rwlid) throw();
+extern ER		ploc_rdl(ID rwlid) throw();
+extern ER		tloc_rdl(ID rwlid, TMO tmout) throw();
+extern ER		loc_wrl(ID rwlid) throw();
+extern ER		ploc_wrl(ID rwlid) throw();
+extern ER		tloc_wrl(ID rwlid, TMO tmout) throw();
+extern ER		unl_rwl(ID rwlid) throw();
+extern ER		ini_rwl(ID rwlid) throw();
+extern ER		ref_rwl(ID rwlid, T_RRWL *pk_rrwl) throw();
+
+extern ER		wai_cnd(ID cndid, ID mtxid) throw();
+extern ER		twai_cnd(ID cndid, ID mtxid, TMO tmout) throw();
+extern ER		sig_cnd(ID cndid) throw();
+extern ER		brd_cnd(ID cndid) throw();
+extern ER		ini_cnd(ID cndid) throw();
+extern ER		ref_cnd(ID cndid, T_RCND *pk_rcnd) throw();
+
 /*
  *  メモリプール管理機能
  */
@@ -313,6 +361,9 @@ extern ER		ref_mpf(ID mpfid, T_RMPF *pk_rmpf) throw();
  */
 extern ER		get_tim(SYSTIM *p_systim) throw();
 extern ER		get_utm(SYSUTM *p_sysutm) throw();
+#ifdef TOPPERS_TARGET_SUPPORT_GET_UTM64
+extern ER		get_utm64(SYSUTM64 *p_sysutm64) throw();
+#endif /* TOPPERS_TARGET_SUPPORT_GET_UTM64 */
 
 extern ER		sta_cyc(ID cycid) throw();
 extern ER		stp_cyc(ID cycid) throw();
@@ -358,6 +409,119 @@ extern ER		get_ipm(PRI *p_intpri) throw();
 extern bool_t	xsns_dpn(void *p_excinf) throw();
 extern bool_t	xsns_xpn(void *p_excinf) throw();
 
+/*
+ *  ミューテックスの高速パス
+ *
+ *  競合のない場合のロック／ロック解除を，カーネルに入らずに，ミューテッ
+ *  クスごとのオーナワード（_kernel_mtxword_table）に対する排他ロード／
+ *  排他ストア命令で行う．オーナワードが0（ロックされていない）でない場
+ *  合や，自タスクの値でない場合は，loc_mtx／unl_mtxを呼び出す．優先度
+ *  上限ミューテックスは，オーナワードが常にカーネル管理を示す値である
+ *  ため，常にloc_mtx／unl_mtxを呼び出す．
+ *
+ *  loc_mtx／unl_mtxがE_CTXを返す状態（floc_mtxではディスパッチ保留状
+ *  態，funl_mtxでは非タスクコンテキストかCPUロック状態）でも，
+ *  loc_mtx／unl_mtxを呼び出し，エラーを返させる．
+ *
+ *  高速パスでロックしているミューテックスの数を，TCB中のmtxfcntに保持
+ *  する．タスクの終了時には，これが0でない場合にのみオーナワードを探
+ *  索する．mtxfcntは，オーナワードを書き換える前に増やし，書き換えた
+ *  後に減らすため，一時的に実際の数よりも大きくなることはあるが，小さ
+ *  くなることはない．
+ */
+#if defined(TOPPERS_MTX_FASTPATH) && defined(TOPPERS_SUPPORT_EXCLUSIVE)
+
+extern uint32_t	_kernel_mtxword_table[];
+extern const ID	_kernel_tmax_mtxid;
+extern struct task_control_block	*_kernel_p_runtsk;
+
+/*
+ *  オーナワードのインデックス（ミューテックスIDの最小値は1）
+ */
+#define TOPPERS_MTXWORD_INDEX(mtxid)	((uint_t)((mtxid) - 1))
+
+/*
+ *  TCBの先頭部分（mtxfcntの参照用）
+ *
+ *  task.h中のTCBの先頭のtask_queueとmtxfcntに対応する．
+ */
+typedef struct {
+	void		*p_next;
+	void		*p_prev;
+	uint32_t	mtxfcnt;
+} TOPPERS_TCB_MTXF;
+
+/*
+ *  自タスクのmtxfcntの更新
+ *
+ *  カーネルは，CPUロック状態でmtxfcntを書き換える（mutex_adopt）が，
+ *  例外の発生により排他モニタがクリアされるため，その間に読み出した値
+ *  を書き戻すことはない．
+ */
+Inline void
+toppers_mtxfcnt_add(uint32_t n)
+{
+	volatile uint32_t	*p_cnt;
+	uint32_t	cnt;
+
+	p_cnt = &(((TOPPERS_TCB_MTXF *) _kernel_p_runtsk)->mtxfcnt);
+	do {
+		cnt = ldrex_word(p_cnt);
+	} while (strex_word(cnt + n, p_cnt) != 0U);
+}
+
+Inline ER
+floc_mtx(ID mtxid)
+{
+	volatile uint32_t	*p_word;
+	uint32_t	self;
+
+	if (get_ipsr() != 0U || sns_dpn()
+			|| TOPPERS_MTXWORD_INDEX(mtxid) >= (uint_t) _kernel_tmax_mtxid) {
+		return(loc_mtx(mtxid));
+	}
+	p_word = &(_kernel_mtxword_table[TOPPERS_MTXWORD_INDEX(mtxid)]);
+	self = (uint32_t)(uintptr_t) _kernel_p_runtsk;
+	toppers_mtxfcnt_add(1U);
+	do {
+		if (ldrex_word(p_word) != 0U) {
+			clrex();
+			toppers_mtxfcnt_add((uint32_t) -1);
+			return(loc_mtx(mtxid));
+		}
+	} while (strex_word(self, p_word) != 0U);
+	return(E_OK);
+}
+
+Inline ER
+funl_mtx(ID mtxid)
+{
+	volatile uint32_t	*p_word;
+	uint32_t	self;
+
+	if (get_ipsr() != 0U || sns_loc()
+			|| TOPPERS_MTXWORD_INDEX(mtxid) >= (uint_t) _kernel_tmax_mtxid) {
+		return(unl_mtx(mtxid));
+	}
+	p_word = &(_kernel_mtxword_table[TOPPERS_MTXWORD_INDEX(mtxid)]);
+	self = (uint32_t)(uintptr_t) _kernel_p_runtsk;
+	do {
+		if (ldrex_word(p_word) != self) {
+			clrex();
+			return(unl_mtx(mtxid));
+		}
+	} while (strex_word(0U, p_word) != 0U);
+	toppers_mtxfcnt_add((uint32_t) -1);
+	return(E_OK);
+}
+
+#else /* TOPPERS_MTX_FASTPATH && TOPPERS_SUPPORT_EXCLUSIVE */
+
+#define floc_mtx(mtxid)		loc_mtx(mtxid)
+#define funl_mtx(mtxid)		unl_mtx(mtxid)
+
+#endif /* TOPPERS_MTX_FASTPATH && TOPPERS_SUPPORT_EXCLUSIVE */
+
 #endif /* TOPPERS_MACRO_ONLY */
 
 /*
@@ -372,6 +536,7 @@ extern bool_t	xsns_xpn(void *p_excinf) throw();
 #define TA_CLR			UINT_C(0x04)	/* イベントフラグのクリア指定 */
 
 #define TA_CEILING		UINT_C(0x03)	/* 優先度上限プロトコル */
+#define TA_WPREF		UINT_C(0x04)	/* リーダライタロックの書込み優先 */
 
 #define TA_STA			UINT_C(0x02)	/* 周期ハンドラを動作状態で生成 */
 
@@ -386,6 +551,12 @@ extern bool_t	xsns_xpn(void *p_excinf) throw();
 #define TWF_ORW			UINT_C(0x01)	/* イベントフラグのOR待ち */
 #define TWF_ANDW		UINT_C(0x02)	/* イベントフラグのAND待ち */
 
+#define TOBJ_SEM		UINT_C(0x01)	/* セマフォを待つ */
+#define TOBJ_FLG		UINT_C(0x02)	/* イベントフラグを待つ */
+#define TOBJ_DTQ		UINT_C(0x03)	/* データキューを待つ */
+#define TOBJ_PDQ		UINT_C(0x04)	/* 優先度データキューを待つ */
+#define TOBJ_MBX		UINT_C(0x05)	/* メールボックスを待つ */
+
 /*
  *  オブジェクトの状態の定義
  */
@@ -406,7 +577,10 @@ extern bool_t	xsns_xpn(void *p_excinf) throw();
 #define TTW_RPDQ		UINT_C(0x0200)	/* 優先度データキューからの受信待ち */
 #define TTW_MBX			UINT_C(0x0040)	/* メールボックスからの受信待ち */
 #define TTW_MTX			UINT_C(0x0080)	/* ミューテックスのロック待ち状態 */
+#define TTW_RWL			UINT_C(0x1000)	/* リーダライタロックのロック待ち状態 */
 #define TTW_MPF			UINT_C(0x2000)	/* 固定長メモリブロックの獲得待ち */
+#define TTW_OBJ			UINT_C(0x4000)	/* 複数オブジェクト待ち */
+#define TTW_CND			UINT_C(0x8000)	/* 条件変数待ち */
 
 #define TTEX_ENA		UINT_C(0x01)	/* タスク例外処理許可状態 */
 #define TTEX_DIS		UINT_C(0x02)	/* タスク例外処理禁止状態 */
@@ -447,7 +621,17 @@ extern bool_t	xsns_xpn(void *p_excinf) throw();
 #define TOPPERS_SUPPORT_GET_UTM			/* get_utmがサポートされている */
 #endif /* TOPPERS_TARGET_SUPPORT_GET_UTM */
 
+#ifdef TOPPERS_TARGET_SUPPORT_GET_UTM64
+#define TOPPERS_SUPPORT_GET_UTM64		/* get_utm64がサポートされている */
+#endif /* TOPPERS_TARGET_SUPPORT_GET_UTM64 */
+
+#ifdef TOPPERS_WAIT_OBJ
+#define TOPPERS_SUPPORT_TWAI_OBJ		/* twai_objがサポートされている */
+#endif /* TOPPERS_WAIT_OBJ */
+
 #define TOPPERS_SUPPORT_MUTEX			/* ミューテックス機能拡張 */
+#define TOPPERS_SUPPORT_RWLOCK			/* リーダライタロック機能 */
+#define TOPPERS_SUPPORT_COND			/* 条件変数機能 */
 
 /*
  *  優先度の範囲
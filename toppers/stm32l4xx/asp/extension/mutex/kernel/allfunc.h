@@ -62,12 +62,14 @@
 
 /* wait.c */
 #define TOPPERS_waimake
+#define TOPPERS_waiwobj
 #define TOPPERS_waicmp
 #define TOPPERS_waitmo
 #define TOPPERS_waitmook
 #define TOPPERS_wairel
 #define TOPPERS_wobjwai
 #define TOPPERS_wobjwaitmo
+#define TOPPERS_wobjpri
 #define TOPPERS_iniwque
 
 /* time_event.c */
@@ -125,6 +127,10 @@
 /* eventflag.c */
 #define TOPPERS_flgini
 #define TOPPERS_flgcnd
+#define TOPPERS_flgiwai
+#define TOPPERS_flgirel
+#define TOPPERS_flgiini
+#define TOPPERS_flgitsk
 #define TOPPERS_set_flg
 #define TOPPERS_iset_flg
 #define TOPPERS_clr_flg
@@ -187,6 +193,9 @@
 #define TOPPERS_mtxcalc
 #define TOPPERS_mtxrel
 #define TOPPERS_mtxrela
+#define TOPPERS_mtxcrel
+#define TOPPERS_mtxcwup
+#define TOPPERS_mtxcloc
 #define TOPPERS_loc_mtx
 #define TOPPERS_ploc_mtx
 #define TOPPERS_tloc_mtx
@@ -194,6 +203,35 @@
 #define TOPPERS_ini_mtx
 #define TOPPERS_ref_mtx
 
+/* rwlock.c */
+#define TOPPERS_rwlhook
+#define TOPPERS_rwlini
+#define TOPPERS_rwlchk
+#define TOPPERS_rwlscan
+#define TOPPERS_rwlcalc
+#define TOPPERS_rwlwup
+#define TOPPERS_rwlrela
+#define TOPPERS_rwlwobj
+#define TOPPERS_rwlpri
+#define TOPPERS_loc_rdl
+#define TOPPERS_ploc_rdl
+#define TOPPERS_tloc_rdl
+#define TOPPERS_loc_wrl
+#define TOPPERS_ploc_wrl
+#define TOPPERS_tloc_wrl
+#define TOPPERS_unl_rwl
+#define TOPPERS_ini_rwl
+#define TOPPERS_ref_rwl
+
+/* cond.c */
+#define TOPPERS_cndini
+#define TOPPERS_wai_cnd
+#define TOPPERS_twai_cnd
+#define TOPPERS_sig_cnd
+#define TOPPERS_brd_cnd
+#define TOPPERS_ini_cnd
+#define TOPPERS_ref_cnd
+
 /* mempfix.c */
 #define TOPPERS_mpfini
 #define TOPPERS_mpfget
@@ -207,6 +245,7 @@
 /* time_manage.c */
 #define TOPPERS_get_tim
 #define TOPPERS_get_utm
+#define TOPPERS_get_utm64
 
 /* cyclic.c */
 #define TOPPERS_cycini
@@ -253,4 +292,9 @@
 #define TOPPERS_xsns_dpn
 #define TOPPERS_xsns_xpn
 
+/* multi_wait.c */
+#define TOPPERS_mwaicb
+#define TOPPERS_mwaintfy
+#define TOPPERS_twai_obj
+
 #endif /* TOPPERS_ALLFUNC_H */
@@ -131,6 +131,8 @@
 #define VALID_PDQID(pdqid)	(TMIN_PDQID <= (pdqid) && (pdqid) <= tmax_pdqid)
 #define VALID_MBXID(mbxid)	(TMIN_MBXID <= (mbxid) && (mbxid) <= tmax_mbxid)
 #define VALID_MTXID(mtxid)	(TMIN_MTXID <= (mtxid) && (mtxid) <= tmax_mtxid)
+#define VALID_RWLID(rwlid)	(TMIN_RWLID <= (rwlid) && (rwlid) <= tmax_rwlid)
+#define VALID_CNDID(cndid)	(TMIN_CNDID <= (cndid) && (cndid) <= tmax_cndid)
 #define VALID_MPFID(mpfid)	(TMIN_MPFID <= (mpfid) && (mpfid) <= tmax_mpfid)
 #define VALID_CYCID(cycid)	(TMIN_CYCID <= (cycid) && (cycid) <= tmax_cycid)
 #define VALID_ALMID(almid)	(TMIN_ALMID <= (almid) && (almid) <= tmax_almid)
@@ -194,6 +196,20 @@
 	}														\
 } while (false)
 
+#define CHECK_RWLID(rwlid) do {								\
+	if (!VALID_RWLID(rwlid)) {								\
+		ercd = E_ID;										\
+		goto error_exit;									\
+	}														\
+} while (false)
+
+#define CHECK_CNDID(cndid) do {								\
+	if (!VALID_CNDID(cndid)) {								\
+		ercd = E_ID;										\
+		goto error_exit;									\
+	}														\
+} while (false)
+
 #define CHECK_MPFID(mpfid) do {								\
 	if (!VALID_MPFID(mpfid)) {								\
 		ercd = E_ID;										\
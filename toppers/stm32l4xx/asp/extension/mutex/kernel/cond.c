@@ -0,0 +1,397 @@
+/*
+ *  TOPPERS/ASP Kernel
+ *      Toyohashi Open Platform for Embedded Real-Time Systems/
+ *      Advanced Standard Profile Kernel
+ * 
+ *  Copyright (C) 2005-2026 by Embedded and Real-Time Systems Laboratory
+ *              Graduate School of Information Science, Nagoya Univ., JAPAN
+ * 
+ *  上記著作権者は，以下の(1)〜(4)の条件を満たす場合に限り，本ソフトウェ
+ *  ア（本ソフトウェアを改変したものを含む．以下同じ）を使用・複製・改
+ *  変・再配布（以下，利用と呼ぶ）することを無償で許諾する．
+ *  (1) 本ソフトウェアをソースコードの形で利用する場合には，上記の著作
+ *      権表示，この利用条件および下記の無保証規定が，そのままの形でソー
+ *      スコード中に含まれていること．
+ *  (2) 本ソフトウェアを，ライブラリ形式など，他のソフトウェア開発に使
+ *      用できる形で再配布する場合には，再配布に伴うドキュメント（利用
+ *      者マニュアルなど）に，上記の著作権表示，この利用条件および下記
+ *      の無保証規定を掲載すること．
+ *  (3) 本ソフトウェアを，機器に組み込むなど，他のソフトウェア開発に使
+ *      用できない形で再配布する場合には，次のいずれかの条件を満たすこ
+ *      と．
+ *    (a) 再配布に伴うドキュメント（利用者マニュアルなど）に，上記の著
+ *        作権表示，この利用条件および下記の無保証規定を掲載すること．
+ *    (b) 再配布の形態を，別に定める方法によって，TOPPERSプロジェクトに
+ *        報告すること．
+ *  (4) 本ソフトウェアの利用により直接的または間接的に生じるいかなる損
+ *      害からも，上記著作権者およびTOPPERSプロジェクトを免責すること．
+ *      また，本ソフトウェアのユーザまたはエンドユーザからのいかなる理
+ *      由に基づく請求からも，上記著作権者およびTOPPERSプロジェクトを
+ *      免責すること．
+ * 
+ *  本ソフトウェアは，無保証で提供されているものである．上記著作権者お
+ *  よびTOPPERSプロジェクトは，本ソフトウェアに関して，特定の使用目的
+ *  に対する適合性も含めて，いかなる保証も行わない．また，本ソフトウェ
+ *  アの利用により直接的または間接的に生じたいかなる損害に関しても，そ
+ *  の責任を負わない．
+ * 
+ *  $Id$
+ */
+
+/*
+ *		条件変数機能
+ */
+
+#include "kernel_impl.h"
+#include "check.h"
+#include "task.h"
+#include "wait.h"
+#include "mutex.h"
+#include "cond.h"
+
+/*
+ *  トレースログマクロのデフォルト定義
+ */
+#ifndef LOG_WAI_CND_ENTER
+#define LOG_WAI_CND_ENTER(cndid, mtxid)
+#endif /* LOG_WAI_CND_ENTER */
+
+#ifndef LOG_WAI_CND_LEAVE
+#define LOG_WAI_CND_LEAVE(ercd)
+#endif /* LOG_WAI_CND_LEAVE */
+
+#ifndef LOG_TWAI_CND_ENTER
+#define LOG_TWAI_CND_ENTER(cndid, mtxid, tmout)
+#endif /* LOG_TWAI_CND_ENTER */
+
+#ifndef LOG_TWAI_CND_LEAVE
+#define LOG_TWAI_CND_LEAVE(ercd)
+#endif /* LOG_TWAI_CND_LEAVE */
+
+#ifndef LOG_SIG_CND_ENTER
+#define LOG_SIG_CND_ENTER(cndid)
+#endif /* LOG_SIG_CND_ENTER */
+
+#ifndef LOG_SIG_CND_LEAVE
+#define LOG_SIG_CND_LEAVE(ercd)
+#endif /* LOG_SIG_CND_LEAVE */
+
+#ifndef LOG_BRD_CND_ENTER
+#define LOG_BRD_CND_ENTER(cndid)
+#endif /* LOG_BRD_CND_ENTER */
+
+#ifndef LOG_BRD_CND_LEAVE
+#define LOG_BRD_CND_LEAVE(ercd)
+#endif /* LOG_BRD_CND_LEAVE */
+
+#ifndef LOG_INI_CND_ENTER
+#define LOG_INI_CND_ENTER(cndid)
+#endif /* LOG_INI_CND_ENTER */
+
+#ifndef LOG_INI_CND_LEAVE
+#define LOG_INI_CND_LEAVE(ercd)
+#endif /* LOG_INI_CND_LEAVE */
+
+#ifndef LOG_REF_CND_ENTER
+#define LOG_REF_CND_ENTER(cndid, pk_rcnd)
+#endif /* LOG_REF_CND_ENTER */
+
+#ifndef LOG_REF_CND_LEAVE
+#define LOG_REF_CND_LEAVE(ercd, pk_rcnd)
+#endif /* LOG_REF_CND_LEAVE */
+
+/*
+ *  条件変数の数
+ */
+#define tnum_cnd	((uint_t)(tmax_cndid - TMIN_CNDID + 1))
+
+/*
+ *  条件変数IDから条件変数管理ブロックを取り出すためのマクロ
+ */
+#define INDEX_CND(cndid)	((uint_t)((cndid) - TMIN_CNDID))
+#define get_cndcb(cndid)	(&(cndcb_table[INDEX_CND(cndid)]))
+
+/*
+ *  ミューテックスIDからミューテックス管理ブロックを取り出すためのマクロ
+ */
+#define INDEX_MTX(mtxid)	((uint_t)((mtxid) - TMIN_MTXID))
+#define get_mtxcb(mtxid)	(&(mtxcb_table[INDEX_MTX(mtxid)]))
+
+/*
+ *  条件変数待ちの後のミューテックスの再ロック
+ *
+ *  条件変数の待ち解除時にミューテックスをロックできていない場合（タイ
+ *  ムアウト，待ち状態の強制解除，条件変数の初期化による待ち解除の場合
+ *  と，ミューテックスのロック待ちが強制解除された場合）には，ここでミュー
+ *  テックスをロックする．ercdは条件変数待ちの結果で，それがE_OKの場合
+ *  には，ミューテックスのロック待ちの結果を返す．ミューテックスをロッ
+ *  クするまで繰り返すため，この関数から戻った時には，実行中のタスクは
+ *  必ずミューテックスをロックしている．
+ */
+Inline ER
+cond_relock(MTXCB *p_mtxcb, ER ercd)
+{
+	ER		rercd;
+
+	while (p_mtxcb->p_loctsk != p_runtsk) {
+		rercd = mutex_cond_relock(p_mtxcb);
+		if (ercd == E_OK) {
+			ercd = rercd;
+		}
+	}
+	return(ercd);
+}
+
+/* 
+ *  条件変数機能の初期化
+ */
+#ifdef TOPPERS_cndini
+
+void
+initialize_cond(void)
+{
+	uint_t	i;
+	CNDCB	*p_cndcb;
+
+	for (i = 0; i < tnum_cnd; i++) {
+		p_cndcb = &(cndcb_table[i]);
+		queue_initialize(&(p_cndcb->wait_queue));
+		p_cndcb->p_cndinib = &(cndinib_table[i]);
+	}
+}
+
+#endif /* TOPPERS_cndini */
+
+/*
+ *  条件変数待ち
+ */
+#ifdef TOPPERS_wai_cnd
+
+ER
+wai_cnd(ID cndid, ID mtxid)
+{
+	CNDCB	*p_cndcb;
+	MTXCB	*p_mtxcb;
+	WINFO_CND winfo_cnd;
+	ER		ercd;
+
+	LOG_WAI_CND_ENTER(cndid, mtxid);
+	CHECK_DISPATCH();
+	CHECK_CNDID(cndid);
+	CHECK_MTXID(mtxid);
+	p_cndcb = get_cndcb(cndid);
+	p_mtxcb = get_mtxcb(mtxid);
+
+	t_lock_cpu();
+	if (!mutex_cond_release(p_mtxcb)) {
+		ercd = E_OBJ;
+	}
+	else {
+		p_runtsk->tstat = (TS_WAITING | TS_WAIT_CND);
+		winfo_cnd.p_mtxcb = p_mtxcb;
+		wobj_make_wait((WOBJCB *) p_cndcb, (WINFO_WOBJ *) &winfo_cnd);
+		dispatch();
+		ercd = cond_relock(p_mtxcb, winfo_cnd.winfo.wercd);
+	}
+	t_unlock_cpu();
+
+  error_exit:
+	LOG_WAI_CND_LEAVE(ercd);
+	return(ercd);
+}
+
+#endif /* TOPPERS_wai_cnd */
+
+/*
+ *  条件変数待ち（タイムアウトあり）
+ *
+ *  tmoutにTMO_POLを指定した場合には，ミューテックスのロックを解除し
+ *  た後に直ちにロックし直し，E_TMOUTを返す．
+ */
+#ifdef TOPPERS_twai_cnd
+
+ER
+twai_cnd(ID cndid, ID mtxid, TMO tmout)
+{
+	CNDCB	*p_cndcb;
+	MTXCB	*p_mtxcb;
+	WINFO_CND winfo_cnd;
+	TMEVTB	tmevtb;
+	ER		ercd;
+
+	LOG_TWAI_CND_ENTER(cndid, mtxid, tmout);
+	CHECK_DISPATCH();
+	CHECK_CNDID(cndid);
+	CHECK_MTXID(mtxid);
+	CHECK_TMOUT(tmout);
+	p_cndcb = get_cndcb(cndid);
+	p_mtxcb = get_mtxcb(mtxid);
+
+	t_lock_cpu();
+	if (!mutex_cond_release(p_mtxcb)) {
+		ercd = E_OBJ;
+	}
+	else if (tmout == TMO_POL) {
+		ercd = cond_relock(p_mtxcb, E_TMOUT);
+	}
+	else {
+		p_runtsk->tstat = (TS_WAITING | TS_WAIT_CND);
+		winfo_cnd.p_mtxcb = p_mtxcb;
+		wobj_make_wait_tmout((WOBJCB *) p_cndcb, (WINFO_WOBJ *) &winfo_cnd,
+														&tmevtb, tmout);
+		dispatch();
+		ercd = cond_relock(p_mtxcb, winfo_cnd.winfo.wercd);
+	}
+	t_unlock_cpu();
+
+  error_exit:
+	LOG_TWAI_CND_LEAVE(ercd);
+	return(ercd);
+}
+
+#endif /* TOPPERS_twai_cnd */
+
+/*
+ *  条件変数の通知
+ *
+ *  待ちキューの先頭のタスク（TA_TPRI属性の場合は最も優先度の高いタス
+ *  ク）を待ち解除する．待ち解除したタスクは，ミューテックスをロック
+ *  できればそのまま実行できる状態になり，ロックできなければミューテッ
+ *  クスのロック待ち状態に移る．
+ */
+#ifdef TOPPERS_sig_cnd
+
+ER
+sig_cnd(ID cndid)
+{
+	CNDCB	*p_cndcb;
+	TCB		*p_tcb;
+	ER		ercd;
+
+	LOG_SIG_CND_ENTER(cndid);
+	CHECK_TSKCTX_UNL();
+	CHECK_CNDID(cndid);
+	p_cndcb = get_cndcb(cndid);
+
+	t_lock_cpu();
+	if (!queue_empty(&(p_cndcb->wait_queue))) {
+		p_tcb = (TCB *) queue_delete_next(&(p_cndcb->wait_queue));
+		if (mutex_cond_wakeup(((WINFO_CND *)(p_tcb->p_winfo))->p_mtxcb,
+																p_tcb)) {
+			dispatch();
+		}
+	}
+	ercd = E_OK;
+	t_unlock_cpu();
+
+  error_exit:
+	LOG_SIG_CND_LEAVE(ercd);
+	return(ercd);
+}
+
+#endif /* TOPPERS_sig_cnd */
+
+/*
+ *  条件変数の全通知
+ *
+ *  待ちキューにつながれているすべてのタスクを，待ちキューの順に待ち解
+ *  除する．
+ */
+#ifdef TOPPERS_brd_cnd
+
+ER
+brd_cnd(ID cndid)
+{
+	CNDCB	*p_cndcb;
+	TCB		*p_tcb;
+	bool_t	dspreq = false;
+	ER		ercd;
+
+	LOG_BRD_CND_ENTER(cndid);
+	CHECK_TSKCTX_UNL();
+	CHECK_CNDID(cndid);
+	p_cndcb = get_cndcb(cndid);
+
+	t_lock_cpu();
+	while (!queue_empty(&(p_cndcb->wait_queue))) {
+		p_tcb = (TCB *) queue_delete_next(&(p_cndcb->wait_queue));
+		if (mutex_cond_wakeup(((WINFO_CND *)(p_tcb->p_winfo))->p_mtxcb,
+																p_tcb)) {
+			dspreq = true;
+		}
+	}
+	if (dspreq) {
+		dispatch();
+	}
+	ercd = E_OK;
+	t_unlock_cpu();
+
+  error_exit:
+	LOG_BRD_CND_LEAVE(ercd);
+	return(ercd);
+}
+
+#endif /* TOPPERS_brd_cnd */
+
+/*
+ *  条件変数の初期化
+ *
+ *  待ち解除したタスクは，ミューテックスをロックし直した後に，E_DLTエ
+ *  ラーでwai_cnd／twai_cndから戻る．
+ */
+#ifdef TOPPERS_ini_cnd
+
+ER
+ini_cnd(ID cndid)
+{
+	CNDCB	*p_cndcb;
+	bool_t	dspreq;
+	ER		ercd;
+    
+	LOG_INI_CND_ENTER(cndid);
+	CHECK_TSKCTX_UNL();
+	CHECK_CNDID(cndid);
+	p_cndcb = get_cndcb(cndid);
+
+	t_lock_cpu();
+	dspreq = init_wait_queue(&(p_cndcb->wait_queue));
+	if (dspreq) {
+		dispatch();
+	}
+	ercd = E_OK;
+	t_unlock_cpu();
+
+  error_exit:
+	LOG_INI_CND_LEAVE(ercd);
+	return(ercd);
+}
+
+#endif /* TOPPERS_ini_cnd */
+
+/*
+ *  条件変数の状態参照
+ */
+#ifdef TOPPERS_ref_cnd
+
+ER
+ref_cnd(ID cndid, T_RCND *pk_rcnd)
+{
+	CNDCB	*p_cndcb;
+	ER		ercd;
+    
+	LOG_REF_CND_ENTER(cndid, pk_rcnd);
+	CHECK_TSKCTX_UNL();
+	CHECK_CNDID(cndid);
+	p_cndcb = get_cndcb(cndid);
+
+	t_lock_cpu();
+	pk_rcnd->wtskid = wait_tskid(&(p_cndcb->wait_queue));
+	ercd = E_OK;
+	t_unlock_cpu();
+
+  error_exit:
+	LOG_REF_CND_LEAVE(ercd, pk_rcnd);
+	return(ercd);
+}
+
+#endif /* TOPPERS_ref_cnd */
@@ -0,0 +1,116 @@
+/*
+ *  TOPPERS/ASP Kernel
+ *      Toyohashi Open Platform for Embedded Real-Time Systems/
+ *      Advanced Standard Profile Kernel
+ * 
+ *  Copyright (C) 2005-2026 by Embedded and Real-Time Systems Laboratory
+ *              Graduate School of Information Science, Nagoya Univ., JAPAN
+ * 
+ *  上記著作権者は，以下の(1)〜(4)の条件を満たす場合に限り，本ソフトウェ
+ *  ア（本ソフトウェアを改変したものを含む．以下同じ）を使用・複製・改
+ *  変・再配布（以下，利用と呼ぶ）することを無償で許諾する．
+ *  (1) 本ソフトウェアをソースコードの形で利用する場合には，上記の著作
+ *      権表示，この利用条件および下記の無保証規定が，そのままの形でソー
+ *      スコード中に含まれていること．
+ *  (2) 本ソフトウェアを，ライブラリ形式など，他のソフトウェア開発に使
+ *      用できる形で再配布する場合には，再配布に伴うドキュメント（利用
+ *      者マニュアルなど）に，上記の著作権表示，この利用条件および下記
+ *      の無保証規定を掲載すること．
+ *  (3) 本ソフトウェアを，機器に組み込むなど，他のソフトウェア開発に使
+ *      用できない形で再配布する場合には，次のいずれかの条件を満たすこ
+ *      と．
+ *    (a) 再配布に伴うドキュメント（利用者マニュアルなど）に，上記の著
+ *        作権表示，この利用条件および下記の無保証規定を掲載すること．
+ *    (b) 再配布の形態を，別に定める方法によって，TOPPERSプロジェクトに
+ *        報告すること．
+ *  (4) 本ソフトウェアの利用により直接的または間接的に生じるいかなる損
+ *      害からも，上記著作権者およびTOPPERSプロジェクトを免責すること．
+ *      また，本ソフトウェアのユーザまたはエンドユーザからのいかなる理
+ *      由に基づく請求からも，上記著作権者およびTOPPERSプロジェクトを
+ *      免責すること．
+ * 
+ *  本ソフトウェアは，無保証で提供されているものである．上記著作権者お
+ *  よびTOPPERSプロジェクトは，本ソフトウェアに関して，特定の使用目的
+ *  に対する適合性も含めて，いかなる保証も行わない．また，本ソフトウェ
+ *  アの利用により直接的または間接的に生じたいかなる損害に関しても，そ
+ *  の責任を負わない．
+ * 
+ *  $Id$
+ */
+
+/*
+ *		条件変数機能
+ */
+
+#ifndef TOPPERS_COND_H
+#define TOPPERS_COND_H
+
+#include "wait.h"
+#include "mutex.h"
+
+/*
+ *  条件変数初期化ブロック
+ *
+ *  この構造体は，同期・通信オブジェクトの初期化ブロックの共通部分
+ *  （WOBJINIB）を拡張（オブジェクト指向言語の継承に相当）したもので，
+ *  最初のフィールドが共通になっている．
+ */
+typedef struct cond_initialization_block {
+	ATR			cndatr;			/* 条件変数属性 */
+} CNDINIB;
+
+/*
+ *  条件変数管理ブロック
+ *
+ *  この構造体は，同期・通信オブジェクトの管理ブロックの共通部分（WOBJCB）
+ *  を拡張（オブジェクト指向言語の継承に相当）したもので，最初の2つの
+ *  フィールドが共通になっている．
+ */
+typedef struct cond_control_block {
+	QUEUE		wait_queue;		/* 条件変数待ちキュー */
+	const CNDINIB *p_cndinib;	/* 初期化ブロックへのポインタ */
+} CNDCB;
+
+/*
+ *  条件変数待ち情報ブロックの定義
+ *
+ *  この構造体は，同期・通信オブジェクトの待ち情報ブロックの共通部分
+ *  （WINFO_WOBJ）を拡張（オブジェクト指向言語の継承に相当）したもので，
+ *  最初の2つのフィールドが共通になっている．
+ *
+ *  条件変数の待ち解除時に，ミューテックスのロック待ち状態に移す場合に
+ *  は，この待ち情報ブロックをミューテックス待ち情報ブロック（WINFO_MTX）
+ *  として用いる．
+ */
+typedef struct cond_waiting_information {
+	WINFO	winfo;			/* 標準の待ち情報ブロック */
+	CNDCB	*p_cndcb;		/* 待っている条件変数の管理ブロック */
+	MTXCB	*p_mtxcb;		/* 再ロックするミューテックスの管理ブロック */
+} WINFO_CND;
+
+/*
+ *  条件変数IDの最大値（kernel_cfg.c）
+ */
+extern const ID	tmax_cndid;
+
+/*
+ *  条件変数初期化ブロックのエリア（kernel_cfg.c）
+ */
+extern const CNDINIB	cndinib_table[];
+
+/*
+ *  条件変数管理ブロックのエリア（kernel_cfg.c）
+ */
+extern CNDCB	cndcb_table[];
+
+/*
+ *  条件変数管理ブロックから条件変数IDを取り出すためのマクロ
+ */
+#define	CNDID(p_cndcb)	((ID)(((p_cndcb) - cndcb_table) + TMIN_CNDID))
+
+/*
+ *  条件変数機能の初期化
+ */
+extern void	initialize_cond(void);
+
+#endif /* TOPPERS_COND_H */
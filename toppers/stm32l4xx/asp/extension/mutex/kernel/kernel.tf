@@ -57,6 +57,8 @@ $NL$
 #define TNUM_PDQID	$LENGTH(PDQ.ID_LIST)$$NL$
 #define TNUM_MBXID	$LENGTH(MBX.ID_LIST)$$NL$
 #define TNUM_MTXID	$LENGTH(MTX.ID_LIST)$$NL$
+#define TNUM_RWLID	$LENGTH(RWL.ID_LIST)$$NL$
+#define TNUM_CNDID	$LENGTH(CND.ID_LIST)$$NL$
 #define TNUM_MPFID	$LENGTH(MPF.ID_LIST)$$NL$
 #define TNUM_CYCID	$LENGTH(CYC.ID_LIST)$$NL$
 #define TNUM_ALMID	$LENGTH(ALM.ID_LIST)$$NL$
@@ -82,6 +84,12 @@ $END$
 $FOREACH id MTX.ID_LIST$
 	#define $id$	$+id$$NL$
 $END$
+$FOREACH id RWL.ID_LIST$
+	#define $id$	$+id$$NL$
+$END$
+$FOREACH id CND.ID_LIST$
+	#define $id$	$+id$$NL$
+$END$
 $FOREACH id MPF.ID_LIST$
 	#define $id$	$+id$$NL$
 $END$
@@ -147,6 +155,12 @@ $IF USE_EXTERNAL_ID$
 	$FOREACH id MTX.ID_LIST$
 		const ID $id$_id$SPC$=$SPC$$+id$;$NL$
 	$END$
+	$FOREACH id RWL.ID_LIST$
+		const ID $id$_id$SPC$=$SPC$$+id$;$NL$
+	$END$
+	$FOREACH id CND.ID_LIST$
+		const ID $id$_id$SPC$=$SPC$$+id$;$NL$
+	$END$
 	$FOREACH id MPF.ID_LIST$
 		const ID $id$_id$SPC$=$SPC$$+id$;$NL$
 	$END$
@@ -333,6 +347,16 @@ $ イベントフラグID番号の最大値
 const ID _kernel_tmax_flgid = (TMIN_FLGID + TNUM_FLGID - 1);$NL$
 $NL$
 
+$ イベントフラグ待ちインデックスの生成
+$IF TOPPERS_FLG_WAIT_INDEX$
+	$FOREACH flgid FLG.ID_LIST$
+		$IF (FLG.FLGATR[flgid] & (TA_TPRI|TA_WMUL)) == TA_WMUL$
+			static FLGWIDX _kernel_flgwidx_$flgid$;$NL$
+		$END$
+	$END$
+	$NL$
+$END$
+
 $ イベントフラグ初期化ブロックの生成
 $IF LENGTH(FLG.ID_LIST)$
 	const FLGINIB _kernel_flginib_table[TNUM_FLGID] = {$NL$
@@ -348,7 +372,15 @@ $		// iflgptnがFLGPTNに格納できない場合（E_PAR）
 		$END$
 
 $		// イベントフラグ初期化ブロック
-		$TAB${ ($FLG.FLGATR[flgid]$), ($FLG.IFLGPTN[flgid]$) }
+		$TAB${ ($FLG.FLGATR[flgid]$), ($FLG.IFLGPTN[flgid]$)
+		$IF TOPPERS_FLG_WAIT_INDEX$
+			$IF (FLG.FLGATR[flgid] & (TA_TPRI|TA_WMUL)) == TA_WMUL$
+				, &_kernel_flgwidx_$flgid$
+			$ELSE$
+				, NULL
+			$END$
+		$END$
+		$SPC$}
 	$END$$NL$
 	};$NL$
 	$NL$
@@ -477,6 +509,16 @@ $ メールボックスID番号の最大値
 const ID _kernel_tmax_mbxid = (TMIN_MBXID + TNUM_MBXID - 1);$NL$
 $NL$
 
+$ 優先度ごとの末尾のメッセージの領域の生成
+$IF TOPPERS_MBX_PRI_QUEUE$
+	$FOREACH mbxid MBX.ID_LIST$
+		$IF (MBX.MBXATR[mbxid] & TA_MPRI) != 0$
+			static T_MSG *_kernel_mprilast_$mbxid$[$MBX.MAXMPRI[mbxid]$];$NL$
+		$END$
+	$END$
+	$NL$
+$END$
+
 $ メールボックス初期化ブロックの生成
 $IF LENGTH(MBX.ID_LIST)$
 	const MBXINIB _kernel_mbxinib_table[TNUM_MBXID] = {$NL$
@@ -497,7 +539,15 @@ $		// mprihdがNULLでない場合（E_NOSPT）
 		$END$
 
 $		// メールボックス初期化ブロック
-		$TAB${ ($MBX.MBXATR[mbxid]$), ($MBX.MAXMPRI[mbxid]$) }
+		$TAB${ ($MBX.MBXATR[mbxid]$), ($MBX.MAXMPRI[mbxid]$)
+		$IF TOPPERS_MBX_PRI_QUEUE$
+			$IF (MBX.MBXATR[mbxid] & TA_MPRI) != 0$
+				, _kernel_mprilast_$mbxid$
+			$ELSE$
+				, NULL
+			$END$
+		$END$
+		$SPC$}
 	$END$$NL$
 	};$NL$
 	$NL$
@@ -547,9 +597,98 @@ $		// ミューテックス初期化ブロック
 
 $	// ミューテックス管理ブロック
 	MTXCB _kernel_mtxcb_table[TNUM_MTXID];$NL$
+$	// ミューテックスのオーナワード
+	$IF TOPPERS_MTX_FASTPATH$
+		uint32_t _kernel_mtxword_table[TNUM_MTXID];$NL$
+	$END$
 $ELSE$
 	TOPPERS_EMPTY_LABEL(const MTXINIB, _kernel_mtxinib_table);$NL$
 	TOPPERS_EMPTY_LABEL(MTXCB, _kernel_mtxcb_table);$NL$
+	$IF TOPPERS_MTX_FASTPATH$
+		TOPPERS_EMPTY_LABEL(uint32_t, _kernel_mtxword_table);$NL$
+	$END$
+$END$$NL$
+
+$ 
+$  リーダライタロック
+$ 
+/*$NL$
+$SPC$*  Reader-Writer Lock Functions$NL$
+$SPC$*/$NL$
+$NL$
+
+$ リーダライタロックID番号の最大値
+const ID _kernel_tmax_rwlid = (TMIN_RWLID + TNUM_RWLID - 1);$NL$
+$NL$
+
+$ リーダライタロック初期化ブロックの生成
+$IF LENGTH(RWL.ID_LIST)$
+	$FOREACH rwlid RWL.ID_LIST$
+$		// rwlatrが（［TA_TPRI｜TA_CEILING］｜［TA_WPREF］）でない場合（E_RSATR）
+		$IF !((RWL.RWLATR[rwlid] & ~TA_WPREF) == 0 || (RWL.RWLATR[rwlid] & ~TA_WPREF) == TA_TPRI || (RWL.RWLATR[rwlid] & ~TA_WPREF) == TA_CEILING)$
+			$ERROR RWL.TEXT_LINE[rwlid]$E_RSATR: $FORMAT(_("illegal %1% `%2%\' of `%3%\' in %4%"), "rwlatr", RWL.RWLATR[rwlid], rwlid, "CRE_RWL")$$END$
+		$END$
+
+$		// ceilpriが未指定の場合は0と見なす
+		$IF !LENGTH(RWL.CEILPRI[rwlid])$
+			$RWL.CEILPRI[rwlid] = 0$
+		$END$
+$		// (TMIN_TPRI <= ceilpri && ceilpri <= TMAX_TPRI)でない場合（E_PAR）
+		$IF (RWL.RWLATR[rwlid] & ~TA_WPREF) == TA_CEILING && (RWL.CEILPRI[rwlid] < TMIN_TPRI || TMAX_TPRI < RWL.CEILPRI[rwlid])$
+			$ERROR RWL.TEXT_LINE[rwlid]$E_PAR: $FORMAT(_("illegal %1% `%2%\' of `%3%\' in %4%"), "ceilpri", RWL.CEILPRI[rwlid], rwlid, "CRE_RWL")$$END$
+		$END$
+
+$		// リーダライタロック保持ブロックの領域
+		static RWLHOLD _kernel_rwlhold_$rwlid$[TNUM_TSKID];$NL$
+	$END$
+
+	const RWLINIB _kernel_rwlinib_table[TNUM_RWLID] = {$NL$
+	$JOINEACH rwlid RWL.ID_LIST ",\n"$
+$		// リーダライタロック初期化ブロック
+		$TAB${ ($RWL.RWLATR[rwlid]$), INT_PRIORITY($RWL.CEILPRI[rwlid]$), _kernel_rwlhold_$rwlid$ }
+	$END$$NL$
+	};$NL$
+	$NL$
+
+$	// リーダライタロック管理ブロック
+	RWLCB _kernel_rwlcb_table[TNUM_RWLID];$NL$
+$ELSE$
+	TOPPERS_EMPTY_LABEL(const RWLINIB, _kernel_rwlinib_table);$NL$
+	TOPPERS_EMPTY_LABEL(RWLCB, _kernel_rwlcb_table);$NL$
+$END$$NL$
+
+$ 
+$  条件変数
+$ 
+/*$NL$
+$SPC$*  Condition Variable Functions$NL$
+$SPC$*/$NL$
+$NL$
+
+$ 条件変数ID番号の最大値
+const ID _kernel_tmax_cndid = (TMIN_CNDID + TNUM_CNDID - 1);$NL$
+$NL$
+
+$ 条件変数初期化ブロックの生成
+$IF LENGTH(CND.ID_LIST)$
+	const CNDINIB _kernel_cndinib_table[TNUM_CNDID] = {$NL$
+	$JOINEACH cndid CND.ID_LIST ",\n"$
+$		// cndatrが（［TA_TPRI］）でない場合（E_RSATR）
+		$IF (CND.CNDATR[cndid] & ~TA_TPRI) != 0$
+			$ERROR CND.TEXT_LINE[cndid]$E_RSATR: $FORMAT(_("illegal %1% `%2%\' of `%3%\' in %4%"), "cndatr", CND.CNDATR[cndid], cndid, "CRE_CND")$$END$
+		$END$
+
+$		// 条件変数初期化ブロック
+		$TAB${ ($CND.CNDATR[cndid]$) }
+	$END$$NL$
+	};$NL$
+	$NL$
+
+$	// 条件変数管理ブロック
+	CNDCB _kernel_cndcb_table[TNUM_CNDID];$NL$
+$ELSE$
+	TOPPERS_EMPTY_LABEL(const CNDINIB, _kernel_cndinib_table);$NL$
+	TOPPERS_EMPTY_LABEL(CNDCB, _kernel_cndcb_table);$NL$
 $END$$NL$
 
 $ 
@@ -1099,6 +1238,8 @@ $IF LENGTH(DTQ.ID_LIST)$$TAB$_kernel_initialize_dataqueue();$NL$$END$
 $IF LENGTH(PDQ.ID_LIST)$$TAB$_kernel_initialize_pridataq();$NL$$END$
 $IF LENGTH(MBX.ID_LIST)$$TAB$_kernel_initialize_mailbox();$NL$$END$
 $IF LENGTH(MTX.ID_LIST)$$TAB$_kernel_initialize_mutex();$NL$$END$
+$IF LENGTH(RWL.ID_LIST)$$TAB$_kernel_initialize_rwlock();$NL$$END$
+$IF LENGTH(CND.ID_LIST)$$TAB$_kernel_initialize_cond();$NL$$END$
 $IF LENGTH(MPF.ID_LIST)$$TAB$_kernel_initialize_mempfix();$NL$$END$
 $IF LENGTH(CYC.ID_LIST)$$TAB$_kernel_initialize_cyclic();$NL$$END$
 $IF LENGTH(ALM.ID_LIST)$$TAB$_kernel_initialize_alarm();$NL$$END$
@@ -122,6 +122,8 @@
 #define TMIN_PDQID		1		/* 優先度データキューIDの最小値 */
 #define TMIN_MBXID		1		/* メールボックスIDの最小値 */
 #define TMIN_MTXID		1		/* ミューテックスIDの最小値 */
+#define TMIN_RWLID		1		/* リーダライタロックIDの最小値 */
+#define TMIN_CNDID		1		/* 条件変数IDの最小値 */
 #define TMIN_MPFID		1		/* 固定長メモリプールIDの最小値 */
 #define TMIN_CYCID		1		/* 周期ハンドラIDの最小値 */
 #define TMIN_ALMID		1		/* アラームハンドラIDの最小値 */
@@ -62,6 +62,8 @@
 #include "pridataq.h"
 #include "mailbox.h"
 #include "mutex.h"
+#include "rwlock.h"
+#include "cond.h"
 #include "mempfix.h"
 #include "cyclic.h"
 #include "alarm.h"
@@ -35,12 +35,14 @@
  *  wait.c
  */
 #define make_wait_tmout				_kernel_make_wait_tmout
+#define wait_dequeue_wobj			_kernel_wait_dequeue_wobj
 #define wait_complete				_kernel_wait_complete
 #define wait_tmout					_kernel_wait_tmout
 #define wait_tmout_ok				_kernel_wait_tmout_ok
 #define wait_release				_kernel_wait_release
 #define wobj_make_wait				_kernel_wobj_make_wait
 #define wobj_make_wait_tmout		_kernel_wobj_make_wait_tmout
+#define wobj_change_priority		_kernel_wobj_change_priority
 #define init_wait_queue				_kernel_init_wait_queue
 
 /*
@@ -69,6 +71,10 @@
  */
 #define initialize_eventflag		_kernel_initialize_eventflag
 #define check_flg_cond				_kernel_check_flg_cond
+#define flg_index_make_wait			_kernel_flg_index_make_wait
+#define flg_index_release			_kernel_flg_index_release
+#define flg_index_init				_kernel_flg_index_init
+#define flg_index_tskid				_kernel_flg_index_tskid
 
 /*
  *  dataqueue.c
@@ -107,6 +113,32 @@
 #define mutex_calc_priority			_kernel_mutex_calc_priority
 #define mutex_release				_kernel_mutex_release
 #define mutex_release_all			_kernel_mutex_release_all
+#define mutex_cond_release			_kernel_mutex_cond_release
+#define mutex_cond_wakeup			_kernel_mutex_cond_wakeup
+#define mutex_cond_relock			_kernel_mutex_cond_relock
+
+/*
+ *  rwlock.c
+ */
+#define rwlhook_dequeue_wobj		_kernel_rwlhook_dequeue_wobj
+#define rwlhook_change_priority		_kernel_rwlhook_change_priority
+#define rwlhook_check_ceilpri		_kernel_rwlhook_check_ceilpri
+#define rwlhook_scan_ceilrwl		_kernel_rwlhook_scan_ceilrwl
+#define rwlhook_calc_priority		_kernel_rwlhook_calc_priority
+#define rwlhook_release_all			_kernel_rwlhook_release_all
+#define initialize_rwlock			_kernel_initialize_rwlock
+#define rwlock_check_ceilpri		_kernel_rwlock_check_ceilpri
+#define rwlock_scan_ceilrwl			_kernel_rwlock_scan_ceilrwl
+#define rwlock_calc_priority		_kernel_rwlock_calc_priority
+#define rwlock_wakeup				_kernel_rwlock_wakeup
+#define rwlock_release_all			_kernel_rwlock_release_all
+#define rwlock_dequeue_wobj			_kernel_rwlock_dequeue_wobj
+#define rwlock_change_priority		_kernel_rwlock_change_priority
+
+/*
+ *  cond.c
+ */
+#define initialize_cond				_kernel_initialize_cond
 
 /*
  *  mempfix.c
@@ -136,6 +168,12 @@
  */
 #define initialize_exception		_kernel_initialize_exception
 
+/*
+ *  multi_wait.c
+ */
+#define mwaitcb						_kernel_mwaitcb
+#define notify_multi_wait			_kernel_notify_multi_wait
+
 /*
  *  kernel_cfg.c
  */
@@ -164,6 +202,13 @@
 #define tmax_mtxid					_kernel_tmax_mtxid
 #define mtxinib_table				_kernel_mtxinib_table
 #define mtxcb_table					_kernel_mtxcb_table
+#define mtxword_table				_kernel_mtxword_table
+#define tmax_rwlid					_kernel_tmax_rwlid
+#define rwlinib_table				_kernel_rwlinib_table
+#define rwlcb_table					_kernel_rwlcb_table
+#define tmax_cndid					_kernel_tmax_cndid
+#define cndinib_table				_kernel_cndinib_table
+#define cndcb_table					_kernel_cndcb_table
 #define tmax_mpfid					_kernel_tmax_mpfid
 #define mpfinib_table				_kernel_mpfinib_table
 #define mpfcb_table					_kernel_mpfcb_table
@@ -219,12 +264,14 @@
  *  wait.c
  */
 #define _make_wait_tmout			__kernel_make_wait_tmout
+#define _wait_dequeue_wobj			__kernel_wait_dequeue_wobj
 #define _wait_complete				__kernel_wait_complete
 #define _wait_tmout					__kernel_wait_tmout
 #define _wait_tmout_ok				__kernel_wait_tmout_ok
 #define _wait_release				__kernel_wait_release
 #define _wobj_make_wait				__kernel_wobj_make_wait
 #define _wobj_make_wait_tmout		__kernel_wobj_make_wait_tmout
+#define _wobj_change_priority		__kernel_wobj_change_priority
 #define _init_wait_queue			__kernel_init_wait_queue
 
 /*
@@ -253,6 +300,10 @@
  */
 #define _initialize_eventflag		__kernel_initialize_eventflag
 #define _check_flg_cond				__kernel_check_flg_cond
+#define _flg_index_make_wait		__kernel_flg_index_make_wait
+#define _flg_index_release			__kernel_flg_index_release
+#define _flg_index_init				__kernel_flg_index_init
+#define _flg_index_tskid			__kernel_flg_index_tskid
 
 /*
  *  dataqueue.c
@@ -291,6 +342,32 @@
 #define _mutex_calc_priority		__kernel_mutex_calc_priority
 #define _mutex_release				__kernel_mutex_release
 #define _mutex_release_all			__kernel_mutex_release_all
+#define _mutex_cond_release			__kernel_mutex_cond_release
+#define _mutex_cond_wakeup			__kernel_mutex_cond_wakeup
+#define _mutex_cond_relock			__kernel_mutex_cond_relock
+
+/*
+ *  rwlock.c
+ */
+#define _rwlhook_dequeue_wobj		__kernel_rwlhook_dequeue_wobj
+#define _rwlhook_change_priority	__kernel_rwlhook_change_priority
+#define _rwlhook_check_ceilpri		__kernel_rwlhook_check_ceilpri
+#define _rwlhook_scan_ceilrwl		__kernel_rwlhook_scan_ceilrwl
+#define _rwlhook_calc_priority		__kernel_rwlhook_calc_priority
+#define _rwlhook_release_all		__kernel_rwlhook_release_all
+#define _initialize_rwlock			__kernel_initialize_rwlock
+#define _rwlock_check_ceilpri		__kernel_rwlock_check_ceilpri
+#define _rwlock_scan_ceilrwl		__kernel_rwlock_scan_ceilrwl
+#define _rwlock_calc_priority		__kernel_rwlock_calc_priority
+#define _rwlock_wakeup				__kernel_rwlock_wakeup
+#define _rwlock_release_all			__kernel_rwlock_release_all
+#define _rwlock_dequeue_wobj		__kernel_rwlock_dequeue_wobj
+#define _rwlock_change_priority		__kernel_rwlock_change_priority
+
+/*
+ *  cond.c
+ */
+#define _initialize_cond			__kernel_initialize_cond
 
 /*
  *  mempfix.c
@@ -320,6 +397,12 @@
  */
 #define _initialize_exception		__kernel_initialize_exception
 
+/*
+ *  multi_wait.c
+ */
+#define _mwaitcb					__kernel_mwaitcb
+#define _notify_multi_wait			__kernel_notify_multi_wait
+
 /*
  *  kernel_cfg.c
  */
@@ -348,6 +431,13 @@
 #define _tmax_mtxid					__kernel_tmax_mtxid
 #define _mtxinib_table				__kernel_mtxinib_table
 #define _mtxcb_table				__kernel_mtxcb_table
+#define _mtxword_table				__kernel_mtxword_table
+#define _tmax_rwlid					__kernel_tmax_rwlid
+#define _rwlinib_table				__kernel_rwlinib_table
+#define _rwlcb_table				__kernel_rwlcb_table
+#define _tmax_cndid					__kernel_tmax_cndid
+#define _cndinib_table				__kernel_cndinib_table
+#define _cndcb_table				__kernel_cndcb_table
 #define _tmax_mpfid					__kernel_tmax_mpfid
 #define _mpfinib_table				__kernel_mpfinib_table
 #define _mpfcb_table				__kernel_mpfcb_table
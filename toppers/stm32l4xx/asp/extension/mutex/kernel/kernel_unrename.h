@@ -36,12 +36,14 @@
  *  wait.c
  */
 #undef make_wait_tmout
+#undef wait_dequeue_wobj
 #undef wait_complete
 #undef wait_tmout
 #undef wait_tmout_ok
 #undef wait_release
 #undef wobj_make_wait
 #undef wobj_make_wait_tmout
+#undef wobj_change_priority
 #undef init_wait_queue
 
 /*
@@ -70,6 +72,10 @@
  */
 #undef initialize_eventflag
 #undef check_flg_cond
+#undef flg_index_make_wait
+#undef flg_index_release
+#undef flg_index_init
+#undef flg_index_tskid
 
 /*
  *  dataqueue.c
@@ -108,6 +114,32 @@
 #undef mutex_calc_priority
 #undef mutex_release
 #undef mutex_release_all
+#undef mutex_cond_release
+#undef mutex_cond_wakeup
+#undef mutex_cond_relock
+
+/*
+ *  rwlock.c
+ */
+#undef rwlhook_dequeue_wobj
+#undef rwlhook_change_priority
+#undef rwlhook_check_ceilpri
+#undef rwlhook_scan_ceilrwl
+#undef rwlhook_calc_priority
+#undef rwlhook_release_all
+#undef initialize_rwlock
+#undef rwlock_check_ceilpri
+#undef rwlock_scan_ceilrwl
+#undef rwlock_calc_priority
+#undef rwlock_wakeup
+#undef rwlock_release_all
+#undef rwlock_dequeue_wobj
+#undef rwlock_change_priority
+
+/*
+ *  cond.c
+ */
+#undef initialize_cond
 
 /*
  *  mempfix.c
@@ -137,6 +169,12 @@
  */
 #undef initialize_exception
 
+/*
+ *  multi_wait.c
+ */
+#undef mwaitcb
+#undef notify_multi_wait
+
 /*
  *  kernel_cfg.c
  */
@@ -165,6 +203,13 @@
 #undef tmax_mtxid
 #undef mtxinib_table
 #undef mtxcb_table
+#undef mtxword_table
+#undef tmax_rwlid
+#undef rwlinib_table
+#undef rwlcb_table
+#undef tmax_cndid
+#undef cndinib_table
+#undef cndcb_table
 #undef tmax_mpfid
 #undef mpfinib_table
 #undef mpfcb_table
@@ -220,12 +265,14 @@
  *  wait.c
  */
 #undef _make_wait_tmout
+#undef _wait_dequeue_wobj
 #undef _wait_complete
 #undef _wait_tmout
 #undef _wait_tmout_ok
 #undef _wait_release
 #undef _wobj_make_wait
 #undef _wobj_make_wait_tmout
+#undef _wobj_change_priority
 #undef _init_wait_queue
 
 /*
@@ -254,6 +301,10 @@
  */
 #undef _initialize_eventflag
 #undef _check_flg_cond
+#undef _flg_index_make_wait
+#undef _flg_index_release
+#undef _flg_index_init
+#undef _flg_index_tskid
 
 /*
  *  dataqueue.c
@@ -292,6 +343,32 @@
 #undef _mutex_calc_priority
 #undef _mutex_release
 #undef _mutex_release_all
+#undef _mutex_cond_release
+#undef _mutex_cond_wakeup
+#undef _mutex_cond_relock
+
+/*
+ *  rwlock.c
+ */
+#undef _rwlhook_dequeue_wobj
+#undef _rwlhook_change_priority
+#undef _rwlhook_check_ceilpri
+#undef _rwlhook_scan_ceilrwl
+#undef _rwlhook_calc_priority
+#undef _rwlhook_release_all
+#undef _initialize_rwlock
+#undef _rwlock_check_ceilpri
+#undef _rwlock_scan_ceilrwl
+#undef _rwlock_calc_priority
+#undef _rwlock_wakeup
+#undef _rwlock_release_all
+#undef _rwlock_dequeue_wobj
+#undef _rwlock_change_priority
+
+/*
+ *  cond.c
+ */
+#undef _initialize_cond
 
 /*
  *  mempfix.c
@@ -321,6 +398,12 @@
  */
 #undef _initialize_exception
 
+/*
+ *  multi_wait.c
+ */
+#undef _mwaitcb
+#undef _notify_multi_wait
+
 /*
  *  kernel_cfg.c
  */
@@ -349,6 +432,13 @@
 #undef _tmax_mtxid
 #undef _mtxinib_table
 #undef _mtxcb_table
+#undef _mtxword_table
+#undef _tmax_rwlid
+#undef _rwlinib_table
+#undef _rwlcb_table
+#undef _tmax_cndid
+#undef _cndinib_table
+#undef _cndcb_table
 #undef _tmax_mpfid
 #undef _mpfinib_table
 #undef _mpfcb_table
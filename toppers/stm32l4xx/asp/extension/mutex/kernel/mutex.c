@@ -47,6 +47,8 @@
 #include "task.h"
 #include "wait.h"
 #include "mutex.h"
+#include "rwlock.h"
+#include "cond.h"
 
 /*
  *  トレースログマクロのデフォルト定義
@@ -155,6 +157,9 @@ initialize_mutex(void)
 		queue_initialize(&(p_mtxcb->wait_queue));
 		p_mtxcb->p_mtxinib = &(mtxinib_table[i]);
 		p_mtxcb->p_loctsk = NULL;
+#ifdef TOPPERS_MTX_FASTPATH
+		MTXWORD(p_mtxcb) = MTX_CEILING(p_mtxcb) ? MTXWORD_KERNEL : 0U;
+#endif /* TOPPERS_MTX_FASTPATH */
 	}
 }
 
@@ -195,6 +200,18 @@ mutex_check_ceilpri(TCB *p_tcb, uint_t bpriority)
 		}
 	}
 
+	/*
+	 *  タスクが条件変数を待っている場合に，待ち解除後に再ロックする優
+	 *  先度上限ミューテックスの上限優先度がbpriorityよりも低くければ，
+	 *  falseを返す．
+	 */
+	if (TSTAT_WAIT_CND(p_tcb->tstat)) {
+		p_mtxcb = ((WINFO_CND *)(p_tcb->p_winfo))->p_mtxcb;
+		if (MTX_CEILING(p_mtxcb) && bpriority < p_mtxcb->p_mtxinib->ceilpri) {
+			return(false);
+		}
+	}
+
 	/*
 	 *  いずれの条件にも当てはまらなければtrueを返す．
 	 */
@@ -248,6 +265,9 @@ mutex_calc_priority(TCB *p_tcb)
 		}
 		p_queue = p_queue->p_next;
 	}
+	if (RWLOCK_MAY_BE_LOCKED(p_tcb)) {
+		priority = (*rwlhook_calc_priority)(p_tcb, priority);
+	}
 	return(priority);
 }
 
@@ -290,12 +310,43 @@ mutex_acquire(TCB *p_loctsk, MTXCB *p_mtxcb)
 {
 	p_mtxcb->p_loctsk = p_loctsk;
 	queue_insert_next(&(p_loctsk->mutex_queue), &(p_mtxcb->mutex_queue));
+#ifdef TOPPERS_MTX_FASTPATH
+	MTXWORD(p_mtxcb) = MTXWORD_KERNEL;
+#endif /* TOPPERS_MTX_FASTPATH */
 	if (MTX_CEILING(p_mtxcb)) {
 		return(mutex_raise_priority(p_loctsk, p_mtxcb->p_mtxinib->ceilpri));
 	}
 	return(false);
 }
 
+/*
+ *  高速パスでロックされたミューテックスの管理ブロックへの反映
+ *
+ *  floc_mtxでロックされているミューテックスは，管理ブロック上はロック
+ *  されていないため，ロックしているタスクにミューテックスをロックさせ，
+ *  以降はカーネルが状態を管理する．CPUロック状態で呼び出す．高速パス
+ *  でロックできるのは優先度上限ミューテックス以外であるため，優先度の
+ *  変更は起こらない．
+ */
+#ifdef TOPPERS_MTX_FASTPATH
+
+Inline void
+mutex_adopt(MTXCB *p_mtxcb)
+{
+	uint32_t	word = MTXWORD(p_mtxcb);
+	TCB			*p_tcb;
+
+	if (word != 0U && word != MTXWORD_KERNEL) {
+		p_tcb = (TCB *)(uintptr_t) word;
+		p_tcb->mtxfcnt--;
+		(void) mutex_acquire(p_tcb, p_mtxcb);
+	}
+}
+
+#else /* TOPPERS_MTX_FASTPATH */
+#define mutex_adopt(p_mtxcb)
+#endif /* TOPPERS_MTX_FASTPATH */
+
 /*
  *  ミューテックスのロック解除
  */
@@ -308,6 +359,9 @@ mutex_release(MTXCB *p_mtxcb)
 
 	if (queue_empty(&(p_mtxcb->wait_queue))) {
 		p_mtxcb->p_loctsk = NULL;
+#ifdef TOPPERS_MTX_FASTPATH
+		MTXWORD(p_mtxcb) = MTX_CEILING(p_mtxcb) ? MTXWORD_KERNEL : 0U;
+#endif /* TOPPERS_MTX_FASTPATH */
 		return(false);
 	}
 	else {
@@ -342,6 +396,22 @@ mutex_release_all(TCB *p_tcb)
 {
 	MTXCB	*p_mtxcb;
 	bool_t	dspreq = false;
+#ifdef TOPPERS_MTX_FASTPATH
+	uint_t	i;
+
+	/*
+	 *  高速パスでロックしているミューテックスは，待っているタスクがな
+	 *  いため，オーナワードを0に戻すだけでよい．mtxfcntが0の場合には，
+	 *  オーナワードを探索しない．
+	 */
+	for (i = 0; i < tnum_mtx && p_tcb->mtxfcnt > 0U; i++) {
+		if (mtxword_table[i] == (uint32_t)(uintptr_t) p_tcb) {
+			mtxword_table[i] = 0U;
+			p_tcb->mtxfcnt--;
+		}
+	}
+	p_tcb->mtxfcnt = 0U;
+#endif /* TOPPERS_MTX_FASTPATH */
 
 	while (!queue_empty(&(p_tcb->mutex_queue))) {
 		p_mtxcb = MTXCB_QUEUE(p_tcb->mutex_queue.p_next);
@@ -355,6 +425,104 @@ mutex_release_all(TCB *p_tcb)
 
 #endif /* TOPPERS_mtxrela */
 
+/*
+ *  条件変数待ちのためのミューテックスのロック解除
+ */
+#ifdef TOPPERS_mtxcrel
+
+bool_t
+mutex_cond_release(MTXCB *p_mtxcb)
+{
+	mutex_adopt(p_mtxcb);
+	if (p_mtxcb->p_loctsk != p_runtsk) {
+		return(false);
+	}
+	queue_delete(&(p_mtxcb->mutex_queue));
+	if (MTX_CEILING(p_mtxcb)) {
+		(void) mutex_drop_priority(p_runtsk, p_mtxcb->p_mtxinib->ceilpri);
+	}
+	(void) mutex_release(p_mtxcb);
+	return(true);
+}
+
+#endif /* TOPPERS_mtxcrel */
+
+/*
+ *  条件変数の待ち解除に伴うミューテックスの再ロック
+ *
+ *  タスクは条件変数の待ちキューから削除されているため，優先度の変更
+ *  にchange_priorityは使わない．ミューテックスのロック待ち状態に移す
+ *  場合には，条件変数待ち情報ブロックをミューテックス待ち情報ブロッ
+ *  クとして用いる．強制待ち状態であれば，二重待ち状態のままとする．
+ */
+#ifdef TOPPERS_mtxcwup
+
+bool_t
+mutex_cond_wakeup(MTXCB *p_mtxcb, TCB *p_tcb)
+{
+	wait_dequeue_tmevtb(p_tcb);
+	p_tcb->p_winfo->p_tmevtb = NULL;
+
+	mutex_adopt(p_mtxcb);
+	if (p_mtxcb->p_loctsk == NULL) {
+		p_tcb->p_winfo->wercd = E_OK;
+		p_mtxcb->p_loctsk = p_tcb;
+		queue_insert_prev(&(p_tcb->mutex_queue), &(p_mtxcb->mutex_queue));
+#ifdef TOPPERS_MTX_FASTPATH
+		MTXWORD(p_mtxcb) = MTXWORD_KERNEL;
+#endif /* TOPPERS_MTX_FASTPATH */
+		if (MTX_CEILING(p_mtxcb)) {
+			if (p_mtxcb->p_mtxinib->ceilpri < p_tcb->priority) {
+				p_tcb->priority = p_mtxcb->p_mtxinib->ceilpri;
+			}
+		}
+		return(make_non_wait(p_tcb));
+	}
+	else {
+		p_tcb->tstat &= ~TS_WAIT_MASK;
+		p_tcb->tstat |= TS_WAIT_MTX;
+		((WINFO_MTX *)(p_tcb->p_winfo))->p_mtxcb = p_mtxcb;
+		if ((p_mtxcb->p_mtxinib->mtxatr & TA_TPRI) != 0U) {
+			queue_insert_tpri(&(p_mtxcb->wait_queue), p_tcb);
+		}
+		else {
+			queue_insert_prev(&(p_mtxcb->wait_queue), &(p_tcb->task_queue));
+		}
+		LOG_TSKSTAT(p_tcb);
+		return(false);
+	}
+}
+
+#endif /* TOPPERS_mtxcwup */
+
+/*
+ *  実行中のタスクによるミューテックスの再ロック
+ *
+ *  ロックを解除する前に保持していたミューテックスであるため，上限優
+ *  先度違反のチェックは行わない．
+ */
+#ifdef TOPPERS_mtxcloc
+
+ER
+mutex_cond_relock(MTXCB *p_mtxcb)
+{
+	WINFO_MTX winfo_mtx;
+
+	mutex_adopt(p_mtxcb);
+	if (p_mtxcb->p_loctsk == NULL) {
+		(void) mutex_acquire(p_runtsk, p_mtxcb);
+		return(E_OK);
+	}
+	else {
+		p_runtsk->tstat = (TS_WAITING | TS_WAIT_MTX);
+		wobj_make_wait((WOBJCB *) p_mtxcb, (WINFO_WOBJ *) &winfo_mtx);
+		dispatch();
+		return(winfo_mtx.winfo.wercd);
+	}
+}
+
+#endif /* TOPPERS_mtxcloc */
+
 /*
  *  ミューテックスのロック
  */
@@ -373,6 +541,7 @@ loc_mtx(ID mtxid)
 	p_mtxcb = get_mtxcb(mtxid);
 
 	t_lock_cpu();
+	mutex_adopt(p_mtxcb);
 	if (MTX_CEILING(p_mtxcb)
 				&& p_runtsk->bpriority < p_mtxcb->p_mtxinib->ceilpri) {
 		ercd = E_ILUSE;
@@ -421,6 +590,7 @@ ploc_mtx(ID mtxid)
 	p_mtxcb = get_mtxcb(mtxid);
 
 	t_lock_cpu();
+	mutex_adopt(p_mtxcb);
 	if (MTX_CEILING(p_mtxcb)
 				&& p_runtsk->bpriority < p_mtxcb->p_mtxinib->ceilpri) {
 		ercd = E_ILUSE;
@@ -469,6 +639,7 @@ tloc_mtx(ID mtxid, TMO tmout)
 	p_mtxcb = get_mtxcb(mtxid);
 
 	t_lock_cpu();
+	mutex_adopt(p_mtxcb);
 	if (MTX_CEILING(p_mtxcb)
 				&& p_runtsk->bpriority < p_mtxcb->p_mtxinib->ceilpri) {
 		ercd = E_ILUSE;
@@ -522,6 +693,7 @@ unl_mtx(ID mtxid)
 	p_mtxcb = get_mtxcb(mtxid);
 
 	t_lock_cpu();
+	mutex_adopt(p_mtxcb);
 	if (p_mtxcb->p_loctsk != p_runtsk) {
 		ercd = E_OBJ;
 	}
@@ -568,11 +740,15 @@ ini_mtx(ID mtxid)
 	p_mtxcb = get_mtxcb(mtxid);
 
 	t_lock_cpu();
+	mutex_adopt(p_mtxcb);
 	dspreq = init_wait_queue(&(p_mtxcb->wait_queue));
 	p_loctsk = p_mtxcb->p_loctsk;
 	if (p_loctsk != NULL) {
 		queue_delete(&(p_mtxcb->mutex_queue));
 		p_mtxcb->p_loctsk = NULL;
+#ifdef TOPPERS_MTX_FASTPATH
+		MTXWORD(p_mtxcb) = MTX_CEILING(p_mtxcb) ? MTXWORD_KERNEL : 0U;
+#endif /* TOPPERS_MTX_FASTPATH */
 		if (MTX_CEILING(p_mtxcb)) {
 			if (mutex_drop_priority(p_loctsk, p_mtxcb->p_mtxinib->ceilpri)) {
 				dspreq = true;
@@ -611,6 +787,11 @@ ref_mtx(ID mtxid, T_RMTX *pk_rmtx)
 	t_lock_cpu();
 	pk_rmtx->htskid = (p_mtxcb->p_loctsk != NULL) ? TSKID(p_mtxcb->p_loctsk)
 													: TSK_NONE;
+#ifdef TOPPERS_MTX_FASTPATH
+	if (MTXWORD(p_mtxcb) != 0U && MTXWORD(p_mtxcb) != MTXWORD_KERNEL) {
+		pk_rmtx->htskid = TSKID((TCB *)(uintptr_t) MTXWORD(p_mtxcb));
+	}
+#endif /* TOPPERS_MTX_FASTPATH */
 	pk_rmtx->wtskid = wait_tskid(&(p_mtxcb->wait_queue));
 	ercd = E_OK;
 	t_unlock_cpu();
@@ -105,6 +105,21 @@ extern MTXCB	mtxcb_table[];
  */
 #define	MTXID(p_mtxcb)	((ID)(((p_mtxcb) - mtxcb_table) + TMIN_MTXID))
 
+#ifdef TOPPERS_MTX_FASTPATH
+/*
+ *  ミューテックスのオーナワードのエリア（kernel_cfg.c）
+ *
+ *  floc_mtx／funl_mtxが排他ロード／排他ストア命令で操作するワードで，
+ *  0はロックされていない状態，TCBへのポインタはそのタスクが高速パスで
+ *  ロックしている状態，MTXWORD_KERNELはカーネルが管理ブロックで状態を
+ *  管理している状態を示す．
+ */
+extern uint32_t	mtxword_table[];
+
+#define MTXWORD_KERNEL		1U
+#define MTXWORD(p_mtxcb)	(mtxword_table[(p_mtxcb) - mtxcb_table])
+#endif /* TOPPERS_MTX_FASTPATH */
+
 /*
  *  ミューテックス機能の初期化
  */
@@ -115,8 +130,9 @@ extern void	initialize_mutex(void);
  *
  *  chg_priの中で上限優先度違反のチェックを行うために用いる関数であり，
  *  p_tcbで指定されるタスクがロックしている優先度上限ミューテックスと，
- *  ロックを待っている優先度上限ミューテックスの中で，上限優先度が
- *  bpriorityよりも低いものがあればfalseを，そうでなければtrueを返す．
+ *  ロックを待っている（条件変数の待ち解除後に再ロックするものを含む）
+ *  優先度上限ミューテックスの中で，上限優先度がbpriorityよりも低いも
+ *  のがあればfalseを，そうでなければtrueを返す．
  */
 extern bool_t	(*mtxhook_check_ceilpri)(TCB *p_tcb, uint_t bpriority);
 extern bool_t	mutex_check_ceilpri(TCB *p_tcb, uint_t bpriority);
@@ -134,6 +150,7 @@ extern bool_t	mutex_scan_ceilmtx(TCB *p_tcb);
  *  タスクの現在優先度の計算
  *
  *  p_tcbで指定されるタスクの現在優先度（に設定すべき値）を計算する．
+ *  ロックしている優先度上限リーダライタロックも考慮する．
  */
 extern uint_t	mutex_calc_priority(TCB *p_tcb);
 
@@ -162,4 +179,49 @@ extern bool_t	mutex_release(MTXCB *p_mtxcb);
 extern bool_t	(*mtxhook_release_all)(TCB *p_tcb);
 extern bool_t	mutex_release_all(TCB *p_tcb);
 
+/*
+ *  条件変数待ちのためのミューテックスのロック解除
+ *
+ *  実行中のタスクがp_mtxcbで指定されるミューテックスをロックしていれ
+ *  ば，ロックを解除してtrueを返す．ロックしていなければ，何もせずに
+ *  falseを返す．実行中のタスクはこの後で待ち状態に遷移するため，ディ
+ *  スパッチが必要かどうかは返さない．
+ */
+extern bool_t	mutex_cond_release(MTXCB *p_mtxcb);
+
+/*
+ *  条件変数の待ち解除に伴うミューテックスの再ロック
+ *
+ *  p_tcbで指定される条件変数待ちのタスク（条件変数の待ちキューからは
+ *  削除済み）に，p_mtxcbで指定されるミューテックスをロックさせて待ち
+ *  解除する．ミューテックスが他のタスクにロックされている場合には，タ
+ *  スクをミューテックスのロック待ち状態に移す．いずれの場合も，タイム
+ *  アウトの設定は解除する．ディスパッチが必要な場合にはtrueを返す．
+ */
+extern bool_t	mutex_cond_wakeup(MTXCB *p_mtxcb, TCB *p_tcb);
+
+/*
+ *  実行中のタスクによるミューテックスの再ロック
+ *
+ *  条件変数待ちがタイムアウトなどで解除された後に，実行中のタスクに
+ *  p_mtxcbで指定されるミューテックスをロックさせる．ロックされている
+ *  場合にはロック待ち状態となり，ロック待ちの結果を返す．
+ */
+extern ER		mutex_cond_relock(MTXCB *p_mtxcb);
+
+/*
+ *  タスクがミューテックスをロックしている可能性があるかのチェック
+ *
+ *  タスクの終了時にmutex_release_allを呼び出すかを判断するために用い
+ *  る．高速パスでロックしているミューテックスはmutex_queueにつながれ
+ *  ていないため，TOPPERS_MTX_FASTPATHを定義した場合には，その数
+ *  （mtxfcnt）もチェックする．
+ */
+#ifdef TOPPERS_MTX_FASTPATH
+#define MUTEX_MAY_BE_LOCKED(p_tcb)	(!queue_empty(&((p_tcb)->mutex_queue)) \
+										|| (p_tcb)->mtxfcnt > 0U)
+#else /* TOPPERS_MTX_FASTPATH */
+#define MUTEX_MAY_BE_LOCKED(p_tcb)	(!queue_empty(&((p_tcb)->mutex_queue)))
+#endif /* TOPPERS_MTX_FASTPATH */
+
 #endif /* TOPPERS_MUTEX_H */
@@ -0,0 +1,872 @@
+/*
+ *  TOPPERS/ASP Kernel
+ *      Toyohashi Open Platform for Embedded Real-Time Systems/
+ *      Advanced Standard Profile Kernel
+ * 
+ *  Copyright (C) 2005-2026 by Embedded and Real-Time Systems Laboratory
+ *              Graduate School of Information Science, Nagoya Univ., JAPAN
+ * 
+ *  上記著作権者は，以下の(1)〜(4)の条件を満たす場合に限り，本ソフトウェ
+ *  ア（本ソフトウェアを改変したものを含む．以下同じ）を使用・複製・改
+ *  変・再配布（以下，利用と呼ぶ）することを無償で許諾する．
+ *  (1) 本ソフトウェアをソースコードの形で利用する場合には，上記の著作
+ *      権表示，この利用条件および下記の無保証規定が，そのままの形でソー
+ *      スコード中に含まれていること．
+ *  (2) 本ソフトウェアを，ライブラリ形式など，他のソフトウェア開発に使
+ *      用できる形で再配布する場合には，再配布に伴うドキュメント（利用
+ *      者マニュアルなど）に，上記の著作権表示，この利用条件および下記
+ *      の無保証規定を掲載すること．
+ *  (3) 本ソフトウェアを，機器に組み込むなど，他のソフトウェア開発に使
+ *      用できない形で再配布する場合には，次のいずれかの条件を満たすこ
+ *      と．
+ *    (a) 再配布に伴うドキュメント（利用者マニュアルなど）に，上記の著
+ *        作権表示，この利用条件および下記の無保証規定を掲載すること．
+ *    (b) 再配布の形態を，別に定める方法によって，TOPPERSプロジェクトに
+ *        報告すること．
+ *  (4) 本ソフトウェアの利用により直接的または間接的に生じるいかなる損
+ *      害からも，上記著作権者およびTOPPERSプロジェクトを免責すること．
+ *      また，本ソフトウェアのユーザまたはエンドユーザからのいかなる理
+ *      由に基づく請求からも，上記著作権者およびTOPPERSプロジェクトを
+ *      免責すること．
+ * 
+ *  本ソフトウェアは，無保証で提供されているものである．上記著作権者お
+ *  よびTOPPERSプロジェクトは，本ソフトウェアに関して，特定の使用目的
+ *  に対する適合性も含めて，いかなる保証も行わない．また，本ソフトウェ
+ *  アの利用により直接的または間接的に生じたいかなる損害に関しても，そ
+ *  の責任を負わない．
+ * 
+ *  $Id$
+ */
+
+/*
+ *		リーダライタロック機能
+ */
+
+#include "kernel_impl.h"
+#include "check.h"
+#include "task.h"
+#include "wait.h"
+#include "mutex.h"
+#include "rwlock.h"
+
+/*
+ *  トレースログマクロのデフォルト定義
+ */
+#ifndef LOG_LOC_RDL_ENTER
+#define LOG_LOC_RDL_ENTER(rwlid)
+#endif /* LOG_LOC_RDL_ENTER */
+
+#ifndef LOG_LOC_RDL_LEAVE
+#define LOG_LOC_RDL_LEAVE(ercd)
+#endif /* LOG_LOC_RDL_LEAVE */
+
+#ifndef LOG_PLOC_RDL_ENTER
+#define LOG_PLOC_RDL_ENTER(rwlid)
+#endif /* LOG_PLOC_RDL_ENTER */
+
+#ifndef LOG_PLOC_RDL_LEAVE
+#define LOG_PLOC_RDL_LEAVE(ercd)
+#endif /* LOG_PLOC_RDL_LEAVE */
+
+#ifndef LOG_TLOC_RDL_ENTER
+#define LOG_TLOC_RDL_ENTER(rwlid, tmout)
+#endif /* LOG_TLOC_RDL_ENTER */
+
+#ifndef LOG_TLOC_RDL_LEAVE
+#define LOG_TLOC_RDL_LEAVE(ercd)
+#endif /* LOG_TLOC_RDL_LEAVE */
+
+#ifndef LOG_LOC_WRL_ENTER
+#define LOG_LOC_WRL_ENTER(rwlid)
+#endif /* LOG_LOC_WRL_ENTER */
+
+#ifndef LOG_LOC_WRL_LEAVE
+#define LOG_LOC_WRL_LEAVE(ercd)
+#endif /* LOG_LOC_WRL_LEAVE */
+
+#ifndef LOG_PLOC_WRL_ENTER
+#define LOG_PLOC_WRL_ENTER(rwlid)
+#endif /* LOG_PLOC_WRL_ENTER */
+
+#ifndef LOG_PLOC_WRL_LEAVE
+#define LOG_PLOC_WRL_LEAVE(ercd)
+#endif /* LOG_PLOC_WRL_LEAVE */
+
+#ifndef LOG_TLOC_WRL_ENTER
+#define LOG_TLOC_WRL_ENTER(rwlid, tmout)
+#endif /* LOG_TLOC_WRL_ENTER */
+
+#ifndef LOG_TLOC_WRL_LEAVE
+#define LOG_TLOC_WRL_LEAVE(ercd)
+#endif /* LOG_TLOC_WRL_LEAVE */
+
+#ifndef LOG_UNL_RWL_ENTER
+#define LOG_UNL_RWL_ENTER(rwlid)
+#endif /* LOG_UNL_RWL_ENTER */
+
+#ifndef LOG_UNL_RWL_LEAVE
+#define LOG_UNL_RWL_LEAVE(ercd)
+#endif /* LOG_UNL_RWL_LEAVE */
+
+#ifndef LOG_INI_RWL_ENTER
+#define LOG_INI_RWL_ENTER(rwlid)
+#endif /* LOG_INI_RWL_ENTER */
+
+#ifndef LOG_INI_RWL_LEAVE
+#define LOG_INI_RWL_LEAVE(ercd)
+#endif /* LOG_INI_RWL_LEAVE */
+
+#ifndef LOG_REF_RWL_ENTER
+#define LOG_REF_RWL_ENTER(rwlid, pk_rrwl)
+#endif /* LOG_REF_RWL_ENTER */
+
+#ifndef LOG_REF_RWL_LEAVE
+#define LOG_REF_RWL_LEAVE(ercd, pk_rrwl)
+#endif /* LOG_REF_RWL_LEAVE */
+
+/*
+ *  リーダライタロックの数
+ */
+#define tnum_rwl	((uint_t)(tmax_rwlid - TMIN_RWLID + 1))
+
+/*
+ *  リーダライタロックIDからリーダライタロック管理ブロックを取り出すた
+ *  めのマクロ
+ */
+#define INDEX_RWL(rwlid)	((uint_t)((rwlid) - TMIN_RWLID))
+#define get_rwlcb(rwlid)	(&(rwlcb_table[INDEX_RWL(rwlid)]))
+
+/*
+ *  リーダライタロックの属性を判断するマクロ
+ *
+ *  TA_CEILINGはTA_TPRIのビットを含むため，優先度上限リーダライタロッ
+ *  クの待ちキューはタスクの優先度順になる．
+ */
+#define RWLPROTO_MASK			0x03U
+#define RWLPROTO(p_rwlcb)		((p_rwlcb)->p_rwlinib->rwlatr & RWLPROTO_MASK)
+#define RWL_CEILING(p_rwlcb)	(RWLPROTO(p_rwlcb) == TA_CEILING)
+#define RWL_TPRI(p_rwlcb)		(((p_rwlcb)->p_rwlinib->rwlatr & TA_TPRI) != 0U)
+#define RWL_WPREF(p_rwlcb)		(((p_rwlcb)->p_rwlinib->rwlatr & TA_WPREF) != 0U)
+
+/*
+ *  リーダライタロック保持ブロックを取り出すためのマクロ
+ */
+#define RWLHOLD_INDEX(p_tcb)	((uint_t)((p_tcb) - tcb_table))
+#define RWLHOLD_TSK(p_rwlcb, p_tcb) \
+				(&((p_rwlcb)->p_rwlinib->p_rwlhold[RWLHOLD_INDEX(p_tcb)]))
+#define RWLHOLD_QUEUE(p_queue)	((RWLHOLD *)(p_queue))
+
+/*
+ *  タスクがリーダライタロックをロックしているかの判定
+ */
+Inline bool_t
+rwlock_holder(RWLCB *p_rwlcb, TCB *p_tcb)
+{
+	return(RWLHOLD_TSK(p_rwlcb, p_tcb)->rwlock_queue.p_next != NULL);
+}
+
+/*
+ *  ロック状態への記録
+ *
+ *  p_tcbで指定されるタスクが，リーダライタロックをロックした状態にす
+ *  る．タスクの優先度は変更しない．
+ */
+Inline void
+rwlock_record(RWLCB *p_rwlcb, TCB *p_tcb, bool_t wrmode)
+{
+	if (wrmode) {
+		p_rwlcb->p_wrtsk = p_tcb;
+	}
+	else {
+		p_rwlcb->rdcnt++;
+	}
+	queue_insert_prev(&(p_tcb->rwlock_queue),
+						&(RWLHOLD_TSK(p_rwlcb, p_tcb)->rwlock_queue));
+}
+
+/*
+ *  ロック状態からの削除
+ *
+ *  p_tcbで指定されるタスクが，リーダライタロックをロックしていない状
+ *  態にする．タスクの優先度は変更しない．
+ */
+Inline void
+rwlock_unrecord(RWLCB *p_rwlcb, TCB *p_tcb)
+{
+	RWLHOLD	*p_rwlhold = RWLHOLD_TSK(p_rwlcb, p_tcb);
+
+	if (p_rwlcb->p_wrtsk == p_tcb) {
+		p_rwlcb->p_wrtsk = NULL;
+	}
+	else {
+		p_rwlcb->rdcnt--;
+	}
+	queue_delete(&(p_rwlhold->rwlock_queue));
+	p_rwlhold->rwlock_queue.p_next = NULL;
+}
+
+/*
+ *  ロック解除に伴う現在優先度の変更
+ *
+ *  優先度上限リーダライタロックのロックを解除したタスクの現在優先度を，
+ *  ロックしている残りのミューテックスとリーダライタロックから計算し直
+ *  す．ディスパッチが必要な場合にはtrueを返す．
+ */
+Inline bool_t
+rwlock_drop_priority(RWLCB *p_rwlcb, TCB *p_tcb)
+{
+	uint_t	newpri;
+
+	if (RWL_CEILING(p_rwlcb)
+				&& p_rwlcb->p_rwlinib->ceilpri == p_tcb->priority) {
+		newpri = mutex_calc_priority(p_tcb);
+		if (newpri != p_tcb->priority) {
+			return(change_priority(p_tcb, newpri, true));
+		}
+	}
+	return(false);
+}
+
+/*
+ *  リーダライタロックを直ちにロックできるかの判定
+ *
+ *  書込みロックは，どのタスクもロックしていなければロックできる．読出
+ *  しロックは，書込みロックが保持されておらず，かつ，書込み優先
+ *  （TA_WPREF）の場合は書込みロックを待っているタスクがなければ，そう
+ *  でない場合は待ちキューの先頭に並ぶことになれば，ロックできる．
+ */
+Inline bool_t
+rwlock_ready(RWLCB *p_rwlcb, bool_t wrmode)
+{
+	if (p_rwlcb->p_wrtsk != NULL) {
+		return(false);
+	}
+	else if (wrmode) {
+		return(p_rwlcb->rdcnt == 0U);
+	}
+	else if (RWL_WPREF(p_rwlcb)) {
+		return(p_rwlcb->wwcnt == 0U);
+	}
+	else if (queue_empty(&(p_rwlcb->wait_queue))) {
+		return(true);
+	}
+	else {
+		return(RWL_TPRI(p_rwlcb) && p_runtsk->priority
+						< ((TCB *)(p_rwlcb->wait_queue.p_next))->priority);
+	}
+}
+
+/*
+ *  リーダライタロックのロック処理の共通部分
+ *
+ *  ロックできた場合はE_OK，ロックを待つ必要がある場合はE_TMOUTを返す．
+ */
+Inline ER
+rwlock_lock(RWLCB *p_rwlcb, bool_t wrmode)
+{
+	if (RWL_CEILING(p_rwlcb)
+				&& p_runtsk->bpriority < p_rwlcb->p_rwlinib->ceilpri) {
+		return(E_ILUSE);
+	}
+	else if (rwlock_holder(p_rwlcb, p_runtsk)) {
+		return(E_OBJ);
+	}
+	else if (rwlock_ready(p_rwlcb, wrmode)) {
+		rwlock_record(p_rwlcb, p_runtsk, wrmode);
+		if (RWL_CEILING(p_rwlcb)
+				&& p_rwlcb->p_rwlinib->ceilpri < p_runtsk->priority) {
+			(void) change_priority(p_runtsk,
+								p_rwlcb->p_rwlinib->ceilpri, true);
+		}
+		/*
+		 *  優先度上限リーダライタロックをロックした場合，p_runtskの優
+		 *  先度が上がる可能性があるが，ディスパッチが必要になることは
+		 *  ない．
+		 */
+		assert(!(p_runtsk != p_schedtsk && dspflg));
+		return(E_OK);
+	}
+	else {
+		return(E_TMOUT);
+	}
+}
+
+/*
+ *  リーダライタロック待ちのための待ち情報の設定
+ */
+Inline void
+rwlock_prepare_wait(RWLCB *p_rwlcb, WINFO_RWL *p_winfo_rwl, bool_t wrmode)
+{
+	p_runtsk->tstat = (TS_WAITING | TS_WAIT_RWL);
+	p_winfo_rwl->wrmode = wrmode;
+	if (wrmode) {
+		p_rwlcb->wwcnt++;
+	}
+}
+
+/*
+ *  フックルーチン呼出し用の変数
+ */
+#ifdef TOPPERS_rwlhook
+
+bool_t	(*rwlhook_dequeue_wobj)(TCB *p_tcb) = NULL;
+bool_t	(*rwlhook_change_priority)(WOBJCB *p_wobjcb) = NULL;
+bool_t	(*rwlhook_check_ceilpri)(TCB *p_tcb, uint_t bpriority) = NULL;
+bool_t	(*rwlhook_scan_ceilrwl)(TCB *p_tcb) = NULL;
+uint_t	(*rwlhook_calc_priority)(TCB *p_tcb, uint_t priority) = NULL;
+bool_t	(*rwlhook_release_all)(TCB *p_tcb) = NULL;
+
+#endif /* TOPPERS_rwlhook */
+
+/* 
+ *  リーダライタロック機能の初期化
+ */
+#ifdef TOPPERS_rwlini
+
+void
+initialize_rwlock(void)
+{
+	uint_t	i, j;
+	RWLCB	*p_rwlcb;
+
+	RWLHOLD	*p_rwlhold;
+
+	rwlhook_dequeue_wobj = rwlock_dequeue_wobj;
+	rwlhook_change_priority = rwlock_change_priority;
+	rwlhook_check_ceilpri = rwlock_check_ceilpri;
+	rwlhook_scan_ceilrwl = rwlock_scan_ceilrwl;
+	rwlhook_calc_priority = rwlock_calc_priority;
+	rwlhook_release_all = rwlock_release_all;
+
+	for (i = 0; i < tnum_rwl; i++) {
+		p_rwlcb = &(rwlcb_table[i]);
+		queue_initialize(&(p_rwlcb->wait_queue));
+		p_rwlcb->p_rwlinib = &(rwlinib_table[i]);
+		p_rwlcb->p_wrtsk = NULL;
+		p_rwlcb->rdcnt = 0U;
+		p_rwlcb->wwcnt = 0U;
+		for (j = 0; j < tnum_tsk; j++) {
+			p_rwlhold = &(p_rwlcb->p_rwlinib->p_rwlhold[j]);
+			p_rwlhold->rwlock_queue.p_next = NULL;
+			p_rwlhold->p_rwlcb = p_rwlcb;
+		}
+	}
+}
+
+#endif /* TOPPERS_rwlini */
+
+/*
+ *  上限優先度違反のチェック
+ */
+#ifdef TOPPERS_rwlchk
+
+bool_t
+rwlock_check_ceilpri(TCB *p_tcb, uint_t bpriority)
+{
+	QUEUE	*p_queue;
+	RWLCB	*p_rwlcb;
+
+	/*
+	 *  タスクがロックしている優先度上限リーダライタロックの中で，上限
+	 *  優先度がbpriorityよりも低いものがあれば，falseを返す．
+	 */
+	p_queue = p_tcb->rwlock_queue.p_next;
+	while (p_queue != &(p_tcb->rwlock_queue)) {
+		p_rwlcb = RWLHOLD_QUEUE(p_queue)->p_rwlcb;
+		if (RWL_CEILING(p_rwlcb) && bpriority < p_rwlcb->p_rwlinib->ceilpri) {
+			return(false);
+		}
+		p_queue = p_queue->p_next;
+	}
+
+	/*
+	 *  タスクが優先度上限リーダライタロックのロックを待っている場合に，
+	 *  その上限優先度がbpriorityよりも低くければ，falseを返す．
+	 */
+	if (TSTAT_WAIT_RWL(p_tcb->tstat)) {
+		p_rwlcb = ((WINFO_RWL *)(p_tcb->p_winfo))->p_rwlcb;
+		if (RWL_CEILING(p_rwlcb) && bpriority < p_rwlcb->p_rwlinib->ceilpri) {
+			return(false);
+		}
+	}
+	return(true);
+}
+
+#endif /* TOPPERS_rwlchk */
+
+/* 
+ *  優先度上限リーダライタロックをロックしているかのチェック
+ */
+#ifdef TOPPERS_rwlscan
+
+bool_t
+rwlock_scan_ceilrwl(TCB *p_tcb)
+{
+	QUEUE	*p_queue;
+
+	p_queue = p_tcb->rwlock_queue.p_next;
+	while (p_queue != &(p_tcb->rwlock_queue)) {
+		if (RWL_CEILING(RWLHOLD_QUEUE(p_queue)->p_rwlcb)) {
+			return(true);
+		}
+		p_queue = p_queue->p_next;
+	}
+	return(false);
+}
+
+#endif /* TOPPERS_rwlscan */
+
+/* 
+ *  リーダライタロックによる現在優先度の計算
+ */
+#ifdef TOPPERS_rwlcalc
+
+uint_t
+rwlock_calc_priority(TCB *p_tcb, uint_t priority)
+{
+	QUEUE	*p_queue;
+	RWLCB	*p_rwlcb;
+
+	p_queue = p_tcb->rwlock_queue.p_next;
+	while (p_queue != &(p_tcb->rwlock_queue)) {
+		p_rwlcb = RWLHOLD_QUEUE(p_queue)->p_rwlcb;
+		if (RWL_CEILING(p_rwlcb) && p_rwlcb->p_rwlinib->ceilpri < priority) {
+			priority = p_rwlcb->p_rwlinib->ceilpri;
+		}
+		p_queue = p_queue->p_next;
+	}
+	return(priority);
+}
+
+#endif /* TOPPERS_rwlcalc */
+
+/*
+ *  リーダライタロック待ちタスクの待ち解除
+ *
+ *  待ちキューを先頭から調べ，ロックできるタスクにロックさせて待ち解除
+ *  する．書込み優先（TA_WPREF）の場合は，書込みロックを待っているタス
+ *  クがある間は，読出しロックを待っているタスクを飛ばす．ディスパッチ
+ *  が必要な場合にはtrueを返す．
+ */
+#ifdef TOPPERS_rwlwup
+
+bool_t
+rwlock_wakeup(RWLCB *p_rwlcb)
+{
+	QUEUE	*p_queue;
+	TCB		*p_tcb;
+	bool_t	wrmode;
+	bool_t	dspreq = false;
+
+	p_queue = p_rwlcb->wait_queue.p_next;
+	while (p_queue != &(p_rwlcb->wait_queue) && p_rwlcb->p_wrtsk == NULL) {
+		p_tcb = (TCB *) p_queue;
+		p_queue = p_queue->p_next;
+		wrmode = ((WINFO_RWL *)(p_tcb->p_winfo))->wrmode;
+		if (wrmode) {
+			if (p_rwlcb->rdcnt > 0U) {
+				break;
+			}
+			p_rwlcb->wwcnt--;
+		}
+		else if (RWL_WPREF(p_rwlcb) && p_rwlcb->wwcnt > 0U) {
+			continue;
+		}
+
+		/*
+		 *  待ちキューから削除したタスク（p_tcb）に，リーダライタロッ
+		 *  クをロックさせる．p_tcbは待ち状態であるため，現在優先度を
+		 *  直接変更してよい．
+		 */
+		queue_delete(&(p_tcb->task_queue));
+		wait_dequeue_tmevtb(p_tcb);
+		p_tcb->p_winfo->wercd = E_OK;
+		rwlock_record(p_rwlcb, p_tcb, wrmode);
+		if (RWL_CEILING(p_rwlcb)
+				&& p_rwlcb->p_rwlinib->ceilpri < p_tcb->priority) {
+			p_tcb->priority = p_rwlcb->p_rwlinib->ceilpri;
+		}
+		if (make_non_wait(p_tcb)) {
+			dspreq = true;
+		}
+	}
+	return(dspreq);
+}
+
+#endif /* TOPPERS_rwlwup */
+
+/*
+ *  タスクがロックしているすべてのリーダライタロックのロック解除
+ */
+#ifdef TOPPERS_rwlrela
+
+bool_t
+rwlock_release_all(TCB *p_tcb)
+{
+	RWLCB	*p_rwlcb;
+	bool_t	dspreq = false;
+
+	while (!queue_empty(&(p_tcb->rwlock_queue))) {
+		p_rwlcb = RWLHOLD_QUEUE(p_tcb->rwlock_queue.p_next)->p_rwlcb;
+		rwlock_unrecord(p_rwlcb, p_tcb);
+		if (rwlock_wakeup(p_rwlcb)) {
+			dspreq = true;
+		}
+	}
+	return(dspreq);
+}
+
+#endif /* TOPPERS_rwlrela */
+
+/*
+ *  リーダライタロック待ちタスクの待ち解除時処理
+ *
+ *  タスクは待ちキューから削除されている．書込みロックを待っていたタス
+ *  クが削除された場合や，先頭のタスクが削除された場合に，後続のタス
+ *  クがロックできるようになることがある．
+ */
+#ifdef TOPPERS_rwlwobj
+
+bool_t
+rwlock_dequeue_wobj(TCB *p_tcb)
+{
+	WINFO_RWL	*p_winfo_rwl = (WINFO_RWL *)(p_tcb->p_winfo);
+
+	if (p_winfo_rwl->wrmode) {
+		p_winfo_rwl->p_rwlcb->wwcnt--;
+	}
+	return(rwlock_wakeup(p_winfo_rwl->p_rwlcb));
+}
+
+#endif /* TOPPERS_rwlwobj */
+
+/*
+ *  リーダライタロック待ちタスクの優先度変更時処理
+ */
+#ifdef TOPPERS_rwlpri
+
+bool_t
+rwlock_change_priority(WOBJCB *p_wobjcb)
+{
+	return(rwlock_wakeup((RWLCB *) p_wobjcb));
+}
+
+#endif /* TOPPERS_rwlpri */
+
+/*
+ *  リーダライタロックの読出しロック
+ */
+#ifdef TOPPERS_loc_rdl
+
+ER
+loc_rdl(ID rwlid)
+{
+	RWLCB	*p_rwlcb;
+	WINFO_RWL winfo_rwl;
+	ER		ercd;
+
+	LOG_LOC_RDL_ENTER(rwlid);
+	CHECK_DISPATCH();
+	CHECK_RWLID(rwlid);
+	p_rwlcb = get_rwlcb(rwlid);
+
+	t_lock_cpu();
+	ercd = rwlock_lock(p_rwlcb, false);
+	if (ercd == E_TMOUT) {
+		rwlock_prepare_wait(p_rwlcb, &winfo_rwl, false);
+		wobj_make_wait((WOBJCB *) p_rwlcb, (WINFO_WOBJ *) &winfo_rwl);
+		dispatch();
+		ercd = winfo_rwl.winfo.wercd;
+	}
+	t_unlock_cpu();
+
+  error_exit:
+	LOG_LOC_RDL_LEAVE(ercd);
+	return(ercd);
+}
+
+#endif /* TOPPERS_loc_rdl */
+
+/*
+ *  リーダライタロックの読出しロック（ポーリング）
+ */
+#ifdef TOPPERS_ploc_rdl
+
+ER
+ploc_rdl(ID rwlid)
+{
+	RWLCB	*p_rwlcb;
+	ER		ercd;
+
+	LOG_PLOC_RDL_ENTER(rwlid);
+	CHECK_TSKCTX_UNL();
+	CHECK_RWLID(rwlid);
+	p_rwlcb = get_rwlcb(rwlid);
+
+	t_lock_cpu();
+	ercd = rwlock_lock(p_rwlcb, false);
+	t_unlock_cpu();
+
+  error_exit:
+	LOG_PLOC_RDL_LEAVE(ercd);
+	return(ercd);
+}
+
+#endif /* TOPPERS_ploc_rdl */
+
+/*
+ *  リーダライタロックの読出しロック（タイムアウトあり）
+ */
+#ifdef TOPPERS_tloc_rdl
+
+ER
+tloc_rdl(ID rwlid, TMO tmout)
+{
+	RWLCB	*p_rwlcb;
+	WINFO_RWL winfo_rwl;
+	TMEVTB	tmevtb;
+	ER		ercd;
+
+	LOG_TLOC_RDL_ENTER(rwlid, tmout);
+	CHECK_DISPATCH();
+	CHECK_RWLID(rwlid);
+	CHECK_TMOUT(tmout);
+	p_rwlcb = get_rwlcb(rwlid);
+
+	t_lock_cpu();
+	ercd = rwlock_lock(p_rwlcb, false);
+	if (ercd == E_TMOUT && tmout != TMO_POL) {
+		rwlock_prepare_wait(p_rwlcb, &winfo_rwl, false);
+		wobj_make_wait_tmout((WOBJCB *) p_rwlcb, (WINFO_WOBJ *) &winfo_rwl,
+														&tmevtb, tmout);
+		dispatch();
+		ercd = winfo_rwl.winfo.wercd;
+	}
+	t_unlock_cpu();
+
+  error_exit:
+	LOG_TLOC_RDL_LEAVE(ercd);
+	return(ercd);
+}
+
+#endif /* TOPPERS_tloc_rdl */
+
+/*
+ *  リーダライタロックの書込みロック
+ */
+#ifdef TOPPERS_loc_wrl
+
+ER
+loc_wrl(ID rwlid)
+{
+	RWLCB	*p_rwlcb;
+	WINFO_RWL winfo_rwl;
+	ER		ercd;
+
+	LOG_LOC_WRL_ENTER(rwlid);
+	CHECK_DISPATCH();
+	CHECK_RWLID(rwlid);
+	p_rwlcb = get_rwlcb(rwlid);
+
+	t_lock_cpu();
+	ercd = rwlock_lock(p_rwlcb, true);
+	if (ercd == E_TMOUT) {
+		rwlock_prepare_wait(p_rwlcb, &winfo_rwl, true);
+		wobj_make_wait((WOBJCB *) p_rwlcb, (WINFO_WOBJ *) &winfo_rwl);
+		dispatch();
+		ercd = winfo_rwl.winfo.wercd;
+	}
+	t_unlock_cpu();
+
+  error_exit:
+	LOG_LOC_WRL_LEAVE(ercd);
+	return(ercd);
+}
+
+#endif /* TOPPERS_loc_wrl */
+
+/*
+ *  リーダライタロックの書込みロック（ポーリング）
+ */
+#ifdef TOPPERS_ploc_wrl
+
+ER
+ploc_wrl(ID rwlid)
+{
+	RWLCB	*p_rwlcb;
+	ER		ercd;
+
+	LOG_PLOC_WRL_ENTER(rwlid);
+	CHECK_TSKCTX_UNL();
+	CHECK_RWLID(rwlid);
+	p_rwlcb = get_rwlcb(rwlid);
+
+	t_lock_cpu();
+	ercd = rwlock_lock(p_rwlcb, true);
+	t_unlock_cpu();
+
+  error_exit:
+	LOG_PLOC_WRL_LEAVE(ercd);
+	return(ercd);
+}
+
+#endif /* TOPPERS_ploc_wrl */
+
+/*
+ *  リーダライタロックの書込みロック（タイムアウトあり）
+ */
+#ifdef TOPPERS_tloc_wrl
+
+ER
+tloc_wrl(ID rwlid, TMO tmout)
+{
+	RWLCB	*p_rwlcb;
+	WINFO_RWL winfo_rwl;
+	TMEVTB	tmevtb;
+	ER		ercd;
+
+	LOG_TLOC_WRL_ENTER(rwlid, tmout);
+	CHECK_DISPATCH();
+	CHECK_RWLID(rwlid);
+	CHECK_TMOUT(tmout);
+	p_rwlcb = get_rwlcb(rwlid);
+
+	t_lock_cpu();
+	ercd = rwlock_lock(p_rwlcb, true);
+	if (ercd == E_TMOUT && tmout != TMO_POL) {
+		rwlock_prepare_wait(p_rwlcb, &winfo_rwl, true);
+		wobj_make_wait_tmout((WOBJCB *) p_rwlcb, (WINFO_WOBJ *) &winfo_rwl,
+														&tmevtb, tmout);
+		dispatch();
+		ercd = winfo_rwl.winfo.wercd;
+	}
+	t_unlock_cpu();
+
+  error_exit:
+	LOG_TLOC_WRL_LEAVE(ercd);
+	return(ercd);
+}
+
+#endif /* TOPPERS_tloc_wrl */
+
+/*
+ *  リーダライタロックのロック解除
+ */
+#ifdef TOPPERS_unl_rwl
+
+ER
+unl_rwl(ID rwlid)
+{
+	RWLCB	*p_rwlcb;
+	bool_t	dspreq = false;
+	ER		ercd;
+
+	LOG_UNL_RWL_ENTER(rwlid);
+	CHECK_TSKCTX_UNL();
+	CHECK_RWLID(rwlid);
+	p_rwlcb = get_rwlcb(rwlid);
+
+	t_lock_cpu();
+	if (!rwlock_holder(p_rwlcb, p_runtsk)) {
+		ercd = E_OBJ;
+	}
+	else {
+		rwlock_unrecord(p_rwlcb, p_runtsk);
+		if (rwlock_drop_priority(p_rwlcb, p_runtsk)) {
+			dspreq = true;
+		}
+		if (rwlock_wakeup(p_rwlcb)) {
+			dspreq = true;
+		}
+		if (dspreq) {
+			dispatch();
+		}
+		ercd = E_OK;
+	}
+	t_unlock_cpu();
+
+  error_exit:
+	LOG_UNL_RWL_LEAVE(ercd);
+	return(ercd);
+}
+
+#endif /* TOPPERS_unl_rwl */
+
+/*
+ *  リーダライタロックの初期化
+ *
+ *  待っているタスクをすべて待ち解除し，ロックしているタスクからロック
+ *  を解除する．
+ */
+#ifdef TOPPERS_ini_rwl
+
+ER
+ini_rwl(ID rwlid)
+{
+	RWLCB	*p_rwlcb;
+	TCB		*p_tcb;
+	uint_t	i;
+	bool_t	dspreq;
+	ER		ercd;
+
+	LOG_INI_RWL_ENTER(rwlid);
+	CHECK_TSKCTX_UNL();
+	CHECK_RWLID(rwlid);
+	p_rwlcb = get_rwlcb(rwlid);
+
+	t_lock_cpu();
+	dspreq = init_wait_queue(&(p_rwlcb->wait_queue));
+	p_rwlcb->wwcnt = 0U;
+	for (i = 0; i < tnum_tsk
+				&& (p_rwlcb->p_wrtsk != NULL || p_rwlcb->rdcnt > 0U); i++) {
+		p_tcb = &(tcb_table[i]);
+		if (rwlock_holder(p_rwlcb, p_tcb)) {
+			rwlock_unrecord(p_rwlcb, p_tcb);
+			if (rwlock_drop_priority(p_rwlcb, p_tcb)) {
+				dspreq = true;
+			}
+		}
+	}
+	if (dspreq) {
+		dispatch();
+	}
+	ercd = E_OK;
+	t_unlock_cpu();
+
+  error_exit:
+	LOG_INI_RWL_LEAVE(ercd);
+	return(ercd);
+}
+
+#endif /* TOPPERS_ini_rwl */
+
+/*
+ *  リーダライタロックの状態参照
+ */
+#ifdef TOPPERS_ref_rwl
+
+ER
+ref_rwl(ID rwlid, T_RRWL *pk_rrwl)
+{
+	RWLCB	*p_rwlcb;
+	ER		ercd;
+
+	LOG_REF_RWL_ENTER(rwlid, pk_rrwl);
+	CHECK_TSKCTX_UNL();
+	CHECK_RWLID(rwlid);
+	p_rwlcb = get_rwlcb(rwlid);
+
+	t_lock_cpu();
+	pk_rrwl->htskid = (p_rwlcb->p_wrtsk != NULL) ? TSKID(p_rwlcb->p_wrtsk)
+													: TSK_NONE;
+	pk_rrwl->rdcnt = p_rwlcb->rdcnt;
+	pk_rrwl->wtskid = wait_tskid(&(p_rwlcb->wait_queue));
+	ercd = E_OK;
+	t_unlock_cpu();
+
+  error_exit:
+	LOG_REF_RWL_LEAVE(ercd, pk_rrwl);
+	return(ercd);
+}
+
+#endif /* TOPPERS_ref_rwl */
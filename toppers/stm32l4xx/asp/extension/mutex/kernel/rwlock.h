@@ -0,0 +1,197 @@
+/*
+ *  TOPPERS/ASP Kernel
+ *      Toyohashi Open Platform for Embedded Real-Time Systems/
+ *      Advanced Standard Profile Kernel
+ * 
+ *  Copyright (C) 2005-2026 by Embedded and Real-Time Systems Laboratory
+ *              Graduate School of Information Science, Nagoya Univ., JAPAN
+ * 
+ *  上記著作権者は，以下の(1)〜(4)の条件を満たす場合に限り，本ソフトウェ
+ *  ア（本ソフトウェアを改変したものを含む．以下同じ）を使用・複製・改
+ *  変・再配布（以下，利用と呼ぶ）することを無償で許諾する．
+ *  (1) 本ソフトウェアをソースコードの形で利用する場合には，上記の著作
+ *      権表示，この利用条件および下記の無保証規定が，そのままの形でソー
+ *      スコード中に含まれていること．
+ *  (2) 本ソフトウェアを，ライブラリ形式など，他のソフトウェア開発に使
+ *      用できる形で再配布する場合には，再配布に伴うドキュメント（利用
+ *      者マニュアルなど）に，上記の著作権表示，この利用条件および下記
+ *      の無保証規定を掲載すること．
+ *  (3) 本ソフトウェアを，機器に組み込むなど，他のソフトウェア開発に使
+ *      用できない形で再配布する場合には，次のいずれかの条件を満たすこ
+ *      と．
+ *    (a) 再配布に伴うドキュメント（利用者マニュアルなど）に，上記の著
+ *        作権表示，この利用条件および下記の無保証規定を掲載すること．
+ *    (b) 再配布の形態を，別に定める方法によって，TOPPERSプロジェクトに
+ *        報告すること．
+ *  (4) 本ソフトウェアの利用により直接的または間接的に生じるいかなる損
+ *      害からも，上記著作権者およびTOPPERSプロジェクトを免責すること．
+ *      また，本ソフトウェアのユーザまたはエンドユーザからのいかなる理
+ *      由に基づく請求からも，上記著作権者およびTOPPERSプロジェクトを
+ *      免責すること．
+ * 
+ *  本ソフトウェアは，無保証で提供されているものである．上記著作権者お
+ *  よびTOPPERSプロジェクトは，本ソフトウェアに関して，特定の使用目的
+ *  に対する適合性も含めて，いかなる保証も行わない．また，本ソフトウェ
+ *  アの利用により直接的または間接的に生じたいかなる損害に関しても，そ
+ *  の責任を負わない．
+ * 
+ *  $Id$
+ */
+
+/*
+ *		リーダライタロック機能
+ */
+
+#ifndef TOPPERS_RWLOCK_H
+#define TOPPERS_RWLOCK_H
+
+#include "wait.h"
+
+/*
+ *  リーダライタロック保持ブロック
+ *
+ *  リーダライタロックごとにタスクの数だけ用意し，タスクがリーダライタ
+ *  ロックをロックしている間（読出しロックと書込みロックのいずれでも），
+ *  そのタスクのTCB中のrwlock_queueにつなぐ．ロックしていない間は，
+ *  rwlock_queue.p_nextをNULLにする．rwlock_queueは，先頭のフィールド
+ *  でなければならない．
+ */
+typedef struct rwlock_holding_block {
+	QUEUE		rwlock_queue;	/* ロックしているリーダライタロックのキュー */
+	struct rwlock_control_block	*p_rwlcb;
+								/* リーダライタロック管理ブロック */
+} RWLHOLD;
+
+/*
+ *  リーダライタロック初期化ブロック
+ *
+ *  この構造体は，同期・通信オブジェクトの初期化ブロックの共通部分
+ *  （WOBJINIB）を拡張（オブジェクト指向言語の継承に相当）したもので，
+ *  最初のフィールドが共通になっている．
+ *
+ *  p_rwlholdは，リーダライタロック保持ブロックをタスクの数だけ置く領域
+ *  （タスクのインデックスで参照する）を指す．
+ */
+typedef struct rwlock_initialization_block {
+	ATR			rwlatr;			/* リーダライタロック属性 */
+	uint_t		ceilpri;		/* 上限優先度（内部表現）*/
+	RWLHOLD		*p_rwlhold;		/* リーダライタロック保持ブロックの領域 */
+} RWLINIB;
+
+/*
+ *  リーダライタロック管理ブロック
+ *
+ *  この構造体は，同期・通信オブジェクトの管理ブロックの共通部分（WOBJCB）
+ *  を拡張（オブジェクト指向言語の継承に相当）したもので，最初の2つの
+ *  フィールドが共通になっている．
+ */
+typedef struct rwlock_control_block {
+	QUEUE		wait_queue;		/* リーダライタロック待ちキュー */
+	const RWLINIB *p_rwlinib;	/* 初期化ブロックへのポインタ */
+	TCB			*p_wrtsk;		/* 書込みロックを保持しているタスク */
+	uint_t		rdcnt;			/* 読出しロックを保持しているタスクの数 */
+	uint_t		wwcnt;			/* 書込みロックを待っているタスクの数 */
+} RWLCB;
+
+/*
+ *  リーダライタロック待ち情報ブロックの定義
+ *
+ *  この構造体は，同期・通信オブジェクトの待ち情報ブロックの共通部分
+ *  （WINFO_WOBJ）を拡張（オブジェクト指向言語の継承に相当）したもので，
+ *  最初の2つのフィールドが共通になっている．
+ */
+typedef struct rwlock_waiting_information {
+	WINFO	winfo;			/* 標準の待ち情報ブロック */
+	RWLCB	*p_rwlcb;		/* 待っているリーダライタロックの管理ブロック */
+	bool_t	wrmode;			/* 書込みロックを待っているか？ */
+} WINFO_RWL;
+
+/*
+ *  リーダライタロックIDの最大値（kernel_cfg.c）
+ */
+extern const ID	tmax_rwlid;
+
+/*
+ *  リーダライタロック初期化ブロックのエリア（kernel_cfg.c）
+ */
+extern const RWLINIB	rwlinib_table[];
+
+/*
+ *  リーダライタロック管理ブロックのエリア（kernel_cfg.c）
+ */
+extern RWLCB	rwlcb_table[];
+
+/*
+ *  リーダライタロック管理ブロックからリーダライタロックIDを取り出すた
+ *  めのマクロ
+ */
+#define	RWLID(p_rwlcb)	((ID)(((p_rwlcb) - rwlcb_table) + TMIN_RWLID))
+
+/*
+ *  リーダライタロック機能の初期化
+ */
+extern void	initialize_rwlock(void);
+
+/*
+ *  上限優先度違反のチェック
+ *
+ *  chg_priで，タスクのベース優先度をbpriorityに変更してよいかを判定す
+ *  る．タスクがロックしているか，ロックを待っている優先度上限リーダラ
+ *  イタロックの中に，上限優先度がbpriorityよりも低いものがあれば，
+ *  falseを返す．
+ */
+extern bool_t	(*rwlhook_check_ceilpri)(TCB *p_tcb, uint_t bpriority);
+extern bool_t	rwlock_check_ceilpri(TCB *p_tcb, uint_t bpriority);
+
+/*
+ *  優先度上限リーダライタロックをロックしているかのチェック
+ */
+extern bool_t	(*rwlhook_scan_ceilrwl)(TCB *p_tcb);
+extern bool_t	rwlock_scan_ceilrwl(TCB *p_tcb);
+
+/*
+ *  リーダライタロックによる現在優先度の計算
+ *
+ *  priorityを，p_tcbで指定されるタスクがロックしている優先度上限リー
+ *  ダライタロックの上限優先度で引き上げた値を返す．
+ */
+extern uint_t	(*rwlhook_calc_priority)(TCB *p_tcb, uint_t priority);
+extern uint_t	rwlock_calc_priority(TCB *p_tcb, uint_t priority);
+
+/*
+ *  リーダライタロック待ちタスクの待ち解除
+ *
+ *  待ちキュー中のタスクの中で，ロックできるものにロックさせて待ち解除
+ *  する．ディスパッチが必要な場合にはtrueを返す．
+ */
+extern bool_t	rwlock_wakeup(RWLCB *p_rwlcb);
+
+/*
+ *  タスクがロックしているすべてのリーダライタロックのロック解除
+ *
+ *  p_tcbで指定されるタスクに，それがロックしているすべてのリーダライ
+ *  タロックをロック解除させる．ロック解除したリーダライタロックに，ロッ
+ *  クを待っているタスクがあれば，待ち解除する．タスクの優先度は変更し
+ *  ない．ディスパッチが必要な場合にはtrueを返す．
+ */
+extern bool_t	(*rwlhook_release_all)(TCB *p_tcb);
+extern bool_t	rwlock_release_all(TCB *p_tcb);
+
+/*
+ *  リーダライタロック待ちタスクの待ち解除時処理
+ */
+extern bool_t	(*rwlhook_dequeue_wobj)(TCB *p_tcb);
+extern bool_t	rwlock_dequeue_wobj(TCB *p_tcb);
+
+/*
+ *  リーダライタロック待ちタスクの優先度変更時処理
+ */
+extern bool_t	(*rwlhook_change_priority)(WOBJCB *p_wobjcb);
+extern bool_t	rwlock_change_priority(WOBJCB *p_wobjcb);
+
+/*
+ *  タスクがリーダライタロックをロックしているかの判定
+ */
+#define RWLOCK_MAY_BE_LOCKED(p_tcb)	(!queue_empty(&((p_tcb)->rwlock_queue)))
+
+#endif /* TOPPERS_RWLOCK_H */
@@ -171,6 +171,17 @@
 #define LOG_SNS_KER_LEAVE(state)
 #endif /* LOG_SNS_KER_LEAVE */
 
+/*
+ *  ディスパッチ禁止区間の計測のためのマクロのデフォルト定義
+ */
+#ifndef LOCKPROF_DSP_ENTER
+#define LOCKPROF_DSP_ENTER()
+#endif /* LOCKPROF_DSP_ENTER */
+
+#ifndef LOCKPROF_DSP_LEAVE
+#define LOCKPROF_DSP_LEAVE()
+#endif /* LOCKPROF_DSP_LEAVE */
+
 /*
  *  タスクの優先順位の回転
  */
@@ -401,6 +412,7 @@ dis_dsp(void)
 	CHECK_TSKCTX_UNL();
 
 	t_lock_cpu();
+	LOCKPROF_DSP_ENTER();
 	disdsp = true;
 	dspflg = false;
 	ercd = E_OK;
@@ -427,6 +439,7 @@ ena_dsp(void)
 	CHECK_TSKCTX_UNL();
 
 	t_lock_cpu();
+	LOCKPROF_DSP_LEAVE();
 	disdsp = false;
 	if (ipmflg) {
 		dspflg = true;
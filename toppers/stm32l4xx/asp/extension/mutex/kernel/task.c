@@ -129,6 +129,10 @@ initialize_task(void)
 		p_tcb->actque = false;
 		make_dormant(p_tcb);
 		queue_initialize(&(p_tcb->mutex_queue));
+		queue_initialize(&(p_tcb->rwlock_queue));
+#ifdef TOPPERS_MTX_FASTPATH
+		p_tcb->mtxfcnt = 0U;
+#endif /* TOPPERS_MTX_FASTPATH */
 		if ((p_tcb->p_tinib->tskatr & TA_ACT) != 0U) {
 			(void) make_active(p_tcb);
 		}
@@ -390,8 +394,8 @@ change_priority(TCB *p_tcb, uint_t newpri, bool_t mtxmode)
 			 *  タスクが，同期・通信オブジェクトの管理ブロックの共通部
 			 *  分（WOBJCB）の待ちキューにつながれている場合
 			 */
-			wobj_change_priority(((WINFO_WOBJ *)(p_tcb->p_winfo))->p_wobjcb,
-																	p_tcb);
+			return(wobj_change_priority(((WINFO_WOBJ *)(p_tcb->p_winfo))
+														->p_wobjcb, p_tcb));
 		}
 	}
 	return(false);
@@ -50,6 +50,16 @@
 #include <queue.h>
 #include "time_event.h"
 
+/*
+ *  TCBの縮小のサポート
+ *
+ *  ミューテックス機能拡張パッケージのカーネルは，TOPPERS_COMPACT_TCBに
+ *  よるTCBの縮小をサポートしていない．
+ */
+#ifdef TOPPERS_COMPACT_TCB
+#error TOPPERS_COMPACT_TCB is not supported with the mutex extension.
+#endif /* TOPPERS_COMPACT_TCB */
+
 /*
  *  トレースログマクロのデフォルト定義
  */
@@ -87,6 +97,9 @@
 #define TS_WAIT_MBX		(0x08U << 3)	/* メールボックスからの受信待ち */
 #define TS_WAIT_MPF		(0x09U << 3)	/* 固定長メモリブロックの獲得待ち */
 #define TS_WAIT_MTX		(0x0aU << 3)	/* ミューテックスのロック待ち */
+#define TS_WAIT_RWL		(0x0bU << 3)	/* リーダライタロックのロック待ち */
+#define TS_WAIT_CND		(0x0cU << 3)	/* 条件変数待ち */
+#define TS_WAIT_OBJ		(0x0fU << 3)	/* 複数オブジェクト待ち */
 
 /*
  *  タスク状態判別マクロ
@@ -125,6 +138,8 @@
 #define TSTAT_WAIT_WOBJ(tstat)		(((tstat) & TS_WAIT_MASK) >= TS_WAIT_RDTQ)
 #define TSTAT_WAIT_WOBJCB(tstat)	(((tstat) & TS_WAIT_MASK) >= TS_WAIT_SEM)
 #define TSTAT_WAIT_MTX(tstat)		(((tstat) & TS_WAIT_MASK) == TS_WAIT_MTX)
+#define TSTAT_WAIT_RWL(tstat)		(((tstat) & TS_WAIT_MASK) == TS_WAIT_RWL)
+#define TSTAT_WAIT_CND(tstat)		(((tstat) & TS_WAIT_MASK) == TS_WAIT_CND)
 
 /*
  *  待ち情報ブロック（WINFO）の定義
@@ -226,16 +241,24 @@ typedef struct task_initialization_block {
  *  ・初期化後は常に有効：
  *  		p_tinib，tstat，actque
  *  ・休止状態以外で有効（休止状態では初期値になっている）：
- *  		bpriority，priority，wupque，enatex，texptn，mutex_queue
+ *  		bpriority，priority，wupque，enatex，texptn，mutex_queue，
+ *  		rwlock_queue，mtxfcnt
  *  ・待ち状態（二重待ち状態を含む）で有効：
  *  		p_winfo
  *  ・実行できる状態と同期・通信オブジェクトに対する待ち状態で有効：
  *  		task_queue
  *  ・実行可能状態，待ち状態，強制待ち状態，二重待ち状態で有効：
  *  		tskctxb
+ *
+ *  mtxfcntは，kernel.h中のfloc_mtx／funl_mtxがTOPPERS_TCB_MTXFとして
+ *  参照するため，task_queueの直後に置かなければならない．
  */
 typedef struct task_control_block {
 	QUEUE			task_queue;		/* タスクキュー */
+#ifdef TOPPERS_MTX_FASTPATH
+	uint32_t		mtxfcnt;		/* 高速パスでロックしているミューテッ
+									   クスの数 */
+#endif /* TOPPERS_MTX_FASTPATH */
 	const TINIB		*p_tinib;		/* 初期化ブロックへのポインタ */
 
 #ifdef UINT8_MAX
@@ -259,6 +282,8 @@ typedef struct task_control_block {
 	TEXPTN			texptn;			/* 保留例外要因 */
 	WINFO			*p_winfo;		/* 待ち情報ブロックへのポインタ */
 	QUEUE			mutex_queue;	/* ロックしているミューテックスのキュー */
+	QUEUE			rwlock_queue;	/* ロックしているリーダライタロックの
+									   キュー */
 	TSKCTXB			tskctxb;		/* タスクコンテキストブロック */
 } TCB;
 
@@ -379,6 +404,12 @@ extern TCB	tcb_table[];
  */
 #define	TSKID(p_tcb)	((ID)(((p_tcb) - tcb_table) + TMIN_TSKID))
 
+/*
+ *  TCBからタスク初期化ブロックと保留例外要因を参照するためのマクロ
+ */
+#define get_tinib(p_tcb)	((p_tcb)->p_tinib)
+#define TSK_TEXPTN(p_tcb)	((p_tcb)->texptn)
+
 /*
  *  タスク管理モジュールの初期化
  */
@@ -49,6 +49,7 @@
 #include "task.h"
 #include "wait.h"
 #include "mutex.h"
+#include "rwlock.h"
 
 /*
  *  トレースログマクロのデフォルト定義
@@ -117,6 +118,13 @@
 #define LOG_GET_INF_LEAVE(ercd, exinf)
 #endif /* LOG_GET_INF_LEAVE */
 
+/*
+ *  ディスパッチ禁止区間の計測のためのマクロのデフォルト定義
+ */
+#ifndef LOCKPROF_DSP_LEAVE
+#define LOCKPROF_DSP_LEAVE()
+#endif /* LOCKPROF_DSP_LEAVE */
+
 /*
  *  タスクの起動
  */
@@ -251,6 +259,7 @@ ext_tsk(void)
 		 *  ディスパッチ禁止状態でext_tskが呼ばれた場合は，ディスパッ
 		 *  チ許可状態にしてからタスクを終了する．
 		 */
+		LOCKPROF_DSP_LEAVE();
 		disdsp = false;
 	}
 	if (!ipmflg) {
@@ -265,9 +274,12 @@ ext_tsk(void)
 	dspflg = true;
 
 	(void) make_non_runnable(p_runtsk);
-	if (!queue_empty(&(p_runtsk->mutex_queue))) {
+	if (MUTEX_MAY_BE_LOCKED(p_runtsk)) {
 		(void) (*mtxhook_release_all)(p_runtsk);
 	}
+	if (RWLOCK_MAY_BE_LOCKED(p_runtsk)) {
+		(void) (*rwlhook_release_all)(p_runtsk);
+	}
 	make_dormant(p_runtsk);
 	if (p_runtsk->actque) {
 		p_runtsk->actque = false;
@@ -315,14 +327,21 @@ ter_tsk(ID tskid)
 			(void) make_non_runnable(p_tcb);
 		}
 		else if (TSTAT_WAITING(p_tcb->tstat)) {
-			wait_dequeue_wobj(p_tcb);
+			if (wait_dequeue_wobj(p_tcb)) {
+				dspreq = true;
+			}
 			wait_dequeue_tmevtb(p_tcb);
 		}
-		if (!queue_empty(&(p_tcb->mutex_queue))) {
+		if (MUTEX_MAY_BE_LOCKED(p_tcb)) {
 			if ((*mtxhook_release_all)(p_tcb)) {
 				dspreq = true;
 			}
 		}
+		if (RWLOCK_MAY_BE_LOCKED(p_tcb)) {
+			if ((*rwlhook_release_all)(p_tcb)) {
+				dspreq = true;
+			}
+		}
 		make_dormant(p_tcb);
 		if (p_tcb->actque) {
 			p_tcb->actque = false;
@@ -369,14 +388,21 @@ chg_pri(ID tskid, PRI tskpri)
 		ercd = E_OBJ;
 	}
 	else if ((!queue_empty(&(p_tcb->mutex_queue))
-										|| TSTAT_WAIT_MTX(p_tcb->tstat))
+										|| TSTAT_WAIT_MTX(p_tcb->tstat)
+										|| TSTAT_WAIT_CND(p_tcb->tstat))
 						&& !((*mtxhook_check_ceilpri)(p_tcb, newbpri))) {
 		ercd = E_ILUSE;
 	}
+	else if ((RWLOCK_MAY_BE_LOCKED(p_tcb) || TSTAT_WAIT_RWL(p_tcb->tstat))
+						&& !((*rwlhook_check_ceilpri)(p_tcb, newbpri))) {
+		ercd = E_ILUSE;
+	}
 	else {
 		p_tcb->bpriority = newbpri;
-		if (queue_empty(&(p_tcb->mutex_queue))
-								|| !((*mtxhook_scan_ceilmtx)(p_tcb))) {
+		if ((queue_empty(&(p_tcb->mutex_queue))
+								|| !((*mtxhook_scan_ceilmtx)(p_tcb)))
+						&& (!RWLOCK_MAY_BE_LOCKED(p_tcb)
+								|| !((*rwlhook_scan_ceilrwl)(p_tcb)))) {
 			if (change_priority(p_tcb, newbpri, false)) {
 				dispatch();
 			}
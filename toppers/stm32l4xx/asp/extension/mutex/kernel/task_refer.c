@@ -52,6 +52,8 @@
 #include "pridataq.h"
 #include "mailbox.h"
 #include "mutex.h"
+#include "rwlock.h"
+#include "cond.h"
 #include "mempfix.h"
 #include "time_event.h"
 
@@ -170,11 +172,26 @@ ref_tsk(ID tskid, T_RTSK *pk_rtsk)
 				pk_rtsk->wobjid = MTXID(((WINFO_MTX *)(p_tcb->p_winfo))
 																->p_mtxcb);
 				break;
+			case TS_WAIT_RWL:
+				pk_rtsk->tskwait = TTW_RWL;
+				pk_rtsk->wobjid = RWLID(((WINFO_RWL *)(p_tcb->p_winfo))
+																->p_rwlcb);
+				break;
+			case TS_WAIT_CND:
+				pk_rtsk->tskwait = TTW_CND;
+				pk_rtsk->wobjid = CNDID(((WINFO_CND *)(p_tcb->p_winfo))
+																->p_cndcb);
+				break;
 			case TS_WAIT_MPF:
 				pk_rtsk->tskwait = TTW_MPF;
 				pk_rtsk->wobjid = MPFID(((WINFO_MPF *)(p_tcb->p_winfo))
 																->p_mpfcb);
 				break;
+#ifdef TOPPERS_WAIT_OBJ
+			case TS_WAIT_OBJ:
+				pk_rtsk->tskwait = TTW_OBJ;
+				break;
+#endif /* TOPPERS_WAIT_OBJ */
 			}
 
 			/*
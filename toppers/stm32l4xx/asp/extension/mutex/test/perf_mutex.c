@@ -0,0 +1,177 @@
+/*
+ *  TOPPERS Software
+ *      Toyohashi Open Platform for Embedded Real-Time Systems
+ * 
+ *  Copyright (C) 2006-2009 by Embedded and Real-Time Systems Laboratory
+ *              Graduate School of Information Science, Nagoya Univ., JAPAN
+ *  Copyright (C) 2017-2018 by TOPPERS PROJECT Educational Working Group.
+ * 
+ *  上記著作権者は，以下の(1)〜(4)の条件を満たす場合に限り，本ソフトウェ
+ *  ア（本ソフトウェアを改変したものを含む．以下同じ）を使用・複製・改
+ *  変・再配布（以下，利用と呼ぶ）することを無償で許諾する．
+ *  (1) 本ソフトウェアをソースコードの形で利用する場合には，上記の著作
+ *      権表示，この利用条件および下記の無保証規定が，そのままの形でソー
+ *      スコード中に含まれていること．
+ *  (2) 本ソフトウェアを，ライブラリ形式など，他のソフトウェア開発に使
+ *      用できる形で再配布する場合には，再配布に伴うドキュメント（利用
+ *      者マニュアルなど）に，上記の著作権表示，この利用条件および下記
+ *      の無保証規定を掲載すること．
+ *  (3) 本ソフトウェアを，機器に組み込むなど，他のソフトウェア開発に使
+ *      用できない形で再配布する場合には，次のいずれかの条件を満たすこ
+ *      と．
+ *    (a) 再配布に伴うドキュメント（利用者マニュアルなど）に，上記の著
+ *        作権表示，この利用条件および下記の無保証規定を掲載すること．
+ *    (b) 再配布の形態を，別に定める方法によって，TOPPERSプロジェクトに
+ *        報告すること．
+ *  (4) 本ソフトウェアの利用により直接的または間接的に生じるいかなる損
+ *      害からも，上記著作権者およびTOPPERSプロジェクトを免責すること．
+ *      また，本ソフトウェアのユーザまたはエンドユーザからのいかなる理
+ *      由に基づく請求からも，上記著作権者およびTOPPERSプロジェクトを
+ *      免責すること．
+ * 
+ *  本ソフトウェアは，無保証で提供されているものである．上記著作権者お
+ *  よびTOPPERSプロジェクトは，本ソフトウェアに関して，特定の使用目的
+ *  に対する適合性も含めて，いかなる保証も行わない．また，本ソフトウェ
+ *  アの利用により直接的または間接的に生じたいかなる損害に関しても，そ
+ *  の責任を負わない．
+ * 
+ *  $Id$
+ */
+
+/*
+ *		ミューテックスの性能評価プログラム
+ *
+ *  loc_mtx，unl_mtxの処理時間を，待ち解除を伴わない経路と，タスク切換
+ *  えを伴う経路のそれぞれについて計測し，print_hist_benchの形式で出力
+ *  するためのプログラム．
+ *
+ *  タスク切換えを伴う経路では，中優先度の計測タスク2がミューテックス
+ *  をロックしている時に，高優先度の計測タスク1がloc_mtxによりロック待
+ *  ち状態となってタスク2に切り換わるまでの時間（block）と，タスク2が
+ *  unl_mtxによりタスク1にロックを渡してタスク1に切り換わるまでの時間
+ *  （wake）を計測する．
+ *
+ *  TOPPERS_MTX_FASTPATHを定義した場合には，高速パス（floc_mtx，
+ *  funl_mtx）の競合のない経路の処理時間も計測する．
+ */
+
+#include <kernel.h>
+#include <t_syslog.h>
+#include <test_lib.h>
+#include <histogram.h>
+#include "kernel_cfg.h"
+#include "perf_mutex.h"
+
+/*
+ *  計測回数と実行時間分布を記録する最大時間
+ */
+#define NO_MEASURE	10000U			/* 計測回数 */
+#define HIST_BITS	12U				/* 4095までの時間を記録 */
+
+/*
+ *  実行時間分布を記録するメモリ領域
+ */
+static uint_t	histarea1[HIST_LOG_NBUCKET(HIST_BITS)];
+static uint_t	histarea2[HIST_LOG_NBUCKET(HIST_BITS)];
+
+/*
+ *  計測タスク1（高優先度）
+ */
+void task1(intptr_t exinf)
+{
+	uint_t	i;
+
+	for (i = 0; i < NO_MEASURE; i++) {
+		slp_tsk();
+		begin_measure(2);
+		loc_mtx(MTX1);
+		end_measure(1);
+		unl_mtx(MTX1);
+	}
+}
+
+/*
+ *  計測タスク2（中優先度）
+ */
+void task2(intptr_t exinf)
+{
+	uint_t	i;
+
+	act_tsk(TASK1);
+	for (i = 0; i < NO_MEASURE; i++) {
+		loc_mtx(MTX1);
+		wup_tsk(TASK1);
+		end_measure(2);
+		begin_measure(1);
+		unl_mtx(MTX1);
+	}
+}
+
+/*
+ *  待ち解除を伴わない経路の計測
+ */
+static void
+perf_nowait(ID mtxid, const char *loc_name, const char *unl_name)
+{
+	uint_t	i;
+
+	init_hist_log(1, HIST_BITS, histarea1);
+	init_hist_log(2, HIST_BITS, histarea2);
+	for (i = 0; i < NO_MEASURE; i++) {
+		begin_measure(1);
+		loc_mtx(mtxid);
+		end_measure(1);
+		begin_measure(2);
+		unl_mtx(mtxid);
+		end_measure(2);
+	}
+	print_hist_bench(1, loc_name);
+	print_hist_bench(2, unl_name);
+}
+
+#ifdef TOPPERS_MTX_FASTPATH
+/*
+ *  高速パスの計測
+ */
+static void
+perf_fastpath(ID mtxid)
+{
+	uint_t	i;
+
+	init_hist_log(1, HIST_BITS, histarea1);
+	init_hist_log(2, HIST_BITS, histarea2);
+	for (i = 0; i < NO_MEASURE; i++) {
+		begin_measure(1);
+		floc_mtx(mtxid);
+		end_measure(1);
+		begin_measure(2);
+		funl_mtx(mtxid);
+		end_measure(2);
+	}
+	print_hist_bench(1, "floc_mtx");
+	print_hist_bench(2, "funl_mtx");
+}
+#endif /* TOPPERS_MTX_FASTPATH */
+
+/*
+ *  メインタスク（低優先度）
+ */
+void main_task(intptr_t exinf)
+{
+	syslog_0(LOG_NOTICE, "Mutex performance evaluation program");
+	syslog_flush();
+
+	perf_nowait(MTX1, "loc_mtx", "unl_mtx");
+	perf_nowait(MTX2, "loc_mtx_ceil", "unl_mtx_ceil");
+#ifdef TOPPERS_MTX_FASTPATH
+	perf_fastpath(MTX1);
+#endif /* TOPPERS_MTX_FASTPATH */
+
+	init_hist_log(1, HIST_BITS, histarea1);
+	init_hist_log(2, HIST_BITS, histarea2);
+	act_tsk(TASK2);
+	print_hist_bench(1, "unl_mtx_wake");
+	print_hist_bench(2, "loc_mtx_block");
+
+	test_finish();
+}
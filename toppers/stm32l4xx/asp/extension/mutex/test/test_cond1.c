@@ -0,0 +1,437 @@
+/*
+ *  TOPPERS Software
+ *      Toyohashi Open Platform for Embedded Real-Time Systems
+ * 
+ *  Copyright (C) 2006-2009 by Embedded and Real-Time Systems Laboratory
+ *              Graduate School of Information Science, Nagoya Univ., JAPAN
+ *  Copyright (C) 2017-2018 by TOPPERS PROJECT Educational Working Group.
+ * 
+ *  上記著作権者は，以下の(1)〜(4)の条件を満たす場合に限り，本ソフトウェ
+ *  ア（本ソフトウェアを改変したものを含む．以下同じ）を使用・複製・改
+ *  変・再配布（以下，利用と呼ぶ）することを無償で許諾する．
+ *  (1) 本ソフトウェアをソースコードの形で利用する場合には，上記の著作
+ *      権表示，この利用条件および下記の無保証規定が，そのままの形でソー
+ *      スコード中に含まれていること．
+ *  (2) 本ソフトウェアを，ライブラリ形式など，他のソフトウェア開発に使
+ *      用できる形で再配布する場合には，再配布に伴うドキュメント（利用
+ *      者マニュアルなど）に，上記の著作権表示，この利用条件および下記
+ *      の無保証規定を掲載すること．
+ *  (3) 本ソフトウェアを，機器に組み込むなど，他のソフトウェア開発に使
+ *      用できない形で再配布する場合には，次のいずれかの条件を満たすこ
+ *      と．
+ *    (a) 再配布に伴うドキュメント（利用者マニュアルなど）に，上記の著
+ *        作権表示，この利用条件および下記の無保証規定を掲載すること．
+ *    (b) 再配布の形態を，別に定める方法によって，TOPPERSプロジェクトに
+ *        報告すること．
+ *  (4) 本ソフトウェアの利用により直接的または間接的に生じるいかなる損
+ *      害からも，上記著作権者およびTOPPERSプロジェクトを免責すること．
+ *      また，本ソフトウェアのユーザまたはエンドユーザからのいかなる理
+ *      由に基づく請求からも，上記著作権者およびTOPPERSプロジェクトを
+ *      免責すること．
+ * 
+ *  本ソフトウェアは，無保証で提供されているものである．上記著作権者お
+ *  よびTOPPERSプロジェクトは，本ソフトウェアに関して，特定の使用目的
+ *  に対する適合性も含めて，いかなる保証も行わない．また，本ソフトウェ
+ *  アの利用により直接的または間接的に生じたいかなる損害に関しても，そ
+ *  の責任を負わない．
+ * 
+ *  $Id$
+ */
+
+/* 
+ *		条件変数のテスト(1)
+ *
+ * 【テストの目的】
+ *
+ *  条件変数の待ち（wai_cnd，twai_cnd）と通知（sig_cnd，brd_cnd）に伴
+ *  うミューテックスのロック解除と再ロック，待ち順序（TA_TPRI属性），待
+ *  ち状態の解除，優先度上限ミューテックスとの組み合わせをテストする．
+ *
+ * 【テスト項目】
+ *
+ *	(A) 条件変数待ち
+ *		(A-1) ミューテックスをロックしていない場合には，E_OBJエラーにな
+ *			  ること
+ *		(A-2) ミューテックスのロックを解除して待ち状態になること
+ *		(A-3) 待ち状態のタスクに対するref_tskで，TTW_CNDと条件変数のID
+ *			  が返ること
+ *	(B) 条件変数の通知
+ *		(B-1) 待っているタスクがない場合には，何もしないこと
+ *		(B-2) ミューテックスがロックされている場合には，待ち解除したタ
+ *			  スクがミューテックスのロック待ち状態になること
+ *		(B-3) TA_TPRI属性の場合には，優先度の高いタスクから待ち解除す
+ *			  ること
+ *		(B-4) ミューテックスがロックされていない場合には，待ち解除した
+ *			  タスクがミューテックスをロックし，ディスパッチが起こること
+ *	(C) 条件変数の全通知
+ *		(C-1) 待っているすべてのタスクが，待ちキューの順にミューテック
+ *			  スのロック待ち状態になること
+ *	(D) タイムアウト
+ *		(D-1) TMO_POLを指定した場合には，E_TMOUTエラーになること
+ *		(D-2) タイムアウトした場合には，E_TMOUTエラーになること
+ *		(D-3) いずれの場合も，ミューテックスをロックした状態で戻ること
+ *	(E) 待ち状態の強制解除
+ *		(E-1) 待ち状態が強制解除された場合には，ミューテックスを再ロッ
+ *			  クしてE_RLWAIエラーになること
+ *	(F) 優先度上限ミューテックス
+ *		(F-1) 条件変数待ちの間に，上限優先度より高いベース優先度に変更
+ *			  しようとすると，E_ILUSEエラーになること
+ *		(F-2) 再ロックした時に，上限優先度まで優先度が上がること
+ *	(G) その他のサービスコール
+ *		(G-1) ini_cndで待ち解除されたタスクは，ミューテックスを再ロッ
+ *			  クしてE_DLTエラーになること
+ *
+ * 【使用リソース】
+ *
+ *	TASK1: 低優先度タスク，メインタスク，最初から起動
+ *	TASK2: 中優先度タスク
+ *	TASK3: 高優先度タスク
+ *	MTX1: ミューテックス（TA_NULL属性）
+ *	MTX2: ミューテックス（TA_CEILING属性，上限は中優先度）
+ *	CND1: 条件変数（TA_TPRI属性）
+ *	CND2: 条件変数（TA_NULL属性）
+ *
+ * 【テストシーケンス】
+ *
+ *	== TASK1（優先度：低）==
+ *	1:	ref_cnd(CND1, &rcnd)
+ *		assert(rcnd.wtskid == TSK_NONE)
+ *		wai_cnd(CND1, MTX1) -> E_OBJ		... (A-1)
+ *		sig_cnd(CND1)						... (B-1)
+ *		loc_mtx(MTX1)
+ *		twai_cnd(CND1, MTX1, TMO_POL) -> E_TMOUT	... (D-1)
+ *		twai_cnd(CND1, MTX1, 10) -> E_TMOUT	... (D-2)
+ *		ref_mtx(MTX1, &rmtx)
+ *		assert(rmtx.htskid == TASK1)		... (D-3)
+ *		act_tsk(TASK2)
+ *	== TASK2（優先度：中）==
+ *	2:	loc_mtx(MTX1)
+ *	== TASK1（続き）==
+ *	3:	wai_cnd(CND1, MTX1)					... (A-2)
+ *	== TASK2（続き）==
+ *	4:	ref_tsk(TASK1, &rtsk)
+ *		assert(rtsk.tskwait == TTW_CND)		... (A-3)
+ *		assert(rtsk.wobjid == CND1)
+ *		ref_cnd(CND1, &rcnd)
+ *		assert(rcnd.wtskid == TASK1)
+ *		act_tsk(TASK3)
+ *	== TASK3（優先度：高）==
+ *	5:	loc_mtx(MTX1)
+ *	== TASK2（続き）==
+ *	6:	sig_cnd(CND1)						... (B-2)
+ *		ref_tsk(TASK1, &rtsk)
+ *		assert(rtsk.tskwait == TTW_MTX)
+ *		assert(rtsk.wobjid == MTX1)
+ *		ref_mtx(MTX1, &rmtx)
+ *		assert(rmtx.wtskid == TASK3)
+ *		unl_mtx(MTX1)
+ *	== TASK3（続き）==
+ *	7:	wai_cnd(CND1, MTX1)
+ *	== TASK2（続き）==
+ *	8:	ref_mtx(MTX1, &rmtx)
+ *		assert(rmtx.htskid == TASK1)
+ *		loc_mtx(MTX1)
+ *	== TASK1（続き）==
+ *	9:	unl_mtx(MTX1)
+ *	== TASK2（続き）==
+ *	10:	wai_cnd(CND1, MTX1)
+ *	== TASK1（続き）==
+ *	11:	ref_cnd(CND1, &rcnd)
+ *		assert(rcnd.wtskid == TASK3)		... (B-3)
+ *		sig_cnd(CND1)						... (B-4)
+ *	== TASK3（続き）==
+ *	12:	ref_mtx(MTX1, &rmtx)
+ *		assert(rmtx.htskid == TASK3)
+ *		wai_cnd(CND2, MTX1)
+ *	== TASK1（続き）==
+ *	13:	rel_wai(TASK2)
+ *	== TASK2（続き）==
+ *	14:	wai_cnd(CND1, MTX1) -> E_RLWAI		... (E-1)
+ *		ref_mtx(MTX1, &rmtx)
+ *		assert(rmtx.htskid == TASK2)
+ *		wai_cnd(CND2, MTX1)
+ *	== TASK1（続き）==
+ *	15:	loc_mtx(MTX1)
+ *		brd_cnd(CND2)						... (C-1)
+ *		ref_cnd(CND2, &rcnd)
+ *		assert(rcnd.wtskid == TSK_NONE)
+ *		ref_mtx(MTX1, &rmtx)
+ *		assert(rmtx.wtskid == TASK3)
+ *		unl_mtx(MTX1)
+ *	== TASK3（続き）==
+ *	16:	unl_mtx(MTX1)
+ *		slp_tsk()
+ *	== TASK2（続き）==
+ *	17:	ref_mtx(MTX1, &rmtx)
+ *		assert(rmtx.htskid == TASK2)
+ *		unl_mtx(MTX1)
+ *		slp_tsk()
+ *	== TASK1（続き）==
+ *	18:	loc_mtx(MTX2)
+ *		get_pri(TSK_SELF, &tskpri)
+ *		assert(tskpri == MID_PRIORITY)
+ *		wup_tsk(TASK2)
+ *		wai_cnd(CND1, MTX2)
+ *	== TASK2（続き）==
+ *	19:	get_pri(TASK1, &tskpri)
+ *		assert(tskpri == LOW_PRIORITY)
+ *		chg_pri(TASK1, HIGH_PRIORITY) -> E_ILUSE	... (F-1)
+ *		ini_cnd(CND1)						... (G-1)
+ *		slp_tsk()
+ *	== TASK1（続き）==
+ *	20:	wai_cnd(CND1, MTX2) -> E_DLT		... (G-1)
+ *		get_pri(TSK_SELF, &tskpri)
+ *		assert(tskpri == MID_PRIORITY)		... (F-2)
+ *		unl_mtx(MTX2)
+ *		get_pri(TSK_SELF, &tskpri)
+ *		assert(tskpri == LOW_PRIORITY)
+ *	21:	END
+ */
+
+#include <kernel.h>
+#include <t_syslog.h>
+#include "kernel_cfg.h"
+#include "test_lib.h"
+#include "test_mutex.h"
+
+void
+task1(intptr_t exinf)
+{
+	ER_UINT	ercd;
+	T_RCND	rcnd;
+	T_RMTX	rmtx;
+	PRI		tskpri;
+
+	check_point(1);
+	ercd = ref_cnd(CND1, &rcnd);
+	check_ercd(ercd, E_OK);
+
+	check_assert(rcnd.wtskid == TSK_NONE);
+
+	ercd = wai_cnd(CND1, MTX1);
+	check_ercd(ercd, E_OBJ);
+
+	ercd = sig_cnd(CND1);
+	check_ercd(ercd, E_OK);
+
+	ercd = loc_mtx(MTX1);
+	check_ercd(ercd, E_OK);
+
+	ercd = twai_cnd(CND1, MTX1, TMO_POL);
+	check_ercd(ercd, E_TMOUT);
+
+	ercd = twai_cnd(CND1, MTX1, 10);
+	check_ercd(ercd, E_TMOUT);
+
+	ercd = ref_mtx(MTX1, &rmtx);
+	check_ercd(ercd, E_OK);
+
+	check_assert(rmtx.htskid == TASK1);
+
+	ercd = act_tsk(TASK2);
+	check_ercd(ercd, E_OK);
+
+	check_point(3);
+	ercd = wai_cnd(CND1, MTX1);
+	check_ercd(ercd, E_OK);
+
+	check_point(9);
+	ercd = unl_mtx(MTX1);
+	check_ercd(ercd, E_OK);
+
+	check_point(11);
+	ercd = ref_cnd(CND1, &rcnd);
+	check_ercd(ercd, E_OK);
+
+	check_assert(rcnd.wtskid == TASK3);
+
+	ercd = sig_cnd(CND1);
+	check_ercd(ercd, E_OK);
+
+	check_point(13);
+	ercd = rel_wai(TASK2);
+	check_ercd(ercd, E_OK);
+
+	check_point(15);
+	ercd = loc_mtx(MTX1);
+	check_ercd(ercd, E_OK);
+
+	ercd = brd_cnd(CND2);
+	check_ercd(ercd, E_OK);
+
+	ercd = ref_cnd(CND2, &rcnd);
+	check_ercd(ercd, E_OK);
+
+	check_assert(rcnd.wtskid == TSK_NONE);
+
+	ercd = ref_mtx(MTX1, &rmtx);
+	check_ercd(ercd, E_OK);
+
+	check_assert(rmtx.wtskid == TASK3);
+
+	ercd = unl_mtx(MTX1);
+	check_ercd(ercd, E_OK);
+
+	check_point(18);
+	ercd = loc_mtx(MTX2);
+	check_ercd(ercd, E_OK);
+
+	ercd = get_pri(TSK_SELF, &tskpri);
+	check_ercd(ercd, E_OK);
+
+	check_assert(tskpri == MID_PRIORITY);
+
+	ercd = wup_tsk(TASK2);
+	check_ercd(ercd, E_OK);
+
+	ercd = wai_cnd(CND1, MTX2);
+	check_ercd(ercd, E_DLT);
+
+	check_point(20);
+	ercd = get_pri(TSK_SELF, &tskpri);
+	check_ercd(ercd, E_OK);
+
+	check_assert(tskpri == MID_PRIORITY);
+
+	ercd = unl_mtx(MTX2);
+	check_ercd(ercd, E_OK);
+
+	ercd = get_pri(TSK_SELF, &tskpri);
+	check_ercd(ercd, E_OK);
+
+	check_assert(tskpri == LOW_PRIORITY);
+
+	check_finish(21);
+	check_point(0);
+}
+
+void
+task2(intptr_t exinf)
+{
+	ER_UINT	ercd;
+	T_RTSK	rtsk;
+	T_RCND	rcnd;
+	T_RMTX	rmtx;
+	PRI		tskpri;
+
+	check_point(2);
+	ercd = loc_mtx(MTX1);
+	check_ercd(ercd, E_OK);
+
+	check_point(4);
+	ercd = ref_tsk(TASK1, &rtsk);
+	check_ercd(ercd, E_OK);
+
+	check_assert(rtsk.tskwait == TTW_CND);
+
+	check_assert(rtsk.wobjid == CND1);
+
+	ercd = ref_cnd(CND1, &rcnd);
+	check_ercd(ercd, E_OK);
+
+	check_assert(rcnd.wtskid == TASK1);
+
+	ercd = act_tsk(TASK3);
+	check_ercd(ercd, E_OK);
+
+	check_point(6);
+	ercd = sig_cnd(CND1);
+	check_ercd(ercd, E_OK);
+
+	ercd = ref_tsk(TASK1, &rtsk);
+	check_ercd(ercd, E_OK);
+
+	check_assert(rtsk.tskwait == TTW_MTX);
+
+	check_assert(rtsk.wobjid == MTX1);
+
+	ercd = ref_mtx(MTX1, &rmtx);
+	check_ercd(ercd, E_OK);
+
+	check_assert(rmtx.wtskid == TASK3);
+
+	ercd = unl_mtx(MTX1);
+	check_ercd(ercd, E_OK);
+
+	check_point(8);
+	ercd = ref_mtx(MTX1, &rmtx);
+	check_ercd(ercd, E_OK);
+
+	check_assert(rmtx.htskid == TASK1);
+
+	ercd = loc_mtx(MTX1);
+	check_ercd(ercd, E_OK);
+
+	check_point(10);
+	ercd = wai_cnd(CND1, MTX1);
+	check_ercd(ercd, E_RLWAI);
+
+	check_point(14);
+	ercd = ref_mtx(MTX1, &rmtx);
+	check_ercd(ercd, E_OK);
+
+	check_assert(rmtx.htskid == TASK2);
+
+	ercd = wai_cnd(CND2, MTX1);
+	check_ercd(ercd, E_OK);
+
+	check_point(17);
+	ercd = ref_mtx(MTX1, &rmtx);
+	check_ercd(ercd, E_OK);
+
+	check_assert(rmtx.htskid == TASK2);
+
+	ercd = unl_mtx(MTX1);
+	check_ercd(ercd, E_OK);
+
+	ercd = slp_tsk();
+	check_ercd(ercd, E_OK);
+
+	check_point(19);
+	ercd = get_pri(TASK1, &tskpri);
+	check_ercd(ercd, E_OK);
+
+	check_assert(tskpri == LOW_PRIORITY);
+
+	ercd = chg_pri(TASK1, HIGH_PRIORITY);
+	check_ercd(ercd, E_ILUSE);
+
+	ercd = ini_cnd(CND1);
+	check_ercd(ercd, E_OK);
+
+	ercd = slp_tsk();
+
+	check_point(0);
+}
+
+void
+task3(intptr_t exinf)
+{
+	ER_UINT	ercd;
+	T_RMTX	rmtx;
+
+	check_point(5);
+	ercd = loc_mtx(MTX1);
+	check_ercd(ercd, E_OK);
+
+	check_point(7);
+	ercd = wai_cnd(CND1, MTX1);
+	check_ercd(ercd, E_OK);
+
+	check_point(12);
+	ercd = ref_mtx(MTX1, &rmtx);
+	check_ercd(ercd, E_OK);
+
+	check_assert(rmtx.htskid == TASK3);
+
+	ercd = wai_cnd(CND2, MTX1);
+	check_ercd(ercd, E_OK);
+
+	check_point(16);
+	ercd = unl_mtx(MTX1);
+	check_ercd(ercd, E_OK);
+
+	ercd = slp_tsk();
+
+	check_point(0);
+}
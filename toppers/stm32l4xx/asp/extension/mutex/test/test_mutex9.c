@@ -0,0 +1,318 @@
+/*
+ *  TOPPERS Software
+ *      Toyohashi Open Platform for Embedded Real-Time Systems
+ * 
+ *  Copyright (C) 2006-2009 by Embedded and Real-Time Systems Laboratory
+ *              Graduate School of Information Science, Nagoya Univ., JAPAN
+ *  Copyright (C) 2017-2018 by TOPPERS PROJECT Educational Working Group.
+ * 
+ *  上記著作権者は，以下の(1)〜(4)の条件を満たす場合に限り，本ソフトウェ
+ *  ア（本ソフトウェアを改変したものを含む．以下同じ）を使用・複製・改
+ *  変・再配布（以下，利用と呼ぶ）することを無償で許諾する．
+ *  (1) 本ソフトウェアをソースコードの形で利用する場合には，上記の著作
+ *      権表示，この利用条件および下記の無保証規定が，そのままの形でソー
+ *      スコード中に含まれていること．
+ *  (2) 本ソフトウェアを，ライブラリ形式など，他のソフトウェア開発に使
+ *      用できる形で再配布する場合には，再配布に伴うドキュメント（利用
+ *      者マニュアルなど）に，上記の著作権表示，この利用条件および下記
+ *      の無保証規定を掲載すること．
+ *  (3) 本ソフトウェアを，機器に組み込むなど，他のソフトウェア開発に使
+ *      用できない形で再配布する場合には，次のいずれかの条件を満たすこ
+ *      と．
+ *    (a) 再配布に伴うドキュメント（利用者マニュアルなど）に，上記の著
+ *        作権表示，この利用条件および下記の無保証規定を掲載すること．
+ *    (b) 再配布の形態を，別に定める方法によって，TOPPERSプロジェクトに
+ *        報告すること．
+ *  (4) 本ソフトウェアの利用により直接的または間接的に生じるいかなる損
+ *      害からも，上記著作権者およびTOPPERSプロジェクトを免責すること．
+ *      また，本ソフトウェアのユーザまたはエンドユーザからのいかなる理
+ *      由に基づく請求からも，上記著作権者およびTOPPERSプロジェクトを
+ *      免責すること．
+ * 
+ *  本ソフトウェアは，無保証で提供されているものである．上記著作権者お
+ *  よびTOPPERSプロジェクトは，本ソフトウェアに関して，特定の使用目的
+ *  に対する適合性も含めて，いかなる保証も行わない．また，本ソフトウェ
+ *  アの利用により直接的または間接的に生じたいかなる損害に関しても，そ
+ *  の責任を負わない．
+ * 
+ *  $Id$
+ */
+
+/* 
+ *		ミューテックスのテスト(9)
+ *
+ * 【テストの目的】
+ *
+ *  ミューテックスの高速パス（floc_mtx，funl_mtx）を，カーネル内の処理
+ *  （loc_mtx，unl_mtx，ini_mtx，ref_mtx，タスクの終了処理）と組み合わ
+ *  せてテストする．TOPPERS_MTX_FASTPATHを定義しない場合には，floc_mtx
+ *  とfunl_mtxはloc_mtxとunl_mtxに置き換わるため，同じ結果になる．
+ *
+ * 【テスト項目】
+ *
+ *	(A) ミューテックスのロック処理（floc_mtx）
+ *		(A-1) ロックされていない場合には，すぐにロックできること
+ *		(A-2) 多重にロックしようとすると，E_OBJエラーになること
+ *		(A-3) 他タスクが高速パスでロックしている場合には，待ち状態にな
+ *			  ること
+ *		(A-4) 優先度上限ミューテックスをロックすると，上限優先度まで優
+ *			  先度が上がること
+ *		(A-5) 優先度上限ミューテックスに対して，上限優先度違反の場合に
+ *			  E_ILUSEエラーになること
+ *		(A-6) ディスパッチ禁止状態で呼び出すと，E_CTXエラーになること
+ *	(B) ミューテックスのロック解除処理（funl_mtx）
+ *		(B-1) ロックしていないミューテックスを解放しようとすると，
+ *			  E_OBJエラーになること
+ *		(B-2) 待ちタスクがある場合には，待ちタスクにロックを渡して，
+ *			  ディスパッチが起こること
+ *		(B-3) カーネルがロックを渡したミューテックスをロック解除した後
+ *			  は，再び高速パスでロックできること
+ *	(C) タスクの終了処理
+ *		(C-1) 高速パスでロックしているミューテックスが，タスクの終了時
+ *			  にロック解除されること
+ *	(D) その他のサービスコール
+ *		(D-1) ref_mtxで，高速パスでロックしているタスクが参照できること
+ *		(D-2) ini_mtxで，高速パスでロックしているミューテックスが初期
+ *			  化されること
+ *
+ * 【使用リソース】
+ *
+ *	TASK1: 低優先度タスク，メインタスク，最初から起動
+ *	TASK2: 中優先度タスク
+ *	TASK3: 高優先度タスク
+ *	MTX1: ミューテックス（TA_NULL属性）
+ *	MTX2: ミューテックス（TA_CEILING属性，上限は中優先度）
+ *
+ * 【テストシーケンス】
+ *
+ *	== TASK1（優先度：低）==
+ *	1:	ref_mtx(MTX1, &rmtx)
+ *		assert(rmtx.htskid == TSK_NONE)
+ *		floc_mtx(MTX1)						... (A-1)
+ *	2:	ref_mtx(MTX1, &rmtx)				... (D-1)
+ *		assert(rmtx.htskid == TASK1)
+ *		assert(rmtx.wtskid == TSK_NONE)
+ *		floc_mtx(MTX1) -> E_OBJ				... (A-2)
+ *	3:	act_tsk(TASK2)
+ *	== TASK2（優先度：中）==
+ *	4:	floc_mtx(MTX1)						... (A-3)
+ *	== TASK1（続き）==
+ *	5:	ref_mtx(MTX1, &rmtx)
+ *		assert(rmtx.htskid == TASK1)
+ *		assert(rmtx.wtskid == TASK2)
+ *		funl_mtx(MTX1)						... (B-2)
+ *	== TASK2（続き）==
+ *	6:	ref_mtx(MTX1, &rmtx)
+ *		assert(rmtx.htskid == TASK2)
+ *		assert(rmtx.wtskid == TSK_NONE)
+ *		funl_mtx(MTX1)
+ *	7:	ref_mtx(MTX1, &rmtx)
+ *		assert(rmtx.htskid == TSK_NONE)
+ *		funl_mtx(MTX1) -> E_OBJ				... (B-1)
+ *		floc_mtx(MTX1)						... (B-3)
+ *		funl_mtx(MTX1)
+ *	8:	floc_mtx(MTX1)
+ *		ext_tsk() -> noreturn				... (C-1)
+ *	== TASK1（続き）==
+ *	9:	ref_mtx(MTX1, &rmtx)
+ *		assert(rmtx.htskid == TSK_NONE)
+ *		floc_mtx(MTX1)
+ *		funl_mtx(MTX1)
+ *	10:	floc_mtx(MTX2)						... (A-4)
+ *		get_pri(TSK_SELF, &tskpri)
+ *		assert(tskpri == MID_PRIORITY)
+ *		ref_mtx(MTX2, &rmtx)
+ *		assert(rmtx.htskid == TASK1)
+ *	11:	funl_mtx(MTX2)
+ *		get_pri(TSK_SELF, &tskpri)
+ *		assert(tskpri == LOW_PRIORITY)
+ *	12:	act_tsk(TASK3)
+ *	== TASK3（優先度：高）==
+ *	13:	floc_mtx(MTX2) -> E_ILUSE			... (A-5)
+ *		ext_tsk() -> noreturn
+ *	== TASK1（続き）==
+ *	14:	floc_mtx(MTX1)
+ *		ini_mtx(MTX1)						... (D-2)
+ *		ref_mtx(MTX1, &rmtx)
+ *		assert(rmtx.htskid == TSK_NONE)
+ *		funl_mtx(MTX1) -> E_OBJ
+ *	15:	dis_dsp()
+ *		floc_mtx(MTX1) -> E_CTX				... (A-6)
+ *		ena_dsp()
+ *	16:	END
+ */
+
+#include <kernel.h>
+#include <t_syslog.h>
+#include "kernel_cfg.h"
+#include "test_lib.h"
+#include "test_mutex.h"
+
+void
+task1(intptr_t exinf)
+{
+	ER_UINT	ercd;
+	T_RMTX	rmtx;
+	PRI		tskpri;
+
+	check_point(1);
+	ercd = ref_mtx(MTX1, &rmtx);
+	check_ercd(ercd, E_OK);
+
+	check_assert(rmtx.htskid == TSK_NONE);
+
+	ercd = floc_mtx(MTX1);
+	check_ercd(ercd, E_OK);
+
+	check_point(2);
+	ercd = ref_mtx(MTX1, &rmtx);
+	check_ercd(ercd, E_OK);
+
+	check_assert(rmtx.htskid == TASK1);
+
+	check_assert(rmtx.wtskid == TSK_NONE);
+
+	ercd = floc_mtx(MTX1);
+	check_ercd(ercd, E_OBJ);
+
+	check_point(3);
+	ercd = act_tsk(TASK2);
+	check_ercd(ercd, E_OK);
+
+	check_point(5);
+	ercd = ref_mtx(MTX1, &rmtx);
+	check_ercd(ercd, E_OK);
+
+	check_assert(rmtx.htskid == TASK1);
+
+	check_assert(rmtx.wtskid == TASK2);
+
+	ercd = funl_mtx(MTX1);
+	check_ercd(ercd, E_OK);
+
+	check_point(9);
+	ercd = ref_mtx(MTX1, &rmtx);
+	check_ercd(ercd, E_OK);
+
+	check_assert(rmtx.htskid == TSK_NONE);
+
+	ercd = floc_mtx(MTX1);
+	check_ercd(ercd, E_OK);
+
+	ercd = funl_mtx(MTX1);
+	check_ercd(ercd, E_OK);
+
+	check_point(10);
+	ercd = floc_mtx(MTX2);
+	check_ercd(ercd, E_OK);
+
+	ercd = get_pri(TSK_SELF, &tskpri);
+	check_ercd(ercd, E_OK);
+
+	check_assert(tskpri == MID_PRIORITY);
+
+	ercd = ref_mtx(MTX2, &rmtx);
+	check_ercd(ercd, E_OK);
+
+	check_assert(rmtx.htskid == TASK1);
+
+	check_point(11);
+	ercd = funl_mtx(MTX2);
+	check_ercd(ercd, E_OK);
+
+	ercd = get_pri(TSK_SELF, &tskpri);
+	check_ercd(ercd, E_OK);
+
+	check_assert(tskpri == LOW_PRIORITY);
+
+	check_point(12);
+	ercd = act_tsk(TASK3);
+	check_ercd(ercd, E_OK);
+
+	check_point(14);
+	ercd = floc_mtx(MTX1);
+	check_ercd(ercd, E_OK);
+
+	ercd = ini_mtx(MTX1);
+	check_ercd(ercd, E_OK);
+
+	ercd = ref_mtx(MTX1, &rmtx);
+	check_ercd(ercd, E_OK);
+
+	check_assert(rmtx.htskid == TSK_NONE);
+
+	ercd = funl_mtx(MTX1);
+	check_ercd(ercd, E_OBJ);
+
+	check_point(15);
+	ercd = dis_dsp();
+	check_ercd(ercd, E_OK);
+
+	ercd = floc_mtx(MTX1);
+	check_ercd(ercd, E_CTX);
+
+	ercd = ena_dsp();
+	check_ercd(ercd, E_OK);
+
+	check_finish(16);
+	check_point(0);
+}
+
+void
+task2(intptr_t exinf)
+{
+	ER_UINT	ercd;
+	T_RMTX	rmtx;
+
+	check_point(4);
+	ercd = floc_mtx(MTX1);
+	check_ercd(ercd, E_OK);
+
+	check_point(6);
+	ercd = ref_mtx(MTX1, &rmtx);
+	check_ercd(ercd, E_OK);
+
+	check_assert(rmtx.htskid == TASK2);
+
+	check_assert(rmtx.wtskid == TSK_NONE);
+
+	ercd = funl_mtx(MTX1);
+	check_ercd(ercd, E_OK);
+
+	check_point(7);
+	ercd = ref_mtx(MTX1, &rmtx);
+	check_ercd(ercd, E_OK);
+
+	check_assert(rmtx.htskid == TSK_NONE);
+
+	ercd = funl_mtx(MTX1);
+	check_ercd(ercd, E_OBJ);
+
+	ercd = floc_mtx(MTX1);
+	check_ercd(ercd, E_OK);
+
+	ercd = funl_mtx(MTX1);
+	check_ercd(ercd, E_OK);
+
+	check_point(8);
+	ercd = floc_mtx(MTX1);
+	check_ercd(ercd, E_OK);
+
+	ercd = ext_tsk();
+
+	check_point(0);
+}
+
+void
+task3(intptr_t exinf)
+{
+	ER_UINT	ercd;
+
+	check_point(13);
+	ercd = floc_mtx(MTX2);
+	check_ercd(ercd, E_ILUSE);
+
+	ercd = ext_tsk();
+
+	check_point(0);
+}
@@ -0,0 +1,498 @@
+/*
+ *  TOPPERS Software
+ *      Toyohashi Open Platform for Embedded Real-Time Systems
+ * 
+ *  Copyright (C) 2006-2009 by Embedded and Real-Time Systems Laboratory
+ *              Graduate School of Information Science, Nagoya Univ., JAPAN
+ *  Copyright (C) 2017-2018 by TOPPERS PROJECT Educational Working Group.
+ * 
+ *  上記著作権者は，以下の(1)〜(4)の条件を満たす場合に限り，本ソフトウェ
+ *  ア（本ソフトウェアを改変したものを含む．以下同じ）を使用・複製・改
+ *  変・再配布（以下，利用と呼ぶ）することを無償で許諾する．
+ *  (1) 本ソフトウェアをソースコードの形で利用する場合には，上記の著作
+ *      権表示，この利用条件および下記の無保証規定が，そのままの形でソー
+ *      スコード中に含まれていること．
+ *  (2) 本ソフトウェアを，ライブラリ形式など，他のソフトウェア開発に使
+ *      用できる形で再配布する場合には，再配布に伴うドキュメント（利用
+ *      者マニュアルなど）に，上記の著作権表示，この利用条件および下記
+ *      の無保証規定を掲載すること．
+ *  (3) 本ソフトウェアを，機器に組み込むなど，他のソフトウェア開発に使
+ *      用できない形で再配布する場合には，次のいずれかの条件を満たすこ
+ *      と．
+ *    (a) 再配布に伴うドキュメント（利用者マニュアルなど）に，上記の著
+ *        作権表示，この利用条件および下記の無保証規定を掲載すること．
+ *    (b) 再配布の形態を，別に定める方法によって，TOPPERSプロジェクトに
+ *        報告すること．
+ *  (4) 本ソフトウェアの利用により直接的または間接的に生じるいかなる損
+ *      害からも，上記著作権者およびTOPPERSプロジェクトを免責すること．
+ *      また，本ソフトウェアのユーザまたはエンドユーザからのいかなる理
+ *      由に基づく請求からも，上記著作権者およびTOPPERSプロジェクトを
+ *      免責すること．
+ * 
+ *  本ソフトウェアは，無保証で提供されているものである．上記著作権者お
+ *  よびTOPPERSプロジェクトは，本ソフトウェアに関して，特定の使用目的
+ *  に対する適合性も含めて，いかなる保証も行わない．また，本ソフトウェ
+ *  アの利用により直接的または間接的に生じたいかなる損害に関しても，そ
+ *  の責任を負わない．
+ * 
+ *  $Id$
+ */
+
+/* 
+ *		リーダライタロックのテスト(1)
+ *
+ * 【テストの目的】
+ *
+ *  リーダライタロックの読出しロック（loc_rdl，ploc_rdl）と書込みロッ
+ *  ク（loc_wrl，ploc_wrl）の獲得・解放，待ち順序（TA_WPREF属性の有無），
+ *  優先度上限（TA_CEILING属性），待ち状態の強制解除とタスクの終了時の
+ *  処理をテストする．
+ *
+ * 【テスト項目】
+ *
+ *	(A) ロックの獲得処理
+ *		(A-1) ロックされていない場合には，すぐに読出しロックできること
+ *		(A-2) 多重にロックしようとすると，E_OBJエラーになること
+ *		(A-3) 他タスクが読出しロックしている場合にも，読出しロックでき
+ *			  ること
+ *		(A-4) 読出しロックしているタスクが書込みロックしようとすると，
+ *			  E_OBJエラーになること
+ *		(A-5) 読出しロックされている場合には，書込みロックは待ち状態に
+ *			  なること
+ *		(A-6) TA_WPREF属性でない場合，書込みロック待ちのタスクがあると，
+ *			  読出しロックもその後ろで待つこと
+ *	(B) ロックの解放処理
+ *		(B-1) ロックしていないリーダライタロックを解放しようとすると，
+ *			  E_OBJエラーになること
+ *		(B-2) 最後の読出しロックを解放すると，書込みロック待ちのタスク
+ *			  にロックを渡して，ディスパッチが起こること
+ *		(B-3) 書込みロックを解放すると，読出しロック待ちのタスクにロッ
+ *			  クを渡して，ディスパッチが起こること
+ *	(C) 待ち状態の解除
+ *		(C-1) 書込みロック待ちのタスクの待ち状態が強制解除されると，そ
+ *			  の後ろで待つ読出しロック待ちのタスクがロックを獲得するこ
+ *			  と
+ *		(C-2) 書込みロックしているタスクが終了すると，ロックが解放され
+ *			  ること
+ *	(D) TA_WPREF属性
+ *		(D-1) 先に待っている読出しロック待ちのタスクよりも，書込みロッ
+ *			  ク待ちのタスクに先にロックを渡すこと
+ *		(D-2) 書込みロック待ちのタスクがあると，読出しロックされている
+ *			  場合にも，新たな読出しロックは獲得できないこと
+ *	(E) TA_CEILING属性
+ *		(E-1) 読出しロックすると，上限優先度まで優先度が上がること
+ *		(E-2) ロックを解放すると，元の優先度に戻ること
+ *		(E-3) ロック中に上限優先度より高いベース優先度に変更しようとす
+ *			  ると，E_ILUSEエラーになること
+ *		(E-4) 上限優先度違反の場合に，E_ILUSEエラーになること
+ *	(F) その他のサービスコール
+ *		(F-1) ini_rwlで，ロックが解放され，元の優先度に戻ること
+ *
+ * 【使用リソース】
+ *
+ *	TASK1: 低優先度タスク，メインタスク，最初から起動
+ *	TASK2: 中優先度タスク
+ *	TASK3: 高優先度タスク
+ *	RWL1: リーダライタロック（TA_NULL属性）
+ *	RWL2: リーダライタロック（TA_WPREF属性）
+ *	RWL3: リーダライタロック（TA_CEILING属性，上限は中優先度）
+ *
+ * 【テストシーケンス】
+ *
+ *	== TASK1（優先度：低）==
+ *	1:	ref_rwl(RWL1, &rrwl)
+ *		assert(rrwl.htskid == TSK_NONE)
+ *		assert(rrwl.rdcnt == 0U)
+ *		loc_rdl(RWL1)						... (A-1)
+ *		loc_rdl(RWL1) -> E_OBJ				... (A-2)
+ *		act_tsk(TASK2)
+ *	== TASK2（優先度：中）==
+ *	2:	loc_rdl(RWL1)						... (A-3)
+ *		ref_rwl(RWL1, &rrwl)
+ *		assert(rrwl.rdcnt == 2U)
+ *		ploc_wrl(RWL1) -> E_OBJ				... (A-4)
+ *		unl_rwl(RWL1)
+ *		unl_rwl(RWL1) -> E_OBJ				... (B-1)
+ *		loc_wrl(RWL1)						... (A-5)
+ *	== TASK1（続き）==
+ *	3:	ref_rwl(RWL1, &rrwl)
+ *		assert(rrwl.rdcnt == 1U)
+ *		assert(rrwl.wtskid == TASK2)
+ *		act_tsk(TASK3)
+ *	== TASK3（優先度：高）==
+ *	4:	ploc_rdl(RWL1) -> E_TMOUT			... (A-6)
+ *		loc_rdl(RWL1)						... (A-6)
+ *	== TASK1（続き）==
+ *	5:	rel_wai(TASK2)						... (C-1)
+ *	== TASK3（続き）==
+ *	6:	ref_rwl(RWL1, &rrwl)
+ *		assert(rrwl.rdcnt == 2U)
+ *		assert(rrwl.wtskid == TSK_NONE)
+ *		unl_rwl(RWL1)
+ *		slp_tsk()
+ *	== TASK2（続き）==
+ *	7:	loc_wrl(RWL1) -> E_RLWAI
+ *		loc_wrl(RWL1)
+ *	== TASK1（続き）==
+ *	8:	unl_rwl(RWL1)						... (B-2)
+ *	== TASK2（続き）==
+ *	9:	ref_rwl(RWL1, &rrwl)
+ *		assert(rrwl.htskid == TASK2)
+ *		assert(rrwl.rdcnt == 0U)
+ *		wup_tsk(TASK3)
+ *	== TASK3（続き）==
+ *	10:	loc_rdl(RWL1)
+ *	== TASK2（続き）==
+ *	11:	unl_rwl(RWL1)						... (B-3)
+ *	== TASK3（続き）==
+ *	12:	ref_rwl(RWL1, &rrwl)
+ *		assert(rrwl.htskid == TSK_NONE)
+ *		assert(rrwl.rdcnt == 1U)
+ *		unl_rwl(RWL1)
+ *		slp_tsk()
+ *	== TASK2（続き）==
+ *	13:	slp_tsk()
+ *	== TASK1（続き）==
+ *	14:	loc_wrl(RWL2)
+ *		wup_tsk(TASK3)
+ *	== TASK3（続き）==
+ *	15:	loc_rdl(RWL2)
+ *	== TASK1（続き）==
+ *	16:	wup_tsk(TASK2)
+ *	== TASK2（続き）==
+ *	17:	loc_wrl(RWL2)
+ *	== TASK1（続き）==
+ *	18:	unl_rwl(RWL2)						... (D-1)
+ *	== TASK2（続き）==
+ *	19:	ref_rwl(RWL2, &rrwl)
+ *		assert(rrwl.htskid == TASK2)
+ *		assert(rrwl.wtskid == TASK3)
+ *		unl_rwl(RWL2)
+ *	== TASK3（続き）==
+ *	20:	ref_rwl(RWL2, &rrwl)
+ *		assert(rrwl.htskid == TSK_NONE)
+ *		assert(rrwl.rdcnt == 1U)
+ *		slp_tsk()
+ *	== TASK2（続き）==
+ *	21:	loc_wrl(RWL2)
+ *	== TASK1（続き）==
+ *	22:	ploc_rdl(RWL2) -> E_TMOUT			... (D-2)
+ *		wup_tsk(TASK3)
+ *	== TASK3（続き）==
+ *	23:	unl_rwl(RWL2)
+ *		loc_rdl(RWL3) -> E_ILUSE			... (E-4)
+ *		ext_tsk() -> noreturn
+ *	== TASK2（続き）==
+ *	24:	ref_rwl(RWL2, &rrwl)
+ *		assert(rrwl.htskid == TASK2)
+ *		ext_tsk() -> noreturn				... (C-2)
+ *	== TASK1（続き）==
+ *	25:	ref_rwl(RWL2, &rrwl)
+ *		assert(rrwl.htskid == TSK_NONE)
+ *		assert(rrwl.rdcnt == 0U)
+ *		ploc_rdl(RWL2)
+ *		unl_rwl(RWL2)
+ *	26:	loc_rdl(RWL3)						... (E-1)
+ *		get_pri(TSK_SELF, &tskpri)
+ *		assert(tskpri == MID_PRIORITY)
+ *		chg_pri(TSK_SELF, HIGH_PRIORITY) -> E_ILUSE		... (E-3)
+ *		unl_rwl(RWL3)						... (E-2)
+ *		get_pri(TSK_SELF, &tskpri)
+ *		assert(tskpri == LOW_PRIORITY)
+ *	27:	loc_wrl(RWL3)
+ *		get_pri(TSK_SELF, &tskpri)
+ *		assert(tskpri == MID_PRIORITY)
+ *		ini_rwl(RWL3)						... (F-1)
+ *		get_pri(TSK_SELF, &tskpri)
+ *		assert(tskpri == LOW_PRIORITY)
+ *		ref_rwl(RWL3, &rrwl)
+ *		assert(rrwl.htskid == TSK_NONE)
+ *		unl_rwl(RWL3) -> E_OBJ
+ *	28:	END
+ */
+
+#include <kernel.h>
+#include <t_syslog.h>
+#include "kernel_cfg.h"
+#include "test_lib.h"
+#include "test_mutex.h"
+
+void
+task1(intptr_t exinf)
+{
+	ER_UINT	ercd;
+	T_RRWL	rrwl;
+	PRI		tskpri;
+
+	check_point(1);
+	ercd = ref_rwl(RWL1, &rrwl);
+	check_ercd(ercd, E_OK);
+
+	check_assert(rrwl.htskid == TSK_NONE);
+
+	check_assert(rrwl.rdcnt == 0U);
+
+	ercd = loc_rdl(RWL1);
+	check_ercd(ercd, E_OK);
+
+	ercd = loc_rdl(RWL1);
+	check_ercd(ercd, E_OBJ);
+
+	ercd = act_tsk(TASK2);
+	check_ercd(ercd, E_OK);
+
+	check_point(3);
+	ercd = ref_rwl(RWL1, &rrwl);
+	check_ercd(ercd, E_OK);
+
+	check_assert(rrwl.rdcnt == 1U);
+
+	check_assert(rrwl.wtskid == TASK2);
+
+	ercd = act_tsk(TASK3);
+	check_ercd(ercd, E_OK);
+
+	check_point(5);
+	ercd = rel_wai(TASK2);
+	check_ercd(ercd, E_OK);
+
+	check_point(8);
+	ercd = unl_rwl(RWL1);
+	check_ercd(ercd, E_OK);
+
+	check_point(14);
+	ercd = loc_wrl(RWL2);
+	check_ercd(ercd, E_OK);
+
+	ercd = wup_tsk(TASK3);
+	check_ercd(ercd, E_OK);
+
+	check_point(16);
+	ercd = wup_tsk(TASK2);
+	check_ercd(ercd, E_OK);
+
+	check_point(18);
+	ercd = unl_rwl(RWL2);
+	check_ercd(ercd, E_OK);
+
+	check_point(22);
+	ercd = ploc_rdl(RWL2);
+	check_ercd(ercd, E_TMOUT);
+
+	ercd = wup_tsk(TASK3);
+	check_ercd(ercd, E_OK);
+
+	check_point(25);
+	ercd = ref_rwl(RWL2, &rrwl);
+	check_ercd(ercd, E_OK);
+
+	check_assert(rrwl.htskid == TSK_NONE);
+
+	check_assert(rrwl.rdcnt == 0U);
+
+	ercd = ploc_rdl(RWL2);
+	check_ercd(ercd, E_OK);
+
+	ercd = unl_rwl(RWL2);
+	check_ercd(ercd, E_OK);
+
+	check_point(26);
+	ercd = loc_rdl(RWL3);
+	check_ercd(ercd, E_OK);
+
+	ercd = get_pri(TSK_SELF, &tskpri);
+	check_ercd(ercd, E_OK);
+
+	check_assert(tskpri == MID_PRIORITY);
+
+	ercd = chg_pri(TSK_SELF, HIGH_PRIORITY);
+	check_ercd(ercd, E_ILUSE);
+
+	ercd = unl_rwl(RWL3);
+	check_ercd(ercd, E_OK);
+
+	ercd = get_pri(TSK_SELF, &tskpri);
+	check_ercd(ercd, E_OK);
+
+	check_assert(tskpri == LOW_PRIORITY);
+
+	check_point(27);
+	ercd = loc_wrl(RWL3);
+	check_ercd(ercd, E_OK);
+
+	ercd = get_pri(TSK_SELF, &tskpri);
+	check_ercd(ercd, E_OK);
+
+	check_assert(tskpri == MID_PRIORITY);
+
+	ercd = ini_rwl(RWL3);
+	check_ercd(ercd, E_OK);
+
+	ercd = get_pri(TSK_SELF, &tskpri);
+	check_ercd(ercd, E_OK);
+
+	check_assert(tskpri == LOW_PRIORITY);
+
+	ercd = ref_rwl(RWL3, &rrwl);
+	check_ercd(ercd, E_OK);
+
+	check_assert(rrwl.htskid == TSK_NONE);
+
+	ercd = unl_rwl(RWL3);
+	check_ercd(ercd, E_OBJ);
+
+	check_finish(28);
+	check_point(0);
+}
+
+void
+task2(intptr_t exinf)
+{
+	ER_UINT	ercd;
+	T_RRWL	rrwl;
+
+	check_point(2);
+	ercd = loc_rdl(RWL1);
+	check_ercd(ercd, E_OK);
+
+	ercd = ref_rwl(RWL1, &rrwl);
+	check_ercd(ercd, E_OK);
+
+	check_assert(rrwl.rdcnt == 2U);
+
+	ercd = ploc_wrl(RWL1);
+	check_ercd(ercd, E_OBJ);
+
+	ercd = unl_rwl(RWL1);
+	check_ercd(ercd, E_OK);
+
+	ercd = unl_rwl(RWL1);
+	check_ercd(ercd, E_OBJ);
+
+	ercd = loc_wrl(RWL1);
+	check_ercd(ercd, E_RLWAI);
+
+	check_point(7);
+	ercd = loc_wrl(RWL1);
+	check_ercd(ercd, E_OK);
+
+	check_point(9);
+	ercd = ref_rwl(RWL1, &rrwl);
+	check_ercd(ercd, E_OK);
+
+	check_assert(rrwl.htskid == TASK2);
+
+	check_assert(rrwl.rdcnt == 0U);
+
+	ercd = wup_tsk(TASK3);
+	check_ercd(ercd, E_OK);
+
+	check_point(11);
+	ercd = unl_rwl(RWL1);
+	check_ercd(ercd, E_OK);
+
+	check_point(13);
+	ercd = slp_tsk();
+	check_ercd(ercd, E_OK);
+
+	check_point(17);
+	ercd = loc_wrl(RWL2);
+	check_ercd(ercd, E_OK);
+
+	check_point(19);
+	ercd = ref_rwl(RWL2, &rrwl);
+	check_ercd(ercd, E_OK);
+
+	check_assert(rrwl.htskid == TASK2);
+
+	check_assert(rrwl.wtskid == TASK3);
+
+	ercd = unl_rwl(RWL2);
+	check_ercd(ercd, E_OK);
+
+	check_point(21);
+	ercd = loc_wrl(RWL2);
+	check_ercd(ercd, E_OK);
+
+	check_point(24);
+	ercd = ref_rwl(RWL2, &rrwl);
+	check_ercd(ercd, E_OK);
+
+	check_assert(rrwl.htskid == TASK2);
+
+	ercd = ext_tsk();
+
+	check_point(0);
+}
+
+void
+task3(intptr_t exinf)
+{
+	ER_UINT	ercd;
+	T_RRWL	rrwl;
+
+	check_point(4);
+	ercd = ploc_rdl(RWL1);
+	check_ercd(ercd, E_TMOUT);
+
+	ercd = loc_rdl(RWL1);
+	check_ercd(ercd, E_OK);
+
+	check_point(6);
+	ercd = ref_rwl(RWL1, &rrwl);
+	check_ercd(ercd, E_OK);
+
+	check_assert(rrwl.rdcnt == 2U);
+
+	check_assert(rrwl.wtskid == TSK_NONE);
+
+	ercd = unl_rwl(RWL1);
+	check_ercd(ercd, E_OK);
+
+	ercd = slp_tsk();
+	check_ercd(ercd, E_OK);
+
+	check_point(10);
+	ercd = loc_rdl(RWL1);
+	check_ercd(ercd, E_OK);
+
+	check_point(12);
+	ercd = ref_rwl(RWL1, &rrwl);
+	check_ercd(ercd, E_OK);
+
+	check_assert(rrwl.htskid == TSK_NONE);
+
+	check_assert(rrwl.rdcnt == 1U);
+
+	ercd = unl_rwl(RWL1);
+	check_ercd(ercd, E_OK);
+
+	ercd = slp_tsk();
+	check_ercd(ercd, E_OK);
+
+	check_point(15);
+	ercd = loc_rdl(RWL2);
+	check_ercd(ercd, E_OK);
+
+	check_point(20);
+	ercd = ref_rwl(RWL2, &rrwl);
+	check_ercd(ercd, E_OK);
+
+	check_assert(rrwl.htskid == TSK_NONE);
+
+	check_assert(rrwl.rdcnt == 1U);
+
+	ercd = slp_tsk();
+	check_ercd(ercd, E_OK);
+
+	check_point(23);
+	ercd = unl_rwl(RWL2);
+	check_ercd(ercd, E_OK);
+
+	ercd = loc_rdl(RWL3);
+	check_ercd(ercd, E_ILUSE);
+
+	ercd = ext_tsk();
+
+	check_point(0);
+}
@@ -125,6 +125,10 @@
 /* eventflag.c */
 #define TOPPERS_flgini
 #define TOPPERS_flgcnd
+#define TOPPERS_flgiwai
+#define TOPPERS_flgirel
+#define TOPPERS_flgiini
+#define TOPPERS_flgitsk
 #define TOPPERS_set_flg
 #define TOPPERS_iset_flg
 #define TOPPERS_clr_flg
@@ -192,6 +196,7 @@
 /* time_manage.c */
 #define TOPPERS_get_tim
 #define TOPPERS_get_utm
+#define TOPPERS_get_utm64
 
 /* cyclic.c */
 #define TOPPERS_cycini
@@ -249,4 +254,9 @@
 #define TOPPERS_xsns_dpn
 #define TOPPERS_xsns_xpn
 
+/* multi_wait.c */
+#define TOPPERS_mwaicb
+#define TOPPERS_mwaintfy
+#define TOPPERS_twai_obj
+
 #endif /* TOPPERS_ALLFUNC_H */
@@ -72,6 +72,10 @@
  */
 #undef initialize_eventflag
 #undef check_flg_cond
+#undef flg_index_make_wait
+#undef flg_index_release
+#undef flg_index_init
+#undef flg_index_tskid
 
 /*
  *  dataqueue.c
@@ -126,6 +130,12 @@
  */
 #undef initialize_exception
 
+/*
+ *  multi_wait.c
+ */
+#undef mwaitcb
+#undef notify_multi_wait
+
 /*
  *  kernel_cfg.c
  */
@@ -242,6 +252,10 @@
  */
 #undef _initialize_eventflag
 #undef _check_flg_cond
+#undef _flg_index_make_wait
+#undef _flg_index_release
+#undef _flg_index_init
+#undef _flg_index_tskid
 
 /*
  *  dataqueue.c
@@ -296,6 +310,12 @@
  */
 #undef _initialize_exception
 
+/*
+ *  multi_wait.c
+ */
+#undef _mwaitcb
+#undef _notify_multi_wait
+
 /*
  *  kernel_cfg.c
  */
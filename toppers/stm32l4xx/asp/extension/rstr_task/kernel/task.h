@@ -50,6 +50,16 @@
 #include <queue.h>
 #include "time_event.h"
 
+/*
+ *  TCBの縮小のサポート
+ *
+ *  制約タスク拡張パッケージのカーネルは，TOPPERS_COMPACT_TCBによるTCBの
+ *  縮小をサポートしていない．
+ */
+#ifdef TOPPERS_COMPACT_TCB
+#error TOPPERS_COMPACT_TCB is not supported with the restricted task extension.
+#endif /* TOPPERS_COMPACT_TCB */
+
 /*
  *  トレースログマクロのデフォルト定義
  */
@@ -86,6 +96,7 @@
 #define TS_WAIT_SPDQ	(0x07U << 3)	/* 優先度データキューへの送信待ち */
 #define TS_WAIT_MBX		(0x08U << 3)	/* メールボックスからの受信待ち */
 #define TS_WAIT_MPF		(0x09U << 3)	/* 固定長メモリブロックの獲得待ち */
+#define TS_WAIT_OBJ		(0x0fU << 3)	/* 複数オブジェクト待ち */
 
 /*
  *  タスク状態判別マクロ
@@ -373,6 +384,12 @@ extern TCB	tcb_table[];
  */
 #define	TSKID(p_tcb)	((ID)(((p_tcb) - tcb_table) + TMIN_TSKID))
 
+/*
+ *  TCBからタスク初期化ブロックと保留例外要因を参照するためのマクロ
+ */
+#define get_tinib(p_tcb)	((p_tcb)->p_tinib)
+#define TSK_TEXPTN(p_tcb)	((p_tcb)->texptn)
+
 /*
  *  タスク管理モジュールの初期化
  */
@@ -124,6 +124,13 @@
 #define LOG_GET_INF_LEAVE(ercd, exinf)
 #endif /* LOG_GET_INF_LEAVE */
 
+/*
+ *  ディスパッチ禁止区間の計測のためのマクロのデフォルト定義
+ */
+#ifndef LOCKPROF_DSP_LEAVE
+#define LOCKPROF_DSP_LEAVE()
+#endif /* LOCKPROF_DSP_LEAVE */
+
 /*
  *  タスクの起動
  */
@@ -258,6 +265,7 @@ ext_tsk(void)
 		 *  ディスパッチ禁止状態でext_tskが呼ばれた場合は，ディスパッ
 		 *  チ許可状態にしてからタスクを終了する．
 		 */
+		LOCKPROF_DSP_LEAVE();
 		disdsp = false;
 	}
 	if (!ipmflg) {
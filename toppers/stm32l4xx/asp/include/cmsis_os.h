@@ -0,0 +1,365 @@
+/*
+ *  TOPPERS/ASP Kernel
+ *      Toyohashi Open Platform for Embedded Real-Time Systems/
+ *      Advanced Standard Profile Kernel
+ * 
+ *  Copyright (C) 2005-2011 by Embedded and Real-Time Systems Laboratory
+ *              Graduate School of Information Science, Nagoya Univ., JAPAN
+ *  Copyright (C) 2017-2018 by TOPPERS PROJECT Educational Working Group.
+ * 
+ *  上記著作権者は，以下の(1)〜(4)の条件を満たす場合に限り，本ソフトウェ
+ *  ア（本ソフトウェアを改変したものを含む．以下同じ）を使用・複製・改
+ *  変・再配布（以下，利用と呼ぶ）することを無償で許諾する．
+ *  (1) 本ソフトウェアをソースコードの形で利用する場合には，上記の著作
+ *      権表示，この利用条件および下記の無保証規定が，そのままの形でソー
+ *      スコード中に含まれていること．
+ *  (2) 本ソフトウェアを，ライブラリ形式など，他のソフトウェア開発に使
+ *      用できる形で再配布する場合には，再配布に伴うドキュメント（利用
+ *      者マニュアルなど）に，上記の著作権表示，この利用条件および下記
+ *      の無保証規定を掲載すること．
+ *  (3) 本ソフトウェアを，機器に組み込むなど，他のソフトウェア開発に使
+ *      用できない形で再配布する場合には，次のいずれかの条件を満たすこ
+ *      と．
+ *    (a) 再配布に伴うドキュメント（利用者マニュアルなど）に，上記の著
+ *        作権表示，この利用条件および下記の無保証規定を掲載すること．
+ *    (b) 再配布の形態を，別に定める方法によって，TOPPERSプロジェクトに
+ *        報告すること．
+ *  (4) 本ソフトウェアの利用により直接的または間接的に生じるいかなる損
+ *      害からも，上記著作権者およびTOPPERSプロジェクトを免責すること．
+ *      また，本ソフトウェアのユーザまたはエンドユーザからのいかなる理
+ *      由に基づく請求からも，上記著作権者およびTOPPERSプロジェクトを
+ *      免責すること．
+ * 
+ *  本ソフトウェアは，無保証で提供されているものである．上記著作権者お
+ *  よびTOPPERSプロジェクトは，本ソフトウェアに関して，特定の使用目的
+ *  に対する適合性も含めて，いかなる保証も行わない．また，本ソフトウェ
+ *  アの利用により直接的または間接的に生じたいかなる損害に関しても，そ
+ *  の責任を負わない．
+ * 
+ *  $Id$
+ */
+
+/*
+ *		CMSIS-RTOS（Version 1）API層
+ *
+ *  CMSIS-RTOS APIのスレッド，メッセージキュー，セマフォ，ミューテック
+ *  ス，タイマを，それぞれタスク，データキュー，セマフォ，ミューテック
+ *  ス（ミューテックス機能拡張パッケージ），周期ハンドラ／アラームハン
+ *  ドラに1対1に対応させる．オブジェクトはシステムコンフィギュレーショ
+ *  ンファイル中の静的APIで，CMSIS-RTOSのオブジェクト名をIDとして生成し
+ *  ておき，osXxxDefマクロはそのIDを保持する．メッセージの複製や独自の
+ *  待ち行列は用いない．
+ *
+ *  osXxxDefマクロを用いるファイルでは，オブジェクト名をIDに展開するた
+ *  めに，kernel_cfg.hをインクルードしておく必要がある．
+ *
+ *  CMSIS-RTOS Version 2のAPI（cmsis_os2.h）は提供しない．
+ */
+
+#ifndef TOPPERS_CMSIS_OS_H
+#define TOPPERS_CMSIS_OS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <kernel.h>
+
+/*
+ *  APIのバージョンとカーネルの識別
+ */
+#define osCMSIS				0x10002U	/* CMSIS-RTOS APIのバージョン（1.02）*/
+#define osCMSIS_KERNEL		0x10903U	/* カーネルのバージョン（1.9.3）*/
+#define osKernelSystemId	"TOPPERS/ASP V1.9.3"
+
+/*
+ *  サポートする機能
+ */
+#define osFeature_MainThread	0		/* mainはスレッドとして実行しない */
+#define osFeature_Pool			0		/* メモリプールは未サポート */
+#define osFeature_MailQ			0		/* メールキューは未サポート */
+#define osFeature_MessageQ		1		/* メッセージキュー */
+#define osFeature_Signals		0		/* シグナルは未サポート */
+#define osFeature_Semaphore		65535	/* セマフォの最大資源数 */
+#define osFeature_Wait			0		/* osWaitは未サポート */
+#define osFeature_SysTick		1		/* osKernelSysTick */
+
+/*
+ *  スレッドの優先度
+ *
+ *  osPriorityNormalをCMSIS_TPRI_NORMALに対応させ，CMSIS-RTOSの優先度
+ *  が1つ高くなる毎に，タスク優先度を1つ高く（値を1小さく）する．CRE_TSK
+ *  の初期優先度は，CMSIS_TPRI(osPriorityNormal)のように指定する．
+ */
+typedef enum {
+	osPriorityIdle			= -3,
+	osPriorityLow			= -2,
+	osPriorityBelowNormal	= -1,
+	osPriorityNormal		= 0,
+	osPriorityAboveNormal	= +1,
+	osPriorityHigh			= +2,
+	osPriorityRealtime		= +3,
+	osPriorityError			= 0x84
+} osPriority;
+
+#ifndef CMSIS_TPRI_NORMAL
+#define CMSIS_TPRI_NORMAL	8			/* osPriorityNormalのタスク優先度 */
+#endif /* CMSIS_TPRI_NORMAL */
+
+#define CMSIS_TPRI(prio)	(CMSIS_TPRI_NORMAL - (prio))
+
+/*
+ *  タイムアウト
+ */
+#define osWaitForever		0xFFFFFFFFU
+
+/*
+ *  ステータスコード
+ */
+typedef enum {
+	osOK					= 0,
+	osEventSignal			= 0x08,
+	osEventMessage			= 0x10,
+	osEventMail				= 0x20,
+	osEventTimeout			= 0x40,
+	osErrorParameter		= 0x80,
+	osErrorResource			= 0x81,
+	osErrorTimeoutResource	= 0xC1,
+	osErrorISR				= 0x82,
+	osErrorISRRecursive		= 0x83,
+	osErrorPriority			= 0x84,
+	osErrorNoMemory			= 0x85,
+	osErrorValue			= 0x86,
+	osErrorOS				= 0xFF,
+	os_status_reserved		= 0x7FFFFFFF
+} osStatus;
+
+/*
+ *  タイマの種類
+ *
+ *  osTimerPeriodicのタイマは周期ハンドラ（CRE_CYC），osTimerOnceのタ
+ *  イマはアラームハンドラ（CRE_ALM）で生成しておく．
+ */
+typedef enum {
+	osTimerOnce			= 0,
+	osTimerPeriodic		= 1
+} os_timer_type;
+
+/*
+ *  スレッドとタイマのエントリ
+ *
+ *  引数の型がタスクのメインルーチン，周期ハンドラ，アラームハンドラ
+ *  （intptr_t型）と異なるため，CRE_TSK／CRE_CYC／CRE_ALMに直接指定し
+ *  てはならない．静的APIには，cmsis_thread_main／cmsis_cyclic_handler
+ *  ／cmsis_alarm_handlerを指定し，拡張情報に定義情報の番地を渡す（後
+ *  述）．
+ */
+typedef void	(*os_pthread)(void const *argument);
+typedef void	(*os_ptimer)(void const *argument);
+
+/*
+ *  オブジェクトの識別子
+ *
+ *  各オブジェクトのIDをそのまま用いる．周期ハンドラで実現したタイマは，
+ *  アラームハンドラのIDと区別するために，CMSIS_TMRID_CYCを加える．
+ */
+typedef ID	osThreadId;
+typedef ID	osTimerId;
+typedef ID	osMutexId;
+typedef ID	osSemaphoreId;
+typedef ID	osMessageQId;
+
+#define CMSIS_TMRID_CYC		0x4000
+
+/*
+ *  オブジェクトの定義情報
+ */
+typedef struct os_thread_def {
+	ID			tskid;			/* タスクID */
+	os_pthread	pthread;		/* スレッドのエントリ */
+	osPriority	tpriority;		/* スレッドの優先度 */
+	uint32_t	instances;		/* インスタンス数（未使用）*/
+	uint32_t	stacksize;		/* スタックサイズ（未使用）*/
+} osThreadDef_t;
+
+typedef struct os_timer_def {
+	ID			tmrid;			/* 周期ハンドラID／アラームハンドラID */
+	os_ptimer	ptimer;			/* タイマのエントリ */
+} osTimerDef_t;
+
+typedef struct os_mutex_def {
+	ID			mtxid;			/* ミューテックスID */
+} osMutexDef_t;
+
+typedef struct os_semaphore_def {
+	ID			semid;			/* セマフォID */
+} osSemaphoreDef_t;
+
+typedef struct os_messageQ_def {
+	ID			dtqid;			/* データキューID */
+	uint32_t	queue_sz;		/* キューの容量（未使用）*/
+	uint32_t	item_sz;		/* 要素のサイズ（未使用）*/
+} osMessageQDef_t;
+
+/*
+ *  イベント（osMessageGetの返値）
+ */
+typedef struct {
+	osStatus	status;
+	union {
+		uint32_t	v;
+		void		*p;
+		int32_t		signals;
+	} value;
+	union {
+		osMessageQId	message_id;
+	} def;
+} osEvent;
+
+/*
+ *  オブジェクトの定義のためのマクロ
+ */
+#define osThreadDef(name, thread, priority, instances, stacksz) \
+	const osThreadDef_t os_thread_def_##name = \
+				{ (name), (thread), (priority), (instances), (stacksz) }
+#define osThread(name)			(&os_thread_def_##name)
+
+#define osTimerDef(name, function) \
+	const osTimerDef_t os_timer_def_##name = { (name), (function) }
+#define osTimer(name)			(&os_timer_def_##name)
+
+/*
+ *  定義情報の宣言のためのマクロ
+ *
+ *  スレッドとタイマの定義情報は，静的APIの拡張情報に番地を渡すために，
+ *  システムコンフィギュレーションファイルからインクルードするヘッダファ
+ *  イルで，これらのマクロを用いて宣言しておく．
+ */
+#define CMSIS_THREAD_DECL(name) \
+	extern const osThreadDef_t os_thread_def_##name
+#define CMSIS_TIMER_DECL(name) \
+	extern const osTimerDef_t os_timer_def_##name
+
+#define osMutexDef(name) \
+	const osMutexDef_t os_mutex_def_##name = { (name) }
+#define osMutex(name)			(&os_mutex_def_##name)
+
+#define osSemaphoreDef(name) \
+	const osSemaphoreDef_t os_semaphore_def_##name = { (name) }
+#define osSemaphore(name)		(&os_semaphore_def_##name)
+
+#define osMessageQDef(name, queue_sz, type) \
+	const osMessageQDef_t os_messageQ_def_##name = \
+				{ (name), (queue_sz), sizeof(type) }
+#define osMessageQ(name)		(&os_messageQ_def_##name)
+
+/*
+ *  カーネルの制御
+ */
+#define osKernelSysTickFrequency	1000000U		/* get_utmの単位 */
+#define osKernelSysTickMicroSec(microsec)	((uint32_t)(microsec))
+
+extern osStatus	osKernelInitialize(void) throw();
+extern osStatus	osKernelStart(void) throw();
+extern int32_t	osKernelRunning(void) throw();
+extern uint32_t	osKernelSysTick(void) throw();
+
+/*
+ *  スレッドの管理
+ */
+extern osThreadId	osThreadCreate(const osThreadDef_t *thread_def,
+										void *argument) throw();
+extern osThreadId	osThreadGetId(void) throw();
+extern osStatus		osThreadTerminate(osThreadId thread_id) throw();
+extern osStatus		osThreadYield(void) throw();
+extern osStatus		osThreadSetPriority(osThreadId thread_id,
+										osPriority priority) throw();
+extern osPriority	osThreadGetPriority(osThreadId thread_id) throw();
+
+/*
+ *  時間待ち
+ */
+extern osStatus	osDelay(uint32_t millisec) throw();
+
+/*
+ *  タイマの管理
+ */
+extern osTimerId	osTimerCreate(const osTimerDef_t *timer_def,
+							os_timer_type type, void *argument) throw();
+extern osStatus		osTimerStart(osTimerId timer_id,
+										uint32_t millisec) throw();
+extern osStatus		osTimerStop(osTimerId timer_id) throw();
+extern osStatus		osTimerDelete(osTimerId timer_id) throw();
+
+/*
+ *  ミューテックスの管理
+ */
+#ifdef TOPPERS_SUPPORT_MUTEX
+extern osMutexId	osMutexCreate(const osMutexDef_t *mutex_def) throw();
+extern osStatus		osMutexWait(osMutexId mutex_id,
+										uint32_t millisec) throw();
+extern osStatus		osMutexRelease(osMutexId mutex_id) throw();
+extern osStatus		osMutexDelete(osMutexId mutex_id) throw();
+#endif /* TOPPERS_SUPPORT_MUTEX */
+
+/*
+ *  セマフォの管理
+ */
+extern osSemaphoreId	osSemaphoreCreate(const osSemaphoreDef_t *semaphore_def,
+										int32_t count) throw();
+extern int32_t		osSemaphoreWait(osSemaphoreId semaphore_id,
+										uint32_t millisec) throw();
+extern osStatus		osSemaphoreRelease(osSemaphoreId semaphore_id) throw();
+extern osStatus		osSemaphoreDelete(osSemaphoreId semaphore_id) throw();
+
+/*
+ *  メッセージキューの管理
+ */
+extern osMessageQId	osMessageCreate(const osMessageQDef_t *queue_def,
+										osThreadId thread_id) throw();
+extern osStatus		osMessagePut(osMessageQId queue_id, uint32_t info,
+										uint32_t millisec) throw();
+extern osEvent		osMessageGet(osMessageQId queue_id,
+										uint32_t millisec) throw();
+
+/*
+ *  CMSIS-RTOS API層の起動タスク
+ *
+ *  カーネル起動前にosThreadCreateで生成を要求されたスレッドを，カーネ
+ *  ル起動後に起動する．syssvc/cmsis_os.cfgで生成する．
+ */
+#ifndef CMSIS_START_PRIORITY
+#define CMSIS_START_PRIORITY	1		/* 初期優先度 */
+#endif /* CMSIS_START_PRIORITY */
+
+#ifndef CMSIS_START_STACK_SIZE
+#define CMSIS_START_STACK_SIZE	512		/* スタック領域のサイズ */
+#endif /* CMSIS_START_STACK_SIZE */
+
+extern void	cmsis_start_task(intptr_t exinf) throw();
+
+/*
+ *  スレッドとタイマのエントリを呼び出すためのルーチン
+ *
+ *  exinfには，osThread(name)／osTimer(name)で得られる定義情報の番地を
+ *  (intptr_t)にキャストして指定する．スレッドのエントリには
+ *  osThreadCreateのargumentが，タイマのエントリにはosTimerCreateの
+ *  argumentが渡される．
+ *
+ *	CRE_TSK(THREAD1, { TA_NULL, (intptr_t) osThread(THREAD1),
+ *						cmsis_thread_main, CMSIS_TPRI(osPriorityNormal),
+ *						STACK_SIZE, NULL });
+ *	CRE_CYC(TIMER1, { TA_NULL, (intptr_t) osTimer(TIMER1),
+ *						cmsis_cyclic_handler, 1000, 0 });
+ *	CRE_ALM(TIMER2, { TA_NULL, (intptr_t) osTimer(TIMER2),
+ *						cmsis_alarm_handler });
+ */
+extern void	cmsis_thread_main(intptr_t exinf) throw();
+extern void	cmsis_cyclic_handler(intptr_t exinf) throw();
+extern void	cmsis_alarm_handler(intptr_t exinf) throw();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TOPPERS_CMSIS_OS_H */
@@ -48,11 +48,52 @@
 extern "C" {
 #endif
 
+/*
+ *  対数線形の区間の分割数（2のべき乗毎の範囲を2^HIST_LOG_SUBBITS個に
+ *  分割する）
+ */
+#ifndef HIST_LOG_SUBBITS
+#define HIST_LOG_SUBBITS	4U
+#endif /* HIST_LOG_SUBBITS */
+
+/*
+ *  対数線形の区間で2^bits-1までの時間を記録するのに必要な区間の数
+ *
+ *  例えば，HIST_LOG_SUBBITSが4の場合，1023までの時間を記録するには
+ *  HIST_LOG_NBUCKET(10)＝112個の区間で足りる．
+ */
+#define HIST_LOG_NBUCKET(bits)	(((bits) - HIST_LOG_SUBBITS + 1U) \
+												<< HIST_LOG_SUBBITS)
+
+/*
+ *  実行時間分布計測の統計情報
+ */
+typedef struct t_rhist {
+	uint_t	count;			/* 計測回数（時間の逆転を除く）*/
+	uint_t	under;			/* 時間の逆転が疑われる度数 */
+	uint_t	over;			/* 最大時間を超えた度数 */
+	uint_t	min;			/* 最小時間 */
+	uint_t	mean;			/* 平均時間 */
+	uint_t	max;			/* 最大時間 */
+	uint_t	p50;			/* 50パーセンタイル値 */
+	uint_t	p90;			/* 90パーセンタイル値 */
+	uint_t	p99;			/* 99パーセンタイル値 */
+	uint_t	p999;			/* 99.9パーセンタイル値 */
+} T_RHIST;
+
 /*
  *  実行時間分布計測の初期化
  */
 extern void	init_hist(ID histid, uint_t maxval, uint_t histarea[]);
 
+/*
+ *  対数線形の区間による実行時間分布計測の初期化
+ *
+ *  2^bits-1までの時間を，相対誤差が2^-HIST_LOG_SUBBITS以下の区間で記録
+ *  する．histareaには，HIST_LOG_NBUCKET(bits)個の要素を持つ領域を渡す．
+ */
+extern void	init_hist_log(ID histid, uint_t bits, uint_t histarea[]);
+
 /*
  *  実行時間計測の開始
  */
@@ -63,11 +104,37 @@ extern void	begin_measure(ID histid);
  */
 extern void	end_measure(ID histid);
 
+/*
+ *  実行時間分布計測の統計情報の参照
+ */
+extern void	ref_hist(ID histid, T_RHIST *pk_rhist);
+
+/*
+ *  実行時間のパーセンタイル値の計算（permilleは1/1000単位）
+ */
+extern uint_t	hist_percentile(ID histid, uint_t permille);
+
 /*
  *  実行時間分布計測の表示
  */
 extern void	print_hist(ID histid);
 
+/*
+ *  実行時間分布計測の統計情報（計測回数，最小・平均・最大時間，パーセ
+ *  ンタイル値）の表示
+ */
+extern void	print_hist_stat(ID histid);
+
+/*
+ *  実行時間分布計測のCSV形式での表示
+ */
+extern void	print_hist_csv(ID histid);
+
+/*
+ *  ベンチマーク結果の機械可読な形式での表示
+ */
+extern void	print_hist_bench(ID histid, const char *name);
+
 #ifdef __cplusplus
 }
 #endif
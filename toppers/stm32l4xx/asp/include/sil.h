@@ -278,6 +278,111 @@ sil_wrw_bem(uint32_t *mem, uint32_t data)
 #endif /* SIL_ENDIAN_BIG */
 #endif /* TOPPERS_OMIT_SIL_ACCESS */
 
+/*
+ *  アトミック操作
+ *
+ *  32ビットのワードに対する読出し・書込み・加算・減算・比較交換・ビッ
+ *  トのセットとクリアを，他の処理（割込みハンドラを含む）に割り込まれ
+ *  ずに行う．sil_atm_add，sil_atm_sub，sil_atm_set，sil_atm_clrは操作
+ *  前の値を，sil_atm_casは交換した場合にtrueを返す．
+ *
+ *  デフォルトの定義は，全割込みロック状態で操作を行う．ターゲット依存
+ *  部で排他ロード／排他ストア命令などを用いて用意する場合には，
+ *  TOPPERS_OMIT_SIL_ATOMICをマクロ定義する．
+ */
+#ifndef TOPPERS_OMIT_SIL_ATOMIC
+
+Inline uint32_t
+sil_atm_rew(const uint32_t *mem)
+{
+	uint32_t	data;
+	SIL_PRE_LOC;
+
+	SIL_LOC_INT();
+	data = *((const volatile uint32_t *) mem);
+	SIL_UNL_INT();
+	return(data);
+}
+
+Inline void
+sil_atm_wrw(uint32_t *mem, uint32_t data)
+{
+	SIL_PRE_LOC;
+
+	SIL_LOC_INT();
+	*((volatile uint32_t *) mem) = data;
+	SIL_UNL_INT();
+}
+
+Inline uint32_t
+sil_atm_add(uint32_t *mem, uint32_t val)
+{
+	uint32_t	data;
+	SIL_PRE_LOC;
+
+	SIL_LOC_INT();
+	data = *((volatile uint32_t *) mem);
+	*((volatile uint32_t *) mem) = data + val;
+	SIL_UNL_INT();
+	return(data);
+}
+
+Inline uint32_t
+sil_atm_sub(uint32_t *mem, uint32_t val)
+{
+	uint32_t	data;
+	SIL_PRE_LOC;
+
+	SIL_LOC_INT();
+	data = *((volatile uint32_t *) mem);
+	*((volatile uint32_t *) mem) = data - val;
+	SIL_UNL_INT();
+	return(data);
+}
+
+Inline bool_t
+sil_atm_cas(uint32_t *mem, uint32_t oldval, uint32_t newval)
+{
+	bool_t	swapped;
+	SIL_PRE_LOC;
+
+	SIL_LOC_INT();
+	swapped = (*((volatile uint32_t *) mem) == oldval);
+	if (swapped) {
+		*((volatile uint32_t *) mem) = newval;
+	}
+	SIL_UNL_INT();
+	return(swapped);
+}
+
+Inline uint32_t
+sil_atm_set(uint32_t *mem, uint32_t bits)
+{
+	uint32_t	data;
+	SIL_PRE_LOC;
+
+	SIL_LOC_INT();
+	data = *((volatile uint32_t *) mem);
+	*((volatile uint32_t *) mem) = data | bits;
+	SIL_UNL_INT();
+	return(data);
+}
+
+Inline uint32_t
+sil_atm_clr(uint32_t *mem, uint32_t bits)
+{
+	uint32_t	data;
+	SIL_PRE_LOC;
+
+	SIL_LOC_INT();
+	data = *((volatile uint32_t *) mem);
+	*((volatile uint32_t *) mem) = data & ~bits;
+	SIL_UNL_INT();
+	return(data);
+}
+
+#endif /* TOPPERS_OMIT_SIL_ATOMIC */
+
 #endif /* TOPPERS_MACRO_ONLY */
 
 #ifdef __cplusplus
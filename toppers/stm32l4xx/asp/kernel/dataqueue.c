@@ -49,6 +49,7 @@
 #include "task.h"
 #include "wait.h"
 #include "dataqueue.h"
+#include "multi_wait.h"
 
 /*
  *  トレースログマクロのデフォルト定義
@@ -253,7 +254,11 @@ send_data(DTQCB *p_dtqcb, intptr_t data, bool_t *p_dspreq)
 	}
 	else if (p_dtqcb->count < p_dtqcb->p_dtqinib->dtqcnt) {
 		enqueue_data(p_dtqcb, data);
+#ifdef TOPPERS_WAIT_OBJ
+		*p_dspreq = NOTIFY_MULTI_WAIT(TOBJ_DTQ, DTQID(p_dtqcb));
+#else /* TOPPERS_WAIT_OBJ */
 		*p_dspreq = false;
+#endif /* TOPPERS_WAIT_OBJ */
 		return(true);
 	}
 	else {
@@ -280,7 +285,11 @@ force_send_data(DTQCB *p_dtqcb, intptr_t data)
 	}
 	else {
 		force_enqueue_data(p_dtqcb, data);
+#ifdef TOPPERS_WAIT_OBJ
+		return(NOTIFY_MULTI_WAIT(TOBJ_DTQ, DTQID(p_dtqcb)));
+#else /* TOPPERS_WAIT_OBJ */
 		return(false);
+#endif /* TOPPERS_WAIT_OBJ */
 	}
 }
 
@@ -352,6 +361,9 @@ snd_dtq(ID dtqid, intptr_t data)
 		winfo_dtq.data = data;
 		p_runtsk->tstat = (TS_WAITING | TS_WAIT_SDTQ);
 		wobj_make_wait((WOBJCB *) p_dtqcb, (WINFO_WOBJ *) &winfo_dtq);
+#ifdef TOPPERS_WAIT_OBJ
+		(void) NOTIFY_MULTI_WAIT(TOBJ_DTQ, dtqid);
+#endif /* TOPPERS_WAIT_OBJ */
 		dispatch();
 		ercd = winfo_dtq.winfo.wercd;
 	}
@@ -471,6 +483,9 @@ tsnd_dtq(ID dtqid, intptr_t data, TMO tmout)
 		p_runtsk->tstat = (TS_WAITING | TS_WAIT_SDTQ);
 		wobj_make_wait_tmout((WOBJCB *) p_dtqcb, (WINFO_WOBJ *) &winfo_dtq,
 														&tmevtb, tmout);
+#ifdef TOPPERS_WAIT_OBJ
+		(void) NOTIFY_MULTI_WAIT(TOBJ_DTQ, dtqid);
+#endif /* TOPPERS_WAIT_OBJ */
 		dispatch();
 		ercd = winfo_dtq.winfo.wercd;
 	}
@@ -49,6 +49,7 @@
 #include "task.h"
 #include "wait.h"
 #include "eventflag.h"
+#include "multi_wait.h"
 
 /*
  *  トレースログマクロのデフォルト定義
@@ -128,6 +129,39 @@
 #define INDEX_FLG(flgid)	((uint_t)((flgid) - TMIN_FLGID))
 #define get_flgcb(flgid)	(&(flgcb_table[INDEX_FLG(flgid)]))
 
+#ifdef TOPPERS_FLG_WAIT_INDEX
+/*
+ *  待ちインデックスを用いる場合のタスクの操作
+ *
+ *  WAISEQは，待ち状態のタスクの通し番号を取り出すためのマクロ．通し番
+ *  号はラップアラウンドするため，SEQ_BEFOREで前後関係を判定する．
+ */
+#define WAISEQ(p_tcb)		(((WINFO_FLG *)((p_tcb)->p_winfo))->waiseq)
+#define SEQ_BEFORE(seq1, seq2)	((int_t)((seq1) - (seq2)) < 0)
+
+/*
+ *  通し番号順のキューへのタスクの併合
+ *
+ *  p_queueの中で，p_cursor以降からタスクを挿入する位置を探して挿入し，
+ *  次に探し始める位置を返す．1つのバケットのタスクは通し番号順につな
+ *  がれているため，バケットごとにp_cursorをキューの先頭から進めながら
+ *  挿入すれば，1つのバケットの処理時間は，キュー中のタスクの数と挿入
+ *  するタスクの数の和に比例する．
+ */
+Inline QUEUE *
+queue_merge_waiseq(QUEUE *p_queue, QUEUE *p_cursor, TCB *p_tcb)
+{
+	uint_t	waiseq = WAISEQ(p_tcb);
+
+	while (p_cursor != p_queue
+				&& SEQ_BEFORE(WAISEQ((TCB *) p_cursor), waiseq)) {
+		p_cursor = p_cursor->p_next;
+	}
+	queue_insert_prev(p_cursor, &(p_tcb->task_queue));
+	return(p_cursor);
+}
+#endif /* TOPPERS_FLG_WAIT_INDEX */
+
 /*
  *  イベントフラグ機能の初期化
  */
@@ -138,12 +172,28 @@ initialize_eventflag(void)
 {
 	uint_t	i;
 	FLGCB	*p_flgcb;
+#ifdef TOPPERS_FLG_WAIT_INDEX
+	FLGWIDX	*p_flgwidx;
+	uint_t	j;
+#endif /* TOPPERS_FLG_WAIT_INDEX */
 
 	for (i = 0; i < tnum_flg; i++) {
 		p_flgcb = &(flgcb_table[i]);
 		queue_initialize(&(p_flgcb->wait_queue));
 		p_flgcb->p_flginib = &(flginib_table[i]);
 		p_flgcb->flgptn = p_flgcb->p_flginib->iflgptn;
+#ifdef TOPPERS_FLG_WAIT_INDEX
+		p_flgwidx = p_flgcb->p_flginib->p_flgwidx;
+		if (p_flgwidx != NULL) {
+			p_flgwidx->bktmap = 0U;
+			p_flgwidx->mltmap = 0U;
+			p_flgwidx->waiseq = 0U;
+			for (j = 0; j < TBIT_FLGPTN; j++) {
+				p_flgwidx->bktptn[j] = 0U;
+				queue_initialize(&(p_flgwidx->bucket[j]));
+			}
+		}
+#endif /* TOPPERS_FLG_WAIT_INDEX */
 	}
 }
 
@@ -169,6 +219,190 @@ check_flg_cond(FLGCB *p_flgcb, FLGPTN waiptn, MODE wfmode, FLGPTN *p_flgptn)
 }
 
 #endif /* TOPPERS_flgcnd */
+#ifdef TOPPERS_FLG_WAIT_INDEX
+
+/*
+ *  待ちインデックスを用いたイベントフラグ待ち状態への移行
+ */
+#ifdef TOPPERS_flgiwai
+
+void
+flg_index_make_wait(FLGCB *p_flgcb, WINFO_FLG *p_winfo_flg,
+										TMEVTB *p_tmevtb, TMO tmout)
+{
+	FLGWIDX	*p_flgwidx = p_flgcb->p_flginib->p_flgwidx;
+	FLGPTN	waiptn = p_winfo_flg->waiptn;
+	uint_t	bitno = flgptn_search(waiptn);
+
+	make_wait_tmout(&(p_winfo_flg->winfo), p_tmevtb, tmout);
+	p_winfo_flg->waiseq = p_flgwidx->waiseq++;
+	queue_insert_prev(&(p_flgwidx->bucket[bitno]), &(p_runtsk->task_queue));
+	p_flgwidx->bktmap |= FLGPTN_BIT(bitno);
+	p_flgwidx->bktptn[bitno] |= waiptn;
+	if (waiptn != FLGPTN_BIT(bitno)) {
+		p_flgwidx->mltmap |= FLGPTN_BIT(bitno);
+	}
+	p_winfo_flg->p_flgcb = p_flgcb;
+	LOG_TSKSTAT(p_runtsk);
+}
+
+#endif /* TOPPERS_flgiwai */
+
+/*
+ *  待ちインデックスを用いたイベントフラグ待ち解除
+ *
+ *  待ち状態のタスクは，待ちパターンとイベントフラグのパターンが待ち解
+ *  除条件を満たさない状態で待っているため，待ち解除条件を満たすように
+ *  なるのは，待ちパターンとsetptnが重なるタスクに限られる．そこで，
+ *  setptnのビットに対応するバケットと，複数ビット待ちのタスクを含みそ
+ *  の待ちパターンの論理和がsetptnと重なるバケットのみを調べる．
+ *
+ *  待ち解除条件を満たしたタスクは，通し番号順のキューに集めてから待ち
+ *  解除する．TA_CLR属性の場合には，通し番号が最も小さいタスクのみを待
+ *  ち解除する．
+ */
+#ifdef TOPPERS_flgirel
+
+bool_t
+flg_index_release(FLGCB *p_flgcb, FLGPTN setptn)
+{
+	FLGWIDX	*p_flgwidx = p_flgcb->p_flginib->p_flgwidx;
+	bool_t	clr = ((p_flgcb->p_flginib->flgatr & TA_CLR) != 0U);
+	QUEUE	rel_queue;
+	QUEUE	*p_queue, *p_cursor;
+	TCB		*p_tcb, *p_reltcb = NULL;
+	WINFO_FLG *p_winfo_flg;
+	FLGPTN	bktmap, bktptn, waiptn, flgptn = p_flgcb->flgptn;
+	uint_t	bitno;
+	bool_t	dspreq = false;
+
+	queue_initialize(&rel_queue);
+	bktmap = (p_flgwidx->bktmap & setptn) | p_flgwidx->mltmap;
+	while (bktmap != 0U) {
+		bitno = flgptn_search(bktmap);
+		bktmap &= bktmap - 1U;
+		if ((p_flgwidx->bktptn[bitno] & setptn) == 0U) {
+			continue;
+		}
+
+		/*
+		 *  バケット内のタスクを調べ，待ちパターンの論理和を作り直す．
+		 */
+		bktptn = 0U;
+		p_cursor = rel_queue.p_next;
+		p_queue = p_flgwidx->bucket[bitno].p_next;
+		while (p_queue != &(p_flgwidx->bucket[bitno])) {
+			p_tcb = (TCB *) p_queue;
+			p_queue = p_queue->p_next;
+			p_winfo_flg = (WINFO_FLG *)(p_tcb->p_winfo);
+			waiptn = p_winfo_flg->waiptn;
+			if ((p_winfo_flg->wfmode & TWF_ORW) != 0U ? (flgptn & waiptn) != 0U
+											: (flgptn & waiptn) == waiptn) {
+				if (clr) {
+					if (p_reltcb == NULL || SEQ_BEFORE(p_winfo_flg->waiseq,
+														WAISEQ(p_reltcb))) {
+						p_reltcb = p_tcb;
+					}
+					bktptn |= waiptn;
+				}
+				else {
+					queue_delete(&(p_tcb->task_queue));
+					p_cursor = queue_merge_waiseq(&rel_queue, p_cursor, p_tcb);
+				}
+			}
+			else {
+				bktptn |= waiptn;
+			}
+		}
+		p_flgwidx->bktptn[bitno] = bktptn;
+		if (bktptn == 0U) {
+			p_flgwidx->bktmap &= ~FLGPTN_BIT(bitno);
+		}
+		if (bktptn == FLGPTN_BIT(bitno) || bktptn == 0U) {
+			p_flgwidx->mltmap &= ~FLGPTN_BIT(bitno);
+		}
+	}
+
+	if (p_reltcb != NULL) {
+		queue_delete(&(p_reltcb->task_queue));
+		queue_insert_prev(&rel_queue, &(p_reltcb->task_queue));
+	}
+	while (!queue_empty(&rel_queue)) {
+		p_tcb = (TCB *) queue_delete_next(&rel_queue);
+		p_winfo_flg = (WINFO_FLG *)(p_tcb->p_winfo);
+		(void) check_flg_cond(p_flgcb, p_winfo_flg->waiptn,
+							p_winfo_flg->wfmode, &(p_winfo_flg->flgptn));
+		if (wait_complete(p_tcb)) {
+			dspreq = true;
+		}
+	}
+	return(dspreq);
+}
+
+#endif /* TOPPERS_flgirel */
+
+/*
+ *  待ちインデックスを用いた待ちキューの初期化
+ */
+#ifdef TOPPERS_flgiini
+
+bool_t
+flg_index_init(FLGCB *p_flgcb)
+{
+	FLGWIDX	*p_flgwidx = p_flgcb->p_flginib->p_flgwidx;
+	QUEUE	rel_queue;
+	QUEUE	*p_cursor;
+	uint_t	bitno;
+
+	queue_initialize(&rel_queue);
+	while (p_flgwidx->bktmap != 0U) {
+		bitno = flgptn_search(p_flgwidx->bktmap);
+		p_flgwidx->bktmap &= p_flgwidx->bktmap - 1U;
+		p_cursor = rel_queue.p_next;
+		while (!queue_empty(&(p_flgwidx->bucket[bitno]))) {
+			p_cursor = queue_merge_waiseq(&rel_queue, p_cursor,
+					(TCB *) queue_delete_next(&(p_flgwidx->bucket[bitno])));
+		}
+		p_flgwidx->bktptn[bitno] = 0U;
+	}
+	p_flgwidx->mltmap = 0U;
+	return(init_wait_queue(&rel_queue));
+}
+
+#endif /* TOPPERS_flgiini */
+
+/*
+ *  待ちインデックスの先頭のタスクのID番号の取出し
+ *
+ *  各バケットは通し番号順になっているため，バケットの先頭のタスクの中
+ *  で，通し番号が最も小さいタスクを返す．
+ */
+#ifdef TOPPERS_flgitsk
+
+ID
+flg_index_tskid(FLGCB *p_flgcb)
+{
+	FLGWIDX	*p_flgwidx = p_flgcb->p_flginib->p_flgwidx;
+	TCB		*p_tcb, *p_headtcb = NULL;
+	FLGPTN	bktmap = p_flgwidx->bktmap;
+	uint_t	bitno;
+
+	while (bktmap != 0U) {
+		bitno = flgptn_search(bktmap);
+		bktmap &= bktmap - 1U;
+		if (!queue_empty(&(p_flgwidx->bucket[bitno]))) {
+			p_tcb = (TCB *)(p_flgwidx->bucket[bitno].p_next);
+			if (p_headtcb == NULL
+						|| SEQ_BEFORE(WAISEQ(p_tcb), WAISEQ(p_headtcb))) {
+				p_headtcb = p_tcb;
+			}
+		}
+	}
+	return((p_headtcb != NULL) ? TSKID(p_headtcb) : TSK_NONE);
+}
+
+#endif /* TOPPERS_flgitsk */
+#endif /* TOPPERS_FLG_WAIT_INDEX */
 
 /*
  *  イベントフラグのセット
@@ -192,6 +426,14 @@ set_flg(ID flgid, FLGPTN setptn)
 
 	t_lock_cpu();
 	p_flgcb->flgptn |= setptn;
+#ifdef TOPPERS_FLG_WAIT_INDEX
+	/*
+	 *  待ちインデックスを用いる場合には，wait_queueは空である．
+	 */
+	if (p_flgcb->p_flginib->p_flgwidx != NULL) {
+		dspreq = flg_index_release(p_flgcb, setptn);
+	}
+#endif /* TOPPERS_FLG_WAIT_INDEX */
 	p_queue = p_flgcb->wait_queue.p_next;
 	while (p_queue != &(p_flgcb->wait_queue)) {
 		p_tcb = (TCB *) p_queue;
@@ -208,6 +450,11 @@ set_flg(ID flgid, FLGPTN setptn)
 			}
 		}
 	}
+#ifdef TOPPERS_WAIT_OBJ
+	if (NOTIFY_MULTI_WAIT(TOBJ_FLG, flgid)) {
+		dspreq = true;
+	}
+#endif /* TOPPERS_WAIT_OBJ */
 	if (dspreq) {
 		dispatch();
 	}
@@ -242,6 +489,13 @@ iset_flg(ID flgid, FLGPTN setptn)
 
 	i_lock_cpu();
 	p_flgcb->flgptn |= setptn;
+#ifdef TOPPERS_FLG_WAIT_INDEX
+	if (p_flgcb->p_flginib->p_flgwidx != NULL) {
+		if (flg_index_release(p_flgcb, setptn)) {
+			reqflg = true;
+		}
+	}
+#endif /* TOPPERS_FLG_WAIT_INDEX */
 	p_queue = p_flgcb->wait_queue.p_next;
 	while (p_queue != &(p_flgcb->wait_queue)) {
 		p_tcb = (TCB *) p_queue;
@@ -258,6 +512,11 @@ iset_flg(ID flgid, FLGPTN setptn)
 			}
 		}
 	}
+#ifdef TOPPERS_WAIT_OBJ
+	if (NOTIFY_MULTI_WAIT(TOBJ_FLG, flgid)) {
+		reqflg = true;
+	}
+#endif /* TOPPERS_WAIT_OBJ */
 	ercd = E_OK;
 	i_unlock_cpu();
 
@@ -327,7 +586,16 @@ wai_flg(ID flgid, FLGPTN waiptn, MODE wfmode, FLGPTN *p_flgptn)
 		winfo_flg.waiptn = waiptn;
 		winfo_flg.wfmode = wfmode;
 		p_runtsk->tstat = (TS_WAITING | TS_WAIT_FLG);
+#ifdef TOPPERS_FLG_WAIT_INDEX
+		if (p_flgcb->p_flginib->p_flgwidx != NULL) {
+			flg_index_make_wait(p_flgcb, &winfo_flg, NULL, TMO_FEVR);
+		}
+		else {
+			wobj_make_wait((WOBJCB *) p_flgcb, (WINFO_WOBJ *) &winfo_flg);
+		}
+#else /* TOPPERS_FLG_WAIT_INDEX */
 		wobj_make_wait((WOBJCB *) p_flgcb, (WINFO_WOBJ *) &winfo_flg);
+#endif /* TOPPERS_FLG_WAIT_INDEX */
 		dispatch();
 		ercd = winfo_flg.winfo.wercd;
 		if (ercd == E_OK) {
@@ -417,8 +685,18 @@ twai_flg(ID flgid, FLGPTN waiptn, MODE wfmode, FLGPTN *p_flgptn, TMO tmout)
 		winfo_flg.waiptn = waiptn;
 		winfo_flg.wfmode = wfmode;
 		p_runtsk->tstat = (TS_WAITING | TS_WAIT_FLG);
+#ifdef TOPPERS_FLG_WAIT_INDEX
+		if (p_flgcb->p_flginib->p_flgwidx != NULL) {
+			flg_index_make_wait(p_flgcb, &winfo_flg, &tmevtb, tmout);
+		}
+		else {
+			wobj_make_wait_tmout((WOBJCB *) p_flgcb,
+							(WINFO_WOBJ *) &winfo_flg, &tmevtb, tmout);
+		}
+#else /* TOPPERS_FLG_WAIT_INDEX */
 		wobj_make_wait_tmout((WOBJCB *) p_flgcb, (WINFO_WOBJ *) &winfo_flg,
 														&tmevtb, tmout);
+#endif /* TOPPERS_FLG_WAIT_INDEX */
 		dispatch();
 		ercd = winfo_flg.winfo.wercd;
 		if (ercd == E_OK) {
@@ -453,7 +731,17 @@ ini_flg(ID flgid)
 
 	t_lock_cpu();
 	dspreq = init_wait_queue(&(p_flgcb->wait_queue));
+#ifdef TOPPERS_FLG_WAIT_INDEX
+	if (p_flgcb->p_flginib->p_flgwidx != NULL) {
+		dspreq = flg_index_init(p_flgcb);
+	}
+#endif /* TOPPERS_FLG_WAIT_INDEX */
 	p_flgcb->flgptn = p_flgcb->p_flginib->iflgptn;
+#ifdef TOPPERS_WAIT_OBJ
+	if (NOTIFY_MULTI_WAIT(TOBJ_FLG, flgid)) {
+		dspreq = true;
+	}
+#endif /* TOPPERS_WAIT_OBJ */
 	if (dspreq) {
 		dispatch();
 	}
@@ -485,6 +773,11 @@ ref_flg(ID flgid, T_RFLG *pk_rflg)
 
 	t_lock_cpu();
 	pk_rflg->wtskid = wait_tskid(&(p_flgcb->wait_queue));
+#ifdef TOPPERS_FLG_WAIT_INDEX
+	if (p_flgcb->p_flginib->p_flgwidx != NULL) {
+		pk_rflg->wtskid = flg_index_tskid(p_flgcb);
+	}
+#endif /* TOPPERS_FLG_WAIT_INDEX */
 	pk_rflg->flgptn = p_flgcb->flgptn;
 	ercd = E_OK;
 	t_unlock_cpu();
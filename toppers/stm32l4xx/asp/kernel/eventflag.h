@@ -49,6 +49,63 @@
 
 #include "wait.h"
 
+#ifdef TOPPERS_FLG_WAIT_INDEX
+/*
+ *  イベントフラグ待ちインデックス
+ *
+ *  TA_WMUL属性でTA_TPRI属性でないイベントフラグでは，待ちパターンの最
+ *  下位のビットの番号ごとに待ちタスクをつなぐキュー（バケット）を用意
+ *  し，set_flg／iset_flgでは，セットするビットと関係するバケットのみ
+ *  を調べる．タスクは待ち状態に入った順に通し番号（waiseq）を付け，待
+ *  ち解除の順序を待ちキューが1本の場合と同じにする．
+ *
+ *  bktmapとbktptnは，バケットを調べた時に作り直すため，それまでの間は
+ *  待ち解除されたタスクの分を含んだもの（実際よりも大きい集合）になる
+ *  ことがある．mltmapは，最下位以外のビットも待つタスクがつながれてい
+ *  る（可能性がある）バケットのビットマップである．
+ */
+typedef struct eventflag_wait_index {
+	FLGPTN		bktmap;			/* タスクがつながれたバケットのビットマップ */
+	FLGPTN		mltmap;			/* 複数ビット待ちのバケットのビットマップ */
+	uint_t		waiseq;			/* 次に待ち状態に入るタスクの通し番号 */
+	FLGPTN		bktptn[TBIT_FLGPTN];	/* バケット内の待ちパターンの論理和 */
+	QUEUE		bucket[TBIT_FLGPTN];	/* バケット */
+} FLGWIDX;
+
+/*
+ *  ビットパターンのビット番号の操作
+ */
+#define FLGPTN_BIT(bitno)	((FLGPTN)(1U << (bitno)))
+
+/*
+ *  最下位のセットされたビットのサーチ
+ *
+ *  ptnは0でないことを前提とする．ターゲット依存部でビットサーチ命令を
+ *  使う場合には，OMIT_FLGPTN_SEARCHを定義し，同じ機能を持つflgptn_
+ *  searchを用意すればよい．
+ */
+#ifndef OMIT_FLGPTN_SEARCH
+
+Inline uint_t
+flgptn_search(FLGPTN ptn)
+{
+	uint_t	n = 0U;
+
+	assert(ptn != 0U);
+	while ((ptn & 0xffU) == 0U) {
+		ptn >>= 8;
+		n += 8U;
+	}
+	while ((ptn & 0x01U) == 0U) {
+		ptn >>= 1;
+		n++;
+	}
+	return(n);
+}
+
+#endif /* OMIT_FLGPTN_SEARCH */
+#endif /* TOPPERS_FLG_WAIT_INDEX */
+
 /*
  *  イベントフラグ初期化ブロック
  *
@@ -59,6 +116,9 @@
 typedef struct eventflag_initialization_block {
 	ATR			flgatr;			/* イベントフラグ属性 */
 	FLGPTN		iflgptn;		/* イベントフラグのビットパターンの初期値 */
+#ifdef TOPPERS_FLG_WAIT_INDEX
+	FLGWIDX		*p_flgwidx;		/* 待ちインデックスへのポインタ */
+#endif /* TOPPERS_FLG_WAIT_INDEX */
 } FLGINIB;
 
 /*
@@ -90,6 +150,9 @@ typedef struct eventflag_waiting_information {
 	FLGPTN		waiptn;			/* 待ちパターン */
 	MODE		wfmode;			/* 待ちモード */
 	FLGPTN		flgptn;			/* 待ち解除時のパターン */
+#ifdef TOPPERS_FLG_WAIT_INDEX
+	uint_t		waiseq;			/* 待ち状態に入った順の通し番号 */
+#endif /* TOPPERS_FLG_WAIT_INDEX */
 } WINFO_FLG;
 
 /*
@@ -123,4 +186,37 @@ extern void	initialize_eventflag(void);
 extern bool_t	check_flg_cond(FLGCB *p_flgcb, FLGPTN waiptn,
 								MODE wfmode, FLGPTN *p_flgptn);
 
+#ifdef TOPPERS_FLG_WAIT_INDEX
+/*
+ *  待ちインデックスを用いたイベントフラグ待ち状態への移行
+ *
+ *  実行中のタスクを，タイムアウト指定付きでイベントフラグ待ち状態に移
+ *  行させ，待ちパターンに対応するバケットにつなぐ．
+ */
+extern void	flg_index_make_wait(FLGCB *p_flgcb, WINFO_FLG *p_winfo_flg,
+											TMEVTB *p_tmevtb, TMO tmout);
+
+/*
+ *  待ちインデックスを用いたイベントフラグ待ち解除
+ *
+ *  イベントフラグにビットパターンsetptnをセットした後に呼び出し，待ち
+ *  解除条件を満たしたタスクを待ち解除する．ディスパッチが必要な場合に
+ *  はtrueを返す．
+ */
+extern bool_t	flg_index_release(FLGCB *p_flgcb, FLGPTN setptn);
+
+/*
+ *  待ちインデックスを用いた待ちキューの初期化
+ *
+ *  待ち状態のタスクをすべて，待ち状態に入った順にE_DLTで待ち解除する．
+ *  ディスパッチが必要な場合にはtrueを返す．
+ */
+extern bool_t	flg_index_init(FLGCB *p_flgcb);
+
+/*
+ *  待ちインデックスの先頭のタスクのID番号の取出し
+ */
+extern ID	flg_index_tskid(FLGCB *p_flgcb);
+#endif /* TOPPERS_FLG_WAIT_INDEX */
+
 #endif /* TOPPERS_EVENTFLAG_H */
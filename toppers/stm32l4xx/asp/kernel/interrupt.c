@@ -210,7 +210,7 @@ chg_ipm(PRI intpri)
 				dispatch();
 			}
 		}
-		if (p_runtsk->enatex && p_runtsk->texptn != 0U) {
+		if (p_runtsk->enatex && TSK_TEXPTN(p_runtsk) != 0U) {
 			call_texrtn();
 		}
 	}
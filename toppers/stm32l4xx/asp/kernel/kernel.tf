@@ -239,6 +239,23 @@ $ 	// stkszがスタック領域のサイズとして正しくない場合（E_P
 $END$
 $NL$
 
+$ 保留例外要因の領域の生成（TCBを縮小する場合）
+$IF TOPPERS_COMPACT_TCB$
+	$numtex = 0$
+	$FOREACH tskid TSK.ID_LIST$
+		$IF LENGTH(TSK.TEXRTN[tskid])$
+			$TSK.TINIB_TEXPTN[tskid] = FORMAT("&_kernel_texptn_table[%1%]", +numtex)$
+			$numtex = numtex + 1$
+		$ELSE$
+			$TSK.TINIB_TEXPTN[tskid] = "NULL"$
+		$END$
+	$END$
+	$IF numtex > 0$
+		TEXPTN _kernel_texptn_table[$numtex$];$NL$
+		$NL$
+	$END$
+$END$
+
 $ タスク初期化ブロックの生成（タスクは1個以上存在する）
 const TINIB _kernel_tinib_table[TNUM_TSKID] = {$NL$
 $JOINEACH tskid TSK.ID_LIST ",\n"$
@@ -255,7 +272,13 @@ $	// タスク初期化コンテキストブロック，スタック領域
 	$END$
 
 $	// タスク例外処理ルーチンの属性と起動番地
-	$SPC$($ALT(TSK.TEXATR[tskid],"TA_NULL")$), ($ALT(TSK.TEXRTN[tskid],"NULL")$) }
+	$SPC$($ALT(TSK.TEXATR[tskid],"TA_NULL")$), ($ALT(TSK.TEXRTN[tskid],"NULL")$)
+
+$	// 保留例外要因の格納場所
+	$IF TOPPERS_COMPACT_TCB$
+		, $TSK.TINIB_TEXPTN[tskid]$
+	$END$
+	$SPC$}
 $END$$NL$
 };$NL$
 $NL$
@@ -326,6 +349,16 @@ $ イベントフラグID番号の最大値
 const ID _kernel_tmax_flgid = (TMIN_FLGID + TNUM_FLGID - 1);$NL$
 $NL$
 
+$ イベントフラグ待ちインデックスの生成
+$IF TOPPERS_FLG_WAIT_INDEX$
+	$FOREACH flgid FLG.ID_LIST$
+		$IF (FLG.FLGATR[flgid] & (TA_TPRI|TA_WMUL)) == TA_WMUL$
+			static FLGWIDX _kernel_flgwidx_$flgid$;$NL$
+		$END$
+	$END$
+	$NL$
+$END$
+
 $ イベントフラグ初期化ブロックの生成
 $IF LENGTH(FLG.ID_LIST)$
 	const FLGINIB _kernel_flginib_table[TNUM_FLGID] = {$NL$
@@ -341,7 +374,15 @@ $		// iflgptnがFLGPTNに格納できない場合（E_PAR）
 		$END$
 
 $		// イベントフラグ初期化ブロック
-		$TAB${ ($FLG.FLGATR[flgid]$), ($FLG.IFLGPTN[flgid]$) }
+		$TAB${ ($FLG.FLGATR[flgid]$), ($FLG.IFLGPTN[flgid]$)
+		$IF TOPPERS_FLG_WAIT_INDEX$
+			$IF (FLG.FLGATR[flgid] & (TA_TPRI|TA_WMUL)) == TA_WMUL$
+				, &_kernel_flgwidx_$flgid$
+			$ELSE$
+				, NULL
+			$END$
+		$END$
+		$SPC$}
 	$END$$NL$
 	};$NL$
 	$NL$
@@ -470,6 +511,16 @@ $ メールボックスID番号の最大値
 const ID _kernel_tmax_mbxid = (TMIN_MBXID + TNUM_MBXID - 1);$NL$
 $NL$
 
+$ 優先度ごとの末尾のメッセージの領域の生成
+$IF TOPPERS_MBX_PRI_QUEUE$
+	$FOREACH mbxid MBX.ID_LIST$
+		$IF (MBX.MBXATR[mbxid] & TA_MPRI) != 0$
+			static T_MSG *_kernel_mprilast_$mbxid$[$MBX.MAXMPRI[mbxid]$];$NL$
+		$END$
+	$END$
+	$NL$
+$END$
+
 $ メールボックス初期化ブロックの生成
 $IF LENGTH(MBX.ID_LIST)$
 	const MBXINIB _kernel_mbxinib_table[TNUM_MBXID] = {$NL$
@@ -490,7 +541,15 @@ $		// mprihdがNULLでない場合（E_NOSPT）
 		$END$
 
 $		// メールボックス初期化ブロック
-		$TAB${ ($MBX.MBXATR[mbxid]$), ($MBX.MAXMPRI[mbxid]$) }
+		$TAB${ ($MBX.MBXATR[mbxid]$), ($MBX.MAXMPRI[mbxid]$)
+		$IF TOPPERS_MBX_PRI_QUEUE$
+			$IF (MBX.MBXATR[mbxid] & TA_MPRI) != 0$
+				, _kernel_mprilast_$mbxid$
+			$ELSE$
+				, NULL
+			$END$
+		$END$
+		$SPC$}
 	$END$$NL$
 	};$NL$
 	$NL$
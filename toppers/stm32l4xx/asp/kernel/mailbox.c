@@ -49,6 +49,7 @@
 #include "task.h"
 #include "wait.h"
 #include "mailbox.h"
+#include "multi_wait.h"
 
 /*
  *  トレースログマクロのデフォルト定義
@@ -128,6 +129,9 @@ initialize_mailbox(void)
 		queue_initialize(&(p_mbxcb->wait_queue));
 		p_mbxcb->p_mbxinib = &(mbxinib_table[i]);
 		p_mbxcb->pk_head = NULL;
+#ifdef TOPPERS_MBX_PRI_QUEUE
+		p_mbxcb->mprimap = 0U;
+#endif /* TOPPERS_MBX_PRI_QUEUE */
 	}
 }
 
@@ -156,6 +160,93 @@ enqueue_msg_pri(T_MSG **ppk_prevmsg_next, T_MSG *pk_msg)
 	*ppk_prevmsg_next = pk_msg;
 }
 
+#ifdef TOPPERS_MBX_PRI_QUEUE
+/*
+ *  メッセージ優先度ビットマップの操作
+ *
+ *  メッセージ優先度ビットマップは，優先度の高い（値の小さい）順に下位
+ *  のビットから対応させる．TMAX_MPRIが16以下であることを仮定している．
+ */
+#define MPRIMAP_BIT(mpri)	((uint16_t)(1U << ((mpri) - TMIN_MPRI)))
+#define MPRIMAP_UPTO(mpri)	((uint16_t)((1U << ((mpri) - TMIN_MPRI + 1)) - 1U))
+#define INDEX_MPRI(mpri)	((uint_t)((mpri) - TMIN_MPRI))
+
+/*
+ *  メッセージ優先度ビットマップのサーチ
+ *
+ *  mprimap内の1のビットの内，最も上位（左）のもののビット番号を返す．
+ *  mprimapに0を指定してはならない．
+ */
+static const unsigned char mprimap_search_table[] = { 0, 0, 1, 1, 2, 2, 2,
+												2, 3, 3, 3, 3, 3, 3, 3, 3 };
+
+Inline uint_t
+mprimap_search(uint16_t mprimap)
+{
+	uint_t	n = 0U;
+
+	assert(mprimap != 0U);
+	if ((mprimap & 0xff00U) != 0U) {
+		mprimap >>= 8;
+		n += 8;
+	}
+	if ((mprimap & 0xf0U) != 0U) {
+		mprimap >>= 4;
+		n += 4;
+	}
+	return(n + mprimap_search_table[mprimap]);
+}
+
+/*
+ *  優先度ごとの末尾を用いた優先度順メッセージキューへの挿入
+ *
+ *  メッセージキュー全体は優先度順の1本のリストのままとし，同じ優先度
+ *  または優先度がより高いメッセージの中で最も低い優先度の末尾の後ろに
+ *  挿入する．そのようなメッセージがない場合には，先頭に挿入する．
+ */
+Inline void
+enqueue_msg_mpri(MBXCB *p_mbxcb, T_MSG *pk_msg)
+{
+	T_MSG	**ppk_mprilast = p_mbxcb->p_mbxinib->ppk_mprilast;
+	PRI		msgpri = MSGPRI(pk_msg);
+	uint16_t mprimap = p_mbxcb->mprimap & MPRIMAP_UPTO(msgpri);
+	T_MSG	*pk_prevmsg;
+
+	if (mprimap != 0U) {
+		pk_prevmsg = ppk_mprilast[mprimap_search(mprimap)];
+		pk_msg->pk_next = pk_prevmsg->pk_next;
+		pk_prevmsg->pk_next = pk_msg;
+	}
+	else {
+		pk_msg->pk_next = p_mbxcb->pk_head;
+		p_mbxcb->pk_head = pk_msg;
+	}
+	ppk_mprilast[INDEX_MPRI(msgpri)] = pk_msg;
+	p_mbxcb->mprimap |= MPRIMAP_BIT(msgpri);
+}
+#endif /* TOPPERS_MBX_PRI_QUEUE */
+
+/*
+ *  メッセージキューの先頭からの取出し
+ *
+ *  メッセージキューが空でないことを前提とする．
+ */
+Inline T_MSG *
+dequeue_msg(MBXCB *p_mbxcb)
+{
+	T_MSG	*pk_msg = p_mbxcb->pk_head;
+
+	p_mbxcb->pk_head = pk_msg->pk_next;
+#ifdef TOPPERS_MBX_PRI_QUEUE
+	if ((p_mbxcb->p_mbxinib->mbxatr & TA_MPRI) != 0U
+			&& p_mbxcb->p_mbxinib->ppk_mprilast[INDEX_MPRI(MSGPRI(pk_msg))]
+																== pk_msg) {
+		p_mbxcb->mprimap &= ~MPRIMAP_BIT(MSGPRI(pk_msg));
+	}
+#endif /* TOPPERS_MBX_PRI_QUEUE */
+	return(pk_msg);
+}
+
 /*
  *  メールボックスへの送信
  */
@@ -166,6 +257,7 @@ snd_mbx(ID mbxid, T_MSG *pk_msg)
 {
 	MBXCB	*p_mbxcb;
 	TCB		*p_tcb;
+	bool_t	dspreq = false;
 	ER		ercd;
     
 	LOG_SND_MBX_ENTER(mbxid, pk_msg);
@@ -180,26 +272,35 @@ snd_mbx(ID mbxid, T_MSG *pk_msg)
 	if (!queue_empty(&(p_mbxcb->wait_queue))) {
 		p_tcb = (TCB *) queue_delete_next(&(p_mbxcb->wait_queue));
 		((WINFO_MBX *)(p_tcb->p_winfo))->pk_msg = pk_msg;
-		if (wait_complete(p_tcb)) {
-			dispatch();
-		}
-		ercd = E_OK;
-	}
-	else if ((p_mbxcb->p_mbxinib->mbxatr & TA_MPRI) != 0U) {
-		enqueue_msg_pri(&(p_mbxcb->pk_head), pk_msg);
+		dspreq = wait_complete(p_tcb);
 		ercd = E_OK;
 	}
 	else {
-		pk_msg->pk_next = NULL;
-		if (p_mbxcb->pk_head != NULL) {
-			p_mbxcb->pk_last->pk_next = pk_msg;
+		if ((p_mbxcb->p_mbxinib->mbxatr & TA_MPRI) != 0U) {
+#ifdef TOPPERS_MBX_PRI_QUEUE
+			enqueue_msg_mpri(p_mbxcb, pk_msg);
+#else /* TOPPERS_MBX_PRI_QUEUE */
+			enqueue_msg_pri(&(p_mbxcb->pk_head), pk_msg);
+#endif /* TOPPERS_MBX_PRI_QUEUE */
 		}
 		else {
-			p_mbxcb->pk_head = pk_msg;
+			pk_msg->pk_next = NULL;
+			if (p_mbxcb->pk_head != NULL) {
+				p_mbxcb->pk_last->pk_next = pk_msg;
+			}
+			else {
+				p_mbxcb->pk_head = pk_msg;
+			}
+			p_mbxcb->pk_last = pk_msg;
 		}
-		p_mbxcb->pk_last = pk_msg;
+#ifdef TOPPERS_WAIT_OBJ
+		dspreq = NOTIFY_MULTI_WAIT(TOBJ_MBX, mbxid);
+#endif /* TOPPERS_WAIT_OBJ */
 		ercd = E_OK;
 	}
+	if (dspreq) {
+		dispatch();
+	}
 	t_unlock_cpu();
 
   error_exit:
@@ -228,8 +329,7 @@ rcv_mbx(ID mbxid, T_MSG **ppk_msg)
     
 	t_lock_cpu();
 	if (p_mbxcb->pk_head != NULL) {
-		*ppk_msg = p_mbxcb->pk_head;
-		p_mbxcb->pk_head = (*ppk_msg)->pk_next;
+		*ppk_msg = dequeue_msg(p_mbxcb);
 		ercd = E_OK;
 	}
 	else {
@@ -268,8 +368,7 @@ prcv_mbx(ID mbxid, T_MSG **ppk_msg)
     
 	t_lock_cpu();
 	if (p_mbxcb->pk_head != NULL) {
-		*ppk_msg = p_mbxcb->pk_head;
-		p_mbxcb->pk_head = (*ppk_msg)->pk_next;
+		*ppk_msg = dequeue_msg(p_mbxcb);
 		ercd = E_OK;
 	}
 	else {
@@ -305,8 +404,7 @@ trcv_mbx(ID mbxid, T_MSG **ppk_msg, TMO tmout)
     
 	t_lock_cpu();
 	if (p_mbxcb->pk_head != NULL) {
-		*ppk_msg = p_mbxcb->pk_head;
-		p_mbxcb->pk_head = (*ppk_msg)->pk_next;
+		*ppk_msg = dequeue_msg(p_mbxcb);
 		ercd = E_OK;
 	}
 	else if (tmout == TMO_POL) {
@@ -351,6 +449,9 @@ ini_mbx(ID mbxid)
 	t_lock_cpu();
 	dspreq = init_wait_queue(&(p_mbxcb->wait_queue));
 	p_mbxcb->pk_head = NULL;
+#ifdef TOPPERS_MBX_PRI_QUEUE
+	p_mbxcb->mprimap = 0U;
+#endif /* TOPPERS_MBX_PRI_QUEUE */
 	if (dspreq) {
 		dispatch();
 	}
@@ -49,6 +49,17 @@
 
 #include "wait.h"
 
+/*
+ *  メッセージ優先度ビットマップのビット数のチェック
+ *
+ *  TOPPERS_MBX_PRI_QUEUEを定義した場合，メッセージ優先度ビットマップ
+ *  （mprimap）はuint16_t型であるため，メッセージ優先度の段階数は16以
+ *  下でなければならない．
+ */
+#if defined(TOPPERS_MBX_PRI_QUEUE) && (TMAX_MPRI - TMIN_MPRI + 1) > 16
+#error TOPPERS_MBX_PRI_QUEUE supports up to 16 message priorities.
+#endif /* defined(TOPPERS_MBX_PRI_QUEUE) && (TMAX_MPRI - TMIN_MPRI + 1) > 16 */
+
 /*
  *  メールボックス初期化ブロック
  *
@@ -59,6 +70,9 @@
 typedef struct mailbox_initialization_block {
 	ATR			mbxatr;			/* メールボックス属性 */
 	PRI			maxmpri;		/* メッセージ優先度の最大値 */
+#ifdef TOPPERS_MBX_PRI_QUEUE
+	T_MSG		**ppk_mprilast;	/* 優先度ごとの末尾のメッセージの領域 */
+#endif /* TOPPERS_MBX_PRI_QUEUE */
 } MBXINIB;
 
 /*
@@ -71,12 +85,20 @@ typedef struct mailbox_initialization_block {
  *  メッセージキューがメッセージの優先度順の場合には，pk_lastは使わな
  *  い．また，メッセージキューが空の場合（pk_headがNULLの場合）にも，
  *  pk_lastは無効である．
+ *
+ *  TOPPERS_MBX_PRI_QUEUEを定義した場合，メッセージキューが優先度順の
+ *  メールボックスでは，メッセージがある優先度をmprimapで，各優先度の
+ *  末尾のメッセージをppk_mprilastの指す領域で管理する．mprimapのビッ
+ *  トが0の優先度の末尾のメッセージは無効である．
  */
 typedef struct mailbox_control_block {
 	QUEUE		wait_queue;		/* メールボックス待ちキュー */
 	const MBXINIB *p_mbxinib;	/* 初期化ブロックへのポインタ */
 	T_MSG		*pk_head;		/* 先頭のメッセージ */
 	T_MSG		*pk_last;		/* 末尾のメッセージ */
+#ifdef TOPPERS_MBX_PRI_QUEUE
+	uint16_t	mprimap;		/* メッセージ優先度のビットマップ */
+#endif /* TOPPERS_MBX_PRI_QUEUE */
 } MBXCB;
 
 /*
@@ -0,0 +1,340 @@
+/*
+ *  TOPPERS/ASP Kernel
+ *      Toyohashi Open Platform for Embedded Real-Time Systems/
+ *      Advanced Standard Profile Kernel
+ * 
+ *  Copyright (C) 2005-2011 by Embedded and Real-Time Systems Laboratory
+ *              Graduate School of Information Science, Nagoya Univ., JAPAN
+ *  Copyright (C) 2017-2018 by TOPPERS PROJECT Educational Working Group.
+ * 
+ *  上記著作権者は，以下の(1)〜(4)の条件を満たす場合に限り，本ソフトウェ
+ *  ア（本ソフトウェアを改変したものを含む．以下同じ）を使用・複製・改
+ *  変・再配布（以下，利用と呼ぶ）することを無償で許諾する．
+ *  (1) 本ソフトウェアをソースコードの形で利用する場合には，上記の著作
+ *      権表示，この利用条件および下記の無保証規定が，そのままの形でソー
+ *      スコード中に含まれていること．
+ *  (2) 本ソフトウェアを，ライブラリ形式など，他のソフトウェア開発に使
+ *      用できる形で再配布する場合には，再配布に伴うドキュメント（利用
+ *      者マニュアルなど）に，上記の著作権表示，この利用条件および下記
+ *      の無保証規定を掲載すること．
+ *  (3) 本ソフトウェアを，機器に組み込むなど，他のソフトウェア開発に使
+ *      用できない形で再配布する場合には，次のいずれかの条件を満たすこ
+ *      と．
+ *    (a) 再配布に伴うドキュメント（利用者マニュアルなど）に，上記の著
+ *        作権表示，この利用条件および下記の無保証規定を掲載すること．
+ *    (b) 再配布の形態を，別に定める方法によって，TOPPERSプロジェクトに
+ *        報告すること．
+ *  (4) 本ソフトウェアの利用により直接的または間接的に生じるいかなる損
+ *      害からも，上記著作権者およびTOPPERSプロジェクトを免責すること．
+ *      また，本ソフトウェアのユーザまたはエンドユーザからのいかなる理
+ *      由に基づく請求からも，上記著作権者およびTOPPERSプロジェクトを
+ *      免責すること．
+ * 
+ *  本ソフトウェアは，無保証で提供されているものである．上記著作権者お
+ *  よびTOPPERSプロジェクトは，本ソフトウェアに関して，特定の使用目的
+ *  に対する適合性も含めて，いかなる保証も行わない．また，本ソフトウェ
+ *  アの利用により直接的または間接的に生じたいかなる損害に関しても，そ
+ *  の責任を負わない．
+ * 
+ *  @(#) $Id$
+ */
+
+/*
+ *		複数オブジェクト待ち機能
+ */
+
+#include "kernel_impl.h"
+#include "check.h"
+#include "task.h"
+#include "wait.h"
+#include "semaphore.h"
+#include "eventflag.h"
+#include "dataqueue.h"
+#include "pridataq.h"
+#include "mailbox.h"
+#include "multi_wait.h"
+
+/*
+ *  トレースログマクロのデフォルト定義
+ */
+#ifndef LOG_TWAI_OBJ_ENTER
+#define LOG_TWAI_OBJ_ENTER(p_wobj, nobj, tmout)
+#endif /* LOG_TWAI_OBJ_ENTER */
+
+#ifndef LOG_TWAI_OBJ_LEAVE
+#define LOG_TWAI_OBJ_LEAVE(ercd)
+#endif /* LOG_TWAI_OBJ_LEAVE */
+
+#ifdef TOPPERS_WAIT_OBJ
+
+/*
+ *  オブジェクトIDから管理ブロックを取り出すためのマクロ
+ */
+#define get_semcb(semid)	(&(semcb_table[(uint_t)((semid) - TMIN_SEMID)]))
+#define get_flgcb(flgid)	(&(flgcb_table[(uint_t)((flgid) - TMIN_FLGID)]))
+#define get_dtqcb(dtqid)	(&(dtqcb_table[(uint_t)((dtqid) - TMIN_DTQID)]))
+#define get_pdqcb(pdqid)	(&(pdqcb_table[(uint_t)((pdqid) - TMIN_PDQID)]))
+#define get_mbxcb(mbxid)	(&(mbxcb_table[(uint_t)((mbxid) - TMIN_MBXID)]))
+
+/*
+ *  待ち解除の条件のチェック
+ *
+ *  p_wobjで指定されるオブジェクトが，待ち解除の条件を満たしているかを
+ *  判定する．オブジェクトの状態は変更しない（イベントフラグのTA_CLR属
+ *  性によるクリアも行わない）．
+ */
+Inline bool_t
+check_wobj_cond(const T_WOBJ *p_wobj)
+{
+	FLGPTN	flgptn;
+	DTQCB	*p_dtqcb;
+	PDQCB	*p_pdqcb;
+
+	switch (p_wobj->objtyp) {
+	case TOBJ_SEM:
+		return(get_semcb(p_wobj->objid)->semcnt > 0U);
+	case TOBJ_FLG:
+		flgptn = get_flgcb(p_wobj->objid)->flgptn;
+		if ((p_wobj->wfmode & TWF_ORW) != 0U) {
+			return((flgptn & p_wobj->waiptn) != 0U);
+		}
+		else {
+			return((flgptn & p_wobj->waiptn) == p_wobj->waiptn);
+		}
+	case TOBJ_DTQ:
+		p_dtqcb = get_dtqcb(p_wobj->objid);
+		return(p_dtqcb->count > 0U || !queue_empty(&(p_dtqcb->swait_queue)));
+	case TOBJ_PDQ:
+		p_pdqcb = get_pdqcb(p_wobj->objid);
+		return(p_pdqcb->count > 0U || !queue_empty(&(p_pdqcb->swait_queue)));
+	default:
+		return(get_mbxcb(p_wobj->objid)->pk_head != NULL);
+	}
+}
+
+/*
+ *  待ち解除できる回数の管理
+ *
+ *  twai_objは資源やデータを取り出さないため，オブジェクトから資源や
+ *  データを取り出せる回数を超える数のタスクを待ち解除しても，超えた分
+ *  のタスクのポーリングはE_TMOUTとなる．そこで，待ち解除する毎に1回分
+ *  を消費し，消費できなくなった時点で待ち解除を打ち切る．
+ *
+ *  CPUロック状態の時間を短くするために，メールボックスのメッセージや，
+ *  データキューと優先度データキューの送信待ちのタスクは，前もって数え
+ *  ず，待ち解除する毎に1つずつたどる．イベントフラグは，TA_CLR属性の
+ *  場合には1回とし，そうでない場合には上限を設けない．
+ */
+typedef struct wobj_avail {
+	uint_t	count;			/* 残りの回数（UINT_MAXは上限なし）*/
+	T_MSG	*pk_msg;		/* 次にたどるメッセージ */
+	QUEUE	*p_queue;		/* 次にたどる送信待ちのタスク */
+	QUEUE	*p_swait_queue;	/* 送信待ちキュー */
+} WOBJ_AVAIL;
+
+Inline void
+init_wobj_avail(WOBJ_AVAIL *p_avail, uint_t objtyp, ID objid)
+{
+	FLGCB	*p_flgcb;
+	DTQCB	*p_dtqcb;
+	PDQCB	*p_pdqcb;
+
+	p_avail->count = 0U;
+	p_avail->pk_msg = NULL;
+	p_avail->p_queue = NULL;
+	p_avail->p_swait_queue = NULL;
+
+	switch (objtyp) {
+	case TOBJ_SEM:
+		p_avail->count = get_semcb(objid)->semcnt;
+		break;
+	case TOBJ_FLG:
+		p_flgcb = get_flgcb(objid);
+		p_avail->count = ((p_flgcb->p_flginib->flgatr & TA_CLR) != 0U)
+														? 1U : UINT_MAX;
+		break;
+	case TOBJ_DTQ:
+		p_dtqcb = get_dtqcb(objid);
+		p_avail->count = p_dtqcb->count;
+		p_avail->p_swait_queue = &(p_dtqcb->swait_queue);
+		p_avail->p_queue = p_dtqcb->swait_queue.p_next;
+		break;
+	case TOBJ_PDQ:
+		p_pdqcb = get_pdqcb(objid);
+		p_avail->count = p_pdqcb->count;
+		p_avail->p_swait_queue = &(p_pdqcb->swait_queue);
+		p_avail->p_queue = p_pdqcb->swait_queue.p_next;
+		break;
+	default:
+		p_avail->pk_msg = get_mbxcb(objid)->pk_head;
+		break;
+	}
+}
+
+Inline bool_t
+take_wobj_avail(WOBJ_AVAIL *p_avail)
+{
+	if (p_avail->count == UINT_MAX) {
+		return(true);
+	}
+	else if (p_avail->count > 0U) {
+		p_avail->count--;
+		return(true);
+	}
+	else if (p_avail->pk_msg != NULL) {
+		p_avail->pk_msg = p_avail->pk_msg->pk_next;
+		return(true);
+	}
+	else if (p_avail->p_queue != p_avail->p_swait_queue) {
+		p_avail->p_queue = p_avail->p_queue->p_next;
+		return(true);
+	}
+	else {
+		return(false);
+	}
+}
+
+/*
+ *  複数オブジェクト待ちの管理ブロック
+ */
+#ifdef TOPPERS_mwaicb
+
+static const WOBJINIB	mwaitinib = { TA_NULL };
+
+WOBJCB	mwaitcb = {
+	{ &(mwaitcb.wait_queue), &(mwaitcb.wait_queue) },
+	&mwaitinib
+};
+
+#endif /* TOPPERS_mwaicb */
+
+/*
+ *  複数オブジェクト待ちのタスクへの通知
+ */
+#ifdef TOPPERS_mwaintfy
+
+bool_t
+notify_multi_wait(uint_t objtyp, ID objid)
+{
+	QUEUE		*p_queue;
+	TCB			*p_tcb;
+	WINFO_OBJ	*p_winfo_obj;
+	const T_WOBJ *p_wobj;
+	WOBJ_AVAIL	avail;
+	uint_t		i;
+	bool_t		counted = false;
+	bool_t		dspreq = false;
+
+	p_queue = mwaitcb.wait_queue.p_next;
+	while (p_queue != &(mwaitcb.wait_queue)) {
+		p_tcb = (TCB *) p_queue;
+		p_queue = p_queue->p_next;
+		p_winfo_obj = (WINFO_OBJ *)(p_tcb->p_winfo);
+		p_wobj = p_winfo_obj->p_wobj;
+		for (i = 0U; i < p_winfo_obj->nobj; i++) {
+			if (p_wobj[i].objtyp == objtyp && p_wobj[i].objid == objid) {
+				break;
+			}
+		}
+		if (i < p_winfo_obj->nobj && check_wobj_cond(&(p_wobj[i]))) {
+			if (!counted) {
+				init_wobj_avail(&avail, objtyp, objid);
+				counted = true;
+			}
+			if (!take_wobj_avail(&avail)) {
+				break;
+			}
+			p_winfo_obj->objidx = i;
+			queue_delete(&(p_tcb->task_queue));
+			if (wait_complete(p_tcb)) {
+				dspreq = true;
+			}
+		}
+	}
+	return(dspreq);
+}
+
+#endif /* TOPPERS_mwaintfy */
+
+/*
+ *  複数オブジェクト待ち（タイムアウトあり）
+ *
+ *  p_wobjで指定されるnobj個のオブジェクトのいずれかが待ち解除の条件を
+ *  満たすまで待ち，条件を満たしたオブジェクトの配列中のインデックスを
+ *  返す．複数のオブジェクトが条件を満たしている場合には，インデックス
+ *  が最小のものを返す．オブジェクトの資源やデータは取り出さないため，
+ *  この後でpol_semやprcv_dtqなどにより取り出す必要がある．
+ */
+#ifdef TOPPERS_twai_obj
+
+ER_UINT
+twai_obj(const T_WOBJ *p_wobj, uint_t nobj, TMO tmout)
+{
+	WINFO_OBJ winfo_obj;
+	TMEVTB	tmevtb;
+	uint_t	i;
+	ER_UINT	ercd;
+
+	LOG_TWAI_OBJ_ENTER(p_wobj, nobj, tmout);
+	CHECK_DISPATCH();
+	CHECK_PAR(nobj > 0U);
+	CHECK_TMOUT(tmout);
+	for (i = 0U; i < nobj; i++) {
+		switch (p_wobj[i].objtyp) {
+		case TOBJ_SEM:
+			CHECK_SEMID(p_wobj[i].objid);
+			break;
+		case TOBJ_FLG:
+			CHECK_FLGID(p_wobj[i].objid);
+			CHECK_PAR(p_wobj[i].waiptn != 0U);
+			CHECK_PAR(p_wobj[i].wfmode == TWF_ORW
+									|| p_wobj[i].wfmode == TWF_ANDW);
+			break;
+		case TOBJ_DTQ:
+			CHECK_DTQID(p_wobj[i].objid);
+			break;
+		case TOBJ_PDQ:
+			CHECK_PDQID(p_wobj[i].objid);
+			break;
+		case TOBJ_MBX:
+			CHECK_MBXID(p_wobj[i].objid);
+			break;
+		default:
+			ercd = E_PAR;
+			goto error_exit;
+		}
+	}
+
+	t_lock_cpu();
+	for (i = 0U; i < nobj; i++) {
+		if (check_wobj_cond(&(p_wobj[i]))) {
+			break;
+		}
+	}
+	if (i < nobj) {
+		ercd = (ER_UINT) i;
+	}
+	else if (tmout == TMO_POL) {
+		ercd = E_TMOUT;
+	}
+	else {
+		winfo_obj.p_wobj = p_wobj;
+		winfo_obj.nobj = nobj;
+		p_runtsk->tstat = (TS_WAITING | TS_WAIT_OBJ);
+		wobj_make_wait_tmout(&mwaitcb, (WINFO_WOBJ *) &winfo_obj,
+														&tmevtb, tmout);
+		dispatch();
+		ercd = winfo_obj.winfo.wercd;
+		if (ercd == E_OK) {
+			ercd = (ER_UINT)(winfo_obj.objidx);
+		}
+	}
+	t_unlock_cpu();
+
+  error_exit:
+	LOG_TWAI_OBJ_LEAVE(ercd);
+	return(ercd);
+}
+
+#endif /* TOPPERS_twai_obj */
+#endif /* TOPPERS_WAIT_OBJ */
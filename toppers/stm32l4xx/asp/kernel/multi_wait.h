@@ -0,0 +1,100 @@
+/*
+ *  TOPPERS/ASP Kernel
+ *      Toyohashi Open Platform for Embedded Real-Time Systems/
+ *      Advanced Standard Profile Kernel
+ * 
+ *  Copyright (C) 2005-2011 by Embedded and Real-Time Systems Laboratory
+ *              Graduate School of Information Science, Nagoya Univ., JAPAN
+ *  Copyright (C) 2017-2018 by TOPPERS PROJECT Educational Working Group.
+ * 
+ *  上記著作権者は，以下の(1)〜(4)の条件を満たす場合に限り，本ソフトウェ
+ *  ア（本ソフトウェアを改変したものを含む．以下同じ）を使用・複製・改
+ *  変・再配布（以下，利用と呼ぶ）することを無償で許諾する．
+ *  (1) 本ソフトウェアをソースコードの形で利用する場合には，上記の著作
+ *      権表示，この利用条件および下記の無保証規定が，そのままの形でソー
+ *      スコード中に含まれていること．
+ *  (2) 本ソフトウェアを，ライブラリ形式など，他のソフトウェア開発に使
+ *      用できる形で再配布する場合には，再配布に伴うドキュメント（利用
+ *      者マニュアルなど）に，上記の著作権表示，この利用条件および下記
+ *      の無保証規定を掲載すること．
+ *  (3) 本ソフトウェアを，機器に組み込むなど，他のソフトウェア開発に使
+ *      用できない形で再配布する場合には，次のいずれかの条件を満たすこ
+ *      と．
+ *    (a) 再配布に伴うドキュメント（利用者マニュアルなど）に，上記の著
+ *        作権表示，この利用条件および下記の無保証規定を掲載すること．
+ *    (b) 再配布の形態を，別に定める方法によって，TOPPERSプロジェクトに
+ *        報告すること．
+ *  (4) 本ソフトウェアの利用により直接的または間接的に生じるいかなる損
+ *      害からも，上記著作権者およびTOPPERSプロジェクトを免責すること．
+ *      また，本ソフトウェアのユーザまたはエンドユーザからのいかなる理
+ *      由に基づく請求からも，上記著作権者およびTOPPERSプロジェクトを
+ *      免責すること．
+ * 
+ *  本ソフトウェアは，無保証で提供されているものである．上記著作権者お
+ *  よびTOPPERSプロジェクトは，本ソフトウェアに関して，特定の使用目的
+ *  に対する適合性も含めて，いかなる保証も行わない．また，本ソフトウェ
+ *  アの利用により直接的または間接的に生じたいかなる損害に関しても，そ
+ *  の責任を負わない．
+ * 
+ *  @(#) $Id$
+ */
+
+/*
+ *		複数オブジェクト待ち機能
+ */
+
+#ifndef TOPPERS_MULTI_WAIT_H
+#define TOPPERS_MULTI_WAIT_H
+
+#ifdef TOPPERS_WAIT_OBJ
+
+#include "wait.h"
+
+/*
+ *  複数オブジェクト待ちの管理ブロック
+ *
+ *  twai_objで待ち状態になったタスクは，すべてこの管理ブロックの待ちキュー
+ *  にFIFO順でつながれる．同期・通信オブジェクトの管理ブロックの共通部
+ *  分（WOBJCB）と同じ形をしているため，タイムアウトや待ち状態の強制解
+ *  除，タスク優先度の変更は，他のオブジェクト待ちと同じ処理で扱われる．
+ *  属性はTA_NULLとしているため，優先度の変更によって待ちキュー中の位置
+ *  は変わらない．
+ */
+extern WOBJCB	mwaitcb;
+
+/*
+ *  複数オブジェクト待ち情報ブロックの定義
+ *
+ *  この構造体は，同期・通信オブジェクトの待ち情報ブロックの共通部分
+ *  （WINFO_WOBJ）を拡張（オブジェクト指向言語の継承に相当）したもので，
+ *  最初の2つのフィールドが共通になっている．
+ */
+typedef struct multi_wait_waiting_information {
+	WINFO		winfo;			/* 標準の待ち情報ブロック */
+	WOBJCB		*p_wobjcb;		/* 複数オブジェクト待ちの管理ブロック */
+	const T_WOBJ *p_wobj;		/* 待ち対象のオブジェクトの配列 */
+	uint_t		nobj;			/* 待ち対象のオブジェクトの数 */
+	uint_t		objidx;			/* 待ち解除の要因となったオブジェクト */
+} WINFO_OBJ;
+
+/*
+ *  複数オブジェクト待ちのタスクへの通知
+ *
+ *  objtypとobjidで指定されるオブジェクトが待ち解除の条件を満たす状態
+ *  になった可能性がある時に，オブジェクトの操作の中からCPUロック状態
+ *  で呼び出す．そのオブジェクトを待っているタスクのうち，オブジェクト
+ *  が条件を満たしているものを，待ちキューの順に，オブジェクトから資源
+ *  やデータを取り出せる回数まで待ち解除する．待ち解除したタスクへのディ
+ *  スパッチが必要な場合にはtrueを返す．
+ *
+ *  複数オブジェクト待ちのタスクがない場合の処理を軽くするために，
+ *  NOTIFY_MULTI_WAITを用いて呼び出す．
+ */
+extern bool_t	notify_multi_wait(uint_t objtyp, ID objid);
+
+#define NOTIFY_MULTI_WAIT(objtyp, objid) \
+				(!queue_empty(&(mwaitcb.wait_queue)) \
+									&& notify_multi_wait(objtyp, objid))
+
+#endif /* TOPPERS_WAIT_OBJ */
+#endif /* TOPPERS_MULTI_WAIT_H */
@@ -49,6 +49,7 @@
 #include "task.h"
 #include "wait.h"
 #include "pridataq.h"
+#include "multi_wait.h"
 
 /*
  *  トレースログマクロのデフォルト定義
@@ -241,7 +242,11 @@ send_pridata(PDQCB *p_pdqcb, intptr_t data, PRI datapri, bool_t *p_dspreq)
 	}
 	else if (p_pdqcb->count < p_pdqcb->p_pdqinib->pdqcnt) {
 		enqueue_pridata(p_pdqcb, data, datapri);
+#ifdef TOPPERS_WAIT_OBJ
+		*p_dspreq = NOTIFY_MULTI_WAIT(TOBJ_PDQ, PDQID(p_pdqcb));
+#else /* TOPPERS_WAIT_OBJ */
 		*p_dspreq = false;
+#endif /* TOPPERS_WAIT_OBJ */
 		return(true);
 	}
 	else {
@@ -323,6 +328,9 @@ snd_pdq(ID pdqid, intptr_t data, PRI datapri)
 		winfo_pdq.datapri = datapri;
 		p_runtsk->tstat = (TS_WAITING | TS_WAIT_SPDQ);
 		wobj_make_wait((WOBJCB *) p_pdqcb, (WINFO_WOBJ *) &winfo_pdq);
+#ifdef TOPPERS_WAIT_OBJ
+		(void) NOTIFY_MULTI_WAIT(TOBJ_PDQ, pdqid);
+#endif /* TOPPERS_WAIT_OBJ */
 		dispatch();
 		ercd = winfo_pdq.winfo.wercd;
 	}
@@ -446,6 +454,9 @@ tsnd_pdq(ID pdqid, intptr_t data, PRI datapri, TMO tmout)
 		p_runtsk->tstat = (TS_WAITING | TS_WAIT_SPDQ);
 		wobj_make_wait_tmout((WOBJCB *) p_pdqcb, (WINFO_WOBJ *) &winfo_pdq,
 														&tmevtb, tmout);
+#ifdef TOPPERS_WAIT_OBJ
+		(void) NOTIFY_MULTI_WAIT(TOBJ_PDQ, pdqid);
+#endif /* TOPPERS_WAIT_OBJ */
 		dispatch();
 		ercd = winfo_pdq.winfo.wercd;
 	}
@@ -49,6 +49,7 @@
 #include "task.h"
 #include "wait.h"
 #include "semaphore.h"
+#include "multi_wait.h"
 
 /*
  *  トレースログマクロのデフォルト定義
@@ -168,6 +169,11 @@ sig_sem(ID semid)
 	}
 	else if (p_semcb->semcnt < p_semcb->p_seminib->maxsem) {
 		p_semcb->semcnt += 1;
+#ifdef TOPPERS_WAIT_OBJ
+		if (NOTIFY_MULTI_WAIT(TOBJ_SEM, semid)) {
+			dispatch();
+		}
+#endif /* TOPPERS_WAIT_OBJ */
 		ercd = E_OK;
 	}
 	else {
@@ -209,6 +215,11 @@ isig_sem(ID semid)
 	}
 	else if (p_semcb->semcnt < p_semcb->p_seminib->maxsem) {
 		p_semcb->semcnt += 1;
+#ifdef TOPPERS_WAIT_OBJ
+		if (NOTIFY_MULTI_WAIT(TOBJ_SEM, semid)) {
+			reqflg = true;
+		}
+#endif /* TOPPERS_WAIT_OBJ */
 		ercd = E_OK;
 	}
 	else {
@@ -356,6 +367,11 @@ ini_sem(ID semid)
 	t_lock_cpu();
 	dspreq = init_wait_queue(&(p_semcb->wait_queue));
 	p_semcb->semcnt = p_semcb->p_seminib->isemcnt;
+#ifdef TOPPERS_WAIT_OBJ
+	if (NOTIFY_MULTI_WAIT(TOBJ_SEM, semid)) {
+		dspreq = true;
+	}
+#endif /* TOPPERS_WAIT_OBJ */
 	if (dspreq) {
 		dispatch();
 	}
@@ -125,10 +125,12 @@ initialize_task(void)
 	for (i = 0; i < tnum_tsk; i++) {
 		j = INDEX_TSK(torder_table[i]);
 		p_tcb = &(tcb_table[j]);
+#ifndef TOPPERS_COMPACT_TCB
 		p_tcb->p_tinib = &(tinib_table[j]);
+#endif /* TOPPERS_COMPACT_TCB */
 		p_tcb->actque = false;
 		make_dormant(p_tcb);
-		if ((p_tcb->p_tinib->tskatr & TA_ACT) != 0U) {
+		if ((get_tinib(p_tcb)->tskatr & TA_ACT) != 0U) {
 			(void) make_active(p_tcb);
 		}
 	}
@@ -305,10 +307,16 @@ void
 make_dormant(TCB *p_tcb)
 {
 	p_tcb->tstat = TS_DORMANT;
-	p_tcb->priority = p_tcb->p_tinib->ipriority;
+	p_tcb->priority = get_tinib(p_tcb)->ipriority;
 	p_tcb->wupque = false;
 	p_tcb->enatex = false;
+#ifdef TOPPERS_COMPACT_TCB
+	if (get_tinib(p_tcb)->p_texptn != NULL) {
+		TSK_TEXPTN(p_tcb) = 0U;
+	}
+#else /* TOPPERS_COMPACT_TCB */
 	p_tcb->texptn = 0U;
+#endif /* TOPPERS_COMPACT_TCB */
 	LOG_TSKSTAT(p_tcb);
 }
 
@@ -432,16 +440,25 @@ call_texrtn(void)
 	TEXPTN	texptn;
 	bool_t	saved_disdsp;
 
+#ifdef TOPPERS_COMPACT_TCB
+	/*
+	 *  TCBを縮小した場合，ディスパッチャと割込みの出口処理は保留例外
+	 *  要因を確認せずにcall_texrtnを呼び出すため，ここで確認する．
+	 */
+	if (TSK_TEXPTN(p_runtsk) == 0U) {
+		return;
+	}
+#endif /* TOPPERS_COMPACT_TCB */
 	saved_disdsp = disdsp;
 	p_runtsk->enatex = false;
 	do {
-		texptn = p_runtsk->texptn;
-		p_runtsk->texptn = 0U;
+		texptn = TSK_TEXPTN(p_runtsk);
+		TSK_TEXPTN(p_runtsk) = 0U;
 
 		t_unlock_cpu();
 		LOG_TEX_ENTER(p_runtsk, texptn);
-		(*((TEXRTN)(p_runtsk->p_tinib->texrtn)))(texptn,
-												p_runtsk->p_tinib->exinf);
+		(*((TEXRTN)(get_tinib(p_runtsk)->texrtn)))(texptn,
+												get_tinib(p_runtsk)->exinf);
 		LOG_TEX_LEAVE(p_runtsk);
 		if (!t_sense_lock()) {
 			t_lock_cpu();
@@ -462,7 +479,7 @@ call_texrtn(void)
 			 */
 			dispatch();
 		}
-	} while (p_runtsk->texptn != 0U);
+	} while (TSK_TEXPTN(p_runtsk) != 0U);
 	p_runtsk->enatex = true;
 }
 
@@ -474,7 +491,7 @@ call_texrtn(void)
 void
 calltex(void)
 {
-	if (p_runtsk->enatex && p_runtsk->texptn != 0U && ipmflg) {
+	if (p_runtsk->enatex && TSK_TEXPTN(p_runtsk) != 0U && ipmflg) {
 		call_texrtn();
 	}
 }
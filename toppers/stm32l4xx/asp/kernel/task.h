@@ -86,6 +86,7 @@
 #define TS_WAIT_SPDQ	(0x07U << 3)	/* 優先度データキューへの送信待ち */
 #define TS_WAIT_MBX		(0x08U << 3)	/* メールボックスからの受信待ち */
 #define TS_WAIT_MPF		(0x09U << 3)	/* 固定長メモリブロックの獲得待ち */
+#define TS_WAIT_OBJ		(0x0fU << 3)	/* 複数オブジェクト待ち */
 
 /*
  *  タスク状態判別マクロ
@@ -195,6 +196,9 @@ typedef struct task_initialization_block {
 
 	ATR			texatr;			/* タスク例外処理ルーチン属性 */
 	TEXRTN		texrtn;			/* タスク例外処理ルーチンの起動番地 */
+#ifdef TOPPERS_COMPACT_TCB
+	TEXPTN		*p_texptn;		/* 保留例外要因の格納場所 */
+#endif /* TOPPERS_COMPACT_TCB */
 } TINIB;
 
 /*
@@ -231,10 +235,18 @@ typedef struct task_initialization_block {
  *  		task_queue
  *  ・実行可能状態，待ち状態，強制待ち状態，二重待ち状態で有効：
  *  		tskctxb
+ *
+ *  TOPPERS_COMPACT_TCBを定義した場合には，RAMを節約するために，p_tinib
+ *  とtexptnをTCBに置かない．タスク初期化ブロックはTCBの位置から求め
+ *  （get_tinib），保留例外要因はタスク例外処理ルーチンが定義されたタス
+ *  クについてのみコンフィギュレータが生成する領域に置く（TSK_TEXPTN）．
+ *  ARM-Mでは，TCBが32バイトから24バイトになる．
  */
 typedef struct task_control_block {
 	QUEUE			task_queue;		/* タスクキュー */
+#ifndef TOPPERS_COMPACT_TCB
 	const TINIB		*p_tinib;		/* 初期化ブロックへのポインタ */
+#endif /* TOPPERS_COMPACT_TCB */
 
 #ifdef UINT8_MAX
 	uint8_t			tstat;			/* タスク状態（内部表現）*/
@@ -251,7 +263,9 @@ typedef struct task_control_block {
 	BIT_FIELD_BOOL	wupque : 1;		/* 起床要求キューイング */
 	BIT_FIELD_BOOL	enatex : 1;		/* タスク例外処理許可状態 */
 
+#ifndef TOPPERS_COMPACT_TCB
 	TEXPTN			texptn;			/* 保留例外要因 */
+#endif /* TOPPERS_COMPACT_TCB */
 	WINFO			*p_winfo;		/* 待ち情報ブロックへのポインタ */
 	TSKCTXB			tskctxb;		/* タスクコンテキストブロック */
 } TCB;
@@ -373,6 +387,20 @@ extern TCB	tcb_table[];
  */
 #define	TSKID(p_tcb)	((ID)(((p_tcb) - tcb_table) + TMIN_TSKID))
 
+/*
+ *  TCBからタスク初期化ブロックと保留例外要因を参照するためのマクロ
+ *
+ *  TOPPERS_COMPACT_TCBを定義した場合，TSK_TEXPTNはタスク例外処理ルー
+ *  チンが定義されたタスクに対してのみ用いることができる．
+ */
+#ifdef TOPPERS_COMPACT_TCB
+#define get_tinib(p_tcb)	(&(tinib_table[(p_tcb) - tcb_table]))
+#define TSK_TEXPTN(p_tcb)	(*(get_tinib(p_tcb)->p_texptn))
+#else /* TOPPERS_COMPACT_TCB */
+#define get_tinib(p_tcb)	((p_tcb)->p_tinib)
+#define TSK_TEXPTN(p_tcb)	((p_tcb)->texptn)
+#endif /* TOPPERS_COMPACT_TCB */
+
 /*
  *  タスク管理モジュールの初期化
  */
@@ -117,11 +117,11 @@ ras_tex(ID tskid, TEXPTN rasptn)
 	p_tcb = get_tcb_self(tskid);
 
 	t_lock_cpu();
-	if (TSTAT_DORMANT(p_tcb->tstat) || p_tcb->p_tinib->texrtn == NULL) {
+	if (TSTAT_DORMANT(p_tcb->tstat) || get_tinib(p_tcb)->texrtn == NULL) {
 		ercd = E_OBJ;
 	}
 	else {
-		p_tcb->texptn |= rasptn;
+		TSK_TEXPTN(p_tcb) |= rasptn;
 		if (p_tcb == p_runtsk && p_runtsk->enatex && ipmflg) {
 			call_texrtn();
 		}
@@ -154,11 +154,11 @@ iras_tex(ID tskid, TEXPTN rasptn)
 	p_tcb = get_tcb(tskid);
 
 	i_lock_cpu();
-	if (TSTAT_DORMANT(p_tcb->tstat) || p_tcb->p_tinib->texrtn == NULL) {
+	if (TSTAT_DORMANT(p_tcb->tstat) || get_tinib(p_tcb)->texrtn == NULL) {
 		ercd = E_OBJ;
 	}
 	else {
-		p_tcb->texptn |= rasptn;
+		TSK_TEXPTN(p_tcb) |= rasptn;
 		if (p_tcb == p_runtsk && p_runtsk->enatex && ipmflg) {
 			reqflg = true;
 		}
@@ -187,7 +187,7 @@ dis_tex(void)
 	CHECK_TSKCTX_UNL();
 
 	t_lock_cpu();
-	if (p_runtsk->p_tinib->texrtn == NULL) {
+	if (get_tinib(p_runtsk)->texrtn == NULL) {
 		ercd = E_OBJ;
 	}
 	else {
@@ -217,12 +217,12 @@ ena_tex(void)
 	CHECK_TSKCTX_UNL();
 
 	t_lock_cpu();
-	if (p_runtsk->p_tinib->texrtn == NULL) {
+	if (get_tinib(p_runtsk)->texrtn == NULL) {
 		ercd = E_OBJ;
 	}
 	else {
 		p_runtsk->enatex = true;
-		if (p_runtsk->texptn != 0U && ipmflg) {
+		if (TSK_TEXPTN(p_runtsk) != 0U && ipmflg) {
 			call_texrtn();
 		}
 		ercd = E_OK;
@@ -271,12 +271,12 @@ ref_tex(ID tskid, T_RTEX *pk_rtex)
 	p_tcb = get_tcb_self(tskid);
 
 	t_lock_cpu();
-	if (TSTAT_DORMANT(p_tcb->tstat) || p_tcb->p_tinib->texrtn == NULL) {
+	if (TSTAT_DORMANT(p_tcb->tstat) || get_tinib(p_tcb)->texrtn == NULL) {
 		ercd = E_OBJ;
 	}
 	else {
 		pk_rtex->texstat = (p_tcb->enatex) ? TTEX_ENA : TTEX_DIS;
-		pk_rtex->pndptn = p_tcb->texptn;
+		pk_rtex->pndptn = TSK_TEXPTN(p_tcb);
 		ercd = E_OK;
 	}
 	t_unlock_cpu();
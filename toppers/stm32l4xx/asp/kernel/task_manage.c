@@ -116,6 +116,13 @@
 #define LOG_GET_INF_LEAVE(ercd, exinf)
 #endif /* LOG_GET_INF_LEAVE */
 
+/*
+ *  ディスパッチ禁止区間の計測のためのマクロのデフォルト定義
+ */
+#ifndef LOCKPROF_DSP_LEAVE
+#define LOCKPROF_DSP_LEAVE()
+#endif /* LOCKPROF_DSP_LEAVE */
+
 /*
  *  タスクの起動
  */
@@ -250,6 +257,7 @@ ext_tsk(void)
 		 *  ディスパッチ禁止状態でext_tskが呼ばれた場合は，ディスパッ
 		 *  チ許可状態にしてからタスクを終了する．
 		 */
+		LOCKPROF_DSP_LEAVE();
 		disdsp = false;
 	}
 	if (!ipmflg) {
@@ -348,7 +356,7 @@ chg_pri(ID tskid, PRI tskpri)
 	CHECK_TSKID_SELF(tskid);
 	CHECK_TPRI_INI(tskpri);
 	p_tcb = get_tcb_self(tskid);
-	newpri = (tskpri == TPRI_INI) ? p_tcb->p_tinib->ipriority
+	newpri = (tskpri == TPRI_INI) ? get_tinib(p_tcb)->ipriority
 										: INT_PRIORITY(tskpri);
 
 	t_lock_cpu();
@@ -417,7 +425,7 @@ get_inf(intptr_t *p_exinf)
 	CHECK_TSKCTX_UNL();
 
 	t_lock_cpu();
-	*p_exinf = p_runtsk->p_tinib->exinf;
+	*p_exinf = get_tinib(p_runtsk)->exinf;
 	ercd = E_OK;
 	t_unlock_cpu();
 
@@ -67,6 +67,14 @@
 #define LOG_GET_UTM_LEAVE(ercd, sysutm)
 #endif /* LOG_GET_UTM_LEAVE */
 
+#ifndef LOG_GET_UTM64_ENTER
+#define LOG_GET_UTM64_ENTER(p_sysutm64)
+#endif /* LOG_GET_UTM64_ENTER */
+
+#ifndef LOG_GET_UTM64_LEAVE
+#define LOG_GET_UTM64_LEAVE(ercd, sysutm64)
+#endif /* LOG_GET_UTM64_LEAVE */
+
 /*
  *  システム時刻の参照
  */
@@ -109,6 +117,7 @@ get_utm(SYSUTM *p_sysutm)
 	uint_t	subtime;
 #endif /* TIC_DENO != 1 */
 	CLOCK	clock1, clock2;
+	SYSUTM	usec;
 	bool_t	ireq;
 	SIL_PRE_LOC;
 
@@ -122,6 +131,7 @@ get_utm(SYSUTM *p_sysutm)
 	clock1 = target_timer_get_current();
 	ireq = target_timer_probe_int();
 	clock2 = target_timer_get_current();
+	usec = TO_USEC(clock1);		/* クロックの変更と排他的に換算する */
 	SIL_UNL_INT();
 
 	utime = ((SYSUTM) time) * 1000U;
@@ -132,7 +142,7 @@ get_utm(SYSUTM *p_sysutm)
 	if (!ireq || clock1 > clock2) {
 		utime -= TIC_NUME * 1000U / TIC_DENO;
 	}
-	utime += TO_USEC(clock1);
+	utime += usec;
 	*p_sysutm = utime;
 
 	LOG_GET_UTM_LEAVE(E_OK, *p_sysutm);
@@ -142,3 +152,25 @@ get_utm(SYSUTM *p_sysutm)
 #endif /* OMIT_GET_UTM */
 #endif /* TOPPERS_SUPPORT_GET_UTM */
 #endif /* TOPPERS_get_utm */
+
+/*
+ *  64ビットの性能評価用システム時刻の参照
+ *
+ *  ターゲット依存部が提供するfch_utm64により，フリーランニングのハー
+ *  ドウェアタイマから読み出す．fch_utm64はCPUロックや割込みロックを行
+ *  わずに読み出すため，どのコンテキストからも呼び出すことができる．
+ */
+#ifdef TOPPERS_get_utm64
+#ifdef TOPPERS_SUPPORT_GET_UTM64
+
+ER
+get_utm64(SYSUTM64 *p_sysutm64)
+{
+	LOG_GET_UTM64_ENTER(p_sysutm64);
+	*p_sysutm64 = fch_utm64();
+	LOG_GET_UTM64_LEAVE(E_OK, *p_sysutm64);
+	return(E_OK);
+}
+
+#endif /* TOPPERS_SUPPORT_GET_UTM64 */
+#endif /* TOPPERS_get_utm64 */
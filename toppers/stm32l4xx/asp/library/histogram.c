@@ -58,24 +58,44 @@
  *  ターゲット依存部で設定変更するためのマクロ
  */
 #ifndef HISTTIM						/* 実行時間計測用の時刻のデータ型 */
+#ifdef TOPPERS_SUPPORT_GET_UTM64
+#define HISTTIM			SYSUTM64
+#else /* TOPPERS_SUPPORT_GET_UTM64 */
 #define HISTTIM			SYSUTM
+#endif /* TOPPERS_SUPPORT_GET_UTM64 */
 #endif /* HISTTIM */
 
 #ifndef HIST_GET_TIM				/* 実行時間計測用の現在時刻の取得 */
+#ifdef TOPPERS_SUPPORT_GET_UTM64
+#define HIST_GET_TIM(p_time)	((void)(*(p_time) = fch_utm64()))
+#else /* TOPPERS_SUPPORT_GET_UTM64 */
 #ifndef TOPPERS_SUPPORT_GET_UTM
 #error get_utm is not supported.
 #endif /* TOPPERS_SUPPORT_GET_UTM */
 #define HIST_GET_TIM(p_time)	((void) get_utm(p_time))
+#endif /* TOPPERS_SUPPORT_GET_UTM64 */
 #endif /* HIST_GET_TIM */
 
 #ifndef HIST_CONV_TIM				/* 時刻の差から実行時間への変換 */
 #define HIST_CONV_TIM(time)		((uint_t)(time))
 #endif /* HIST_CONV_TIM */
 
+#ifndef HIST_UNIT					/* 実行時間の単位（表示用）*/
+#define HIST_UNIT				"us"
+#endif /* HIST_UNIT */
+
 #ifndef HIST_BM_HOOK				/* 実行時間計測直前に行うべき処理 */
 #define HIST_BM_HOOK()			((void) 0)
 #endif
 
+#ifndef HIST_INIT_HOOK				/* 実行時間分布計測の初期化時の処理 */
+#define HIST_INIT_HOOK()		((void) 0)
+#endif /* HIST_INIT_HOOK */
+
+#ifndef HIST_CALIBRATE_COUNT		/* オーバヘッドの計測回数 */
+#define HIST_CALIBRATE_COUNT	100U
+#endif /* HIST_CALIBRATE_COUNT */
+
 /*
  *  実行時間分布計測管理ブロック
  */
@@ -85,6 +105,12 @@ typedef struct histogram_control_block {
 	uint_t		*histarea;			/* 分布を記録するメモリ領域 */
 	uint_t		over;				/* 最大時間を超えた度数 */
 	uint_t		under;				/* 時間の逆転が疑われる度数 */
+	bool_t		logscale;			/* 対数線形の区間で記録するか */
+	uint_t		nbucket;			/* 分布を記録する区間の数 */
+	uint_t		count;				/* 計測回数（逆転を除く）*/
+	uint_t		min;				/* 最小時間 */
+	uint_t		max;				/* 最大時間 */
+	uint64_t	sum;				/* 時間の合計 */
 } HISTCB;
 
 /*
@@ -98,25 +124,148 @@ static HISTCB	histcb_table[TNUM_HIST];
 #define TMIN_HISTID		1
 #define TMAX_HISTID		(TMIN_HISTID + TNUM_HIST - 1)
 
+#ifdef HIST_CALIBRATE
 /*
- *  実行時間分布計測の初期化
+ *  計測のオーバヘッド
+ *
+ *  HIST_CALIBRATEが定義されている場合，空のプログラム区間の実行時間の
+ *  最小値を計測のオーバヘッドとして，計測した実行時間から差し引く．
  */
-void
-init_hist(ID histid, uint_t maxval, uint_t histarea[])
+static uint_t	hist_overhead;
+
+/*
+ *  計測のオーバヘッドの計測
+ */
+static void
+hist_calibrate(HISTCB *p_histcb)
 {
-	HISTCB	*p_histcb;
-	uint_t	i;
+	HISTTIM	end_time;
+	uint_t	i, val, minval;
 
-	assert(TMIN_HISTID <= histid && histid <= TMAX_HISTID);
-	p_histcb = &(histcb_table[histid - TMIN_HISTID]);
+	minval = UINT_MAX;
+	for (i = 0; i < HIST_CALIBRATE_COUNT; i++) {
+		HIST_BM_HOOK();
+		HIST_GET_TIM(&(p_histcb->begin_time));
+		HIST_GET_TIM(&end_time);
+		val = HIST_CONV_TIM(end_time - p_histcb->begin_time);
+		if (val < minval) {
+			minval = val;
+		}
+	}
+	hist_overhead = minval;
+}
+#endif /* HIST_CALIBRATE */
+
+/*
+ *  対数線形の区間の番号の計算
+ *
+ *  2^(HIST_LOG_SUBBITS+1)未満の時間は1単位毎の区間に，それ以上の時間
+ *  は，2のべき乗毎の範囲をそれぞれ2^HIST_LOG_SUBBITS個に等分した区間
+ *  に記録する．
+ */
+static uint_t
+hist_log_index(uint_t val)
+{
+	uint_t	shift;
+
+	if (val < (2U << HIST_LOG_SUBBITS)) {
+		return(val);
+	}
+	shift = 0U;
+	while ((val >> shift) >= (2U << HIST_LOG_SUBBITS)) {
+		shift++;
+	}
+	return((shift << HIST_LOG_SUBBITS) + (val >> shift));
+}
+
+/*
+ *  区間に含まれる最大時間の計算
+ */
+static uint_t
+hist_bucket_upper(HISTCB *p_histcb, uint_t index)
+{
+	uint_t	shift;
+
+	if (!(p_histcb->logscale) || index < (2U << HIST_LOG_SUBBITS)) {
+		return(index);
+	}
+	shift = (index >> HIST_LOG_SUBBITS) - 1U;
+	return((((index - (shift << HIST_LOG_SUBBITS)) + 1U) << shift) - 1U);
+}
+
+/*
+ *  区間に含まれる最小時間の計算
+ */
+static uint_t
+hist_bucket_lower(HISTCB *p_histcb, uint_t index)
+{
+	uint_t	shift;
 
-	for (i = 0; i <= maxval; i++) {
+	if (!(p_histcb->logscale) || index < (2U << HIST_LOG_SUBBITS)) {
+		return(index);
+	}
+	shift = (index >> HIST_LOG_SUBBITS) - 1U;
+	return((index - (shift << HIST_LOG_SUBBITS)) << shift);
+}
+
+/*
+ *  実行時間分布計測管理ブロックの初期化
+ */
+static void
+hist_init_cb(HISTCB *p_histcb, uint_t maxval, uint_t nbucket,
+									uint_t histarea[], bool_t logscale)
+{
+	uint_t	i;
+
+	for (i = 0; i < nbucket; i++) {
 		histarea[i] = 0U;
 	}
 	p_histcb->maxval = maxval;
 	p_histcb->histarea = histarea;
 	p_histcb->over = 0U;
 	p_histcb->under = 0U;
+	p_histcb->logscale = logscale;
+	p_histcb->nbucket = nbucket;
+	p_histcb->count = 0U;
+	p_histcb->min = UINT_MAX;
+	p_histcb->max = 0U;
+	p_histcb->sum = 0U;
+
+	HIST_INIT_HOOK();
+#ifdef HIST_CALIBRATE
+	hist_calibrate(p_histcb);
+#endif /* HIST_CALIBRATE */
+}
+
+/*
+ *  実行時間分布計測の初期化
+ */
+void
+init_hist(ID histid, uint_t maxval, uint_t histarea[])
+{
+	HISTCB	*p_histcb;
+
+	assert(TMIN_HISTID <= histid && histid <= TMAX_HISTID);
+	p_histcb = &(histcb_table[histid - TMIN_HISTID]);
+
+	hist_init_cb(p_histcb, maxval, maxval + 1U, histarea, false);
+}
+
+/*
+ *  対数線形の区間による実行時間分布計測の初期化
+ */
+void
+init_hist_log(ID histid, uint_t bits, uint_t histarea[])
+{
+	HISTCB	*p_histcb;
+	uint_t	maxval;
+
+	assert(TMIN_HISTID <= histid && histid <= TMAX_HISTID);
+	assert(HIST_LOG_SUBBITS < bits && bits <= 32U);
+	p_histcb = &(histcb_table[histid - TMIN_HISTID]);
+
+	maxval = (bits < 32U) ? ((1U << bits) - 1U) : UINT_MAX;
+	hist_init_cb(p_histcb, maxval, HIST_LOG_NBUCKET(bits), histarea, true);
 }
 
 /*
@@ -136,6 +285,10 @@ begin_measure(ID histid)
 
 /*
  *  実行時間計測の終了
+ *
+ *  計測開始時刻を計測IDごとに1つしか持たないため，1つの計測IDを複数
+ *  の処理単位から同時に用いることはできない．そのため，度数や合計の更
+ *  新には排他制御やアトミック操作を用いない．
  */
 void
 end_measure(ID histid)
@@ -150,15 +303,99 @@ end_measure(ID histid)
 	p_histcb = &(histcb_table[histid - TMIN_HISTID]);
 
 	val = HIST_CONV_TIM(end_time - p_histcb->begin_time);
+	if (val > ((uint_t) INT_MAX)) {
+		p_histcb->under++;
+		return;
+	}
+#ifdef HIST_CALIBRATE
+	val = (val > hist_overhead) ? (val - hist_overhead) : 0U;
+#endif /* HIST_CALIBRATE */
+
 	if (val <= p_histcb->maxval) {
-		p_histcb->histarea[val]++;
+		if (p_histcb->logscale) {
+			p_histcb->histarea[hist_log_index(val)]++;
+		}
+		else {
+			p_histcb->histarea[val]++;
+		}
 	}
-	else if (val <= ((uint_t) INT_MAX)) {
+	else {
 		p_histcb->over++;
 	}
+
+	p_histcb->count++;
+	p_histcb->sum += val;
+	if (val < p_histcb->min) {
+		p_histcb->min = val;
+	}
+	if (val > p_histcb->max) {
+		p_histcb->max = val;
+	}
+}
+
+/*
+ *  実行時間分布計測の統計情報の参照
+ */
+void
+ref_hist(ID histid, T_RHIST *pk_rhist)
+{
+	HISTCB	*p_histcb;
+
+	assert(TMIN_HISTID <= histid && histid <= TMAX_HISTID);
+	p_histcb = &(histcb_table[histid - TMIN_HISTID]);
+
+	pk_rhist->count = p_histcb->count;
+	pk_rhist->under = p_histcb->under;
+	pk_rhist->over = p_histcb->over;
+	if (p_histcb->count > 0U) {
+		pk_rhist->min = p_histcb->min;
+		pk_rhist->max = p_histcb->max;
+		pk_rhist->mean = (uint_t)(p_histcb->sum / p_histcb->count);
+	}
 	else {
-		p_histcb->under++;
+		pk_rhist->min = 0U;
+		pk_rhist->max = 0U;
+		pk_rhist->mean = 0U;
 	}
+	pk_rhist->p50 = hist_percentile(histid, 500U);
+	pk_rhist->p90 = hist_percentile(histid, 900U);
+	pk_rhist->p99 = hist_percentile(histid, 990U);
+	pk_rhist->p999 = hist_percentile(histid, 999U);
+}
+
+/*
+ *  実行時間のパーセンタイル値の計算
+ *
+ *  計測回数のpermille/1000以上が含まれる最小の区間の最大時間を返す．
+ *  最大時間を超えた度数に含まれる場合は，計測された最大時間を返す．
+ */
+uint_t
+hist_percentile(ID histid, uint_t permille)
+{
+	HISTCB		*p_histcb;
+	uint64_t	rank, cumul;
+	uint_t		i, upper;
+
+	assert(TMIN_HISTID <= histid && histid <= TMAX_HISTID);
+	p_histcb = &(histcb_table[histid - TMIN_HISTID]);
+
+	if (p_histcb->count == 0U) {
+		return(0U);
+	}
+	rank = ((uint64_t)(p_histcb->count) * permille + 999U) / 1000U;
+	if (rank == 0U) {
+		rank = 1U;
+	}
+
+	cumul = 0U;
+	for (i = 0; i < p_histcb->nbucket; i++) {
+		cumul += p_histcb->histarea[i];
+		if (cumul >= rank) {
+			upper = hist_bucket_upper(p_histcb, i);
+			return((upper < p_histcb->max) ? upper : p_histcb->max);
+		}
+	}
+	return(p_histcb->max);
 }
 
 /*
@@ -173,9 +410,19 @@ print_hist(ID histid)
 	assert(TMIN_HISTID <= histid && histid <= TMAX_HISTID);
 	p_histcb = &(histcb_table[histid - TMIN_HISTID]);
 
-	for (i = 0; i <= p_histcb->maxval; i++) {
+	for (i = 0; i < p_histcb->nbucket; i++) {
 		if (p_histcb->histarea[i] > 0) {
-			syslog_2(LOG_NOTICE, "%d : %d", i, p_histcb->histarea[i]);
+			if (p_histcb->logscale && hist_bucket_lower(p_histcb, i)
+										!= hist_bucket_upper(p_histcb, i)) {
+				syslog_3(LOG_NOTICE, "%d-%d : %d",
+							hist_bucket_lower(p_histcb, i),
+							hist_bucket_upper(p_histcb, i),
+							p_histcb->histarea[i]);
+			}
+			else {
+				syslog_2(LOG_NOTICE, "%d : %d", hist_bucket_lower(p_histcb, i),
+												p_histcb->histarea[i]);
+			}
 			syslog_flush();
 		}
 	}
@@ -187,3 +434,86 @@ print_hist(ID histid)
 	}
 	syslog_flush();
 }
+
+/*
+ *  実行時間分布計測の統計情報の表示
+ */
+void
+print_hist_stat(ID histid)
+{
+	T_RHIST	rhist;
+
+	ref_hist(histid, &rhist);
+	syslog_4(LOG_NOTICE, "count %d, min %d, mean %d, max %d",
+						rhist.count, rhist.min, rhist.mean, rhist.max);
+	syslog_5(LOG_NOTICE, "p50 %d, p90 %d, p99 %d, p99.9 %d, max %d",
+						rhist.p50, rhist.p90, rhist.p99, rhist.p999, rhist.max);
+	syslog_flush();
+}
+
+/*
+ *  実行時間分布計測のCSV形式での表示
+ *
+ *  次の形式の行を出力する．
+ *
+ *	hist,<histid>,bucket,<最小時間>,<最大時間>,<度数>
+ *	hist,<histid>,over,<最大時間>,<度数>
+ *	hist,<histid>,stat,<計測回数>,<最小>,<平均>,<最大>
+ *	hist,<histid>,pct,<p50>,<p90>,<p99>,<p99.9>
+ */
+void
+print_hist_csv(ID histid)
+{
+	HISTCB	*p_histcb;
+	T_RHIST	rhist;
+	uint_t	i;
+
+	assert(TMIN_HISTID <= histid && histid <= TMAX_HISTID);
+	p_histcb = &(histcb_table[histid - TMIN_HISTID]);
+
+	for (i = 0; i < p_histcb->nbucket; i++) {
+		if (p_histcb->histarea[i] > 0) {
+			syslog_4(LOG_NOTICE, "hist,%d,bucket,%d,%d,%d", histid,
+							hist_bucket_lower(p_histcb, i),
+							hist_bucket_upper(p_histcb, i),
+							p_histcb->histarea[i]);
+			syslog_flush();
+		}
+	}
+	if (p_histcb->over > 0) {
+		syslog_3(LOG_NOTICE, "hist,%d,over,%d,%d", histid,
+							p_histcb->maxval, p_histcb->over);
+	}
+
+	ref_hist(histid, &rhist);
+	syslog_5(LOG_NOTICE, "hist,%d,stat,%d,%d,%d,%d", histid,
+						rhist.count, rhist.min, rhist.mean, rhist.max);
+	syslog_5(LOG_NOTICE, "hist,%d,pct,%d,%d,%d,%d", histid,
+						rhist.p50, rhist.p90, rhist.p99, rhist.p999);
+	syslog_flush();
+}
+
+/*
+ *  ベンチマーク結果の表示
+ *
+ *  nameで指定した名前を付けて，次の形式の行を出力する．リリース間で計
+ *  測結果を比較するために，形式は変更しないこと．
+ *
+ *	bench,<name>,stat,<計測回数>,<最小>,<平均>,<最大>
+ *	bench,<name>,pct,<p50>,<p90>,<p99>,<p99.9>
+ *	bench,<name>,info,<単位>,<逆転の度数>,<最大時間を超えた度数>
+ */
+void
+print_hist_bench(ID histid, const char *name)
+{
+	T_RHIST	rhist;
+
+	ref_hist(histid, &rhist);
+	syslog_5(LOG_NOTICE, "bench,%s,stat,%d,%d,%d,%d", name,
+						rhist.count, rhist.min, rhist.mean, rhist.max);
+	syslog_5(LOG_NOTICE, "bench,%s,pct,%d,%d,%d,%d", name,
+						rhist.p50, rhist.p90, rhist.p99, rhist.p999);
+	syslog_4(LOG_NOTICE, "bench,%s,info,%s,%d,%d", name,
+						HIST_UNIT, rhist.under, rhist.over);
+	syslog_flush();
+}
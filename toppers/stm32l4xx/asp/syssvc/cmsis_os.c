@@ -0,0 +1,498 @@
+/*
+ *  TOPPERS/ASP Kernel
+ *      Toyohashi Open Platform for Embedded Real-Time Systems/
+ *      Advanced Standard Profile Kernel
+ * 
+ *  Copyright (C) 2005-2011 by Embedded and Real-Time Systems Laboratory
+ *              Graduate School of Information Science, Nagoya Univ., JAPAN
+ *  Copyright (C) 2017-2018 by TOPPERS PROJECT Educational Working Group.
+ * 
+ *  上記著作権者は，以下の(1)〜(4)の条件を満たす場合に限り，本ソフトウェ
+ *  ア（本ソフトウェアを改変したものを含む．以下同じ）を使用・複製・改
+ *  変・再配布（以下，利用と呼ぶ）することを無償で許諾する．
+ *  (1) 本ソフトウェアをソースコードの形で利用する場合には，上記の著作
+ *      権表示，この利用条件および下記の無保証規定が，そのままの形でソー
+ *      スコード中に含まれていること．
+ *  (2) 本ソフトウェアを，ライブラリ形式など，他のソフトウェア開発に使
+ *      用できる形で再配布する場合には，再配布に伴うドキュメント（利用
+ *      者マニュアルなど）に，上記の著作権表示，この利用条件および下記
+ *      の無保証規定を掲載すること．
+ *  (3) 本ソフトウェアを，機器に組み込むなど，他のソフトウェア開発に使
+ *      用できない形で再配布する場合には，次のいずれかの条件を満たすこ
+ *      と．
+ *    (a) 再配布に伴うドキュメント（利用者マニュアルなど）に，上記の著
+ *        作権表示，この利用条件および下記の無保証規定を掲載すること．
+ *    (b) 再配布の形態を，別に定める方法によって，TOPPERSプロジェクトに
+ *        報告すること．
+ *  (4) 本ソフトウェアの利用により直接的または間接的に生じるいかなる損
+ *      害からも，上記著作権者およびTOPPERSプロジェクトを免責すること．
+ *      また，本ソフトウェアのユーザまたはエンドユーザからのいかなる理
+ *      由に基づく請求からも，上記著作権者およびTOPPERSプロジェクトを
+ *      免責すること．
+ * 
+ *  本ソフトウェアは，無保証で提供されているものである．上記著作権者お
+ *  よびTOPPERSプロジェクトは，本ソフトウェアに関して，特定の使用目的
+ *  に対する適合性も含めて，いかなる保証も行わない．また，本ソフトウェ
+ *  アの利用により直接的または間接的に生じたいかなる損害に関しても，そ
+ *  の責任を負わない．
+ * 
+ *  $Id$
+ */
+
+/*
+ *		CMSIS-RTOS（Version 1）API層
+ */
+
+#include <kernel.h>
+#include <cmsis_os.h>
+#include "kernel_cfg.h"
+
+/*
+ *  カーネル起動前に生成を要求されたスレッド
+ */
+static bool_t	cmsis_pending[TNUM_TSKID];
+
+/*
+ *  スレッドとタイマのエントリに渡す引数
+ *
+ *  osThreadCreateとosTimerCreateのargumentを，タスク，周期ハンドラ，
+ *  アラームハンドラ毎に記録しておき，cmsis_thread_mainなどがエントリ
+ *  を呼び出す時に渡す．
+ */
+static void		*cmsis_thread_arg[TNUM_TSKID];
+
+#if TNUM_CYCID > 0
+static void		*cmsis_cyclic_arg[TNUM_CYCID];
+#endif /* TNUM_CYCID > 0 */
+
+#if TNUM_ALMID > 0
+static void		*cmsis_alarm_arg[TNUM_ALMID];
+#endif /* TNUM_ALMID > 0 */
+
+/*
+ *  タイムアウト時間の変換
+ */
+Inline TMO
+cmsis_tmout(uint32_t millisec)
+{
+	return((millisec == osWaitForever) ? TMO_FEVR : (TMO) millisec);
+}
+
+/*
+ *  エラーコードの変換
+ */
+static osStatus
+cmsis_status(ER ercd, uint32_t millisec)
+{
+	switch (MERCD(ercd)) {
+	case E_OK:
+		return(osOK);
+	case E_TMOUT:
+		return((millisec == 0U) ? osErrorResource : osErrorTimeoutResource);
+	case E_CTX:
+		return(osErrorISR);
+	case E_ID:
+	case E_PAR:
+	case E_NOEXS:
+		return(osErrorParameter);
+	case E_QOVR:
+	case E_OBJ:
+	case E_ILUSE:
+		return(osErrorResource);
+	default:
+		return(osErrorOS);
+	}
+}
+
+/*
+ *  カーネルの制御
+ *
+ *  カーネルはスタートアップモジュールから起動されるため，
+ *  osKernelInitializeとosKernelStartは何もしない．
+ */
+osStatus
+osKernelInitialize(void)
+{
+	return(osOK);
+}
+
+osStatus
+osKernelStart(void)
+{
+	return(osOK);
+}
+
+int32_t
+osKernelRunning(void)
+{
+	return(sns_ker() ? 0 : 1);
+}
+
+uint32_t
+osKernelSysTick(void)
+{
+	SYSUTM	sysutm;
+
+	if (get_utm(&sysutm) != E_OK) {
+		return(0U);
+	}
+	return((uint32_t) sysutm);
+}
+
+/*
+ *  スレッドの管理
+ *
+ *  スレッドはCRE_TSKで生成しておき，osThreadCreateではタスクを起動す
+ *  る．カーネル起動前に呼ばれた場合には，起動タスクに起動を依頼する．
+ *  argumentは，タスクが起動された時にcmsis_thread_mainがスレッドのエ
+ *  ントリに渡す．
+ */
+osThreadId
+osThreadCreate(const osThreadDef_t *thread_def, void *argument)
+{
+	ID		tskid;
+	ER		ercd;
+
+	if (thread_def == NULL) {
+		return(0);
+	}
+	tskid = thread_def->tskid;
+	if (!(1 <= tskid && tskid <= TNUM_TSKID)) {
+		return(0);
+	}
+	cmsis_thread_arg[tskid - 1] = argument;
+	if (sns_ker()) {
+		cmsis_pending[tskid - 1] = true;
+		return(tskid);
+	}
+	ercd = sns_ctx() ? iact_tsk(tskid) : act_tsk(tskid);
+	return((ercd == E_OK || MERCD(ercd) == E_QOVR) ? tskid : 0);
+}
+
+osThreadId
+osThreadGetId(void)
+{
+	ID		tskid;
+
+	if ((sns_ctx() ? iget_tid(&tskid) : get_tid(&tskid)) != E_OK) {
+		return(0);
+	}
+	return(tskid);
+}
+
+osStatus
+osThreadTerminate(osThreadId thread_id)
+{
+	ER		ercd;
+
+	ercd = ter_tsk(thread_id);
+	if (MERCD(ercd) == E_ILUSE) {
+		ercd = ext_tsk();
+	}
+	return(cmsis_status(ercd, 0U));
+}
+
+osStatus
+osThreadYield(void)
+{
+	return(cmsis_status(rot_rdq(TPRI_SELF), 0U));
+}
+
+osStatus
+osThreadSetPriority(osThreadId thread_id, osPriority priority)
+{
+	if (!(osPriorityIdle <= priority && priority <= osPriorityRealtime)) {
+		return(osErrorValue);
+	}
+	return(cmsis_status(chg_pri(thread_id, CMSIS_TPRI(priority)), 0U));
+}
+
+osPriority
+osThreadGetPriority(osThreadId thread_id)
+{
+	PRI		tskpri;
+
+	if (get_pri(thread_id, &tskpri) != E_OK) {
+		return(osPriorityError);
+	}
+	return((osPriority)(CMSIS_TPRI_NORMAL - tskpri));
+}
+
+/*
+ *  時間待ち
+ */
+osStatus
+osDelay(uint32_t millisec)
+{
+	ER		ercd;
+
+	ercd = dly_tsk((RELTIM) millisec);
+	return((ercd == E_OK) ? osEventTimeout : cmsis_status(ercd, 0U));
+}
+
+/*
+ *  タイマの管理
+ *
+ *  周期タイマは周期ハンドラ，ワンショットタイマはアラームハンドラに対
+ *  応させる．周期ハンドラの周期は静的APIで指定したものであり，
+ *  osTimerStartのmillisecは用いない．argumentは，ハンドラが起動された
+ *  時にcmsis_cyclic_handler／cmsis_alarm_handlerがタイマのエントリに
+ *  渡す．
+ */
+osTimerId
+osTimerCreate(const osTimerDef_t *timer_def, os_timer_type type,
+															void *argument)
+{
+	ID		tmrid;
+
+	if (timer_def == NULL) {
+		return(0);
+	}
+	tmrid = timer_def->tmrid;
+	if (type == osTimerPeriodic) {
+#if TNUM_CYCID > 0
+		if (1 <= tmrid && tmrid <= TNUM_CYCID) {
+			cmsis_cyclic_arg[tmrid - 1] = argument;
+			return(tmrid | CMSIS_TMRID_CYC);
+		}
+#endif /* TNUM_CYCID > 0 */
+	}
+	else {
+#if TNUM_ALMID > 0
+		if (1 <= tmrid && tmrid <= TNUM_ALMID) {
+			cmsis_alarm_arg[tmrid - 1] = argument;
+			return(tmrid);
+		}
+#endif /* TNUM_ALMID > 0 */
+	}
+	return(0);
+}
+
+osStatus
+osTimerStart(osTimerId timer_id, uint32_t millisec)
+{
+	ER		ercd;
+
+	if ((timer_id & CMSIS_TMRID_CYC) != 0) {
+		ercd = sta_cyc(timer_id & ~CMSIS_TMRID_CYC);
+	}
+	else if (sns_ctx()) {
+		ercd = ista_alm(timer_id, (RELTIM) millisec);
+	}
+	else {
+		ercd = sta_alm(timer_id, (RELTIM) millisec);
+	}
+	return(cmsis_status(ercd, 0U));
+}
+
+osStatus
+osTimerStop(osTimerId timer_id)
+{
+	ER		ercd;
+
+	if ((timer_id & CMSIS_TMRID_CYC) != 0) {
+		ercd = stp_cyc(timer_id & ~CMSIS_TMRID_CYC);
+	}
+	else if (sns_ctx()) {
+		ercd = istp_alm(timer_id);
+	}
+	else {
+		ercd = stp_alm(timer_id);
+	}
+	return(cmsis_status(ercd, 0U));
+}
+
+osStatus
+osTimerDelete(osTimerId timer_id)
+{
+	return(osErrorOS);
+}
+
+/*
+ *  ミューテックスの管理
+ */
+#ifdef TOPPERS_SUPPORT_MUTEX
+
+osMutexId
+osMutexCreate(const osMutexDef_t *mutex_def)
+{
+	return((mutex_def == NULL) ? 0 : mutex_def->mtxid);
+}
+
+osStatus
+osMutexWait(osMutexId mutex_id, uint32_t millisec)
+{
+	return(cmsis_status(tloc_mtx(mutex_id, cmsis_tmout(millisec)),
+															millisec));
+}
+
+osStatus
+osMutexRelease(osMutexId mutex_id)
+{
+	return(cmsis_status(unl_mtx(mutex_id), 0U));
+}
+
+osStatus
+osMutexDelete(osMutexId mutex_id)
+{
+	return(osErrorOS);
+}
+
+#endif /* TOPPERS_SUPPORT_MUTEX */
+
+/*
+ *  セマフォの管理
+ *
+ *  資源数の初期値と最大値は静的APIで指定したものであり，
+ *  osSemaphoreCreateのcountは用いない．
+ */
+osSemaphoreId
+osSemaphoreCreate(const osSemaphoreDef_t *semaphore_def, int32_t count)
+{
+	return((semaphore_def == NULL) ? 0 : semaphore_def->semid);
+}
+
+/*
+ *  osSemaphoreWaitは，資源を獲得できた場合，獲得する前の資源数（獲得
+ *  後の資源数に1を加えたもの）を返す．獲得後の資源数はref_semで読み出
+ *  すため，その間に他のタスクや割込みハンドラが資源を返却・獲得した場
+ *  合には，それを反映した値となる．
+ */
+int32_t
+osSemaphoreWait(osSemaphoreId semaphore_id, uint32_t millisec)
+{
+	T_RSEM	rsem;
+	ER		ercd;
+
+	if (sns_ctx()) {
+		return(-1);
+	}
+	ercd = twai_sem(semaphore_id, cmsis_tmout(millisec));
+	if (ercd == E_OK) {
+		if (ref_sem(semaphore_id, &rsem) != E_OK) {
+			return(1);
+		}
+		return((int32_t)(rsem.semcnt + 1U));
+	}
+	return((MERCD(ercd) == E_TMOUT) ? 0 : -1);
+}
+
+osStatus
+osSemaphoreRelease(osSemaphoreId semaphore_id)
+{
+	return(cmsis_status(sns_ctx() ? isig_sem(semaphore_id)
+									: sig_sem(semaphore_id), 0U));
+}
+
+osStatus
+osSemaphoreDelete(osSemaphoreId semaphore_id)
+{
+	return(osErrorOS);
+}
+
+/*
+ *  メッセージキューの管理
+ *
+ *  メッセージキューはデータキューに対応させ，32ビットのメッセージを
+ *  データとしてそのまま送受信する．
+ */
+osMessageQId
+osMessageCreate(const osMessageQDef_t *queue_def, osThreadId thread_id)
+{
+	return((queue_def == NULL) ? 0 : queue_def->dtqid);
+}
+
+osStatus
+osMessagePut(osMessageQId queue_id, uint32_t info, uint32_t millisec)
+{
+	ER		ercd;
+
+	if (sns_ctx()) {
+		if (millisec != 0U) {
+			return(osErrorParameter);
+		}
+		ercd = ipsnd_dtq(queue_id, (intptr_t) info);
+	}
+	else {
+		ercd = tsnd_dtq(queue_id, (intptr_t) info, cmsis_tmout(millisec));
+	}
+	return(cmsis_status(ercd, millisec));
+}
+
+osEvent
+osMessageGet(osMessageQId queue_id, uint32_t millisec)
+{
+	osEvent		event;
+	intptr_t	data;
+	ER			ercd;
+
+	event.def.message_id = queue_id;
+	event.value.v = 0U;
+	if (sns_ctx()) {
+		event.status = osErrorISR;
+		return(event);
+	}
+	ercd = trcv_dtq(queue_id, &data, cmsis_tmout(millisec));
+	if (ercd == E_OK) {
+		event.status = osEventMessage;
+		event.value.v = (uint32_t) data;
+	}
+	else if (MERCD(ercd) == E_TMOUT) {
+		event.status = (millisec == 0U) ? osOK : osEventTimeout;
+	}
+	else {
+		event.status = cmsis_status(ercd, millisec);
+	}
+	return(event);
+}
+
+/*
+ *  CMSIS-RTOS API層の起動タスク
+ */
+void
+cmsis_start_task(intptr_t exinf)
+{
+	uint_t	i;
+
+	for (i = 0; i < TNUM_TSKID; i++) {
+		if (cmsis_pending[i]) {
+			cmsis_pending[i] = false;
+			(void) act_tsk((ID)(i + 1));
+		}
+	}
+}
+
+/*
+ *  スレッドとタイマのエントリの呼出し
+ */
+void
+cmsis_thread_main(intptr_t exinf)
+{
+	const osThreadDef_t	*thread_def = (const osThreadDef_t *) exinf;
+
+	(*thread_def->pthread)(cmsis_thread_arg[thread_def->tskid - 1]);
+}
+
+#if TNUM_CYCID > 0
+
+void
+cmsis_cyclic_handler(intptr_t exinf)
+{
+	const osTimerDef_t	*timer_def = (const osTimerDef_t *) exinf;
+
+	(*timer_def->ptimer)(cmsis_cyclic_arg[timer_def->tmrid - 1]);
+}
+
+#endif /* TNUM_CYCID > 0 */
+
+#if TNUM_ALMID > 0
+
+void
+cmsis_alarm_handler(intptr_t exinf)
+{
+	const osTimerDef_t	*timer_def = (const osTimerDef_t *) exinf;
+
+	(*timer_def->ptimer)(cmsis_alarm_arg[timer_def->tmrid - 1]);
+}
+
+#endif /* TNUM_ALMID > 0 */
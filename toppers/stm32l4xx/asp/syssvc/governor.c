@@ -0,0 +1,218 @@
+/*
+ *  TOPPERS/ASP Kernel
+ *      Toyohashi Open Platform for Embedded Real-Time Systems/
+ *      Advanced Standard Profile Kernel
+ * 
+ *  Copyright (C) 2005-2011 by Embedded and Real-Time Systems Laboratory
+ *              Graduate School of Information Science, Nagoya Univ., JAPAN
+ *  Copyright (C) 2017-2018 by TOPPERS PROJECT Educational Working Group.
+ * 
+ *  上記著作権者は，以下の(1)〜(4)の条件を満たす場合に限り，本ソフトウェ
+ *  ア（本ソフトウェアを改変したものを含む．以下同じ）を使用・複製・改
+ *  変・再配布（以下，利用と呼ぶ）することを無償で許諾する．
+ *  (1) 本ソフトウェアをソースコードの形で利用する場合には，上記の著作
+ *      権表示，この利用条件および下記の無保証規定が，そのままの形でソー
+ *      スコード中に含まれていること．
+ *  (2) 本ソフトウェアを，ライブラリ形式など，他のソフトウェア開発に使
+ *      用できる形で再配布する場合には，再配布に伴うドキュメント（利用
+ *      者マニュアルなど）に，上記の著作権表示，この利用条件および下記
+ *      の無保証規定を掲載すること．
+ *  (3) 本ソフトウェアを，機器に組み込むなど，他のソフトウェア開発に使
+ *      用できない形で再配布する場合には，次のいずれかの条件を満たすこ
+ *      と．
+ *    (a) 再配布に伴うドキュメント（利用者マニュアルなど）に，上記の著
+ *        作権表示，この利用条件および下記の無保証規定を掲載すること．
+ *    (b) 再配布の形態を，別に定める方法によって，TOPPERSプロジェクトに
+ *        報告すること．
+ *  (4) 本ソフトウェアの利用により直接的または間接的に生じるいかなる損
+ *      害からも，上記著作権者およびTOPPERSプロジェクトを免責すること．
+ *      また，本ソフトウェアのユーザまたはエンドユーザからのいかなる理
+ *      由に基づく請求からも，上記著作権者およびTOPPERSプロジェクトを
+ *      免責すること．
+ * 
+ *  本ソフトウェアは，無保証で提供されているものである．上記著作権者お
+ *  よびTOPPERSプロジェクトは，本ソフトウェアに関して，特定の使用目的
+ *  に対する適合性も含めて，いかなる保証も行わない．また，本ソフトウェ
+ *  アの利用により直接的または間接的に生じたいかなる損害に関しても，そ
+ *  の責任を負わない．
+ * 
+ *  $Id$
+ */
+
+/*
+ *		クロックガバナ
+ */
+
+#include <kernel.h>
+#include <sil.h>
+#include "governor.h"
+
+#ifdef TOPPERS_SUPPORT_GOVERNOR
+
+/*
+ *  クロックのレベルの表
+ */
+static const GOVLVL	govlvl_table[] = GOVERNOR_LEVEL_TABLE;
+
+#define TNUM_GOVLVL	((uint_t)(sizeof(govlvl_table) / sizeof(GOVLVL)))
+
+/*
+ *  アイドルタスクが割込み待ちで過ごした時間の累計（マイクロ秒）
+ */
+static volatile SYSUTM	governor_idle_time;
+
+/*
+ *  クロックガバナの状態
+ */
+static bool_t	governor_enabled = true;	/* 動作が許可されている */
+static uint_t	governor_level;				/* 現在のレベル */
+static uint_t	governor_load;				/* 直前の負荷（%）*/
+static uint_t	governor_count;				/* クロックを切り換えた回数 */
+
+/*
+ *  レベルの切換え
+ */
+static ER
+governor_set_level(uint_t level)
+{
+	ER		ercd;
+
+	if (level == governor_level) {
+		return(E_OK);
+	}
+	ercd = GOVERNOR_SWITCH(govlvl_table[level].range);
+	if (ercd == E_OK) {
+		governor_level = level;
+		governor_count++;
+	}
+	return(ercd);
+}
+
+/*
+ *  クロックガバナの動作の許可
+ */
+ER
+governor_ena(void)
+{
+	governor_enabled = true;
+	return(E_OK);
+}
+
+/*
+ *  クロックガバナの動作の禁止
+ */
+ER
+governor_dis(void)
+{
+	ER		ercd;
+
+	if (sns_dpn()) {
+		return(E_CTX);
+	}
+	dis_dsp();
+	governor_enabled = false;
+	ercd = governor_set_level(0U);
+	ena_dsp();
+	return(ercd);
+}
+
+/*
+ *  クロックガバナの状態参照
+ */
+ER
+governor_ref(T_GOVERNOR_RGOV *pk_rgov)
+{
+	SIL_PRE_LOC;
+
+	SIL_LOC_INT();
+	pk_rgov->level = governor_level;
+	pk_rgov->load = governor_load;
+	pk_rgov->count = governor_count;
+	SIL_UNL_INT();
+	return(E_OK);
+}
+
+/*
+ *  ガバナタスクの本体
+ *
+ *  GOVERNOR_INTERVAL毎に直前の負荷を求め，負荷がGOVERNOR_UP_LOAD以上
+ *  であれば，最も高いクロックに切り換える．1段低いクロックに換算した
+ *  負荷がGOVERNOR_DOWN_LOAD未満である状態がGOVERNOR_DOWN_COUNT回続く
+ *  と，クロックを1段下げる．
+ */
+void
+governor_main(intptr_t exinf)
+{
+	SYSUTM		last_time, last_idle, now, idle;
+	uint32_t	elapsed, idled, next_load;
+	uint_t		down_count = 0U;
+
+	/*
+	 *  最も高いクロックから始める．既にそのクロックで動作している場合
+	 *  にエラーを返すターゲットがあるため，返値は無視する．
+	 */
+	(void) GOVERNOR_SWITCH(govlvl_table[0].range);
+	(void) get_utm(&last_time);
+	last_idle = governor_idle_time;
+	for (;;) {
+		(void) dly_tsk(GOVERNOR_INTERVAL);
+
+		(void) get_utm(&now);
+		idle = governor_idle_time;
+		elapsed = (uint32_t)(now - last_time);
+		idled = (uint32_t)(idle - last_idle);
+		last_time = now;
+		last_idle = idle;
+		if (elapsed == 0U) {
+			continue;
+		}
+		governor_load = (idled < elapsed)
+				? (uint_t)(((uint64_t)(elapsed - idled)) * 100U / elapsed) : 0U;
+
+		if (!governor_enabled) {
+			down_count = 0U;
+		}
+		else if (governor_load >= GOVERNOR_UP_LOAD) {
+			down_count = 0U;
+			(void) governor_set_level(0U);
+		}
+		else if (governor_level + 1U < TNUM_GOVLVL) {
+			next_load = (uint32_t)(((uint64_t) governor_load)
+							* govlvl_table[governor_level].frequency
+							/ govlvl_table[governor_level + 1U].frequency);
+			if (next_load >= GOVERNOR_DOWN_LOAD) {
+				down_count = 0U;
+			}
+			else if (++down_count >= GOVERNOR_DOWN_COUNT) {
+				down_count = 0U;
+				(void) governor_set_level(governor_level + 1U);
+			}
+		}
+	}
+}
+
+/*
+ *  アイドルタスクの本体
+ *
+ *  割込み待ちの前後の時刻を，全割込み禁止のまま読み出すことで，割込み
+ *  処理の時間を含めずにアイドル時間を計測する．
+ */
+void
+governor_idle(intptr_t exinf)
+{
+	SYSUTM	begin, end;
+
+	for (;;) {
+		GOVERNOR_IDLE_LOCK();
+		(void) get_utm(&begin);
+		GOVERNOR_IDLE_WAIT();
+		(void) get_utm(&end);
+		if (end > begin) {
+			governor_idle_time += end - begin;
+		}
+		GOVERNOR_IDLE_UNLOCK();
+		(void) rot_rdq(TPRI_SELF);
+	}
+}
+
+#endif /* TOPPERS_SUPPORT_GOVERNOR */
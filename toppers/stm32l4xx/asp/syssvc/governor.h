@@ -0,0 +1,158 @@
+/*
+ *  TOPPERS/ASP Kernel
+ *      Toyohashi Open Platform for Embedded Real-Time Systems/
+ *      Advanced Standard Profile Kernel
+ * 
+ *  Copyright (C) 2005-2011 by Embedded and Real-Time Systems Laboratory
+ *              Graduate School of Information Science, Nagoya Univ., JAPAN
+ *  Copyright (C) 2017-2018 by TOPPERS PROJECT Educational Working Group.
+ * 
+ *  上記著作権者は，以下の(1)〜(4)の条件を満たす場合に限り，本ソフトウェ
+ *  ア（本ソフトウェアを改変したものを含む．以下同じ）を使用・複製・改
+ *  変・再配布（以下，利用と呼ぶ）することを無償で許諾する．
+ *  (1) 本ソフトウェアをソースコードの形で利用する場合には，上記の著作
+ *      権表示，この利用条件および下記の無保証規定が，そのままの形でソー
+ *      スコード中に含まれていること．
+ *  (2) 本ソフトウェアを，ライブラリ形式など，他のソフトウェア開発に使
+ *      用できる形で再配布する場合には，再配布に伴うドキュメント（利用
+ *      者マニュアルなど）に，上記の著作権表示，この利用条件および下記
+ *      の無保証規定を掲載すること．
+ *  (3) 本ソフトウェアを，機器に組み込むなど，他のソフトウェア開発に使
+ *      用できない形で再配布する場合には，次のいずれかの条件を満たすこ
+ *      と．
+ *    (a) 再配布に伴うドキュメント（利用者マニュアルなど）に，上記の著
+ *        作権表示，この利用条件および下記の無保証規定を掲載すること．
+ *    (b) 再配布の形態を，別に定める方法によって，TOPPERSプロジェクトに
+ *        報告すること．
+ *  (4) 本ソフトウェアの利用により直接的または間接的に生じるいかなる損
+ *      害からも，上記著作権者およびTOPPERSプロジェクトを免責すること．
+ *      また，本ソフトウェアのユーザまたはエンドユーザからのいかなる理
+ *      由に基づく請求からも，上記著作権者およびTOPPERSプロジェクトを
+ *      免責すること．
+ * 
+ *  本ソフトウェアは，無保証で提供されているものである．上記著作権者お
+ *  よびTOPPERSプロジェクトは，本ソフトウェアに関して，特定の使用目的
+ *  に対する適合性も含めて，いかなる保証も行わない．また，本ソフトウェ
+ *  アの利用により直接的または間接的に生じたいかなる損害に関しても，そ
+ *  の責任を負わない．
+ * 
+ *  $Id$
+ */
+
+/*
+ *		クロックガバナ
+ *
+ *  CPUの負荷に応じて，システムクロックを切り換えるシステムサービス．
+ *  負荷の高い期間は最も高いクロックで動作し，負荷が下がると，処理が間
+ *  に合う範囲で低いクロックに落とす．
+ *
+ *  負荷は，最低優先度のアイドルタスクが割込み待ち（GOVERNOR_IDLE_WAIT）
+ *  で過ごした時間を，性能評価用システム時刻（get_utm）で計測して求め
+ *  る．アイドルタスクは割込み待ちから戻る毎にレディキューを回転させる
+ *  ため，同じ優先度のタスクを置くこともできる．
+ *
+ *  ターゲット依存部は，TOPPERS_SUPPORT_GOVERNORを定義し，次のマクロを
+ *  target_syssvc.hに定義する．
+ *
+ *    GOVERNOR_LEVEL_TABLE	クロックのレベルの表（GOVLVLの初期化子）．
+ *							高いクロックから順に並べる．
+ *    GOVERNOR_SWITCH(lvl)	レベルのクロックに切り換える．タイムティッ
+ *							クを失わないこと．
+ *    GOVERNOR_IDLE_LOCK()	割込み待ちの前に全割込みを禁止する．
+ *    GOVERNOR_IDLE_WAIT()	割込みが要求されるまで待つ．
+ *    GOVERNOR_IDLE_UNLOCK()	全割込みを許可する．
+ */
+
+#ifndef TOPPERS_GOVERNOR_H
+#define TOPPERS_GOVERNOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "target_syssvc.h"
+
+/*
+ *  クロックガバナ関連の定数のデフォルト値の定義
+ */ 
+#ifndef GOVERNOR_PRIORITY
+#define GOVERNOR_PRIORITY		2		/* ガバナタスクの初期優先度 */
+#endif /* GOVERNOR_PRIORITY */
+
+#ifndef GOVERNOR_STACK_SIZE
+#define GOVERNOR_STACK_SIZE		512		/* ガバナタスクのスタックサイズ */
+#endif /* GOVERNOR_STACK_SIZE */
+
+#ifndef GOVERNOR_IDLE_PRIORITY
+#define GOVERNOR_IDLE_PRIORITY	TMAX_TPRI	/* アイドルタスクの初期優先度 */
+#endif /* GOVERNOR_IDLE_PRIORITY */
+
+#ifndef GOVERNOR_IDLE_STACK_SIZE
+#define GOVERNOR_IDLE_STACK_SIZE	256	/* アイドルタスクのスタックサイズ */
+#endif /* GOVERNOR_IDLE_STACK_SIZE */
+
+#ifndef GOVERNOR_INTERVAL
+#define GOVERNOR_INTERVAL		100U	/* 負荷の計測間隔（ミリ秒）*/
+#endif /* GOVERNOR_INTERVAL */
+
+#ifndef GOVERNOR_UP_LOAD
+#define GOVERNOR_UP_LOAD		80U		/* クロックを上げる負荷（%）*/
+#endif /* GOVERNOR_UP_LOAD */
+
+#ifndef GOVERNOR_DOWN_LOAD
+#define GOVERNOR_DOWN_LOAD		60U		/* クロックを下げた後の負荷の上限（%）*/
+#endif /* GOVERNOR_DOWN_LOAD */
+
+#ifndef GOVERNOR_DOWN_COUNT
+#define GOVERNOR_DOWN_COUNT		3U		/* クロックを下げるまでの計測回数 */
+#endif /* GOVERNOR_DOWN_COUNT */
+
+#ifndef TOPPERS_MACRO_ONLY
+
+/*
+ *  クロックのレベル
+ */
+typedef struct governor_level {
+	uint8_t		range;			/* GOVERNOR_SWITCHに渡す値 */
+	uint32_t	frequency;		/* クロック周波数（Hz）*/
+} GOVLVL;
+
+/*
+ *  クロックガバナの状態
+ */
+typedef struct t_governor_rgov {
+	uint_t		level;			/* 現在のレベル（0が最も高いクロック）*/
+	uint_t		load;			/* 直前の計測間隔の負荷（%）*/
+	uint_t		count;			/* クロックを切り換えた回数 */
+} T_GOVERNOR_RGOV;
+
+/*
+ *  クロックガバナの動作の許可／禁止
+ *
+ *  禁止すると，最も高いクロックに切り換えて固定する．
+ */
+extern ER	governor_ena(void) throw();
+extern ER	governor_dis(void) throw();
+
+/*
+ *  クロックガバナの状態参照
+ */
+extern ER	governor_ref(T_GOVERNOR_RGOV *pk_rgov) throw();
+
+/*
+ *  ガバナタスクの本体
+ */
+extern void	governor_main(intptr_t exinf) throw();
+
+/*
+ *  アイドルタスクの本体
+ */
+extern void	governor_idle(intptr_t exinf) throw();
+
+#endif /* TOPPERS_MACRO_ONLY */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TOPPERS_GOVERNOR_H */
@@ -45,6 +45,7 @@
  */
 
 #include <kernel.h>
+#include <sil.h>
 #include <t_syslog.h>
 #include "target_syssvc.h"
 #include "target_serial.h"
@@ -168,7 +169,7 @@ typedef struct serial_port_control_block {
 
 	uint_t	rcv_read_ptr;		/* 受信バッファ読出しポインタ */
 	uint_t	rcv_write_ptr;		/* 受信バッファ書込みポインタ */
-	uint_t	rcv_count;			/* 受信バッファ中の文字数 */
+	uint32_t	rcv_count;		/* 受信バッファ中の文字数 */
 	char	rcv_fc_chr;			/* 送るべきSTART/STOP */
 	bool_t	rcv_stopped;		/* STOPを送った状態か？ */
 
@@ -509,28 +510,34 @@ serial_rea_chr(SPCB *p_spcb, char *p_c)
 	bool_t	buffer_empty;
 	ER		ercd;
 
-	SVC(loc_cpu(), gen_ercd_sys(p_spcb));
-
 	/*
 	 *  受信バッファから文字を取り出す．
+	 *
+	 *  読出しポインタを操作するのはこの関数のみ（受信用セマフォで排他
+	 *  されている）であるため，CPUロック状態にする必要はない．受信バッ
+	 *  ファ中の文字数は受信通知コールバックと共有しているため，アトミッ
+	 *  ク操作で減算する．
 	 */
 	*p_c = p_spcb->p_spinib->rcv_buffer[p_spcb->rcv_read_ptr];
 	INC_PTR(p_spcb->rcv_read_ptr, p_spcb->p_spinib->rcv_bufsz);
-	p_spcb->rcv_count--;
-	buffer_empty = (p_spcb->rcv_count == 0U);
+	buffer_empty = (sil_atm_sub(&(p_spcb->rcv_count), 1U) == 1U);
 
 	/*
 	 *  STARTを送信する．
+	 *
+	 *  STOPを送った状態の場合のみ，CPUロック状態にしてSIOを操作する．
 	 */
-	if (p_spcb->rcv_stopped && p_spcb->rcv_count
+	if (p_spcb->rcv_stopped) {
+		SVC(loc_cpu(), gen_ercd_sys(p_spcb));
+		if (p_spcb->rcv_stopped && p_spcb->rcv_count
 								<= BUFCNT_START(p_spcb->p_spinib->rcv_bufsz)) {
-		if (!serial_snd_chr(p_spcb, FC_START)) {
-			p_spcb->rcv_fc_chr = FC_START;
+			if (!serial_snd_chr(p_spcb, FC_START)) {
+				p_spcb->rcv_fc_chr = FC_START;
+			}
+			p_spcb->rcv_stopped = false;
 		}
-		p_spcb->rcv_stopped = false;
+		SVC(unl_cpu(), gen_ercd_sys(p_spcb));
 	}
-
-	SVC(unl_cpu(), gen_ercd_sys(p_spcb));
 	ercd = (ER_BOOL) buffer_empty;
 
   error_exit:
@@ -106,8 +106,8 @@ static uint_t	syslog_lost;			/* 失われたログの数 */
 /*
  *  出力すべきログ情報の重要度（ビットマップ）
  */
-static uint_t	syslog_logmask;			/* ログバッファに記録すべき重要度 */
-static uint_t	syslog_lowmask_not;		/* 低レベル出力すべき重要度（反転）*/
+static uint32_t	syslog_logmask;			/* ログバッファに記録すべき重要度 */
+static uint32_t	syslog_lowmask_not;		/* 低レベル出力すべき重要度（反転）*/
 
 /*
  *  システムログ機能の初期化
@@ -134,6 +134,18 @@ syslog_wri_log(uint_t prio, const SYSLOG *p_syslog)
 	SIL_PRE_LOC;
 
 	LOG_SYSLOG_WRI_LOG_ENTER(prio, p_syslog);
+
+	/*
+	 *  ログバッファへの記録も低レベル出力も行わない場合には，全割込み
+	 *  ロック状態にせずにリターンする（マスクはアトミック操作で読み出
+	 *  す）．
+	 */
+	if ((sil_atm_rew(&syslog_logmask) & LOG_MASK(prio)) == 0U
+			&& (~sil_atm_rew(&syslog_lowmask_not) & LOG_MASK(prio)) == 0U) {
+		LOG_SYSLOG_WRI_LOG_LEAVE(E_OK);
+		return(E_OK);
+	}
+
 	SIL_LOC_INT();
 
 	/*
@@ -215,8 +227,8 @@ ER
 syslog_msk_log(uint_t logmask, uint_t lowmask)
 {
 	LOG_SYSLOG_MSK_LOG_ENTER(logmask, lowmask);
-	syslog_logmask = logmask;
-	syslog_lowmask_not = ~lowmask;
+	sil_atm_wrw(&syslog_logmask, logmask);
+	sil_atm_wrw(&syslog_lowmask_not, ~lowmask);
 	LOG_SYSLOG_MSK_LOG_LEAVE(E_OK);
 	return(E_OK);
 }
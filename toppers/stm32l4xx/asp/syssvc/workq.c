@@ -0,0 +1,234 @@
+/*
+ *  TOPPERS/ASP Kernel
+ *      Toyohashi Open Platform for Embedded Real-Time Systems/
+ *      Advanced Standard Profile Kernel
+ * 
+ *  Copyright (C) 2005-2011 by Embedded and Real-Time Systems Laboratory
+ *              Graduate School of Information Science, Nagoya Univ., JAPAN
+ *  Copyright (C) 2017-2018 by TOPPERS PROJECT Educational Working Group.
+ * 
+ *  上記著作権者は，以下の(1)〜(4)の条件を満たす場合に限り，本ソフトウェ
+ *  ア（本ソフトウェアを改変したものを含む．以下同じ）を使用・複製・改
+ *  変・再配布（以下，利用と呼ぶ）することを無償で許諾する．
+ *  (1) 本ソフトウェアをソースコードの形で利用する場合には，上記の著作
+ *      権表示，この利用条件および下記の無保証規定が，そのままの形でソー
+ *      スコード中に含まれていること．
+ *  (2) 本ソフトウェアを，ライブラリ形式など，他のソフトウェア開発に使
+ *      用できる形で再配布する場合には，再配布に伴うドキュメント（利用
+ *      者マニュアルなど）に，上記の著作権表示，この利用条件および下記
+ *      の無保証規定を掲載すること．
+ *  (3) 本ソフトウェアを，機器に組み込むなど，他のソフトウェア開発に使
+ *      用できない形で再配布する場合には，次のいずれかの条件を満たすこ
+ *      と．
+ *    (a) 再配布に伴うドキュメント（利用者マニュアルなど）に，上記の著
+ *        作権表示，この利用条件および下記の無保証規定を掲載すること．
+ *    (b) 再配布の形態を，別に定める方法によって，TOPPERSプロジェクトに
+ *        報告すること．
+ *  (4) 本ソフトウェアの利用により直接的または間接的に生じるいかなる損
+ *      害からも，上記著作権者およびTOPPERSプロジェクトを免責すること．
+ *      また，本ソフトウェアのユーザまたはエンドユーザからのいかなる理
+ *      由に基づく請求からも，上記著作権者およびTOPPERSプロジェクトを
+ *      免責すること．
+ * 
+ *  本ソフトウェアは，無保証で提供されているものである．上記著作権者お
+ *  よびTOPPERSプロジェクトは，本ソフトウェアに関して，特定の使用目的
+ *  に対する適合性も含めて，いかなる保証も行わない．また，本ソフトウェ
+ *  アの利用により直接的または間接的に生じたいかなる損害に関しても，そ
+ *  の責任を負わない．
+ * 
+ *  $Id$
+ */
+
+/*
+ *		ワークキュー
+ */
+
+#include <kernel.h>
+#include <sil.h>
+#include "workq.h"
+#include "kernel_cfg.h"
+
+#if (WORKQ_SIZE & (WORKQ_SIZE - 1U)) != 0U
+#error WORKQ_SIZE must be a power of 2.
+#endif /* (WORKQ_SIZE & (WORKQ_SIZE - 1U)) != 0U */
+
+/*
+ *  依頼のエントリ
+ *
+ *  seqは，エントリの状態を示すシーケンス番号である．登録位置posのエン
+ *  トリは，seqがposの場合に登録でき，pos+1の場合に取り出すことができ
+ *  る．取り出した後は，pos+WORKQ_SIZE（次の周回の登録位置）とする．
+ *  funcとexinfをseqより先に書き込むために，volatile修飾する．
+ */
+typedef struct workq_entry {
+	uint32_t			seq;		/* シーケンス番号 */
+	volatile WORKQ_FUNC	func;		/* 依頼する処理 */
+	volatile intptr_t	exinf;		/* 処理に渡す引数 */
+} WORKQ_ENTRY;
+
+/*
+ *  ワークキューのエリア
+ */
+static WORKQ_ENTRY	workq_buffer[WORKQ_SIZE];
+
+static uint32_t	workq_tail;			/* 次に登録する位置 */
+static uint32_t	workq_head;			/* 次に取り出す位置 */
+static uint32_t	workq_signaled;		/* セマフォを返却済み */
+static uint32_t	workq_ovrcnt;		/* 溢れた依頼の数 */
+
+/*
+ *  ワークキューの初期化
+ */
+void
+workq_initialize(intptr_t exinf)
+{
+	uint_t	i;
+
+	for (i = 0U; i < WORKQ_SIZE; i++) {
+		workq_buffer[i].seq = i;
+	}
+	workq_tail = 0U;
+	workq_head = 0U;
+	workq_signaled = 0U;
+	workq_ovrcnt = 0U;
+}
+
+/*
+ *  処理の依頼
+ *
+ *  登録位置をsil_atm_casで予約してから，エントリに書き込み，seqを更新
+ *  して登録を完了する．予約と完了の間に割り込んだ依頼も，別のエントリ
+ *  に登録される．ワーカタスクが取り出しを始めた後の最初の依頼でのみ，
+ *  セマフォを返却する．
+ */
+ER
+workq_submit(WORKQ_FUNC func, intptr_t exinf)
+{
+	WORKQ_ENTRY	*p_entry;
+	uint32_t	pos, seq;
+	ER			ercd;
+
+	if (func == NULL) {
+		return(E_PAR);
+	}
+
+	pos = sil_atm_rew(&workq_tail);
+	for (;;) {
+		p_entry = &(workq_buffer[pos & (WORKQ_SIZE - 1U)]);
+		seq = sil_atm_rew(&(p_entry->seq));
+		if (seq == pos) {
+			if (sil_atm_cas(&workq_tail, pos, pos + 1U)) {
+				break;
+			}
+		}
+		else if ((int32_t)(seq - pos) < 0) {
+			/*
+			 *  取り出されていないエントリに追いついた場合
+			 */
+			(void) sil_atm_add(&workq_ovrcnt, 1U);
+			return(E_QOVR);
+		}
+		pos = sil_atm_rew(&workq_tail);
+	}
+	p_entry->func = func;
+	p_entry->exinf = exinf;
+	sil_atm_wrw(&(p_entry->seq), pos + 1U);
+
+	/*
+	 *  セマフォを返却できなかった場合（CPUロック状態やカーネル起動前に
+	 *  呼ばれた場合）には，フラグを元に戻し，次の依頼で返却させる．
+	 */
+	if (sil_atm_cas(&workq_signaled, 0U, 1U)) {
+		if (sns_ctx()) {
+			ercd = isig_sem(WORKQ_SEM);
+		}
+		else {
+			ercd = sig_sem(WORKQ_SEM);
+		}
+		if (ercd != E_OK && MERCD(ercd) != E_QOVR) {
+			sil_atm_wrw(&workq_signaled, 0U);
+		}
+	}
+	return(E_OK);
+}
+
+/*
+ *  依頼の取出し
+ *
+ *  複数のワーカタスクが取り出す場合に備えて，取出し位置もsil_atm_cas
+ *  で更新する．先頭のエントリの登録が完了していない場合には，空とみな
+ *  す（登録を完了した依頼側が，セマフォを返却する）．
+ */
+static bool_t
+workq_take(WORKQ_FUNC *p_func, intptr_t *p_exinf)
+{
+	WORKQ_ENTRY	*p_entry;
+	uint32_t	pos, seq;
+
+	pos = sil_atm_rew(&workq_head);
+	for (;;) {
+		p_entry = &(workq_buffer[pos & (WORKQ_SIZE - 1U)]);
+		seq = sil_atm_rew(&(p_entry->seq));
+		if (seq == pos + 1U) {
+			if (sil_atm_cas(&workq_head, pos, pos + 1U)) {
+				break;
+			}
+		}
+		else if ((int32_t)(seq - (pos + 1U)) < 0) {
+			return(false);
+		}
+		pos = sil_atm_rew(&workq_head);
+	}
+	*p_func = p_entry->func;
+	*p_exinf = p_entry->exinf;
+	sil_atm_wrw(&(p_entry->seq), pos + WORKQ_SIZE);
+	return(true);
+}
+
+/*
+ *  ワークキューの状態参照
+ */
+ER
+workq_ref(T_WORKQ_RWQ *pk_rwq)
+{
+	pk_rwq->count = (uint_t)(sil_atm_rew(&workq_tail)
+										- sil_atm_rew(&workq_head));
+	pk_rwq->ovrcnt = (uint_t) sil_atm_rew(&workq_ovrcnt);
+	return(E_OK);
+}
+
+/*
+ *  ワーカタスクの本体
+ *
+ *  起床されると，ワークキューが空になるまで依頼を実行する．
+ *  WORKQ_BATCH個の依頼を実行する毎に，待っている他のワーカタスクを起
+ *  床し，同じ優先度のタスクに実行を譲る．セマフォを返却済みであること
+ *  を示すフラグは，取出しを始める前にクリアするため，取出し中に登録さ
+ *  れた依頼が取り残されることはない．
+ */
+void
+workq_main(intptr_t exinf)
+{
+	WORKQ_FUNC	func;
+	intptr_t	arg;
+	uint_t		count;
+
+	for (;;) {
+		if (wai_sem(WORKQ_SEM) != E_OK) {
+			continue;
+		}
+		do {
+			sil_atm_wrw(&workq_signaled, 0U);
+			for (count = 0U; count < WORKQ_BATCH; count++) {
+				if (!workq_take(&func, &arg)) {
+					break;
+				}
+				(*func)(arg);
+			}
+			if (count == WORKQ_BATCH) {
+				(void) sig_sem(WORKQ_SEM);
+				(void) rot_rdq(TPRI_SELF);
+			}
+		} while (count == WORKQ_BATCH);
+	}
+}
@@ -0,0 +1,136 @@
+/*
+ *  TOPPERS/ASP Kernel
+ *      Toyohashi Open Platform for Embedded Real-Time Systems/
+ *      Advanced Standard Profile Kernel
+ * 
+ *  Copyright (C) 2005-2011 by Embedded and Real-Time Systems Laboratory
+ *              Graduate School of Information Science, Nagoya Univ., JAPAN
+ *  Copyright (C) 2017-2018 by TOPPERS PROJECT Educational Working Group.
+ * 
+ *  上記著作権者は，以下の(1)〜(4)の条件を満たす場合に限り，本ソフトウェ
+ *  ア（本ソフトウェアを改変したものを含む．以下同じ）を使用・複製・改
+ *  変・再配布（以下，利用と呼ぶ）することを無償で許諾する．
+ *  (1) 本ソフトウェアをソースコードの形で利用する場合には，上記の著作
+ *      権表示，この利用条件および下記の無保証規定が，そのままの形でソー
+ *      スコード中に含まれていること．
+ *  (2) 本ソフトウェアを，ライブラリ形式など，他のソフトウェア開発に使
+ *      用できる形で再配布する場合には，再配布に伴うドキュメント（利用
+ *      者マニュアルなど）に，上記の著作権表示，この利用条件および下記
+ *      の無保証規定を掲載すること．
+ *  (3) 本ソフトウェアを，機器に組み込むなど，他のソフトウェア開発に使
+ *      用できない形で再配布する場合には，次のいずれかの条件を満たすこ
+ *      と．
+ *    (a) 再配布に伴うドキュメント（利用者マニュアルなど）に，上記の著
+ *        作権表示，この利用条件および下記の無保証規定を掲載すること．
+ *    (b) 再配布の形態を，別に定める方法によって，TOPPERSプロジェクトに
+ *        報告すること．
+ *  (4) 本ソフトウェアの利用により直接的または間接的に生じるいかなる損
+ *      害からも，上記著作権者およびTOPPERSプロジェクトを免責すること．
+ *      また，本ソフトウェアのユーザまたはエンドユーザからのいかなる理
+ *      由に基づく請求からも，上記著作権者およびTOPPERSプロジェクトを
+ *      免責すること．
+ * 
+ *  本ソフトウェアは，無保証で提供されているものである．上記著作権者お
+ *  よびTOPPERSプロジェクトは，本ソフトウェアに関して，特定の使用目的
+ *  に対する適合性も含めて，いかなる保証も行わない．また，本ソフトウェ
+ *  アの利用により直接的または間接的に生じたいかなる損害に関しても，そ
+ *  の責任を負わない．
+ * 
+ *  $Id$
+ */
+
+/*
+ *		ワークキュー
+ *
+ *  割込みハンドラなどから，処理（関数と引数の組）をワーカタスクに依頼
+ *  するためのシステムサービス．依頼された処理は，ワーカタスクがタスク
+ *  コンテキストで実行する．依頼ごとにタスクやカーネルオブジェクトを用
+ *  意する必要がない．
+ *
+ *  依頼はリングバッファに登録する．登録位置の予約と登録完了の通知を，
+ *  アトミック操作（sil_atm_cas）で行うため，依頼側は割込みを禁止せず，
+ *  待ち状態にもならない．ワーカタスクの起床には，セマフォ（WORKQ_SEM）
+ *  を用い，ワーカタスクが取り出しを始める前の依頼についてのみ，セマフォ
+ *  を返却する．
+ *
+ *  ワーカタスクは，workq.cfgが生成するもの（WORKQ_TASK）に加えて，
+ *  workq_mainをメインルーチンとするタスクを生成することで増やすことが
+ *  できる．優先度は任意である．
+ */
+
+#ifndef TOPPERS_WORKQ_H
+#define TOPPERS_WORKQ_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "target_syssvc.h"
+
+/*
+ *  ワークキュー関連の定数のデフォルト値の定義
+ */ 
+#ifndef WORKQ_PRIORITY
+#define WORKQ_PRIORITY		2		/* ワーカタスクの初期優先度 */
+#endif /* WORKQ_PRIORITY */
+
+#ifndef WORKQ_STACK_SIZE
+#define WORKQ_STACK_SIZE	1024	/* ワーカタスクのスタックサイズ */
+#endif /* WORKQ_STACK_SIZE */
+
+#ifndef WORKQ_SIZE
+#define WORKQ_SIZE			32U		/* 登録できる依頼の数（2のべき乗）*/
+#endif /* WORKQ_SIZE */
+
+#ifndef WORKQ_BATCH
+#define WORKQ_BATCH			8U		/* 続けて実行する依頼の数 */
+#endif /* WORKQ_BATCH */
+
+#ifndef TOPPERS_MACRO_ONLY
+
+/*
+ *  依頼する処理の型
+ */
+typedef void	(*WORKQ_FUNC)(intptr_t exinf);
+
+/*
+ *  ワークキューの状態
+ */
+typedef struct t_workq_rwq {
+	uint_t		count;			/* 登録されている依頼の数 */
+	uint_t		ovrcnt;			/* 溢れた依頼の数 */
+} T_WORKQ_RWQ;
+
+/*
+ *  処理の依頼
+ *
+ *  タスクコンテキストと非タスクコンテキストのいずれからも呼び出すこと
+ *  ができる．ワークキューが満杯の場合には，E_QOVRを返す．CPUロック状
+ *  態やカーネル起動前（初期化ルーチン中）に呼び出した場合，依頼は登録
+ *  されるが，ワーカタスクは起床されず，その後に他のコンテキストから依
+ *  頼した時に合わせて実行される．
+ */
+extern ER	workq_submit(WORKQ_FUNC func, intptr_t exinf) throw();
+
+/*
+ *  ワークキューの状態参照
+ */
+extern ER	workq_ref(T_WORKQ_RWQ *pk_rwq) throw();
+
+/*
+ *  ワークキューの初期化
+ */
+extern void	workq_initialize(intptr_t exinf) throw();
+
+/*
+ *  ワーカタスクの本体
+ */
+extern void	workq_main(intptr_t exinf) throw();
+
+#endif /* TOPPERS_MACRO_ONLY */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TOPPERS_WORKQ_H */
@@ -0,0 +1,28 @@
+$ 
+$ 		パス2のターゲット依存テンプレート（Linux用）
+$ 
+
+$ 
+$  ATT_ISRで使用できる割込み番号とそれに対応する割込みハンドラ番号
+$ 
+$  割込み番号と割込みハンドラ番号には，シグナル番号をそのまま用いる．
+$ 
+$INTNO_ATTISR_VALID = { 10;12;14;29;34,35,...,49 }$
+$INHNO_ATTISR_VALID = INTNO_ATTISR_VALID$
+
+$ 
+$  DEF_INT／DEF_EXCで使用できる割込みハンドラ番号／CPU例外ハンドラ番号
+$ 
+$INHNO_DEFINH_VALID = INTNO_ATTISR_VALID$
+$EXCNO_DEFEXC_VALID = { 4;5;7;8;11 }$
+
+$ 
+$  CFG_INTで使用できる割込み番号と割込み優先度
+$ 
+$INTNO_CFGINT_VALID = INTNO_ATTISR_VALID$
+$INTPRI_CFGINT_VALID = { -7,-6,...,-1 }$
+
+$ 
+$  標準テンプレートファイルのインクルード
+$ 
+$INCLUDE "kernel/kernel.tf"$
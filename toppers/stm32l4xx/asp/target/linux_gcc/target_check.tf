@@ -0,0 +1,6 @@
+$ 
+$ 		パス3のターゲット依存テンプレート（Linux用）
+$ 
+$  ホストのABIが関数とスタック領域のアラインメントを保証するため，パス
+$  3でのメモリ上の値のチェックは行わない．
+$ 
@@ -0,0 +1,258 @@
+/*
+ *  TOPPERS/ASP Kernel
+ *      Toyohashi Open Platform for Embedded Real-Time Systems/
+ *      Advanced Standard Profile Kernel
+ * 
+ *  Copyright (C) 2005-2011 by Embedded and Real-Time Systems Laboratory
+ *              Graduate School of Information Science, Nagoya Univ., JAPAN
+ *  Copyright (C) 2017-2018 by TOPPERS PROJECT Educational Working Group.
+ * 
+ *  上記著作権者は，以下の(1)〜(4)の条件を満たす場合に限り，本ソフトウェ
+ *  ア（本ソフトウェアを改変したものを含む．以下同じ）を使用・複製・改
+ *  変・再配布（以下，利用と呼ぶ）することを無償で許諾する．
+ *  (1) 本ソフトウェアをソースコードの形で利用する場合には，上記の著作
+ *      権表示，この利用条件および下記の無保証規定が，そのままの形でソー
+ *      スコード中に含まれていること．
+ *  (2) 本ソフトウェアを，ライブラリ形式など，他のソフトウェア開発に使
+ *      用できる形で再配布する場合には，再配布に伴うドキュメント（利用
+ *      者マニュアルなど）に，上記の著作権表示，この利用条件および下記
+ *      の無保証規定を掲載すること．
+ *  (3) 本ソフトウェアを，機器に組み込むなど，他のソフトウェア開発に使
+ *      用できない形で再配布する場合には，次のいずれかの条件を満たすこ
+ *      と．
+ *    (a) 再配布に伴うドキュメント（利用者マニュアルなど）に，上記の著
+ *        作権表示，この利用条件および下記の無保証規定を掲載すること．
+ *    (b) 再配布の形態を，別に定める方法によって，TOPPERSプロジェクトに
+ *        報告すること．
+ *  (4) 本ソフトウェアの利用により直接的または間接的に生じるいかなる損
+ *      害からも，上記著作権者およびTOPPERSプロジェクトを免責すること．
+ *      また，本ソフトウェアのユーザまたはエンドユーザからのいかなる理
+ *      由に基づく請求からも，上記著作権者およびTOPPERSプロジェクトを
+ *      免責すること．
+ * 
+ *  本ソフトウェアは，無保証で提供されているものである．上記著作権者お
+ *  よびTOPPERSプロジェクトは，本ソフトウェアに関して，特定の使用目的
+ *  に対する適合性も含めて，いかなる保証も行わない．また，本ソフトウェ
+ *  アの利用により直接的または間接的に生じたいかなる損害に関しても，そ
+ *  の責任を負わない．
+ * 
+ *  $Id$
+ */
+
+/*
+ *		シリアルI/Oデバイス（SIO）ドライバ（Linux用）
+ */
+
+#include <kernel.h>
+#include <t_syslog.h>
+#include "target_serial.h"
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <signal.h>
+
+/*
+ *  標準入出力のファイル記述子
+ */
+#define SIO_FD_RCV		0			/* 受信に用いるファイル記述子 */
+#define SIO_FD_SND		1			/* 送信に用いるファイル記述子 */
+
+/*
+ *  シリアルI/Oポート管理ブロックの定義
+ */
+struct sio_port_control_block {
+	intptr_t	exinf;			/* 拡張情報 */
+	bool_t		openflag;		/* オープン済みフラグ */
+	bool_t		sendflag;		/* 送信可能コールバック許可フラグ */
+	bool_t		getready;		/* 受信通知コールバック許可フラグ */
+	int_t		rcv_chr;		/* 受信した文字（ない時は-1） */
+};
+
+/*
+ *  シリアルI/Oポート管理ブロックのエリア
+ */
+static SIOPCB	siopcb_table[TNUM_SIOP];
+
+/*
+ *  シリアルI/OポートIDから管理ブロックを取り出すためのマクロ
+ */
+#define INDEX_SIOP(siopid)	((uint_t)((siopid) - 1))
+#define get_siopcb(siopid)	(&(siopcb_table[INDEX_SIOP(siopid)]))
+
+/*
+ *  1文字の受信
+ *
+ *  受信した文字をrcv_chrに読み込む．受信した文字がない場合にはfalseを
+ *  返す．
+ */
+static bool_t
+sio_getready(SIOPCB *p_siopcb)
+{
+	unsigned char	c;
+
+	if (p_siopcb->rcv_chr < 0) {
+		if (read(SIO_FD_RCV, &c, 1U) == 1) {
+			p_siopcb->rcv_chr = (int_t) c;
+		}
+	}
+	return(p_siopcb->rcv_chr >= 0);
+}
+
+/*
+ *  SIOドライバの初期化
+ */
+void
+sio_initialize(intptr_t exinf)
+{
+	SIOPCB	*p_siopcb;
+	uint_t	i;
+
+	for (p_siopcb = siopcb_table, i = 0; i < TNUM_SIOP; p_siopcb++, i++) {
+		p_siopcb->openflag = false;
+		p_siopcb->sendflag = false;
+		p_siopcb->getready = false;
+		p_siopcb->rcv_chr = -1;
+	}
+}
+
+/*
+ *  シリアルI/Oポートのオープン
+ *
+ *  標準入力をノンブロッキングモードにし，入力があった時にSIGIOが送ら
+ *  れるように設定する．
+ */
+SIOPCB *
+sio_opn_por(ID siopid, intptr_t exinf)
+{
+	SIOPCB	*p_siopcb = get_siopcb(siopid);
+	int		flags;
+	ER		ercd;
+
+	p_siopcb->exinf = exinf;
+	p_siopcb->openflag = true;
+
+	(void) fcntl(SIO_FD_RCV, F_SETOWN, getpid());
+	flags = fcntl(SIO_FD_RCV, F_GETFL);
+	(void) fcntl(SIO_FD_RCV, F_SETFL, flags | O_NONBLOCK | O_ASYNC);
+
+	/*
+	 *  シリアルI/O割込みのマスクを解除する．
+	 */
+	ercd = ena_int(INTNO_SIO);
+	assert(ercd == E_OK);
+	return(p_siopcb);
+}
+
+/*
+ *  シリアルI/Oポートのクローズ
+ */
+void
+sio_cls_por(SIOPCB *p_siopcb)
+{
+	int		flags;
+	ER		ercd;
+
+	flags = fcntl(SIO_FD_RCV, F_GETFL);
+	(void) fcntl(SIO_FD_RCV, F_SETFL, flags & ~(O_NONBLOCK | O_ASYNC));
+	p_siopcb->openflag = false;
+
+	/*
+	 *  シリアルI/O割込みをマスクする．
+	 */
+	ercd = dis_int(INTNO_SIO);
+	assert(ercd == E_OK);
+}
+
+/*
+ *  SIOの割込みサービスルーチン
+ *
+ *  SIGIOは入力が到着した時にのみ送られるため，受信できる文字がなくな
+ *  るまで受信通知コールバックを繰り返す．
+ */
+void
+sio_isr(intptr_t exinf)
+{
+	SIOPCB	*p_siopcb = get_siopcb(1);
+
+	while (p_siopcb->openflag) {
+		if (p_siopcb->sendflag) {
+			sio_irdy_snd(p_siopcb->exinf);
+		}
+		else if (p_siopcb->getready && sio_getready(p_siopcb)) {
+			sio_irdy_rcv(p_siopcb->exinf);
+		}
+		else {
+			break;
+		}
+	}
+}
+
+/*
+ *  シリアルI/Oポートへの文字送信
+ *
+ *  標準出力への書込みは常に完了させるため，送信可能コールバックが必要
+ *  になることはない．標準入力と標準出力が同じ端末を指す場合には，ノン
+ *  ブロッキングモードが標準出力にも及ぶため，EAGAINの場合は再試行する．
+ */
+bool_t
+sio_snd_chr(SIOPCB *p_siopcb, char c)
+{
+	while (write(SIO_FD_SND, &c, 1U) < 0) {
+		if (errno != EAGAIN && errno != EINTR) {
+			break;
+		}
+	}
+	return(true);
+}
+
+/*
+ *  シリアルI/Oポートからの文字受信
+ */
+int_t
+sio_rcv_chr(SIOPCB *p_siopcb)
+{
+	int_t	c;
+
+	if (sio_getready(p_siopcb)) {
+		c = p_siopcb->rcv_chr;
+		p_siopcb->rcv_chr = -1;
+		return(c);
+	}
+	return(-1);
+}
+
+/*
+ *  シリアルI/Oポートからのコールバックの許可
+ *
+ *  コールバックが許可された時点で受信済みの文字を取りこぼさないように，
+ *  SIGIOを自分自身に送る．
+ */
+void
+sio_ena_cbr(SIOPCB *p_siopcb, uint_t cbrtn)
+{
+	switch (cbrtn) {
+	case SIO_RDY_SND:
+		p_siopcb->sendflag = true;
+		break;
+	case SIO_RDY_RCV:
+		p_siopcb->getready = true;
+		break;
+	}
+	(void) kill(getpid(), SIGIO);
+}
+
+/*
+ *  シリアルI/Oポートからのコールバックの禁止
+ */
+void
+sio_dis_cbr(SIOPCB *p_siopcb, uint_t cbrtn)
+{
+	switch (cbrtn) {
+	case SIO_RDY_SND:
+		p_siopcb->sendflag = false;
+		break;
+	case SIO_RDY_RCV:
+		p_siopcb->getready = false;
+		break;
+	}
+}
@@ -0,0 +1,123 @@
+/*
+ *  TOPPERS/ASP Kernel
+ *      Toyohashi Open Platform for Embedded Real-Time Systems/
+ *      Advanced Standard Profile Kernel
+ * 
+ *  Copyright (C) 2005-2011 by Embedded and Real-Time Systems Laboratory
+ *              Graduate School of Information Science, Nagoya Univ., JAPAN
+ *  Copyright (C) 2017-2018 by TOPPERS PROJECT Educational Working Group.
+ * 
+ *  上記著作権者は，以下の(1)〜(4)の条件を満たす場合に限り，本ソフトウェ
+ *  ア（本ソフトウェアを改変したものを含む．以下同じ）を使用・複製・改
+ *  変・再配布（以下，利用と呼ぶ）することを無償で許諾する．
+ *  (1) 本ソフトウェアをソースコードの形で利用する場合には，上記の著作
+ *      権表示，この利用条件および下記の無保証規定が，そのままの形でソー
+ *      スコード中に含まれていること．
+ *  (2) 本ソフトウェアを，ライブラリ形式など，他のソフトウェア開発に使
+ *      用できる形で再配布する場合には，再配布に伴うドキュメント（利用
+ *      者マニュアルなど）に，上記の著作権表示，この利用条件および下記
+ *      の無保証規定を掲載すること．
+ *  (3) 本ソフトウェアを，機器に組み込むなど，他のソフトウェア開発に使
+ *      用できない形で再配布する場合には，次のいずれかの条件を満たすこ
+ *      と．
+ *    (a) 再配布に伴うドキュメント（利用者マニュアルなど）に，上記の著
+ *        作権表示，この利用条件および下記の無保証規定を掲載すること．
+ *    (b) 再配布の形態を，別に定める方法によって，TOPPERSプロジェクトに
+ *        報告すること．
+ *  (4) 本ソフトウェアの利用により直接的または間接的に生じるいかなる損
+ *      害からも，上記著作権者およびTOPPERSプロジェクトを免責すること．
+ *      また，本ソフトウェアのユーザまたはエンドユーザからのいかなる理
+ *      由に基づく請求からも，上記著作権者およびTOPPERSプロジェクトを
+ *      免責すること．
+ * 
+ *  本ソフトウェアは，無保証で提供されているものである．上記著作権者お
+ *  よびTOPPERSプロジェクトは，本ソフトウェアに関して，特定の使用目的
+ *  に対する適合性も含めて，いかなる保証も行わない．また，本ソフトウェ
+ *  アの利用により直接的または間接的に生じたいかなる損害に関しても，そ
+ *  の責任を負わない．
+ * 
+ *  $Id$
+ */
+
+/*
+ *		タイマドライバ（Linux用）
+ *
+ *  インターバルタイマ（ITIMER_REAL）を周期的に動作させ，その満了によ
+ *  るSIGALRMをタイマ割込みとして用いる．
+ */
+
+#ifndef TOPPERS_TARGET_TIMER_H
+#define TOPPERS_TARGET_TIMER_H
+
+#include <sil.h>
+
+/*
+ *  タイマ割込みハンドラ登録のための定数
+ */
+#define INHNO_TIMER		TINTNO_ALRM		/* 割込みハンドラ番号 */
+#define INTNO_TIMER		TINTNO_ALRM		/* 割込み番号 */
+#define INTPRI_TIMER	(-6)			/* 割込み優先度 */
+#define INTATR_TIMER	0U				/* 割込み属性 */
+
+#ifndef TOPPERS_MACRO_ONLY
+
+#include <sys/time.h>
+
+/*
+ *  タイマ値の内部表現の型
+ */
+typedef uint32_t	CLOCK;
+
+/*
+ *  タイマ値の内部表現とミリ秒・μ秒単位との変換
+ *
+ *  インターバルタイマの分解能は1μ秒である．
+ */
+#define TIMER_CLOCK				1000U
+#define TO_CLOCK(nume, deno)	((CLOCK)(TIMER_CLOCK * (nume) / (deno)))
+#define TO_USEC(clock)			(((SYSUTM) clock) * 1000U / TIMER_CLOCK)
+
+/*
+ *  タイマの起動処理
+ *
+ *  インターバルタイマを設定し，周期的なタイマ割込み要求を発生させる．
+ */
+extern void	target_timer_initialize(intptr_t exinf);
+
+/*
+ *  タイマの停止処理
+ */
+extern void	target_timer_terminate(intptr_t exinf);
+
+/*
+ *  タイマの現在値の読出し
+ *
+ *  インターバルタイマは満了までの残り時間を返すため，タイマ周期から引
+ *  いて，前回のタイマ割込みからの経過時間に変換する．
+ */
+Inline CLOCK
+target_timer_get_current(void)
+{
+	struct itimerval	itv;
+
+	(void) getitimer(ITIMER_REAL, &itv);
+	return(TO_CLOCK(TIC_NUME, TIC_DENO)
+			- (CLOCK)(itv.it_value.tv_sec * 1000000 + itv.it_value.tv_usec));
+}
+
+/*
+ *  タイマ割込み要求のチェック
+ */
+Inline bool_t
+target_timer_probe_int(void)
+{
+	return(x_probe_int(INTNO_TIMER));
+}
+
+/*
+ *  タイマ割込みハンドラ
+ */
+extern void	target_timer_handler(void);
+
+#endif /* TOPPERS_MACRO_ONLY */
+#endif /* TOPPERS_TARGET_TIMER_H */
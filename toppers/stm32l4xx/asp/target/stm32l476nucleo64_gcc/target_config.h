@@ -73,6 +73,28 @@
 #include "logtrace/trace_config.h"
 #endif /* TOPPERS_ENABLE_TRACE */
 
+/*
+ *  STOP2による省電力アイドルに関する設定
+ *
+ *  ディスパッチャのアイドル処理を，target_asm.incのtoppers_asm_custom_idle
+ *  に置き換える．
+ */
+#ifdef TOPPERS_STOP2_IDLE
+#define TOPPERS_CUSTOM_IDLE
+#endif /* TOPPERS_STOP2_IDLE */
+
+/*
+ *  SRAM2へのホットパス配置に関する設定
+ *
+ *  ベクタテーブルをSRAM2（.ramvector）にコピーして使用する．SRAM2は
+ *  コード領域にあるため，例外受付け時のベクタフェッチとSRAM1へのスタッ
+ *  ク積み上げが別のバスで並行して行われる．
+ */
+#ifdef TOPPERS_RAM_HOTPATH
+#define TOPPERS_RAM_VECTOR
+#define RAM_VECTOR_ATTRIBUTE	__attribute__((section(".ramvector"),aligned(512)))
+#endif /* TOPPERS_RAM_HOTPATH */
+
 #ifndef TOPPERS_MACRO_ONLY
 
 /*
@@ -85,6 +107,21 @@ extern uint32_t sysclock_init_value(void);
  */
 extern ER sysclock_change(uint8_t range);
 
+/*
+ *  実行中のシステムクロックの切換え
+ *
+ *  タイマドライバとシリアルポートを新しいクロックに合わせて再設定する．
+ */
+extern ER sysclock_switch(uint8_t range);
+
+#ifdef TOPPERS_STOP2_IDLE
+/*
+ *  STOP2アイドルの初期化とアイドル処理
+ */
+extern void target_idle_initialize(void);
+extern void target_custom_idle(void);
+#endif /* TOPPERS_STOP2_IDLE */
+
 #endif /* TOPPERS_MACRO_ONLY */
 
 
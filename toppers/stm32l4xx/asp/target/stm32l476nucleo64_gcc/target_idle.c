@@ -0,0 +1,308 @@
+/*
+ *  TOPPERS/ASP Kernel
+ *      Toyohashi Open Platform for Embedded Real-Time Systems/
+ *      Advanced Standard Profile Kernel
+ * 
+ *  Copyright (C) 2005-2011 by Embedded and Real-Time Systems Laboratory
+ *              Graduate School of Information Science, Nagoya Univ., JAPAN
+ *  Copyright (C) 2017-2018 by TOPPERS PROJECT Educational Working Group.
+ * 
+ *  上記著作権者は，以下の(1)〜(4)の条件を満たす場合に限り，本ソフトウェ
+ *  ア（本ソフトウェアを改変したものを含む．以下同じ）を使用・複製・改
+ *  変・再配布（以下，利用と呼ぶ）することを無償で許諾する．
+ *  (1) 本ソフトウェアをソースコードの形で利用する場合には，上記の著作
+ *      権表示，この利用条件および下記の無保証規定が，そのままの形でソー
+ *      スコード中に含まれていること．
+ *  (2) 本ソフトウェアを，ライブラリ形式など，他のソフトウェア開発に使
+ *      用できる形で再配布する場合には，再配布に伴うドキュメント（利用
+ *      者マニュアルなど）に，上記の著作権表示，この利用条件および下記
+ *      の無保証規定を掲載すること．
+ *  (3) 本ソフトウェアを，機器に組み込むなど，他のソフトウェア開発に使
+ *      用できない形で再配布する場合には，次のいずれかの条件を満たすこ
+ *      と．
+ *    (a) 再配布に伴うドキュメント（利用者マニュアルなど）に，上記の著
+ *        作権表示，この利用条件および下記の無保証規定を掲載すること．
+ *    (b) 再配布の形態を，別に定める方法によって，TOPPERSプロジェクトに
+ *        報告すること．
+ *  (4) 本ソフトウェアの利用により直接的または間接的に生じるいかなる損
+ *      害からも，上記著作権者およびTOPPERSプロジェクトを免責すること．
+ *      また，本ソフトウェアのユーザまたはエンドユーザからのいかなる理
+ *      由に基づく請求からも，上記著作権者およびTOPPERSプロジェクトを
+ *      免責すること．
+ * 
+ *  本ソフトウェアは，無保証で提供されているものである．上記著作権者お
+ *  よびTOPPERSプロジェクトは，本ソフトウェアに関して，特定の使用目的
+ *  に対する適合性も含めて，いかなる保証も行わない．また，本ソフトウェ
+ *  アの利用により直接的または間接的に生じたいかなる損害に関しても，そ
+ *  の責任を負わない．
+ * 
+ *  @(#) $Id$
+ */
+
+/*
+ *  STOP2による省電力アイドル処理（stm32l476-nucleo64用）
+ *
+ *  次のタイムイベントまでの時間が十分に長い場合に，SysTickを停止して
+ *  STOP2モードで割込みを待つ．STOP2中はLPTIM1で経過時間を計測し，そ
+ *  の時刻に起床する．起床後はシステムクロックをPLLに戻し，眠っていた
+ *  時間分だけシステム時刻と64ビットの性能評価用システム時刻を進め，
+ *  SysTickを同じ位相で再起動する．
+ */
+
+#include "kernel_impl.h"
+#include <sil.h>
+#include "time_event.h"
+#include "target_timer.h"
+#include "target_serial.h"
+
+#define sil_modw_mem(addr, mask, val)	sil_wrw_mem((addr), ((sil_rew_mem(addr) & ~(mask)) | (val)))
+#define sil_andw_mem(addr, mask)		sil_wrw_mem((addr), (sil_rew_mem(addr) & ~(mask)))
+#define sil_orw_mem(addr, val)			sil_wrw_mem((addr), (sil_rew_mem(addr) | (val)))
+
+#if TIC_NUME != 1U || TIC_DENO != 1U
+#error STOP2 idle supports 1ms time tick only.
+#endif /* TIC_NUME != 1U || TIC_DENO != 1U */
+
+/*
+ *  LPTIM1のクロック定義
+ *
+ *  RTCと同じ低速クロックを使用する．RTC_CLOCK_LSEを定義した場合はLSE，
+ *  そうでない場合はLSIとなる．
+ */
+#ifdef RTC_CLOCK_LSE
+#define STOP2_LPTIM_CLOCK      32768U
+#define STOP2_LPTIM_SEL        RCC_CCIPR_LPTIM1SEL
+#else /* RTC_CLOCK_LSE */
+#define STOP2_LPTIM_CLOCK      32000U
+#define STOP2_LPTIM_SEL        RCC_CCIPR_LPTIM1SEL_0
+#endif /* RTC_CLOCK_LSE */
+
+/*
+ *  STOP2に入る最小の待ち時間（単位: ミリ秒）
+ *
+ *  これより短い時間で次のタイムイベントが発生する場合は，通常のWFIで
+ *  待つ．STOP2からの復帰とPLLの再起動に要する時間より長くすること．
+ */
+#ifndef STOP2_MIN_TICKS
+#define STOP2_MIN_TICKS        3U
+#endif /* STOP2_MIN_TICKS */
+
+/*
+ *  1回のSTOP2で眠る最大時間（単位: ミリ秒）
+ *
+ *  LPTIMのカウンタは16ビットのため，約2秒が上限となる．
+ */
+#define STOP2_MAX_TICKS        ((0xFFFFU * 1000U) / STOP2_LPTIM_CLOCK - 1U)
+
+/*
+ *  LPTIMのレジスタ定義
+ */
+#define LPTIM_ISR_ARRM         0x00000002	/* Autoreload match */
+#define LPTIM_ISR_ARROK        0x00000010	/* Autoreload register update OK */
+#define LPTIM_ICR_ALL          0x0000007F	/* Clear all flags */
+#define LPTIM_IER_ARRMIE       0x00000002	/* Autoreload match Interrupt Enable */
+#define LPTIM_CR_ENABLE        0x00000001	/* LPTIM enable */
+#define LPTIM_CR_CNTSTRT       0x00000004	/* Timer start in continuous mode */
+
+#define LPTIM1_IRQ             (IRQ_VECTOR_LPTIM1 - 16)
+#define LPTIM1_NVIC_OFF        ((LPTIM1_IRQ / 32) * 4)
+#define LPTIM1_NVIC_BIT        (1U << (LPTIM1_IRQ % 32))
+
+#define SCB_ICSR_ISRPENDING    0x00400000	/* Interrupt pending flag */
+
+#define LSE_TIMEOUT_VALUE      (5000*1000)
+#define LSI_TIMEOUT_VALUE      (100*1000)
+
+/*
+ *  LPTIM1のカウンタの読出し
+ *
+ *  カウンタは非同期で更新されるため，2回続けて同じ値が読めるまで読み
+ *  直す．
+ */
+static uint32_t
+lptim_get_count(void)
+{
+	uint32_t cnt1, cnt2;
+
+	cnt2 = sil_rew_mem((uint32_t *)(TADR_LPTIM1_BASE+TOFF_LPTIM_CNT));
+	do {
+		cnt1 = cnt2;
+		cnt2 = sil_rew_mem((uint32_t *)(TADR_LPTIM1_BASE+TOFF_LPTIM_CNT));
+	} while (cnt1 != cnt2);
+	return cnt1;
+}
+
+/*
+ *  システムクロックのPLLへの復帰
+ *
+ *  STOP2からの起床時にはMSIが入床前のレンジで動作しているため，PLLを
+ *  起動してシステムクロックを切り換える．PLLの設定とFLASHのレイテンシ
+ *  はSTOP2中も保持されている．
+ */
+static void
+stop2_restore_pll(void)
+{
+	sil_orw_mem((uint32_t *)(TADR_RCC_BASE+TOFF_RCC_CR), RCC_CR_PLLON);
+	while((sil_rew_mem((uint32_t *)(TADR_RCC_BASE+TOFF_RCC_CR)) & RCC_CR_PLLRDY) == 0);
+	sil_modw_mem((uint32_t *)(TADR_RCC_BASE+TOFF_RCC_CFGR), RCC_CFGR_SW, RCC_CFGR_SW_PLL);
+	while((sil_rew_mem((uint32_t *)(TADR_RCC_BASE+TOFF_RCC_CFGR)) & RCC_CFGR_SWS) != RCC_CFGR_SWS_PLL);
+}
+
+/*
+ *  STOP2アイドルの初期化
+ *
+ *  LPTIM1のクロック源を起動し，STOP2をディープスリープ時の低消費電力
+ *  モードに設定する．LSEの起動には時間がかかるため，アイドル処理の中
+ *  ではなく，target_initializeから呼び出す．
+ */
+void
+target_idle_initialize(void)
+{
+	uint32_t tick = 0;
+	uint32_t pwren;
+
+	pwren = sil_rew_mem((uint32_t *)(TADR_RCC_BASE+TOFF_RCC_APB1ENR1)) & RCC_APB1ENR1_PWREN;
+	sil_orw_mem((uint32_t *)(TADR_RCC_BASE+TOFF_RCC_APB1ENR1), RCC_APB1ENR1_PWREN);
+
+#ifdef RTC_CLOCK_LSE
+	/*
+	 *  LSE ENABLE
+	 */
+	sil_orw_mem((uint32_t *)(TADR_PWR_BASE+TOFF_PWR_CR1), PWR_CR1_DBP);
+	sil_orw_mem((uint32_t *)(TADR_RCC_BASE+TOFF_RCC_BDCR), RCC_BDCR_LSEON);
+	while((sil_rew_mem((uint32_t *)(TADR_RCC_BASE+TOFF_RCC_BDCR)) & RCC_BDCR_LSERDY) == 0){
+		if(tick++ > LSE_TIMEOUT_VALUE)
+			break;
+		sil_dly_nse(1000);
+	}
+#else /* RTC_CLOCK_LSE */
+	/*
+	 *  LSI ENABLE
+	 */
+	sil_orw_mem((uint32_t *)(TADR_RCC_BASE+TOFF_RCC_CSR), RCC_CSR_LSION);
+	while((sil_rew_mem((uint32_t *)(TADR_RCC_BASE+TOFF_RCC_CSR)) & RCC_CSR_LSIRDY) == 0){
+		if(tick++ > LSI_TIMEOUT_VALUE)
+			break;
+		sil_dly_nse(1000);
+	}
+#endif /* RTC_CLOCK_LSE */
+
+	/*
+	 *  LPTIM1のクロック選択と初期設定
+	 */
+	sil_modw_mem((uint32_t *)(TADR_RCC_BASE+TOFF_RCC_CCIPR), RCC_CCIPR_LPTIM1SEL, STOP2_LPTIM_SEL);
+	sil_orw_mem((uint32_t *)(TADR_RCC_BASE+TOFF_RCC_APB1ENR1), RCC_APB1ENR1_LPTIM1EN);
+	sil_orw_mem((uint32_t *)(TADR_RCC_BASE+TOFF_RCC_APB1SMENR1), RCC_APB1SMENR1_LPTIM1SMEN);
+	sil_wrw_mem((uint32_t *)(TADR_LPTIM1_BASE+TOFF_LPTIM_CR), 0);
+	sil_wrw_mem((uint32_t *)(TADR_LPTIM1_BASE+TOFF_LPTIM_CFGR), 0);
+	sil_wrw_mem((uint32_t *)(TADR_LPTIM1_BASE+TOFF_LPTIM_IER), LPTIM_IER_ARRMIE);
+
+	/*
+	 *  ディープスリープ時の低消費電力モードをSTOP2に設定
+	 */
+	sil_modw_mem((uint32_t *)(TADR_PWR_BASE+TOFF_PWR_CR1), PWR_CR1_LPMS, PWR_CR1_LPMS_STOP2);
+	if(pwren == 0)
+		sil_andw_mem((uint32_t *)(TADR_RCC_BASE+TOFF_RCC_APB1ENR1), RCC_APB1ENR1_PWREN);
+}
+
+/*
+ *  STOP2による割込み待ち
+ *
+ *  ディスパッチャのアイドルループから，PRIMASKをセットし，BASEPRIを
+ *  全割込み許可とした状態で呼び出される．次のタイムイベントまでの時間
+ *  がSTOP2_MIN_TICKSより短い場合や，割込み要求が保留されている場合，
+ *  送信中のシリアルポートがある場合は，通常のWFIで割込みを待つ．
+ *
+ *  STOP2に入る場合は，タイムイベントが発生するタイムティックの前に起
+ *  床するようにLPTIM1を設定する．起床後，経過したタイムティック数だけ
+ *  next_timeを進めてからsignal_timeを呼び出し，システム時刻を補正する．
+ */
+void
+target_custom_idle(void)
+{
+	CLOCK    cyc, elapsed;
+	uint32_t left, cnt, slept, sws;
+	uint64_t total;
+
+	if (last_index > 0) {
+		left = (uint32_t)(tmevt_heap[0].time - next_time);
+	}
+	else {
+		left = STOP2_MAX_TICKS;
+	}
+	if (left > STOP2_MAX_TICKS) {
+		left = STOP2_MAX_TICKS;
+	}
+
+	if (left < STOP2_MIN_TICKS
+		|| (sil_rew_mem((uint32_t *)(TADR_SCB_BASE+TOFF_SCB_ICSR))
+								& (SCB_ICSR_ISRPENDING | NVIC_PENDSTSET)) != 0
+		|| chip_uart_busy()) {
+		Asm("wfi");
+		return;
+	}
+
+	/*
+	 *  SysTickを停止し，現在の周期の経過時間を記録する
+	 */
+	cyc = target_timer_cyc;
+	sil_wrw_mem((void *)SYSTIC_CONTROL_STATUS,
+					sil_rew_mem((void *)SYSTIC_CONTROL_STATUS) & ~SYSTIC_ENABLE);
+	elapsed = cyc - sil_rew_mem((void *)SYSTIC_CURRENT_VALUE);
+	if ((sil_rew_mem((uint32_t *)(TADR_SCB_BASE+TOFF_SCB_ICSR)) & NVIC_PENDSTSET) != 0) {
+		/*
+		 *  停止の直前にタイムティックが発生した場合は，STOP2に入らない
+		 */
+		target_timer_restart(elapsed);
+		return;
+	}
+
+	/*
+	 *  LPTIM1をleftミリ秒後に起床するように起動する
+	 */
+	cnt = left * STOP2_LPTIM_CLOCK / 1000U;
+	sil_wrw_mem((uint32_t *)(TADR_LPTIM1_BASE+TOFF_LPTIM_ICR), LPTIM_ICR_ALL);
+	sil_wrw_mem((uint32_t *)(TADR_LPTIM1_BASE+TOFF_LPTIM_CR), LPTIM_CR_ENABLE);
+	sil_wrw_mem((uint32_t *)(TADR_LPTIM1_BASE+TOFF_LPTIM_ARR), cnt);
+	while ((sil_rew_mem((uint32_t *)(TADR_LPTIM1_BASE+TOFF_LPTIM_ISR)) & LPTIM_ISR_ARROK) == 0) ;
+	sil_wrw_mem((uint32_t *)(TADR_LPTIM1_BASE+TOFF_LPTIM_ICR), LPTIM_ICR_ALL);
+	sil_orw_mem((uint32_t *)(TADR_LPTIM1_BASE+TOFF_LPTIM_CR), LPTIM_CR_CNTSTRT);
+	sil_wrw_mem((uint32_t *)(TADR_NVIC_BASE+TOFF_NVIC_ISER+LPTIM1_NVIC_OFF), LPTIM1_NVIC_BIT);
+
+	/*
+	 *  STOP2で割込みを待つ
+	 */
+	sws = sil_rew_mem((uint32_t *)(TADR_RCC_BASE+TOFF_RCC_CFGR)) & RCC_CFGR_SWS;
+	sil_orw_mem((uint32_t *)(TADR_SCB_BASE+TOFF_SCB_SCR), SCB_SCR_SLEEPDEEP_Msk);
+	Asm("dsb");
+	Asm("wfi");
+	sil_andw_mem((uint32_t *)(TADR_SCB_BASE+TOFF_SCB_SCR), SCB_SCR_SLEEPDEEP_Msk);
+	if (sws == RCC_CFGR_SWS_PLL) {
+		stop2_restore_pll();
+	}
+
+	/*
+	 *  眠っていた時間を読み出し，LPTIM1を停止する
+	 */
+	slept = lptim_get_count();
+	if ((sil_rew_mem((uint32_t *)(TADR_LPTIM1_BASE+TOFF_LPTIM_ISR)) & LPTIM_ISR_ARRM) != 0) {
+		slept = lptim_get_count() + cnt + 1U;
+	}
+	sil_wrw_mem((uint32_t *)(TADR_LPTIM1_BASE+TOFF_LPTIM_CR), 0);
+	sil_wrw_mem((uint32_t *)(TADR_LPTIM1_BASE+TOFF_LPTIM_ICR), LPTIM_ICR_ALL);
+	sil_wrw_mem((uint32_t *)(TADR_NVIC_BASE+TOFF_NVIC_ICER+LPTIM1_NVIC_OFF), LPTIM1_NVIC_BIT);
+	sil_wrw_mem((uint32_t *)(TADR_NVIC_BASE+TOFF_NVIC_ICPR+LPTIM1_NVIC_OFF), LPTIM1_NVIC_BIT);
+
+	/*
+	 *  経過したタイムティックだけシステム時刻を進め，残りの位相でSysTick
+	 *  を再起動する．起床はタイムイベントの発生するタイムティックの前で
+	 *  あるため，タイムイベントを飛び越すことはない．
+	 */
+	total = elapsed + (uint64_t) slept * cyc * 1000U / STOP2_LPTIM_CLOCK;
+	chip_utm64_reload((uint32_t)((uint64_t) slept * 1000000U / STOP2_LPTIM_CLOCK));
+	if (total / cyc > 0U) {
+		next_time += (EVTTIM)(total / cyc) - 1U;
+		signal_time();
+	}
+	target_timer_restart((CLOCK)(total % cyc));
+}
@@ -41,8 +41,12 @@
  *  @(#) $Id: target_inithook.c 698 2017-08-27 16:35:34Z roi $
  */
 
+#include <kernel.h>
 #include <sil.h>
 #include "stm32l4xx.h"
+#include "arm_m.h"
+#include "target_timer.h"
+#include "target_serial.h"
 
 /*
  *  初期化プログラム（stm32l476-nucleo64用）
@@ -609,6 +613,34 @@ sysclock_change(uint8_t range)
 		return SystemLowClock_Config(range);
 }
 
+/*
+ *  実行中のシステムクロック切換え
+ *
+ *  sysclock_changeでシステムクロックを変更し，タイマドライバのタイマ
+ *  周期とシリアルポートのボーレート，64ビットカウンタのプリスケーラを，
+ *  変更後のクロックに合わせて再設定する．タイムティックを失わないように，全体を割込みロック状態で実
+ *  行する．クロックの切換えは，タイマ周期（1ミリ秒）以内に完了する必
+ *  要がある．
+ */
+ER
+sysclock_switch(uint8_t range)
+{
+	uint32_t old_frequency;
+	ER       ercd;
+	SIL_PRE_LOC;
+
+	SIL_LOC_INT();
+	old_frequency = SystemFrequency;
+	ercd = sysclock_change(range);
+	if(SystemFrequency != old_frequency){
+		target_timer_change_clock();
+		chip_uart_change_clock();
+		chip_utm64_reload(0U);
+	}
+	SIL_UNL_INT();
+	return ercd;
+}
+
 
 #ifndef TOPPERS_RAM_EXEC
 /*
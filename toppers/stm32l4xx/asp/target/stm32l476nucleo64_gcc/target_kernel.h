@@ -58,4 +58,17 @@
  */
 #include "arm_m_gcc/stm32l4xx/chip_kernel.h"
 
+/*
+ *  SRAM2で実行する関数の指定
+ *
+ *  ENABLE_RAM_HOTPATH=trueでROM化した場合，TOPPERS_RAMTEXTを付けた関
+ *  数は起動時にSRAM2にコピーされ，そこで実行される．応答性が重要な割
+ *  込みハンドラ等に用いる．
+ */
+#ifdef TOPPERS_RAM_HOTPATH
+#define TOPPERS_RAMTEXT		__attribute__((section(".ramtext")))
+#else /* TOPPERS_RAM_HOTPATH */
+#define TOPPERS_RAMTEXT
+#endif /* TOPPERS_RAM_HOTPATH */
+
 #endif /* TOPPERS_TARGET_KERNEL_H */
@@ -119,4 +119,21 @@ extern void	target_fput_log(int8_t c);
  *  デフォルト値の通り．
  */
 
+/*
+ *  クロックガバナ関連の定義
+ *
+ *  負荷の高い期間だけPLL（80MHz）で動作し，それ以外はMSIの16MHzまた
+ *  は4MHzで動作する．各レベルは，sysclock_switchに渡すレンジと，その
+ *  周波数の組である（0はPLL）．
+ */
+#define TOPPERS_SUPPORT_GOVERNOR
+#define GOVERNOR_LEVEL_TABLE	{ { 0U, 80000000U }, { 8U, 16000000U }, \
+													{ 6U, 4000000U } }
+#define GOVERNOR_SWITCH(range)	sysclock_switch(range)
+#define GOVERNOR_IDLE_LOCK()	Asm("cpsid i" ::: "memory")
+#define GOVERNOR_IDLE_WAIT()	Asm("wfi" ::: "memory")
+#define GOVERNOR_IDLE_UNLOCK()	Asm("cpsie i" ::: "memory")
+
+extern ER	sysclock_switch(uint8_t range);
+
 #endif /* TOPPERS_TARGET_SYSSVC_H */
@@ -156,7 +156,7 @@ bit_task(ID tskid)
 		return(E_ID);
 	}
 	p_tcb = get_tcb(tskid);
-	p_tinib = p_tcb->p_tinib;
+	p_tinib = get_tinib(p_tcb);
 	tstat = p_tcb->tstat;
 	tstat_wait = (tstat & TS_WAIT_MASK);
 	pri = p_tcb->priority;
@@ -218,9 +218,15 @@ bit_task(ID tskid)
 	/*
 	 *  texptnの検査
 	 */
+#ifdef TOPPERS_COMPACT_TCB
+	if ((p_tinib->texrtn == NULL) != (p_tinib->p_texptn == NULL)) {
+		return(E_SYS_LINENO);
+	}
+#else /* TOPPERS_COMPACT_TCB */
 	if (p_tcb->p_tinib->texrtn == NULL && p_tcb->texptn != 0U) {
 		return(E_SYS_LINENO);
 	}
+#endif /* TOPPERS_COMPACT_TCB */
 
 	/*
 	 *  休止状態におけるチェック
@@ -229,7 +235,7 @@ bit_task(ID tskid)
 		if (!(pri == p_tinib->ipriority)
 					&& (p_tcb->wupque == false)
 					&& (p_tcb->enatex == false)
-					&& (p_tcb->texptn == 0U)) {
+					&& (p_tinib->texrtn == NULL || TSK_TEXPTN(p_tcb) == 0U)) {
 			return(E_SYS_LINENO);
 		}
 	}
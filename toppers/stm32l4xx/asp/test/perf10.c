@@ -0,0 +1,249 @@
+/*
+ *  TOPPERS Software
+ *      Toyohashi Open Platform for Embedded Real-Time Systems
+ * 
+ *  Copyright (C) 2006-2009 by Embedded and Real-Time Systems Laboratory
+ *              Graduate School of Information Science, Nagoya Univ., JAPAN
+ *  Copyright (C) 2017-2018 by TOPPERS PROJECT Educational Working Group.
+ * 
+ *  上記著作権者は，以下の(1)〜(4)の条件を満たす場合に限り，本ソフトウェ
+ *  ア（本ソフトウェアを改変したものを含む．以下同じ）を使用・複製・改
+ *  変・再配布（以下，利用と呼ぶ）することを無償で許諾する．
+ *  (1) 本ソフトウェアをソースコードの形で利用する場合には，上記の著作
+ *      権表示，この利用条件および下記の無保証規定が，そのままの形でソー
+ *      スコード中に含まれていること．
+ *  (2) 本ソフトウェアを，ライブラリ形式など，他のソフトウェア開発に使
+ *      用できる形で再配布する場合には，再配布に伴うドキュメント（利用
+ *      者マニュアルなど）に，上記の著作権表示，この利用条件および下記
+ *      の無保証規定を掲載すること．
+ *  (3) 本ソフトウェアを，機器に組み込むなど，他のソフトウェア開発に使
+ *      用できない形で再配布する場合には，次のいずれかの条件を満たすこ
+ *      と．
+ *    (a) 再配布に伴うドキュメント（利用者マニュアルなど）に，上記の著
+ *        作権表示，この利用条件および下記の無保証規定を掲載すること．
+ *    (b) 再配布の形態を，別に定める方法によって，TOPPERSプロジェクトに
+ *        報告すること．
+ *  (4) 本ソフトウェアの利用により直接的または間接的に生じるいかなる損
+ *      害からも，上記著作権者およびTOPPERSプロジェクトを免責すること．
+ *      また，本ソフトウェアのユーザまたはエンドユーザからのいかなる理
+ *      由に基づく請求からも，上記著作権者およびTOPPERSプロジェクトを
+ *      免責すること．
+ * 
+ *  本ソフトウェアは，無保証で提供されているものである．上記著作権者お
+ *  よびTOPPERSプロジェクトは，本ソフトウェアに関して，特定の使用目的
+ *  に対する適合性も含めて，いかなる保証も行わない．また，本ソフトウェ
+ *  アの利用により直接的または間接的に生じたいかなる損害に関しても，そ
+ *  の責任を負わない．
+ * 
+ *  $Id$
+ */
+
+/*
+ *		カーネル性能評価プログラム(10)
+ *
+ *  カーネル管理外の割込みの応答性を，サイクルカウンタを用いてサイクル
+ *  数で計測するためのプログラム．割込み要求を発生させてから，割込みハ
+ *  ンドラ（または割込みサービスルーチン）の先頭で時刻を取得するまでの
+ *  時間を，以下の条件で計測する．
+ *
+ *  (1) カーネル管理の割込みサービスルーチン（TEST_INTNO）
+ *  (2) カーネル管理外の割込みハンドラ（TEST_NKINTNO）
+ *  (3) CPUロック状態でのカーネル管理外の割込みハンドラ
+ *  (4) CPUロック状態（LOCK_DLY）でのカーネル管理の割込みサービスルー
+ *      チン
+ *
+ *  また，カーネル管理外の割込みハンドラからnkint_set_flgで通知して，イ
+ *  ベントフラグで待っているタスクが実行されるまでの時間を計測する．
+ */
+
+#include <kernel.h>
+#include <sil.h>
+#include <t_syslog.h>
+#include <test_lib.h>
+#include "kernel_cfg.h"
+#include "perf10.h"
+
+#ifndef TEST_GET_CYC
+#error TEST_GET_CYC is not supported.
+#endif /* TEST_GET_CYC */
+
+#if !defined(TEST_RAISE_INT) || !defined(TEST_NKINTNO)
+#error TEST_RAISE_INT and TEST_NKINTNO are required.
+#endif /* !defined(TEST_RAISE_INT) || !defined(TEST_NKINTNO) */
+
+#include "arm_m_gcc/common/core_nkint.h"
+
+/*
+ *  計測回数とCPUロック状態の時間
+ */
+#define NO_MEASURE	10000U			/* 計測回数 */
+#define LOCK_DLY	10000U			/* CPUロック状態の時間（nsec）*/
+
+/*
+ *  計測結果
+ */
+typedef struct {
+	uint32_t	min;				/* 最小値 */
+	uint32_t	max;				/* 最大値 */
+	uint32_t	sum;				/* 合計値 */
+} CYCSTAT;
+
+static void
+init_stat(CYCSTAT *p_stat)
+{
+	p_stat->min = UINT32_MAX;
+	p_stat->max = 0U;
+	p_stat->sum = 0U;
+}
+
+static void
+add_stat(CYCSTAT *p_stat, uint32_t cyc)
+{
+	if (cyc < p_stat->min) {
+		p_stat->min = cyc;
+	}
+	if (cyc > p_stat->max) {
+		p_stat->max = cyc;
+	}
+	p_stat->sum += cyc;
+}
+
+static void
+print_stat(const char *label, CYCSTAT *p_stat, uint32_t overhead)
+{
+	syslog_4(LOG_NOTICE, "%s: min %d, avg %d, max %d cycles", label,
+				p_stat->min - overhead,
+				p_stat->sum / NO_MEASURE - overhead,
+				p_stat->max - overhead);
+	syslog_flush();
+}
+
+/*
+ *  計測用の変数
+ *
+ *  cyc_endは，割込みハンドラ（または割込みサービスルーチン，計測タス
+ *  ク）が時刻を記録したことを示すために，記録後にdoneをtrueにする．
+ */
+static volatile uint32_t	cyc_end;
+static volatile bool_t		done;
+static volatile bool_t		relay;
+
+/*
+ *  カーネル管理の割込みサービスルーチン
+ */
+void isr1(intptr_t exinf)
+{
+	cyc_end = TEST_GET_CYC();
+	done = true;
+}
+
+/*
+ *  カーネル管理外の割込みハンドラ
+ *
+ *  サービスコールは呼び出さず，relayがtrueの場合には，nkint_set_flgに
+ *  よりタスクに通知する．
+ */
+void nkint_handler(void)
+{
+	if (relay) {
+		nkint_set_flg(0x01U);
+	}
+	else {
+		cyc_end = TEST_GET_CYC();
+		done = true;
+	}
+}
+
+/*
+ *  計測タスク
+ */
+void task1(intptr_t exinf)
+{
+	FLGPTN	flgptn;
+
+	while (true) {
+		(void) wai_flg(NKINT_FLG, 0x01U, TWF_ORW, &flgptn);
+		cyc_end = TEST_GET_CYC();
+		(void) clr_flg(NKINT_FLG, ~0x01U);
+		done = true;
+	}
+}
+
+/*
+ *  割込み要求を発生させて，処理されるまでの時間を計測する
+ */
+static void
+measure_int(CYCSTAT *p_stat, INTNO intno, bool_t lock)
+{
+	uint_t		i;
+	uint32_t	begin;
+
+	init_stat(p_stat);
+	for (i = 0; i < NO_MEASURE; i++) {
+		done = false;
+		if (lock) {
+			(void) loc_cpu();
+		}
+		begin = TEST_GET_CYC();
+		TEST_RAISE_INT(intno);
+		if (lock) {
+			sil_dly_nse(LOCK_DLY);
+			(void) unl_cpu();
+		}
+		while (!done) ;
+		add_stat(p_stat, cyc_end - begin);
+	}
+}
+
+/*
+ *  メインタスク
+ */
+void main_task(intptr_t exinf)
+{
+	uint_t		i;
+	uint32_t	begin, end, overhead;
+	CYCSTAT		stat_ovh, stat_isr, stat_nk, stat_nklock, stat_isrlock;
+	CYCSTAT		stat_relay;
+
+	syslog_0(LOG_NOTICE, "Performance evaluation program (10)");
+	syslog_2(LOG_NOTICE, "TMIN_INTPRI = %d, TEST_NKINTPRI = %d",
+										TMIN_INTPRI, TEST_NKINTPRI);
+	syslog_flush();
+	TEST_CYC_INIT();
+	(void) act_tsk(TASK1);
+
+	/*
+	 *  計測のオーバヘッド
+	 */
+	init_stat(&stat_ovh);
+	for (i = 0; i < NO_MEASURE; i++) {
+		begin = TEST_GET_CYC();
+		end = TEST_GET_CYC();
+		add_stat(&stat_ovh, end - begin);
+	}
+	overhead = stat_ovh.min;
+
+	/*
+	 *  割込みハンドラの実行開始までの時間
+	 */
+	measure_int(&stat_isr, TEST_INTNO, false);
+	measure_int(&stat_nk, TEST_NKINTNO, false);
+	measure_int(&stat_nklock, TEST_NKINTNO, true);
+	measure_int(&stat_isrlock, TEST_INTNO, true);
+
+	/*
+	 *  カーネル管理外の割込みからタスクの実行開始までの時間
+	 */
+	relay = true;
+	measure_int(&stat_relay, TEST_NKINTNO, false);
+	relay = false;
+
+	syslog_1(LOG_NOTICE, "Measurement overhead: %d cycles", overhead);
+	print_stat("ISR entry", &stat_isr, overhead);
+	print_stat("Non-kernel handler entry", &stat_nk, overhead);
+	print_stat("Non-kernel handler entry (CPU locked)",
+											&stat_nklock, overhead);
+	print_stat("ISR entry (CPU locked)", &stat_isrlock, overhead);
+	print_stat("Non-kernel handler to task", &stat_relay, overhead);
+	test_finish();
+}
@@ -0,0 +1,168 @@
+/*
+ *  TOPPERS Software
+ *      Toyohashi Open Platform for Embedded Real-Time Systems
+ * 
+ *  Copyright (C) 2006-2009 by Embedded and Real-Time Systems Laboratory
+ *              Graduate School of Information Science, Nagoya Univ., JAPAN
+ *  Copyright (C) 2017-2018 by TOPPERS PROJECT Educational Working Group.
+ * 
+ *  上記著作権者は，以下の(1)〜(4)の条件を満たす場合に限り，本ソフトウェ
+ *  ア（本ソフトウェアを改変したものを含む．以下同じ）を使用・複製・改
+ *  変・再配布（以下，利用と呼ぶ）することを無償で許諾する．
+ *  (1) 本ソフトウェアをソースコードの形で利用する場合には，上記の著作
+ *      権表示，この利用条件および下記の無保証規定が，そのままの形でソー
+ *      スコード中に含まれていること．
+ *  (2) 本ソフトウェアを，ライブラリ形式など，他のソフトウェア開発に使
+ *      用できる形で再配布する場合には，再配布に伴うドキュメント（利用
+ *      者マニュアルなど）に，上記の著作権表示，この利用条件および下記
+ *      の無保証規定を掲載すること．
+ *  (3) 本ソフトウェアを，機器に組み込むなど，他のソフトウェア開発に使
+ *      用できない形で再配布する場合には，次のいずれかの条件を満たすこ
+ *      と．
+ *    (a) 再配布に伴うドキュメント（利用者マニュアルなど）に，上記の著
+ *        作権表示，この利用条件および下記の無保証規定を掲載すること．
+ *    (b) 再配布の形態を，別に定める方法によって，TOPPERSプロジェクトに
+ *        報告すること．
+ *  (4) 本ソフトウェアの利用により直接的または間接的に生じるいかなる損
+ *      害からも，上記著作権者およびTOPPERSプロジェクトを免責すること．
+ *      また，本ソフトウェアのユーザまたはエンドユーザからのいかなる理
+ *      由に基づく請求からも，上記著作権者およびTOPPERSプロジェクトを
+ *      免責すること．
+ * 
+ *  本ソフトウェアは，無保証で提供されているものである．上記著作権者お
+ *  よびTOPPERSプロジェクトは，本ソフトウェアに関して，特定の使用目的
+ *  に対する適合性も含めて，いかなる保証も行わない．また，本ソフトウェ
+ *  アの利用により直接的または間接的に生じたいかなる損害に関しても，そ
+ *  の責任を負わない．
+ * 
+ *  $Id$
+ */
+
+/*
+ *		カーネル性能評価プログラム(5)
+ *
+ *  トレースログの書込み（trace_wri_log）1回あたりのオーバヘッドを，サ
+ *  イクルカウンタを用いてサイクル数で計測するためのプログラム．トレー
+ *  スログ機能を有効にしてビルドする必要がある（TOPPERS_TRACE_LOCKFREE
+ *  の有無で，ロックフリー版と割込み禁止版を比較できる）．
+ */
+
+#include <kernel.h>
+#include <t_syslog.h>
+#include <test_lib.h>
+#include "kernel_cfg.h"
+#include "perf5.h"
+
+#ifndef TOPPERS_ENABLE_TRACE
+#error perf5 requires the trace log facility (ENABLE_TRACE=true).
+#endif /* TOPPERS_ENABLE_TRACE */
+
+#ifndef TEST_GET_CYC
+#error TEST_GET_CYC is not supported.
+#endif /* TEST_GET_CYC */
+
+#include "logtrace/trace_config.h"
+
+/*
+ *  計測回数
+ */
+#define NO_MEASURE	10000U			/* 計測回数 */
+
+/*
+ *  計測結果
+ */
+typedef struct {
+	uint32_t	min;				/* 最小値 */
+	uint32_t	max;				/* 最大値 */
+	uint32_t	sum;				/* 合計値 */
+} CYCSTAT;
+
+static void
+init_stat(CYCSTAT *p_stat)
+{
+	p_stat->min = UINT32_MAX;
+	p_stat->max = 0U;
+	p_stat->sum = 0U;
+}
+
+static void
+add_stat(CYCSTAT *p_stat, uint32_t cyc)
+{
+	if (cyc < p_stat->min) {
+		p_stat->min = cyc;
+	}
+	if (cyc > p_stat->max) {
+		p_stat->max = cyc;
+	}
+	p_stat->sum += cyc;
+}
+
+static void
+print_stat(const char *label, CYCSTAT *p_stat, uint32_t overhead)
+{
+	syslog_4(LOG_NOTICE, "%s: min %d, avg %d, max %d cycles", label,
+				p_stat->min - overhead,
+				p_stat->sum / NO_MEASURE - overhead,
+				p_stat->max - overhead);
+	syslog_flush();
+}
+
+/*
+ *  メインタスク
+ */
+void main_task(intptr_t exinf)
+{
+	uint_t		i;
+	uint32_t	begin, end, overhead;
+	CYCSTAT		stat_ovh, stat_off, stat_on;
+
+	syslog_0(LOG_NOTICE, "Performance evaluation program (5)");
+#ifdef TOPPERS_TRACE_LOCKFREE
+	syslog_0(LOG_NOTICE, "trace_wri_log: lock-free version");
+#else /* TOPPERS_TRACE_LOCKFREE */
+	syslog_0(LOG_NOTICE, "trace_wri_log: interrupt-lock version");
+#endif /* TOPPERS_TRACE_LOCKFREE */
+	syslog_flush();
+	TEST_CYC_INIT();
+
+	/*
+	 *  計測のオーバヘッド
+	 */
+	init_stat(&stat_ovh);
+	for (i = 0; i < NO_MEASURE; i++) {
+		begin = TEST_GET_CYC();
+		end = TEST_GET_CYC();
+		add_stat(&stat_ovh, end - begin);
+	}
+	overhead = stat_ovh.min;
+
+	/*
+	 *  トレース停止中のトレースポイント
+	 */
+	(void) trace_sta_log(TRACE_STOP);
+	init_stat(&stat_off);
+	for (i = 0; i < NO_MEASURE; i++) {
+		begin = TEST_GET_CYC();
+		trace_2(LOG_TYPE_SVC|LOG_ENTER, i, 0);
+		end = TEST_GET_CYC();
+		add_stat(&stat_off, end - begin);
+	}
+
+	/*
+	 *  トレース記録中のトレースポイント
+	 */
+	(void) trace_sta_log(TRACE_RINGBUF|TRACE_CLEAR);
+	init_stat(&stat_on);
+	for (i = 0; i < NO_MEASURE; i++) {
+		begin = TEST_GET_CYC();
+		trace_2(LOG_TYPE_SVC|LOG_ENTER, i, 0);
+		end = TEST_GET_CYC();
+		add_stat(&stat_on, end - begin);
+	}
+	(void) trace_sta_log(TRACE_STOP);
+
+	syslog_1(LOG_NOTICE, "Measurement overhead: %d cycles", overhead);
+	print_stat("Trace point (trace stopped)", &stat_off, overhead);
+	print_stat("Trace point (trace recording)", &stat_on, overhead);
+	test_finish();
+}
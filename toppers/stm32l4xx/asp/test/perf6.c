@@ -0,0 +1,320 @@
+/*
+ *  TOPPERS Software
+ *      Toyohashi Open Platform for Embedded Real-Time Systems
+ * 
+ *  Copyright (C) 2006-2009 by Embedded and Real-Time Systems Laboratory
+ *              Graduate School of Information Science, Nagoya Univ., JAPAN
+ *  Copyright (C) 2017-2018 by TOPPERS PROJECT Educational Working Group.
+ * 
+ *  上記著作権者は，以下の(1)〜(4)の条件を満たす場合に限り，本ソフトウェ
+ *  ア（本ソフトウェアを改変したものを含む．以下同じ）を使用・複製・改
+ *  変・再配布（以下，利用と呼ぶ）することを無償で許諾する．
+ *  (1) 本ソフトウェアをソースコードの形で利用する場合には，上記の著作
+ *      権表示，この利用条件および下記の無保証規定が，そのままの形でソー
+ *      スコード中に含まれていること．
+ *  (2) 本ソフトウェアを，ライブラリ形式など，他のソフトウェア開発に使
+ *      用できる形で再配布する場合には，再配布に伴うドキュメント（利用
+ *      者マニュアルなど）に，上記の著作権表示，この利用条件および下記
+ *      の無保証規定を掲載すること．
+ *  (3) 本ソフトウェアを，機器に組み込むなど，他のソフトウェア開発に使
+ *      用できない形で再配布する場合には，次のいずれかの条件を満たすこ
+ *      と．
+ *    (a) 再配布に伴うドキュメント（利用者マニュアルなど）に，上記の著
+ *        作権表示，この利用条件および下記の無保証規定を掲載すること．
+ *    (b) 再配布の形態を，別に定める方法によって，TOPPERSプロジェクトに
+ *        報告すること．
+ *  (4) 本ソフトウェアの利用により直接的または間接的に生じるいかなる損
+ *      害からも，上記著作権者およびTOPPERSプロジェクトを免責すること．
+ *      また，本ソフトウェアのユーザまたはエンドユーザからのいかなる理
+ *      由に基づく請求からも，上記著作権者およびTOPPERSプロジェクトを
+ *      免責すること．
+ * 
+ *  本ソフトウェアは，無保証で提供されているものである．上記著作権者お
+ *  よびTOPPERSプロジェクトは，本ソフトウェアに関して，特定の使用目的
+ *  に対する適合性も含めて，いかなる保証も行わない．また，本ソフトウェ
+ *  アの利用により直接的または間接的に生じたいかなる損害に関しても，そ
+ *  の責任を負わない．
+ * 
+ *  $Id$
+ */
+
+/*
+ *		カーネル性能評価プログラム(6)
+ *
+ *  主なサービスコールの処理時間を，待ち解除を伴わない経路と，タスク切
+ *  換えを伴う経路のそれぞれについて計測し，割込み発生からタスクが実行
+ *  されるまでの時間とあわせて，print_hist_benchの形式で出力するための
+ *  プログラム．リリース間で結果を比較するために用いる．
+ *
+ *  タスク切換えを伴う経路の計測は，perf1と同様に，高優先度の計測タス
+ *  ク1が待ち状態の時に，中優先度の計測タスク2が待ち解除を行ってタスク
+ *  1に切り換わるまでの時間（wake）と，タスク1が待ち状態に入ってタスク
+ *  2に切り換わるまでの時間（block）を計測する．
+ */
+
+#include <kernel.h>
+#include <t_syslog.h>
+#include <test_lib.h>
+#include <histogram.h>
+#include "kernel_cfg.h"
+#include "perf6.h"
+
+/*
+ *  計測回数と実行時間分布を記録する最大時間
+ */
+#define NO_MEASURE	10000U			/* 計測回数 */
+#define HIST_BITS	12U				/* 4095までの時間を記録 */
+
+/*
+ *  実行時間分布を記録するメモリ領域
+ */
+static uint_t	histarea1[HIST_LOG_NBUCKET(HIST_BITS)];
+static uint_t	histarea2[HIST_LOG_NBUCKET(HIST_BITS)];
+
+/*
+ *  計測対象のオブジェクトに対する操作
+ */
+static T_MSG	msg1;
+static void		*blk1;
+
+static void
+wait_sem(void)
+{
+	wai_sem(SEM1);
+}
+
+static void
+signal_sem(void)
+{
+	sig_sem(SEM1);
+}
+
+static void
+wait_mbx(void)
+{
+	T_MSG	*p_msg;
+
+	rcv_mbx(MBX1, &p_msg);
+}
+
+static void
+signal_mbx(void)
+{
+	snd_mbx(MBX1, &msg1);
+}
+
+static void
+wait_mpf(void)
+{
+	get_mpf(MPF1, &blk1);
+}
+
+static void
+signal_mpf(void)
+{
+	rel_mpf(MPF1, blk1);
+}
+
+static void
+wait_pdq(void)
+{
+	intptr_t	data;
+	PRI			pri;
+
+	rcv_pdq(PDQ1, &data, &pri);
+}
+
+static void
+signal_pdq(void)
+{
+	snd_pdq(PDQ1, 0, 1);
+}
+
+static void
+lock_cpu(void)
+{
+	loc_cpu();
+}
+
+static void
+unlock_cpu(void)
+{
+	unl_cpu();
+}
+
+static void
+get_time(void)
+{
+	SYSTIM	systim;
+
+	get_tim(&systim);
+}
+
+/*
+ *  タスク切換えを伴う経路の計測で用いる操作
+ */
+static void		(*wait_func)(void);
+static void		(*signal_func)(void);
+
+/*
+ *  計測タスク1（高優先度）
+ */
+void task1(intptr_t exinf)
+{
+	uint_t	i;
+
+	(*wait_func)();
+	end_measure(1);
+	for (i = 1; i < NO_MEASURE; i++) {
+		begin_measure(2);
+		(*wait_func)();
+		end_measure(1);
+	}
+	begin_measure(2);
+	(*wait_func)();
+}
+
+/*
+ *  計測タスク2（中優先度）
+ */
+void task2(intptr_t exinf)
+{
+	uint_t	i;
+
+	for (i = 0; i < NO_MEASURE; i++) {
+		begin_measure(1);
+		(*signal_func)();
+		end_measure(2);
+	}
+	(*signal_func)();
+}
+
+/*
+ *  計測タスク3（高優先度）
+ */
+void task3(intptr_t exinf)
+{
+	uint_t	i;
+
+	for (i = 0; i < NO_MEASURE; i++) {
+		slp_tsk();
+		end_measure(2);
+	}
+}
+
+/*
+ *  割込みサービスルーチン
+ */
+void isr1(intptr_t exinf)
+{
+	end_measure(1);
+	begin_measure(2);
+	iwup_tsk(TASK3);
+}
+
+/*
+ *  計測用の分布記録領域の初期化
+ */
+static void
+init_measure(void)
+{
+	init_hist_log(1, HIST_BITS, histarea1);
+	init_hist_log(2, HIST_BITS, histarea2);
+}
+
+/*
+ *  待ち解除を伴わない経路の計測
+ *
+ *  func1とfunc2を交互に呼び出し，それぞれの処理時間を計測する．
+ */
+static void
+perf_nowait(void (*func1)(void), const char *name1,
+					void (*func2)(void), const char *name2)
+{
+	uint_t	i;
+
+	init_measure();
+	for (i = 0; i < NO_MEASURE; i++) {
+		begin_measure(1);
+		(*func1)();
+		end_measure(1);
+		if (func2 != NULL) {
+			begin_measure(2);
+			(*func2)();
+			end_measure(2);
+		}
+	}
+	print_hist_bench(1, name1);
+	if (func2 != NULL) {
+		print_hist_bench(2, name2);
+	}
+}
+
+/*
+ *  タスク切換えを伴う経路の計測
+ */
+static void
+perf_switch(void (*wait)(void), void (*signal)(void),
+						const char *wake_name, const char *block_name)
+{
+	wait_func = wait;
+	signal_func = signal;
+	init_measure();
+	act_tsk(TASK1);
+	act_tsk(TASK2);
+	print_hist_bench(1, wake_name);
+	print_hist_bench(2, block_name);
+}
+
+/*
+ *  メインタスク（低優先度）
+ */
+void main_task(intptr_t exinf)
+{
+	syslog_0(LOG_NOTICE, "Performance evaluation program (6)");
+	syslog_flush();
+
+	/*
+	 *  待ち解除を伴わない経路
+	 */
+	perf_nowait(signal_sem, "sig_sem", wait_sem, "wai_sem");
+	perf_nowait(signal_mbx, "snd_mbx", wait_mbx, "rcv_mbx");
+	perf_nowait(wait_mpf, "get_mpf", signal_mpf, "rel_mpf");
+	perf_nowait(signal_pdq, "snd_pdq", wait_pdq, "rcv_pdq");
+	perf_nowait(lock_cpu, "loc_cpu", unlock_cpu, "unl_cpu");
+	perf_nowait(get_time, "get_tim", NULL, NULL);
+
+	/*
+	 *  タスク切換えを伴う経路
+	 *
+	 *  固定長メモリプールは，メインタスクがブロックを獲得して空にして
+	 *  おく．
+	 */
+	perf_switch(wait_sem, signal_sem, "sig_sem_wake", "wai_sem_block");
+	perf_switch(wait_mbx, signal_mbx, "snd_mbx_wake", "rcv_mbx_block");
+	get_mpf(MPF1, &blk1);
+	perf_switch(wait_mpf, signal_mpf, "rel_mpf_wake", "get_mpf_block");
+	ini_mpf(MPF1);
+	perf_switch(wait_pdq, signal_pdq, "snd_pdq_wake", "rcv_pdq_block");
+
+	/*
+	 *  割込み発生から割込みサービスルーチンまでの時間（isr_entry）と，
+	 *  割込みサービスルーチンからタスクまでの時間（isr_task）
+	 */
+#ifdef TEST_RAISE_INT
+	{
+		uint_t	i;
+
+		init_measure();
+		act_tsk(TASK3);
+		for (i = 0; i < NO_MEASURE; i++) {
+			begin_measure(1);
+			TEST_RAISE_INT(TEST_INTNO);
+		}
+		print_hist_bench(1, "isr_entry");
+		print_hist_bench(2, "isr_task");
+	}
+#endif /* TEST_RAISE_INT */
+
+	test_finish();
+}
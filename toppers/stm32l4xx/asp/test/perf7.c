@@ -0,0 +1,338 @@
+/*
+ *  TOPPERS Software
+ *      Toyohashi Open Platform for Embedded Real-Time Systems
+ * 
+ *  Copyright (C) 2006-2009 by Embedded and Real-Time Systems Laboratory
+ *              Graduate School of Information Science, Nagoya Univ., JAPAN
+ *  Copyright (C) 2017-2018 by TOPPERS PROJECT Educational Working Group.
+ * 
+ *  上記著作権者は，以下の(1)〜(4)の条件を満たす場合に限り，本ソフトウェ
+ *  ア（本ソフトウェアを改変したものを含む．以下同じ）を使用・複製・改
+ *  変・再配布（以下，利用と呼ぶ）することを無償で許諾する．
+ *  (1) 本ソフトウェアをソースコードの形で利用する場合には，上記の著作
+ *      権表示，この利用条件および下記の無保証規定が，そのままの形でソー
+ *      スコード中に含まれていること．
+ *  (2) 本ソフトウェアを，ライブラリ形式など，他のソフトウェア開発に使
+ *      用できる形で再配布する場合には，再配布に伴うドキュメント（利用
+ *      者マニュアルなど）に，上記の著作権表示，この利用条件および下記
+ *      の無保証規定を掲載すること．
+ *  (3) 本ソフトウェアを，機器に組み込むなど，他のソフトウェア開発に使
+ *      用できない形で再配布する場合には，次のいずれかの条件を満たすこ
+ *      と．
+ *    (a) 再配布に伴うドキュメント（利用者マニュアルなど）に，上記の著
+ *        作権表示，この利用条件および下記の無保証規定を掲載すること．
+ *    (b) 再配布の形態を，別に定める方法によって，TOPPERSプロジェクトに
+ *        報告すること．
+ *  (4) 本ソフトウェアの利用により直接的または間接的に生じるいかなる損
+ *      害からも，上記著作権者およびTOPPERSプロジェクトを免責すること．
+ *      また，本ソフトウェアのユーザまたはエンドユーザからのいかなる理
+ *      由に基づく請求からも，上記著作権者およびTOPPERSプロジェクトを
+ *      免責すること．
+ * 
+ *  本ソフトウェアは，無保証で提供されているものである．上記著作権者お
+ *  よびTOPPERSプロジェクトは，本ソフトウェアに関して，特定の使用目的
+ *  に対する適合性も含めて，いかなる保証も行わない．また，本ソフトウェ
+ *  アの利用により直接的または間接的に生じたいかなる損害に関しても，そ
+ *  の責任を負わない．
+ * 
+ *  $Id$
+ */
+
+
+/*
+ *		カーネル性能評価プログラム(7)
+ *
+ *  Thread-Metricと同様の7つのシナリオについて，一定の計測期間
+ *  （TM_PERIOD，デフォルトは30秒）に実行できた操作の回数を計測し，他
+ *  のRTOSとスループットを比較するためのプログラム．シナリオを順に実行
+ *  し，それぞれの結果を次の形式で出力する．
+ *
+ *	bench,<シナリオ名>,ops,<計測期間（ミリ秒）>,<操作回数>
+ *
+ *  (1) tm_cooperative：同じ優先度の5つのタスクが，カウンタを更新して
+ *      rot_rdqで実行権を譲ることを繰り返す．
+ *  (2) tm_preemptive：優先度の異なる5つのタスクが，wup_tskで1つ高い
+ *      優先度のタスクを起床し，slp_tskで待ち状態に入ることを繰り返す．
+ *  (3) tm_interrupt：タスクが割込みを発生させ，割込みサービスルーチン
+ *      がisig_semで返却したセマフォをwai_semで獲得することを繰り返す．
+ *  (4) tm_interrupt_preemption：低優先度のタスクが割込みを発生させ，
+ *      割込みサービスルーチンがiwup_tskで高優先度のタスクを起床するこ
+ *      とを繰り返す．
+ *  (5) tm_message：16バイトのメッセージをデータキューに送信し，受信す
+ *      ることを繰り返す．
+ *  (6) tm_semaphore：セマフォの獲得と返却を繰り返す．
+ *  (7) tm_memory：128バイトのメモリブロックの獲得と返却を繰り返す．
+ *
+ *  (3)と(4)は，ターゲット依存部がTEST_RAISE_INTを定義している場合に
+ *  のみ実行する．Thread-Metricではメッセージをコピーで受け渡すため，
+ *  (5)ではメッセージをintptr_t単位に分割してデータキューで送る．
+ */
+
+#include <kernel.h>
+#include <t_syslog.h>
+#include <test_lib.h>
+#include "kernel_cfg.h"
+#include "perf7.h"
+
+/*
+ *  シナリオの番号
+ */
+#define TM_COOPERATIVE			1
+#define TM_PREEMPTIVE			2
+#define TM_INTERRUPT			3
+#define TM_INTERRUPT_PREEMPTION	4
+#define TM_MESSAGE				5
+#define TM_SEMAPHORE			6
+#define TM_MEMORY				7
+
+/*
+ *  実行中のシナリオと各計測タスクの操作回数
+ */
+static volatile uint_t	tm_scenario;
+static volatile uint_t	tm_counter[NUM_TM_TASK];
+
+/*
+ *  計測タスクのID
+ */
+static const ID	tm_tskid[NUM_TM_TASK] = { TASK1, TASK2, TASK3, TASK4, TASK5 };
+
+/*
+ *  送受信するメッセージ
+ */
+#define TM_MSG_NDATA	(TM_MSG_SIZE / sizeof(intptr_t))
+
+static intptr_t	tm_msg[TM_MSG_NDATA];
+
+/*
+ *  (1) 協調スケジューリング
+ */
+static void
+tm_cooperative(uint_t idx)
+{
+	while (true) {
+		tm_counter[idx]++;
+		rot_rdq(TPRI_SELF);
+	}
+}
+
+/*
+ *  (2) プリエンプティブスケジューリング
+ *
+ *  最も低い優先度の計測タスク5が，1つ高い優先度のタスクを起床する．起
+ *  床されたタスクは，さらに1つ高い優先度のタスクを起床してから操作回
+ *  数を更新し，待ち状態に入る．
+ */
+static void
+tm_preemptive(uint_t idx)
+{
+	while (true) {
+		if (idx < NUM_TM_TASK - 1) {
+			slp_tsk();
+		}
+		if (idx > 0) {
+			wup_tsk(tm_tskid[idx - 1]);
+		}
+		tm_counter[idx]++;
+	}
+}
+
+/*
+ *  (3) 割込み処理
+ */
+static void
+tm_interrupt(uint_t idx)
+{
+#ifdef TEST_RAISE_INT
+	while (true) {
+		TEST_RAISE_INT(TEST_INTNO);
+		wai_sem(SEM2);
+		tm_counter[idx]++;
+	}
+#endif /* TEST_RAISE_INT */
+}
+
+/*
+ *  (4) 割込みプリエンプション処理
+ *
+ *  計測タスク2が割込みを発生させ，割込みサービスルーチンが高優先度の
+ *  計測タスク1を起床する．
+ */
+static void
+tm_interrupt_preemption(uint_t idx)
+{
+#ifdef TEST_RAISE_INT
+	while (true) {
+		if (idx == 0) {
+			slp_tsk();
+		}
+		else {
+			TEST_RAISE_INT(TEST_INTNO);
+		}
+		tm_counter[idx]++;
+	}
+#endif /* TEST_RAISE_INT */
+}
+
+/*
+ *  (5) メッセージの受渡し
+ */
+static void
+tm_message(uint_t idx)
+{
+	intptr_t	data;
+	uint_t		i;
+
+	while (true) {
+		for (i = 0; i < TM_MSG_NDATA; i++) {
+			snd_dtq(DTQ1, tm_msg[i]);
+		}
+		for (i = 0; i < TM_MSG_NDATA; i++) {
+			rcv_dtq(DTQ1, &data);
+			if (data != tm_msg[i]) {
+				syslog_0(LOG_ERROR, "## message mismatch.");
+				test_finish();
+			}
+		}
+		tm_counter[idx]++;
+	}
+}
+
+/*
+ *  (6) セマフォによる同期
+ */
+static void
+tm_semaphore(uint_t idx)
+{
+	while (true) {
+		wai_sem(SEM1);
+		sig_sem(SEM1);
+		tm_counter[idx]++;
+	}
+}
+
+/*
+ *  (7) メモリブロックの獲得と返却
+ */
+static void
+tm_memory(uint_t idx)
+{
+	void	*blk;
+
+	while (true) {
+		get_mpf(MPF1, &blk);
+		rel_mpf(MPF1, blk);
+		tm_counter[idx]++;
+	}
+}
+
+/*
+ *  計測タスク
+ */
+void tm_task(intptr_t exinf)
+{
+	uint_t	idx = (uint_t) exinf;
+
+	switch (tm_scenario) {
+	case TM_COOPERATIVE:
+		tm_cooperative(idx);
+		break;
+	case TM_PREEMPTIVE:
+		tm_preemptive(idx);
+		break;
+	case TM_INTERRUPT:
+		tm_interrupt(idx);
+		break;
+	case TM_INTERRUPT_PREEMPTION:
+		tm_interrupt_preemption(idx);
+		break;
+	case TM_MESSAGE:
+		tm_message(idx);
+		break;
+	case TM_SEMAPHORE:
+		tm_semaphore(idx);
+		break;
+	case TM_MEMORY:
+		tm_memory(idx);
+		break;
+	}
+}
+
+/*
+ *  割込みサービスルーチン
+ */
+void isr1(intptr_t exinf)
+{
+	if (tm_scenario == TM_INTERRUPT) {
+		isig_sem(SEM2);
+	}
+	else if (tm_scenario == TM_INTERRUPT_PREEMPTION) {
+		iwup_tsk(TASK1);
+	}
+}
+
+/*
+ *  シナリオの実行
+ *
+ *  first〜lastの計測タスクを起動し，計測期間の経過後に強制終了させて，
+ *  操作回数の合計を出力する．メインタスクは最高優先度であるため，計測
+ *  タスクが実行を始めるのは，メインタスクがdly_tskで待ち状態に入って
+ *  からである．
+ */
+static void
+tm_run(uint_t scenario, const char *name, uint_t first, uint_t last)
+{
+	uint_t	i, total;
+
+	tm_scenario = scenario;
+	for (i = 0; i < NUM_TM_TASK; i++) {
+		tm_counter[i] = 0U;
+	}
+	for (i = first; i <= last; i++) {
+		act_tsk(tm_tskid[i]);
+		if (scenario == TM_COOPERATIVE) {
+			chg_pri(tm_tskid[i], COOP_PRIORITY);
+		}
+	}
+
+	dly_tsk(TM_PERIOD);
+
+	total = 0U;
+	for (i = first; i <= last; i++) {
+		ter_tsk(tm_tskid[i]);
+		total += tm_counter[i];
+	}
+	ini_sem(SEM1);
+	ini_sem(SEM2);
+	ini_dtq(DTQ1);
+	ini_mpf(MPF1);
+
+	syslog_3(LOG_NOTICE, "bench,%s,ops,%u,%u", name, TM_PERIOD, total);
+	syslog_flush();
+}
+
+/*
+ *  メインタスク（最高優先度）
+ */
+void main_task(intptr_t exinf)
+{
+	uint_t	i;
+
+	syslog_0(LOG_NOTICE, "Performance evaluation program (7)");
+	syslog_flush();
+
+	for (i = 0; i < TM_MSG_NDATA; i++) {
+		tm_msg[i] = (intptr_t)(i + 1);
+	}
+
+	tm_run(TM_COOPERATIVE, "tm_cooperative", 0, NUM_TM_TASK - 1);
+	tm_run(TM_PREEMPTIVE, "tm_preemptive", 0, NUM_TM_TASK - 1);
+#ifdef TEST_RAISE_INT
+	tm_run(TM_INTERRUPT, "tm_interrupt", 0, 0);
+	tm_run(TM_INTERRUPT_PREEMPTION, "tm_interrupt_preemption", 0, 1);
+#endif /* TEST_RAISE_INT */
+	tm_run(TM_MESSAGE, "tm_message", 0, 0);
+	tm_run(TM_SEMAPHORE, "tm_semaphore", 0, 0);
+	tm_run(TM_MEMORY, "tm_memory", 0, 0);
+
+	test_finish();
+}
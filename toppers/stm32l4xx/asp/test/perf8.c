@@ -0,0 +1,426 @@
+/*
+ *  TOPPERS Software
+ *      Toyohashi Open Platform for Embedded Real-Time Systems
+ * 
+ *  Copyright (C) 2006-2009 by Embedded and Real-Time Systems Laboratory
+ *              Graduate School of Information Science, Nagoya Univ., JAPAN
+ *  Copyright (C) 2017-2018 by TOPPERS PROJECT Educational Working Group.
+ * 
+ *  上記著作権者は，以下の(1)〜(4)の条件を満たす場合に限り，本ソフトウェ
+ *  ア（本ソフトウェアを改変したものを含む．以下同じ）を使用・複製・改
+ *  変・再配布（以下，利用と呼ぶ）することを無償で許諾する．
+ *  (1) 本ソフトウェアをソースコードの形で利用する場合には，上記の著作
+ *      権表示，この利用条件および下記の無保証規定が，そのままの形でソー
+ *      スコード中に含まれていること．
+ *  (2) 本ソフトウェアを，ライブラリ形式など，他のソフトウェア開発に使
+ *      用できる形で再配布する場合には，再配布に伴うドキュメント（利用
+ *      者マニュアルなど）に，上記の著作権表示，この利用条件および下記
+ *      の無保証規定を掲載すること．
+ *  (3) 本ソフトウェアを，機器に組み込むなど，他のソフトウェア開発に使
+ *      用できない形で再配布する場合には，次のいずれかの条件を満たすこ
+ *      と．
+ *    (a) 再配布に伴うドキュメント（利用者マニュアルなど）に，上記の著
+ *        作権表示，この利用条件および下記の無保証規定を掲載すること．
+ *    (b) 再配布の形態を，別に定める方法によって，TOPPERSプロジェクトに
+ *        報告すること．
+ *  (4) 本ソフトウェアの利用により直接的または間接的に生じるいかなる損
+ *      害からも，上記著作権者およびTOPPERSプロジェクトを免責すること．
+ *      また，本ソフトウェアのユーザまたはエンドユーザからのいかなる理
+ *      由に基づく請求からも，上記著作権者およびTOPPERSプロジェクトを
+ *      免責すること．
+ * 
+ *  本ソフトウェアは，無保証で提供されているものである．上記著作権者お
+ *  よびTOPPERSプロジェクトは，本ソフトウェアに関して，特定の使用目的
+ *  に対する適合性も含めて，いかなる保証も行わない．また，本ソフトウェ
+ *  アの利用により直接的または間接的に生じたいかなる損害に関しても，そ
+ *  の責任を負わない．
+ * 
+ *  $Id$
+ */
+
+
+/*
+ *		カーネル性能評価プログラム(8)
+ *
+ *  CMSIS-RTOS API層（syssvc/cmsis_os.c）のオーバヘッドを評価するため
+ *  に，CMSIS-RTOS APIと，それが対応するサービスコールの処理時間を交互
+ *  に計測し，print_hist_benchの形式で出力するプログラム．両者の差が，
+ *  API層によって加わる処理時間である．
+ *
+ *  タスク切換えを伴う経路として，perf6と同様に，メッセージキューの送
+ *  信による待ち解除（wake）と，受信による待ち（block）も計測する．
+ */
+
+#include <kernel.h>
+#include <t_syslog.h>
+#include <test_lib.h>
+#include <histogram.h>
+#include "kernel_cfg.h"
+#include "perf8.h"
+
+/*
+ *  計測回数と実行時間分布を記録する最大時間
+ */
+#define NO_MEASURE	10000U			/* 計測回数 */
+#define HIST_BITS	12U				/* 4095までの時間を記録 */
+
+/*
+ *  実行時間分布を記録するメモリ領域
+ */
+static uint_t	histarea1[HIST_LOG_NBUCKET(HIST_BITS)];
+static uint_t	histarea2[HIST_LOG_NBUCKET(HIST_BITS)];
+
+/*
+ *  CMSIS-RTOS APIのオブジェクトの定義
+ */
+osSemaphoreDef(SEM1);
+osMessageQDef(DTQ1, 1, uint32_t);
+osTimerDef(ALM1, NULL);
+osTimerDef(CYC1, NULL);
+#ifdef TOPPERS_SUPPORT_MUTEX
+osMutexDef(MTX1);
+#endif /* TOPPERS_SUPPORT_MUTEX */
+
+static osSemaphoreId	sem1_id;
+static osMessageQId		dtq1_id;
+static osTimerId		alm1_id;
+static osTimerId		cyc1_id;
+#ifdef TOPPERS_SUPPORT_MUTEX
+static osMutexId		mtx1_id;
+#endif /* TOPPERS_SUPPORT_MUTEX */
+
+/*
+ *  CMSIS-RTOS APIによる操作
+ */
+static void
+cmsis_sem_release(void)
+{
+	osSemaphoreRelease(sem1_id);
+}
+
+static void
+cmsis_sem_wait(void)
+{
+	osSemaphoreWait(sem1_id, 0U);
+}
+
+static void
+cmsis_msg_put(void)
+{
+	osMessagePut(dtq1_id, 0U, 0U);
+}
+
+static void
+cmsis_msg_get(void)
+{
+	osMessageGet(dtq1_id, 0U);
+}
+
+static void
+cmsis_msg_get_forever(void)
+{
+	osMessageGet(dtq1_id, osWaitForever);
+}
+
+static void
+cmsis_alm_start(void)
+{
+	osTimerStart(alm1_id, 1000U);
+}
+
+static void
+cmsis_alm_stop(void)
+{
+	osTimerStop(alm1_id);
+}
+
+static void
+cmsis_cyc_start(void)
+{
+	osTimerStart(cyc1_id, 1000U);
+}
+
+static void
+cmsis_cyc_stop(void)
+{
+	osTimerStop(cyc1_id);
+}
+
+static void
+cmsis_yield(void)
+{
+	osThreadYield();
+}
+
+static void
+cmsis_get_id(void)
+{
+	osThreadGetId();
+}
+
+#ifdef TOPPERS_SUPPORT_MUTEX
+
+static void
+cmsis_mtx_wait(void)
+{
+	osMutexWait(mtx1_id, osWaitForever);
+}
+
+static void
+cmsis_mtx_release(void)
+{
+	osMutexRelease(mtx1_id);
+}
+
+#endif /* TOPPERS_SUPPORT_MUTEX */
+
+/*
+ *  サービスコールによる操作
+ */
+static void
+native_sem_release(void)
+{
+	sig_sem(SEM1);
+}
+
+static void
+native_sem_wait(void)
+{
+	pol_sem(SEM1);
+}
+
+static void
+native_msg_put(void)
+{
+	psnd_dtq(DTQ1, 0);
+}
+
+static void
+native_msg_get(void)
+{
+	intptr_t	data;
+
+	prcv_dtq(DTQ1, &data);
+}
+
+static void
+native_msg_get_forever(void)
+{
+	intptr_t	data;
+
+	rcv_dtq(DTQ1, &data);
+}
+
+static void
+native_msg_send(void)
+{
+	snd_dtq(DTQ1, 0);
+}
+
+static void
+native_alm_start(void)
+{
+	sta_alm(ALM1, 1000U);
+}
+
+static void
+native_alm_stop(void)
+{
+	stp_alm(ALM1);
+}
+
+static void
+native_cyc_start(void)
+{
+	sta_cyc(CYC1);
+}
+
+static void
+native_cyc_stop(void)
+{
+	stp_cyc(CYC1);
+}
+
+static void
+native_yield(void)
+{
+	rot_rdq(TPRI_SELF);
+}
+
+static void
+native_get_id(void)
+{
+	ID		tskid;
+
+	get_tid(&tskid);
+}
+
+#ifdef TOPPERS_SUPPORT_MUTEX
+
+static void
+native_mtx_wait(void)
+{
+	loc_mtx(MTX1);
+}
+
+static void
+native_mtx_release(void)
+{
+	unl_mtx(MTX1);
+}
+
+#endif /* TOPPERS_SUPPORT_MUTEX */
+
+/*
+ *  タスク切換えを伴う経路の計測で用いる操作
+ */
+static void		(*wait_func)(void);
+static void		(*signal_func)(void);
+
+/*
+ *  計測タスク1（高優先度）
+ */
+void task1(intptr_t exinf)
+{
+	uint_t	i;
+
+	(*wait_func)();
+	end_measure(1);
+	for (i = 1; i < NO_MEASURE; i++) {
+		begin_measure(2);
+		(*wait_func)();
+		end_measure(1);
+	}
+	begin_measure(2);
+	(*wait_func)();
+}
+
+/*
+ *  計測タスク2（中優先度）
+ */
+void task2(intptr_t exinf)
+{
+	uint_t	i;
+
+	for (i = 0; i < NO_MEASURE; i++) {
+		begin_measure(1);
+		(*signal_func)();
+		end_measure(2);
+	}
+	(*signal_func)();
+}
+
+/*
+ *  アラームハンドラと周期ハンドラ（計測中には呼び出されない）
+ */
+void alarm1_handler(intptr_t exinf)
+{
+}
+
+void cyclic1_handler(intptr_t exinf)
+{
+}
+
+/*
+ *  計測用の分布記録領域の初期化
+ */
+static void
+init_measure(void)
+{
+	init_hist_log(1, HIST_BITS, histarea1);
+	init_hist_log(2, HIST_BITS, histarea2);
+}
+
+/*
+ *  待ち解除を伴わない経路の計測
+ *
+ *  func1とfunc2を交互に呼び出し，それぞれの処理時間を計測する．
+ */
+static void
+perf_nowait(void (*func1)(void), const char *name1,
+					void (*func2)(void), const char *name2)
+{
+	uint_t	i;
+
+	init_measure();
+	for (i = 0; i < NO_MEASURE; i++) {
+		begin_measure(1);
+		(*func1)();
+		end_measure(1);
+		if (func2 != NULL) {
+			begin_measure(2);
+			(*func2)();
+			end_measure(2);
+		}
+	}
+	print_hist_bench(1, name1);
+	if (func2 != NULL) {
+		print_hist_bench(2, name2);
+	}
+}
+
+/*
+ *  タスク切換えを伴う経路の計測
+ */
+static void
+perf_switch(void (*wait)(void), void (*signal)(void),
+						const char *wake_name, const char *block_name)
+{
+	wait_func = wait;
+	signal_func = signal;
+	init_measure();
+	act_tsk(TASK1);
+	act_tsk(TASK2);
+	print_hist_bench(1, wake_name);
+	print_hist_bench(2, block_name);
+}
+
+/*
+ *  メインタスク（低優先度）
+ */
+void main_task(intptr_t exinf)
+{
+	syslog_0(LOG_NOTICE, "Performance evaluation program (8)");
+	syslog_flush();
+
+	sem1_id = osSemaphoreCreate(osSemaphore(SEM1), 1);
+	dtq1_id = osMessageCreate(osMessageQ(DTQ1), 0);
+	alm1_id = osTimerCreate(osTimer(ALM1), osTimerOnce, NULL);
+	cyc1_id = osTimerCreate(osTimer(CYC1), osTimerPeriodic, NULL);
+#ifdef TOPPERS_SUPPORT_MUTEX
+	mtx1_id = osMutexCreate(osMutex(MTX1));
+#endif /* TOPPERS_SUPPORT_MUTEX */
+
+	/*
+	 *  待ち解除を伴わない経路
+	 */
+	perf_nowait(cmsis_sem_release, "osSemaphoreRelease",
+								native_sem_release, "sig_sem");
+	perf_nowait(cmsis_sem_wait, "osSemaphoreWait",
+								native_sem_wait, "pol_sem");
+	perf_nowait(cmsis_msg_put, "osMessagePut", cmsis_msg_get, "osMessageGet");
+	perf_nowait(native_msg_put, "psnd_dtq", native_msg_get, "prcv_dtq");
+	perf_nowait(cmsis_alm_start, "osTimerStart_once",
+								cmsis_alm_stop, "osTimerStop_once");
+	perf_nowait(native_alm_start, "sta_alm", native_alm_stop, "stp_alm");
+	perf_nowait(cmsis_cyc_start, "osTimerStart_periodic",
+								cmsis_cyc_stop, "osTimerStop_periodic");
+	perf_nowait(native_cyc_start, "sta_cyc", native_cyc_stop, "stp_cyc");
+	perf_nowait(cmsis_yield, "osThreadYield", native_yield, "rot_rdq");
+	perf_nowait(cmsis_get_id, "osThreadGetId", native_get_id, "get_tid");
+#ifdef TOPPERS_SUPPORT_MUTEX
+	perf_nowait(cmsis_mtx_wait, "osMutexWait", cmsis_mtx_release,
+													"osMutexRelease");
+	perf_nowait(native_mtx_wait, "loc_mtx", native_mtx_release, "unl_mtx");
+#endif /* TOPPERS_SUPPORT_MUTEX */
+
+	/*
+	 *  タスク切換えを伴う経路
+	 */
+	perf_switch(cmsis_msg_get_forever, cmsis_msg_put,
+							"osMessagePut_wake", "osMessageGet_block");
+	perf_switch(native_msg_get_forever, native_msg_send,
+							"snd_dtq_wake", "rcv_dtq_block");
+
+	test_finish();
+}
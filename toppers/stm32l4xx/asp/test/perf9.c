@@ -0,0 +1,159 @@
+/*
+ *  TOPPERS Software
+ *      Toyohashi Open Platform for Embedded Real-Time Systems
+ * 
+ *  Copyright (C) 2006-2009 by Embedded and Real-Time Systems Laboratory
+ *              Graduate School of Information Science, Nagoya Univ., JAPAN
+ *  Copyright (C) 2017-2018 by TOPPERS PROJECT Educational Working Group.
+ * 
+ *  上記著作権者は，以下の(1)〜(4)の条件を満たす場合に限り，本ソフトウェ
+ *  ア（本ソフトウェアを改変したものを含む．以下同じ）を使用・複製・改
+ *  変・再配布（以下，利用と呼ぶ）することを無償で許諾する．
+ *  (1) 本ソフトウェアをソースコードの形で利用する場合には，上記の著作
+ *      権表示，この利用条件および下記の無保証規定が，そのままの形でソー
+ *      スコード中に含まれていること．
+ *  (2) 本ソフトウェアを，ライブラリ形式など，他のソフトウェア開発に使
+ *      用できる形で再配布する場合には，再配布に伴うドキュメント（利用
+ *      者マニュアルなど）に，上記の著作権表示，この利用条件および下記
+ *      の無保証規定を掲載すること．
+ *  (3) 本ソフトウェアを，機器に組み込むなど，他のソフトウェア開発に使
+ *      用できない形で再配布する場合には，次のいずれかの条件を満たすこ
+ *      と．
+ *    (a) 再配布に伴うドキュメント（利用者マニュアルなど）に，上記の著
+ *        作権表示，この利用条件および下記の無保証規定を掲載すること．
+ *    (b) 再配布の形態を，別に定める方法によって，TOPPERSプロジェクトに
+ *        報告すること．
+ *  (4) 本ソフトウェアの利用により直接的または間接的に生じるいかなる損
+ *      害からも，上記著作権者およびTOPPERSプロジェクトを免責すること．
+ *      また，本ソフトウェアのユーザまたはエンドユーザからのいかなる理
+ *      由に基づく請求からも，上記著作権者およびTOPPERSプロジェクトを
+ *      免責すること．
+ * 
+ *  本ソフトウェアは，無保証で提供されているものである．上記著作権者お
+ *  よびTOPPERSプロジェクトは，本ソフトウェアに関して，特定の使用目的
+ *  に対する適合性も含めて，いかなる保証も行わない．また，本ソフトウェ
+ *  アの利用により直接的または間接的に生じたいかなる損害に関しても，そ
+ *  の責任を負わない．
+ * 
+ *  $Id$
+
+/*
+ *		カーネル性能評価プログラム(9)
+ *
+ *  TA_WMUL属性のイベントフラグで，待ち状態のタスクの数により，set_flg
+ *  の処理時間がどのように変化するかを計測するためのプログラム．最大32
+ *  個のタスクが，それぞれ異なるビットを待っている状態で，最後に待ち状
+ *  態に入ったタスクを待ち解除するset_flgの処理時間を計測し，
+ *  print_hist_benchの形式で出力する．
+ *
+ *  TOPPERS_FLG_WAIT_INDEXを定義してカーネルを構築した場合には，待ち状
+ *  態のタスクの数によらずに処理時間がほぼ一定になる．
+ */
+
+#include <kernel.h>
+#include <t_syslog.h>
+#include <test_lib.h>
+#include <histogram.h>
+#include "kernel_cfg.h"
+#include "perf9.h"
+
+/*
+ *  計測回数と実行時間分布を記録する最大時間
+ */
+#define NO_MEASURE	10000U			/* 計測回数 */
+#define HIST_BITS	12U				/* 4095までの時間を記録 */
+
+/*
+ *  実行時間分布を記録するメモリ領域
+ */
+static uint_t	histarea1[HIST_LOG_NBUCKET(HIST_BITS)];
+
+/*
+ *  計測タスクのリスト
+ */
+static const ID task_list[NUM_TASK] = {
+	TASK1, TASK2, TASK3, TASK4, TASK5, TASK6, TASK7, TASK8,
+	TASK9, TASK10, TASK11, TASK12, TASK13, TASK14, TASK15, TASK16,
+	TASK17, TASK18, TASK19, TASK20, TASK21, TASK22, TASK23, TASK24,
+	TASK25, TASK26, TASK27, TASK28, TASK29, TASK30, TASK31, TASK32
+};
+
+/*
+ *  待ち状態のタスクの数と計測結果の名前
+ */
+static const struct {
+	uint_t		n;
+	const char	*name;
+} perf_list[] = {
+	{ 1U, "set_flg_wmul_1" },
+	{ 2U, "set_flg_wmul_2" },
+	{ 4U, "set_flg_wmul_4" },
+	{ 8U, "set_flg_wmul_8" },
+	{ 16U, "set_flg_wmul_16" },
+	{ 32U, "set_flg_wmul_32" }
+};
+
+/*
+ *  計測タスク（中優先度）
+ *
+ *  exinfで指定されたビットを繰り返し待つ．
+ */
+void task(intptr_t exinf)
+{
+	FLGPTN	flgptn;
+
+	while (true) {
+		wai_flg(FLG1, ((FLGPTN) 1U) << exinf, TWF_ORW, &flgptn);
+	}
+}
+
+/*
+ *  計測ルーチン
+ *
+ *  既に待ち状態に入っているタスクに加えて，n個のタスクが待ち状態にな
+ *  るまで計測タスクを起動し，最後に起動したタスクを待ち解除する．待ち
+ *  解除されたタスクは，再び待ちキューの末尾につながれる．
+ */
+static void
+perf_eval(uint_t n, uint_t *p_nact, const char *name)
+{
+	uint_t	i;
+	FLGPTN	setptn = ((FLGPTN) 1U) << (n - 1U);
+
+	while (*p_nact < n) {
+		act_tsk(task_list[*p_nact]);
+		*p_nact += 1U;
+	}
+	chg_pri(TSK_SELF, MAIN_PRIORITY_LOW);
+	/* タスクが待ち状態に入るのを待つ */
+	chg_pri(TSK_SELF, TPRI_INI);
+
+	init_hist_log(1, HIST_BITS, histarea1);
+	for (i = 0; i < NO_MEASURE; i++) {
+		begin_measure(1);
+		set_flg(FLG1, setptn);
+		end_measure(1);
+
+		clr_flg(FLG1, 0U);
+		chg_pri(TSK_SELF, MAIN_PRIORITY_LOW);
+		/* タスクが再び待ち状態に入るのを待つ */
+		chg_pri(TSK_SELF, TPRI_INI);
+	}
+	print_hist_bench(1, name);
+}
+
+/*
+ *  メインタスク（高優先度）
+ */
+void main_task(intptr_t exinf)
+{
+	uint_t	i, nact = 0U;
+
+	syslog_0(LOG_NOTICE, "Performance evaluation program (9)");
+	syslog_flush();
+
+	for (i = 0; i < sizeof(perf_list) / sizeof(perf_list[0]); i++) {
+		perf_eval(perf_list[i].n, &nact, perf_list[i].name);
+	}
+	test_finish();
+}
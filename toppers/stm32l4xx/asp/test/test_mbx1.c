@@ -0,0 +1,255 @@
+/*
+ *  TOPPERS/ASP Kernel
+ *      Toyohashi Open Platform for Embedded Real-Time Systems/
+ *      Advanced Standard Profile Kernel
+ * 
+ *  Copyright (C) 2005-2011 by Embedded and Real-Time Systems Laboratory
+ *              Graduate School of Information Science, Nagoya Univ., JAPAN
+ *  Copyright (C) 2017-2018 by TOPPERS PROJECT Educational Working Group.
+ * 
+ *  上記著作権者は，以下の(1)〜(4)の条件を満たす場合に限り，本ソフトウェ
+ *  ア（本ソフトウェアを改変したものを含む．以下同じ）を使用・複製・改
+ *  変・再配布（以下，利用と呼ぶ）することを無償で許諾する．
+ *  (1) 本ソフトウェアをソースコードの形で利用する場合には，上記の著作
+ *      権表示，この利用条件および下記の無保証規定が，そのままの形でソー
+ *      スコード中に含まれていること．
+ *  (2) 本ソフトウェアを，ライブラリ形式など，他のソフトウェア開発に使
+ *      用できる形で再配布する場合には，再配布に伴うドキュメント（利用
+ *      者マニュアルなど）に，上記の著作権表示，この利用条件および下記
+ *      の無保証規定を掲載すること．
+ *  (3) 本ソフトウェアを，機器に組み込むなど，他のソフトウェア開発に使
+ *      用できない形で再配布する場合には，次のいずれかの条件を満たすこ
+ *      と．
+ *    (a) 再配布に伴うドキュメント（利用者マニュアルなど）に，上記の著
+ *        作権表示，この利用条件および下記の無保証規定を掲載すること．
+ *    (b) 再配布の形態を，別に定める方法によって，TOPPERSプロジェクトに
+ *        報告すること．
+ *  (4) 本ソフトウェアの利用により直接的または間接的に生じるいかなる損
+ *      害からも，上記著作権者およびTOPPERSプロジェクトを免責すること．
+ *      また，本ソフトウェアのユーザまたはエンドユーザからのいかなる理
+ *      由に基づく請求からも，上記著作権者およびTOPPERSプロジェクトを
+ *      免責すること．
+ * 
+ *  本ソフトウェアは，無保証で提供されているものである．上記著作権者お
+ *  よびTOPPERSプロジェクトは，本ソフトウェアに関して，特定の使用目的
+ *  に対する適合性も含めて，いかなる保証も行わない．また，本ソフトウェ
+ *  アの利用により直接的または間接的に生じたいかなる損害に関しても，そ
+ *  の責任を負わない．
+ * 
+ *  $Id$
+ */
+
+/*
+ *		メールボックス機能のテスト(1)
+ *
+ * 【テストの目的】
+ *
+ *  TA_MPRI属性のメールボックスで，メッセージが優先度順に受信され，同
+ *  じ優先度のメッセージが送信した順に受信されることをテストする．
+ *  TOPPERS_MBX_PRI_QUEUEの有無にかかわらず，同じ結果になる．
+ *
+ * 【テスト項目】
+ *
+ *	(A) snd_mbxのパラメータエラーのテスト
+ *		(A-1) メッセージ優先度が小さすぎる
+ *		(A-2) メッセージ優先度が大きすぎる
+ *	(B) 異なる優先度のメッセージが優先度順に受信される
+ *	(C) 同じ優先度のメッセージが送信した順に受信される
+ *	(D) ある優先度のメッセージがなくなった後に，再び同じ優先度のメッセー
+ *		ジが正しくつながれる
+ *	(E) ini_mbxの後に，メッセージが正しくつながれる
+ *	(F) 受信待ちのタスクがある場合には，メッセージが直接渡される
+ *
+ * 【使用リソース】
+ *
+ *	TASK1: 中優先度タスク，TA_ACT属性
+ *	TASK2: 高優先度タスク
+ *	MBX1:  TA_MPRI属性，メッセージ優先度の最大値4
+ *
+ * 【テストシーケンス】
+ *
+ *	== TASK1（優先度：中）==
+ *	1:	snd_mbx(MBX1, msg[0]/優先度0) -> E_PAR		... (A-1)
+ *		snd_mbx(MBX1, msg[0]/優先度5) -> E_PAR		... (A-2)
+ *	2:	優先度2，1，3，2，1，4，2の順でmsg[0]〜msg[6]を送信
+ *		ref_mbx(MBX1, &rmbx)
+ *		assert(rmbx.pk_msg == msg[1])
+ *	3:	msg[1]，msg[4]，msg[0]，msg[3]，msg[6]，msg[2]，msg[5]の順に受信
+ *		prcv_mbx(MBX1) -> E_TMOUT						... (B)(C)
+ *	4:	msg[0]/優先度2，msg[1]/優先度2を送信
+ *		msg[0]を受信
+ *		msg[2]/優先度1，msg[3]/優先度2を送信
+ *		msg[2]を受信
+ *		msg[1]を受信
+ *		msg[4]/優先度2を送信
+ *		msg[3]，msg[4]の順に受信							... (D)
+ *		prcv_mbx(MBX1) -> E_TMOUT
+ *	5:	msg[0]/優先度3，msg[1]/優先度3を送信
+ *		ini_mbx(MBX1)
+ *		prcv_mbx(MBX1) -> E_TMOUT
+ *		msg[2]/優先度3，msg[3]/優先度1，msg[4]/優先度3を送信
+ *		msg[3]，msg[2]，msg[4]の順に受信					... (E)
+ *	6:	act_tsk(TASK2)
+ *	== TASK2（優先度：高）==
+ *	7:	rcv_mbx(MBX1, &pk_msg)
+ *	== TASK1（続き）==
+ *	8:	snd_mbx(MBX1, msg[5]/優先度4)					... (F)
+ *	== TASK2（続き）==
+ *	9:	assert(pk_msg == msg[5])
+ *		ext_tsk()
+ *	== TASK1（続き）==
+ *	10:	prcv_mbx(MBX1) -> E_TMOUT
+ *		テスト終了
+ */
+
+#include <kernel.h>
+#include <test_lib.h>
+#include <t_syslog.h>
+#include "kernel_cfg.h"
+#include "test_mbx1.h"
+
+/*
+ *  テストに用いるメッセージ
+ */
+#define NUM_MSG		7
+
+static T_MSG_PRI	msg[NUM_MSG];
+
+/*
+ *  メッセージの送信
+ */
+static void
+send_msg(uint_t i, PRI msgpri)
+{
+	ER		ercd;
+
+	msg[i].msgpri = msgpri;
+	ercd = snd_mbx(MBX1, (T_MSG *) &msg[i]);
+	check_ercd(ercd, E_OK);
+}
+
+/*
+ *  メッセージの受信と受信したメッセージのチェック
+ */
+static void
+receive_msg(uint_t i)
+{
+	T_MSG	*pk_msg;
+	ER		ercd;
+
+	ercd = prcv_mbx(MBX1, &pk_msg);
+	check_ercd(ercd, E_OK);
+	check_assert(pk_msg == (T_MSG *) &msg[i]);
+}
+
+/*
+ *  メッセージキューが空であることのチェック
+ */
+static void
+check_empty(void)
+{
+	T_MSG	*pk_msg;
+	ER		ercd;
+
+	ercd = prcv_mbx(MBX1, &pk_msg);
+	check_ercd(ercd, E_TMOUT);
+}
+
+void
+task1(intptr_t exinf)
+{
+	ER		ercd;
+	T_RMBX	rmbx;
+
+	test_start(__FILE__);
+
+	check_point(1);
+	msg[0].msgpri = TMIN_MPRI - 1;
+	ercd = snd_mbx(MBX1, (T_MSG *) &msg[0]);
+	check_ercd(ercd, E_PAR);
+
+	msg[0].msgpri = MAXMPRI_MBX1 + 1;
+	ercd = snd_mbx(MBX1, (T_MSG *) &msg[0]);
+	check_ercd(ercd, E_PAR);
+
+	check_point(2);
+	send_msg(0, 2);
+	send_msg(1, 1);
+	send_msg(2, 3);
+	send_msg(3, 2);
+	send_msg(4, 1);
+	send_msg(5, 4);
+	send_msg(6, 2);
+
+	ercd = ref_mbx(MBX1, &rmbx);
+	check_ercd(ercd, E_OK);
+	check_assert(rmbx.wtskid == TSK_NONE);
+	check_assert(rmbx.pk_msg == (T_MSG *) &msg[1]);
+
+	check_point(3);
+	receive_msg(1);
+	receive_msg(4);
+	receive_msg(0);
+	receive_msg(3);
+	receive_msg(6);
+	receive_msg(2);
+	receive_msg(5);
+	check_empty();
+
+	check_point(4);
+	send_msg(0, 2);
+	send_msg(1, 2);
+	receive_msg(0);
+	send_msg(2, 1);
+	send_msg(3, 2);
+	receive_msg(2);
+	receive_msg(1);
+	send_msg(4, 2);
+	receive_msg(3);
+	receive_msg(4);
+	check_empty();
+
+	check_point(5);
+	send_msg(0, 3);
+	send_msg(1, 3);
+	ercd = ini_mbx(MBX1);
+	check_ercd(ercd, E_OK);
+	check_empty();
+	send_msg(2, 3);
+	send_msg(3, 1);
+	send_msg(4, 3);
+	receive_msg(3);
+	receive_msg(2);
+	receive_msg(4);
+	check_empty();
+
+	check_point(6);
+	ercd = act_tsk(TASK2);
+	check_ercd(ercd, E_OK);
+
+	check_point(8);
+	send_msg(5, 4);
+
+	check_empty();
+	check_finish(10);
+
+	check_point(0);
+}
+
+void
+task2(intptr_t exinf)
+{
+	ER		ercd;
+	T_MSG	*pk_msg;
+
+	check_point(7);
+	ercd = rcv_mbx(MBX1, &pk_msg);
+	check_ercd(ercd, E_OK);
+
+	check_point(9);
+	check_assert(pk_msg == (T_MSG *) &msg[5]);
+
+	ercd = ext_tsk();
+
+	check_point(0);
+}
@@ -0,0 +1,409 @@
+/*
+ *  TOPPERS/ASP Kernel
+ *      Toyohashi Open Platform for Embedded Real-Time Systems/
+ *      Advanced Standard Profile Kernel
+ * 
+ *  Copyright (C) 2005-2011 by Embedded and Real-Time Systems Laboratory
+ *              Graduate School of Information Science, Nagoya Univ., JAPAN
+ *  Copyright (C) 2017-2018 by TOPPERS PROJECT Educational Working Group.
+ * 
+ *  上記著作権者は，以下の(1)〜(4)の条件を満たす場合に限り，本ソフトウェ
+ *  ア（本ソフトウェアを改変したものを含む．以下同じ）を使用・複製・改
+ *  変・再配布（以下，利用と呼ぶ）することを無償で許諾する．
+ *  (1) 本ソフトウェアをソースコードの形で利用する場合には，上記の著作
+ *      権表示，この利用条件および下記の無保証規定が，そのままの形でソー
+ *      スコード中に含まれていること．
+ *  (2) 本ソフトウェアを，ライブラリ形式など，他のソフトウェア開発に使
+ *      用できる形で再配布する場合には，再配布に伴うドキュメント（利用
+ *      者マニュアルなど）に，上記の著作権表示，この利用条件および下記
+ *      の無保証規定を掲載すること．
+ *  (3) 本ソフトウェアを，機器に組み込むなど，他のソフトウェア開発に使
+ *      用できない形で再配布する場合には，次のいずれかの条件を満たすこ
+ *      と．
+ *    (a) 再配布に伴うドキュメント（利用者マニュアルなど）に，上記の著
+ *        作権表示，この利用条件および下記の無保証規定を掲載すること．
+ *    (b) 再配布の形態を，別に定める方法によって，TOPPERSプロジェクトに
+ *        報告すること．
+ *  (4) 本ソフトウェアの利用により直接的または間接的に生じるいかなる損
+ *      害からも，上記著作権者およびTOPPERSプロジェクトを免責すること．
+ *      また，本ソフトウェアのユーザまたはエンドユーザからのいかなる理
+ *      由に基づく請求からも，上記著作権者およびTOPPERSプロジェクトを
+ *      免責すること．
+ * 
+ *  本ソフトウェアは，無保証で提供されているものである．上記著作権者お
+ *  よびTOPPERSプロジェクトは，本ソフトウェアに関して，特定の使用目的
+ *  に対する適合性も含めて，いかなる保証も行わない．また，本ソフトウェ
+ *  アの利用により直接的または間接的に生じたいかなる損害に関しても，そ
+ *  の責任を負わない．
+ * 
+ *  $Id$
+ */
+
+/*
+ *		複数オブジェクト待ち機能のテスト(1)
+ *
+ * 【テストの目的】
+ *
+ *  twai_objが，待ち対象のオブジェクトのいずれかが待ち解除の条件を満た
+ *  した時に，そのオブジェクトのインデックスを返すことをテストする．セ
+ *  マフォ，イベントフラグ，データキュー，優先度データキュー，メールボッ
+ *  クスのそれぞれについて，待ち状態からの待ち解除を確認する．また，1
+ *  つの資源に対して，twai_objで待っているタスクが1つだけ待ち解除され
+ *  ることを確認する．TOPPERS_WAIT_OBJをマクロ定義してカーネルを構築する必要がある．
+ *
+ * 【テスト項目】
+ *
+ *	(A) twai_objのパラメータエラーのテスト
+ *		(A-1) nobjが0
+ *		(A-2) オブジェクトの種類が不正
+ *		(A-3) オブジェクトIDが不正
+ *		(A-4) イベントフラグの待ちパターンが0
+ *	(B) 条件を満たすオブジェクトがない場合のポーリングとタイムアウト
+ *	(C) 複数のオブジェクトが条件を満たしている場合には，インデックスが
+ *		最小のものが返る
+ *	(D) オブジェクトの資源やデータは取り出されない
+ *	(E) イベントフラグのAND待ちで，一部のビットだけでは待ち解除されない
+ *	(F) 待ち状態のタスクの待ち要因がTTW_OBJになる
+ *	(G) 各種類のオブジェクトによる待ち解除
+ *		(G-1) データキューへの送信
+ *		(G-2) データキューへの送信待ち（同期通信）
+ *		(G-3) 優先度データキューへの送信
+ *		(G-4) メールボックスへの送信
+ *		(G-5) セマフォ資源の返却
+ *	(H) rel_waiによる待ち状態の強制解除
+ *	(I) 1つの資源に対しては，twai_objで待っているタスクが待ちキュー
+ *		の順に1つだけ待ち解除される
+ *
+ * 【使用リソース】
+ *
+ *	TASK1: 中優先度タスク，TA_ACT属性
+ *	TASK2: 高優先度タスク
+ *	TASK3: 高優先度タスク
+ *	SEM1:  TA_NULL属性，初期資源数0，最大資源数1
+ *	FLG1:  TA_NULL属性，初期パターン0x00
+ *	DTQ1:  TA_NULL属性，データ数2
+ *	DTQ2:  TA_NULL属性，データ数0
+ *	PDQ1:  TA_NULL属性，データ数2，データ優先度の最大値4
+ *	MBX1:  TA_NULL属性
+ *
+ *	待ち対象は，SEM1，FLG1（0x03のAND待ち），DTQ1，DTQ2，PDQ1，MBX1の
+ *	順で指定する（インデックス0〜5）．
+ *
+ * 【テストシーケンス】
+ *
+ *	== TASK1（優先度：中）==
+ *	1:	twai_obj(wobj, 0, TMO_POL) -> E_PAR				... (A-1)
+ *		twai_obj(不正な種類, 1, TMO_POL) -> E_PAR		... (A-2)
+ *		twai_obj(不正なID, 1, TMO_POL) -> E_ID			... (A-3)
+ *		twai_obj(待ちパターン0, 1, TMO_POL) -> E_PAR	... (A-4)
+ *	2:	twai_obj(wobj, 6, TMO_POL) -> E_TMOUT
+ *		twai_obj(wobj, 6, 10) -> E_TMOUT					... (B)
+ *	3:	sig_sem(SEM1)
+ *		psnd_dtq(DTQ1, 1)
+ *		twai_obj(wobj, 6, TMO_POL) -> 0					... (C)
+ *		pol_sem(SEM1)										... (D)
+ *		twai_obj(wobj, 6, TMO_POL) -> 2
+ *		prcv_dtq(DTQ1) -> 1
+ *	4:	set_flg(FLG1, 0x01)
+ *		twai_obj(wobj, 6, TMO_POL) -> E_TMOUT				... (E)
+ *		set_flg(FLG1, 0x02)
+ *		twai_obj(wobj, 6, TMO_POL) -> 1
+ *		clr_flg(FLG1, 0x00)
+ *		act_tsk(TASK2)
+ *	== TASK2（優先度：高）==
+ *	5:	twai_obj(wobj, 6, TMO_FEVR)
+ *	== TASK1（続き）==
+ *	6:	ref_tsk(TASK2) -> TTW_OBJ							... (F)
+ *		set_flg(FLG1, 0x01)
+ *		ref_tsk(TASK2) -> TTW_OBJ							... (E)
+ *		clr_flg(FLG1, 0x00)
+ *		psnd_dtq(DTQ1, 2)									... (G-1)
+ *	== TASK2（続き）==
+ *	7:	twai_obj -> 2
+ *		prcv_dtq(DTQ1) -> 2
+ *		twai_obj(wobj, 6, TMO_FEVR)
+ *	== TASK1（続き）==
+ *	8:	snd_dtq(DTQ2, 3)									... (G-2)
+ *	== TASK2（続き）==
+ *	9:	twai_obj -> 3
+ *		prcv_dtq(DTQ2) -> 3
+ *		twai_obj(wobj, 6, TMO_FEVR)
+ *	== TASK1（続き）==
+ *	10:	snd_dtqから戻る
+ *		psnd_pdq(PDQ1, 4, 1)								... (G-3)
+ *	== TASK2（続き）==
+ *	11:	twai_obj -> 4
+ *		prcv_pdq(PDQ1) -> 4
+ *		twai_obj(wobj, 6, TMO_FEVR)
+ *	== TASK1（続き）==
+ *	12:	snd_mbx(MBX1, &msg)									... (G-4)
+ *	== TASK2（続き）==
+ *	13:	twai_obj -> 5
+ *		prcv_mbx(MBX1) -> &msg
+ *		twai_obj(wobj, 6, TMO_FEVR)
+ *	== TASK1（続き）==
+ *	14:	rel_wai(TASK2)										... (H)
+ *	== TASK2（続き）==
+ *	15:	twai_obj -> E_RLWAI
+ *		twai_obj(wobj, 6, TMO_FEVR)
+ *	== TASK1（続き）==
+ *	16:	act_tsk(TASK3)
+ *	== TASK3（優先度：高）==
+ *	17:	twai_obj(wobj, 6, TMO_FEVR)
+ *	== TASK1（続き）==
+ *	18:	sig_sem(SEM1)										... (G-5)
+ *	== TASK2（続き）==
+ *	19:	twai_obj -> 0
+ *		pol_sem(SEM1)
+ *		ext_tsk()
+ *	== TASK1（続き）==
+ *	20:	ref_tsk(TASK3) -> TTW_OBJ							... (I)
+ *		sig_sem(SEM1)
+ *	== TASK3（続き）==
+ *	21:	twai_obj -> 0
+ *		pol_sem(SEM1)
+ *		ext_tsk()
+ *	== TASK1（続き）==
+ *	22:	テスト終了
+ */
+
+#include <kernel.h>
+#include <test_lib.h>
+#include <t_syslog.h>
+#include "kernel_cfg.h"
+#include "test_mobj1.h"
+
+#ifndef TOPPERS_SUPPORT_TWAI_OBJ
+#error twai_obj is not supported.
+#endif /* TOPPERS_SUPPORT_TWAI_OBJ */
+
+/*
+ *  待ち対象のオブジェクト
+ */
+#define NUM_WOBJ	6
+
+static const T_WOBJ	wobj[NUM_WOBJ] = {
+	{ TOBJ_SEM, SEM1, 0U, 0U },
+	{ TOBJ_FLG, FLG1, 0x03U, TWF_ANDW },
+	{ TOBJ_DTQ, DTQ1, 0U, 0U },
+	{ TOBJ_DTQ, DTQ2, 0U, 0U },
+	{ TOBJ_PDQ, PDQ1, 0U, 0U },
+	{ TOBJ_MBX, MBX1, 0U, 0U }
+};
+
+/*
+ *  テストに用いるメッセージ
+ */
+static T_MSG	msg;
+
+void
+task1(intptr_t exinf)
+{
+	ER_UINT	ercd;
+	T_WOBJ	bad_wobj;
+	T_RTSK	rtsk;
+	intptr_t data;
+
+	test_start(__FILE__);
+
+	check_point(1);
+	ercd = twai_obj(wobj, 0U, TMO_POL);
+	check_ercd(ercd, E_PAR);
+
+	bad_wobj = wobj[0];
+	bad_wobj.objtyp = 0U;
+	ercd = twai_obj(&bad_wobj, 1U, TMO_POL);
+	check_ercd(ercd, E_PAR);
+
+	bad_wobj = wobj[0];
+	bad_wobj.objid = 0;
+	ercd = twai_obj(&bad_wobj, 1U, TMO_POL);
+	check_ercd(ercd, E_ID);
+
+	bad_wobj = wobj[1];
+	bad_wobj.waiptn = 0U;
+	ercd = twai_obj(&bad_wobj, 1U, TMO_POL);
+	check_ercd(ercd, E_PAR);
+
+	check_point(2);
+	ercd = twai_obj(wobj, NUM_WOBJ, TMO_POL);
+	check_ercd(ercd, E_TMOUT);
+
+	ercd = twai_obj(wobj, NUM_WOBJ, 10);
+	check_ercd(ercd, E_TMOUT);
+
+	check_point(3);
+	ercd = sig_sem(SEM1);
+	check_ercd(ercd, E_OK);
+
+	ercd = psnd_dtq(DTQ1, 1);
+	check_ercd(ercd, E_OK);
+
+	ercd = twai_obj(wobj, NUM_WOBJ, TMO_POL);
+	check_assert(ercd == 0);
+
+	ercd = pol_sem(SEM1);
+	check_ercd(ercd, E_OK);
+
+	ercd = twai_obj(wobj, NUM_WOBJ, TMO_POL);
+	check_assert(ercd == 2);
+
+	ercd = prcv_dtq(DTQ1, &data);
+	check_ercd(ercd, E_OK);
+	check_assert(data == 1);
+
+	check_point(4);
+	ercd = set_flg(FLG1, 0x01U);
+	check_ercd(ercd, E_OK);
+
+	ercd = twai_obj(wobj, NUM_WOBJ, TMO_POL);
+	check_ercd(ercd, E_TMOUT);
+
+	ercd = set_flg(FLG1, 0x02U);
+	check_ercd(ercd, E_OK);
+
+	ercd = twai_obj(wobj, NUM_WOBJ, TMO_POL);
+	check_assert(ercd == 1);
+
+	ercd = clr_flg(FLG1, 0x00U);
+	check_ercd(ercd, E_OK);
+
+	ercd = act_tsk(TASK2);
+	check_ercd(ercd, E_OK);
+
+	check_point(6);
+	ercd = ref_tsk(TASK2, &rtsk);
+	check_ercd(ercd, E_OK);
+	check_assert(rtsk.tskstat == TTS_WAI);
+	check_assert(rtsk.tskwait == TTW_OBJ);
+
+	ercd = set_flg(FLG1, 0x01U);
+	check_ercd(ercd, E_OK);
+
+	ercd = ref_tsk(TASK2, &rtsk);
+	check_ercd(ercd, E_OK);
+	check_assert(rtsk.tskstat == TTS_WAI);
+	check_assert(rtsk.tskwait == TTW_OBJ);
+
+	ercd = clr_flg(FLG1, 0x00U);
+	check_ercd(ercd, E_OK);
+
+	ercd = psnd_dtq(DTQ1, 2);
+	check_ercd(ercd, E_OK);
+
+	check_point(8);
+	ercd = snd_dtq(DTQ2, 3);
+	check_ercd(ercd, E_OK);
+
+	check_point(10);
+	ercd = psnd_pdq(PDQ1, 4, 1);
+	check_ercd(ercd, E_OK);
+
+	check_point(12);
+	ercd = snd_mbx(MBX1, &msg);
+	check_ercd(ercd, E_OK);
+
+	check_point(14);
+	ercd = rel_wai(TASK2);
+	check_ercd(ercd, E_OK);
+
+	check_point(16);
+	ercd = act_tsk(TASK3);
+	check_ercd(ercd, E_OK);
+
+	check_point(18);
+	ercd = sig_sem(SEM1);
+	check_ercd(ercd, E_OK);
+
+	check_point(20);
+	ercd = ref_tsk(TASK3, &rtsk);
+	check_ercd(ercd, E_OK);
+	check_assert(rtsk.tskstat == TTS_WAI);
+	check_assert(rtsk.tskwait == TTW_OBJ);
+
+	ercd = sig_sem(SEM1);
+	check_ercd(ercd, E_OK);
+
+	check_finish(22);
+}
+
+void
+task2(intptr_t exinf)
+{
+	ER_UINT	ercd;
+	intptr_t data;
+	PRI		datapri;
+	T_MSG	*pk_msg;
+
+	check_point(5);
+	ercd = twai_obj(wobj, NUM_WOBJ, TMO_FEVR);
+
+	check_point(7);
+	check_assert(ercd == 2);
+
+	ercd = prcv_dtq(DTQ1, &data);
+	check_ercd(ercd, E_OK);
+	check_assert(data == 2);
+
+	ercd = twai_obj(wobj, NUM_WOBJ, TMO_FEVR);
+
+	check_point(9);
+	check_assert(ercd == 3);
+
+	ercd = prcv_dtq(DTQ2, &data);
+	check_ercd(ercd, E_OK);
+	check_assert(data == 3);
+
+	ercd = twai_obj(wobj, NUM_WOBJ, TMO_FEVR);
+
+	check_point(11);
+	check_assert(ercd == 4);
+
+	ercd = prcv_pdq(PDQ1, &data, &datapri);
+	check_ercd(ercd, E_OK);
+	check_assert(data == 4);
+	check_assert(datapri == 1);
+
+	ercd = twai_obj(wobj, NUM_WOBJ, TMO_FEVR);
+
+	check_point(13);
+	check_assert(ercd == 5);
+
+	ercd = prcv_mbx(MBX1, &pk_msg);
+	check_ercd(ercd, E_OK);
+	check_assert(pk_msg == &msg);
+
+	ercd = twai_obj(wobj, NUM_WOBJ, TMO_FEVR);
+
+	check_point(15);
+	check_ercd(ercd, E_RLWAI);
+
+	ercd = twai_obj(wobj, NUM_WOBJ, TMO_FEVR);
+
+	check_point(19);
+	check_assert(ercd == 0);
+
+	ercd = pol_sem(SEM1);
+	check_ercd(ercd, E_OK);
+
+	ercd = ext_tsk();
+	check_point(0);
+}
+
+void
+task3(intptr_t exinf)
+{
+	ER_UINT	ercd;
+
+	check_point(17);
+	ercd = twai_obj(wobj, NUM_WOBJ, TMO_FEVR);
+
+	check_point(21);
+	check_assert(ercd == 0);
+
+	ercd = pol_sem(SEM1);
+	check_ercd(ercd, E_OK);
+
+	ercd = ext_tsk();
+	check_point(0);
+}
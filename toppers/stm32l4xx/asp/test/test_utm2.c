@@ -0,0 +1,141 @@
+/*
+ *  TOPPERS/ASP Kernel
+ *      Toyohashi Open Platform for Embedded Real-Time Systems/
+ *      Advanced Standard Profile Kernel
+ * 
+ *  Copyright (C) 2005-2011 by Embedded and Real-Time Systems Laboratory
+ *              Graduate School of Information Science, Nagoya Univ., JAPAN
+ *  Copyright (C) 2017-2018 by TOPPERS PROJECT Educational Working Group.
+ * 
+ *  上記著作権者は，以下の(1)〜(4)の条件を満たす場合に限り，本ソフトウェ
+ *  ア（本ソフトウェアを改変したものを含む．以下同じ）を使用・複製・改
+ *  変・再配布（以下，利用と呼ぶ）することを無償で許諾する．
+ *  (1) 本ソフトウェアをソースコードの形で利用する場合には，上記の著作
+ *      権表示，この利用条件および下記の無保証規定が，そのままの形でソー
+ *      スコード中に含まれていること．
+ *  (2) 本ソフトウェアを，ライブラリ形式など，他のソフトウェア開発に使
+ *      用できる形で再配布する場合には，再配布に伴うドキュメント（利用
+ *      者マニュアルなど）に，上記の著作権表示，この利用条件および下記
+ *      の無保証規定を掲載すること．
+ *  (3) 本ソフトウェアを，機器に組み込むなど，他のソフトウェア開発に使
+ *      用できない形で再配布する場合には，次のいずれかの条件を満たすこ
+ *      と．
+ *    (a) 再配布に伴うドキュメント（利用者マニュアルなど）に，上記の著
+ *        作権表示，この利用条件および下記の無保証規定を掲載すること．
+ *    (b) 再配布の形態を，別に定める方法によって，TOPPERSプロジェクトに
+ *        報告すること．
+ *  (4) 本ソフトウェアの利用により直接的または間接的に生じるいかなる損
+ *      害からも，上記著作権者およびTOPPERSプロジェクトを免責すること．
+ *      また，本ソフトウェアのユーザまたはエンドユーザからのいかなる理
+ *      由に基づく請求からも，上記著作権者およびTOPPERSプロジェクトを
+ *      免責すること．
+ * 
+ *  本ソフトウェアは，無保証で提供されているものである．上記著作権者お
+ *  よびTOPPERSプロジェクトは，本ソフトウェアに関して，特定の使用目的
+ *  に対する適合性も含めて，いかなる保証も行わない．また，本ソフトウェ
+ *  アの利用により直接的または間接的に生じたいかなる損害に関しても，そ
+ *  の責任を負わない．
+ * 
+ *  $Id$
+ */
+
+/*
+ *		get_utm64に関するテスト(1)
+ *
+ * 【テストの目的】
+ *
+ *  64ビットの性能評価用システム時刻が，CPUロック状態にせずに読み出し
+ *  ても逆行することがないことと，get_utmと同じ速さで進むことをテスト
+ *  する．
+ *
+ * 【テストの内容】
+ *
+ *  メインタスクでは，get_utm64とfch_utm64を交互に繰り返し呼び出し，時
+ *  刻が小さくならないかをチェックする．それと並行して，周期ハンドラを
+ *  1ミリ秒周期で実行し，その中でもfch_utm64で時刻を取得する．いずれの
+ *  コンテキストでも，読み出す前に他方のコンテキストが最後に取得した時
+ *  刻を参照し，それより小さくならないかをチェックする．
+ *
+ *  最後に，テスト全体の経過時間をget_utmとget_utm64で比較し，差が
+ *  0.1%を超えていないかをチェックする．
+ */
+
+#include <kernel.h>
+#include <test_lib.h>
+#include <t_syslog.h>
+#include "kernel_cfg.h"
+#include "test_utm2.h"
+
+#ifndef TOPPERS_SUPPORT_GET_UTM64
+#error get_utm64 is not supported.
+#endif /* TOPPERS_SUPPORT_GET_UTM64 */
+
+#define	NO_LOOP		ULONG_C(200000)
+
+volatile SYSUTM64	recent_task;
+volatile SYSUTM64	recent_cyc;
+uint_t	cyclic_count;
+uint_t	error_count;
+
+void
+cyclic_handler(intptr_t exinf)
+{
+	SYSUTM64	sysutm64, prev_task;
+
+	prev_task = recent_task;
+	sysutm64 = fch_utm64();
+	if (sysutm64 < prev_task || sysutm64 < recent_cyc) {
+		error_count += 1;
+	}
+	recent_cyc = sysutm64;
+	cyclic_count += 1;
+}
+
+void
+main_task(intptr_t exinf)
+{
+	SYSUTM64	sysutm64, prev_cyc, begin64;
+	SYSUTM		begin, end;
+	ulong_t		i, elapsed, elapsed64, diff;
+
+	cyclic_count = 0U;
+	error_count = 0U;
+	recent_task = fch_utm64();
+	syslog(LOG_NOTICE, "64bit system performance time test starts.");
+
+	get_utm(&begin);
+	get_utm64(&begin64);
+	for (i = 0; i < NO_LOOP; i++) {
+		prev_cyc = recent_cyc;
+		if ((i & 1U) == 0U) {
+			get_utm64(&sysutm64);
+		}
+		else {
+			sysutm64 = fch_utm64();
+		}
+		if (sysutm64 < prev_cyc || sysutm64 < recent_task) {
+			syslog(LOG_NOTICE, "64bit system performance time goes back"
+								" at loop %d.", i);
+		}
+		recent_task = sysutm64;
+	}
+	get_utm64(&sysutm64);
+	get_utm(&end);
+
+	elapsed = (ulong_t)(end - begin);
+	elapsed64 = (ulong_t)(sysutm64 - begin64);
+	diff = (elapsed > elapsed64) ? elapsed - elapsed64 : elapsed64 - elapsed;
+	syslog(LOG_NOTICE, "elapsed time: get_utm %d, get_utm64 %d",
+												elapsed, elapsed64);
+	if (diff > elapsed / 1000U + 2U) {
+		syslog(LOG_NOTICE, "get_utm64 runs at a different rate.");
+	}
+	if (error_count > 0U) {
+		syslog(LOG_NOTICE, "64bit system performance time goes back"
+							" in cyclic handler: %d", error_count);
+	}
+
+	syslog(LOG_NOTICE, "64bit system performance time test finishes.");
+	syslog(LOG_NOTICE, "number of cyclic handler execution: %d", cyclic_count);
+	test_finish();
+}